@@ -11,6 +11,8 @@ if(CMAKE_CXX_COMPILER_ID MATCHES "GNU|Clang")
   set(AVX_FLAG "-mavx")
   set(AVX2_FLAG "-mavx2")
   set(AVX512F_FLAG "-mavx512f")
+  set(AMX_FLAG
+      "-mamx-tile -mamx-bf16 -mamx-int8 -mavx512f -mavx512bw -mavx512bf16")
   set(Wno_Maybe_Uninitialized "-Wno-maybe-uninitialized")
   set(FMA_FLAG "-mfma")
   if(${CMAKE_CXX_COMPILER_VERSION} VERSION_GREATER_EQUAL 12.0)
@@ -137,6 +139,24 @@ if(AVX512F_FOUND)
   add_definitions(-DPADDLE_WITH_AVX512F)
 endif()
 
+# Check AMX, only whether the compiler supports it: the kernels built with
+# it check the CPU at runtime
+if(AMX_FLAG)
+  set(CMAKE_REQUIRED_FLAGS ${AMX_FLAG})
+  check_cxx_source_compiles(
+    "
+#include <immintrin.h>
+int main()
+{
+    _tile_zero(0);
+    _tile_dpbf16ps(0, 1, 2);
+    _tile_dpbssd(0, 1, 2);
+    _tile_release();
+    return 0;
+}"
+    AMX_FOUND)
+endif()
+
 set(CMAKE_REQUIRED_FLAGS ${CMAKE_REQUIRED_FLAGS_RETAINED})
 mark_as_advanced(MMX_FOUND SSE2_FOUND SSE3_FOUND AVX_FOUND AVX2_FOUND
-                 AVX512F_FOUND)
+                 AVX512F_FOUND AMX_FOUND)
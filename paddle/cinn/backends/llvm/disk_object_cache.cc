@@ -0,0 +1,231 @@
+// Copyright (c) 2025 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/cinn/backends/llvm/disk_object_cache.h"
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "glog/logging.h"
+#include "paddle/common/flags.h"
+
+PD_DECLARE_string(cinn_object_cache_dir);
+PD_DECLARE_int64(cinn_object_cache_max_size_mb);
+
+namespace cinn::backends {
+namespace {
+
+constexpr char kMagic[8] = "CINNOBJ";
+constexpr uint32_t kFormatVersion = 1;
+constexpr char kSuffix[] = ".o";
+// the temporary files left by the processes killed while writing them
+constexpr int64_t kStaleTmpSeconds = 3600;
+
+struct Header {
+  char magic[8];
+  uint32_t version;
+  uint32_t reserved;
+  double compile_ms;
+  uint64_t size;
+};
+
+bool EndsWith(const std::string& s, const std::string& suffix) {
+  return s.size() >= suffix.size() &&
+         s.compare(s.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+}  // namespace
+
+DiskObjectCache* DiskObjectCache::Global() {
+  static std::unique_ptr<DiskObjectCache> cache = []() {
+    std::unique_ptr<DiskObjectCache> cache;
+    if (!FLAGS_cinn_object_cache_dir.empty()) {
+      cache = std::make_unique<DiskObjectCache>(
+          FLAGS_cinn_object_cache_dir,
+          FLAGS_cinn_object_cache_max_size_mb << 20);
+    }
+    return cache;
+  }();
+  return cache.get();
+}
+
+DiskObjectCache::DiskObjectCache(const std::string& dir, int64_t max_bytes)
+    : dir_(dir), max_bytes_(max_bytes) {
+  if (mkdir(dir_.c_str(), 0755) != 0 && errno != EEXIST) {
+    LOG(WARNING) << "Failed to create the object cache directory " << dir_
+                 << ": " << std::strerror(errno)
+                 << ". The object cache is disabled.";
+    enabled_ = false;
+  }
+}
+
+std::string DiskObjectCache::Path(const std::string& key) const {
+  return dir_ + "/" + key + kSuffix;
+}
+
+bool DiskObjectCache::Load(const std::string& key, std::string* object) {
+  if (!enabled_) return false;
+  const std::string path = Path(key);
+  std::ifstream in(path, std::ios::binary | std::ios::ate);
+  const int64_t file_size = in.good() ? static_cast<int64_t>(in.tellg()) : 0;
+  in.seekg(0);
+  Header header;
+  bool valid = file_size >= static_cast<int64_t>(sizeof(header)) &&
+               in.read(reinterpret_cast<char*>(&header), sizeof(header)) &&
+               std::memcmp(header.magic, kMagic, sizeof(kMagic)) == 0 &&
+               header.version == kFormatVersion &&
+               header.size == file_size - sizeof(header);
+  if (valid) {
+    object->resize(header.size);
+    valid = static_cast<bool>(in.read(&(*object)[0], header.size));
+  }
+  std::lock_guard<std::mutex> lock(mu_);
+  if (!valid) {
+    if (in.is_open()) {
+      LOG(WARNING) << "Ignore the broken object " << path;
+    }
+    ++stats_.misses;
+    return false;
+  }
+  // the modification times order the objects for the eviction
+  utimes(path.c_str(), nullptr);
+  ++stats_.hits;
+  stats_.saved_ms += header.compile_ms;
+  VLOG(1) << "Loaded the object " << key << " compiled in "
+          << header.compile_ms << "ms, " << stats_.hits << " hits have saved "
+          << stats_.saved_ms << "ms.";
+  return true;
+}
+
+void DiskObjectCache::Store(const std::string& key,
+                            const std::string& object,
+                            double compile_ms) {
+  if (!enabled_) return;
+  {
+    std::lock_guard<std::mutex> lock(mu_);
+    stats_.compile_ms += compile_ms;
+  }
+  static std::atomic<int> counter{0};
+  const std::string tmp_path = dir_ + "/" + key + ".tmp." +
+                               std::to_string(getpid()) + "." +
+                               std::to_string(counter++);
+  Header header;
+  std::memcpy(header.magic, kMagic, sizeof(kMagic));
+  header.version = kFormatVersion;
+  header.reserved = 0;
+  header.compile_ms = compile_ms;
+  header.size = object.size();
+  {
+    std::ofstream out(tmp_path, std::ios::binary);
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(object.data(), object.size());
+    out.close();
+    if (!out) {
+      LOG(WARNING) << "Failed to write the object " << tmp_path;
+      std::remove(tmp_path.c_str());
+      return;
+    }
+  }
+  // the readers of the other processes see the whole object or no object
+  if (std::rename(tmp_path.c_str(), Path(key).c_str()) != 0) {
+    LOG(WARNING) << "Failed to store the object " << Path(key) << ": "
+                 << std::strerror(errno);
+    std::remove(tmp_path.c_str());
+    return;
+  }
+  VLOG(1) << "Stored the object " << key << " compiled in " << compile_ms
+          << "ms.";
+  Evict();
+}
+
+void DiskObjectCache::Evict() {
+  // one process evicts at a time, the others leave it to that one
+  const std::string lock_path = dir_ + "/.lock";
+  int fd = open(lock_path.c_str(), O_RDWR | O_CREAT, 0644);
+  if (fd < 0) return;
+  if (flock(fd, LOCK_EX | LOCK_NB) != 0) {
+    close(fd);
+    return;
+  }
+
+  struct Entry {
+    std::string path;
+    int64_t size;
+    int64_t mtime;
+  };
+  std::vector<Entry> entries;
+  int64_t total = 0;
+  const int64_t now = static_cast<int64_t>(time(nullptr));
+  if (DIR* dir = opendir(dir_.c_str())) {
+    while (struct dirent* ent = readdir(dir)) {
+      const std::string name = ent->d_name;
+      const std::string path = dir_ + "/" + name;
+      struct stat st;
+      if (stat(path.c_str(), &st) != 0 || !S_ISREG(st.st_mode)) continue;
+      if (EndsWith(name, kSuffix)) {
+        entries.push_back({path, st.st_size, st.st_mtime});
+        total += st.st_size;
+      } else if (name.find(".tmp.") != std::string::npos &&
+                 now - st.st_mtime > kStaleTmpSeconds) {
+        std::remove(path.c_str());
+      }
+    }
+    closedir(dir);
+  }
+
+  if (total > max_bytes_) {
+    // down to 90% of the bound, not to evict again at the next store
+    const int64_t target = max_bytes_ / 10 * 9;
+    std::sort(entries.begin(),
+              entries.end(),
+              [](const Entry& a, const Entry& b) { return a.mtime < b.mtime; });
+    int64_t evicted = 0;
+    for (const auto& entry : entries) {
+      if (total <= target) break;
+      if (std::remove(entry.path.c_str()) == 0) {
+        total -= entry.size;
+        ++evicted;
+      }
+    }
+    std::lock_guard<std::mutex> lock(mu_);
+    stats_.evictions += evicted;
+    VLOG(1) << "Evicted " << evicted << " objects from " << dir_
+            << ", which holds " << total << " bytes.";
+  }
+
+  flock(fd, LOCK_UN);
+  close(fd);
+}
+
+DiskObjectCache::Stats DiskObjectCache::stats() const {
+  std::lock_guard<std::mutex> lock(mu_);
+  return stats_;
+}
+
+}  // namespace cinn::backends
@@ -0,0 +1,73 @@
+// Copyright (c) 2025 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <mutex>  // NOLINT
+#include <string>
+
+namespace cinn::backends {
+
+/**
+ * The objects compiled for the host modules, kept in a directory shared by
+ * the processes: a process compiling a module that was already compiled by
+ * the same LLVM for the same CPU loads the object instead.
+ *
+ * The keys are hashes of the content they stand for, and each object is a
+ * file named by its key. It is written to a temporary file renamed into
+ * place, so that the other processes see the whole file or no file. A hit
+ * updates the modification time of the file, and when the directory grows
+ * over its size bound the least recently used files are removed, by one
+ * process at a time.
+ */
+class DiskObjectCache {
+ public:
+  struct Stats {
+    int64_t hits{0};
+    int64_t misses{0};
+    int64_t evictions{0};
+    // the time spent compiling the missed objects, and the time it took to
+    // compile the objects that were loaded instead
+    double compile_ms{0};
+    double saved_ms{0};
+  };
+
+  // The cache in FLAGS_cinn_object_cache_dir, nullptr if the flag is empty.
+  static DiskObjectCache* Global();
+
+  DiskObjectCache(const std::string& dir, int64_t max_bytes);
+
+  // Reads the object of `key`, returns false if it is not in the cache.
+  bool Load(const std::string& key, std::string* object);
+
+  // Writes the object of `key`, which took compile_ms to compile.
+  void Store(const std::string& key,
+             const std::string& object,
+             double compile_ms);
+
+  Stats stats() const;
+
+ private:
+  std::string Path(const std::string& key) const;
+  void Evict();
+
+  std::string dir_;
+  int64_t max_bytes_;
+  bool enabled_{true};
+  mutable std::mutex mu_;
+  Stats stats_;
+};
+
+}  // namespace cinn::backends
@@ -15,6 +15,7 @@
 #include "paddle/cinn/backends/llvm/execution_engine.h"
 
 #include <absl/strings/string_view.h>
+#include <llvm/ADT/StringExtras.h>
 #include <llvm/ADT/Triple.h>
 #include <llvm/AsmParser/Parser.h>
 #include <llvm/Config/llvm-config.h>
@@ -36,6 +37,7 @@
 #include <llvm/Support/Error.h>
 #include <llvm/Support/Host.h>
 #include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Support/SHA1.h>
 #include <llvm/Support/SourceMgr.h>
 #include <llvm/Support/TargetRegistry.h>
 #include <llvm/Support/TargetSelect.h>
@@ -48,16 +50,19 @@
 #include <llvm/Transforms/Scalar/Reassociate.h>
 #include <llvm/Transforms/Scalar/SimplifyCFG.h>
 
+#include <algorithm>
 #include <cmath>
 #include <memory>
 #include <mutex>  // NOLINT
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "paddle/cinn/backends/codegen_cuda_host.h"
 #include "paddle/cinn/backends/llvm/cinn_runtime_llvm_ir.h"
 #include "paddle/cinn/backends/llvm/codegen_llvm.h"
 #include "paddle/cinn/backends/llvm/codegen_x86.h"
+#include "paddle/cinn/backends/llvm/disk_object_cache.h"
 #include "paddle/cinn/backends/llvm/llvm_optimizer.h"
 #include "paddle/cinn/backends/llvm/llvm_util.h"
 #include "paddle/cinn/backends/llvm/runtime_symbol_registry.h"
@@ -86,25 +91,87 @@ void InitializeLLVMPasses() {
   // llvm::initializeTarget(registry);
   // llvm::initializeCodeGenPreparePass(registry);
 }
+
+// The key of the object of `m` in the disk cache: the object depends on the
+// IR, the LLVM that compiles it and the CPU it is compiled for.
+std::string ObjectKey(const llvm::Module &m) {
+  static const std::string host = []() {
+    std::string host = LLVM_VERSION_STRING;
+    host += ";" + llvm::sys::getHostCPUName().str();
+    llvm::StringMap<bool> features;
+    llvm::sys::getHostCPUFeatures(features);
+    std::vector<std::string> enabled;
+    for (const auto &feature : features) {
+      if (feature.getValue()) enabled.push_back(feature.getKey().str());
+    }
+    std::sort(enabled.begin(), enabled.end());
+    for (const auto &feature : enabled) {
+      host += ";+" + feature;
+    }
+    return host;
+  }();
+  std::string ir;
+  llvm::raw_string_ostream os(ir);
+  m.print(os, nullptr);
+  os.flush();
+
+  llvm::SHA1 sha1;
+  sha1.update(host);
+  sha1.update(m.getTargetTriple());
+  sha1.update(ir);
+  return llvm::toHex(sha1.final(), /*LowerCase=*/true);
+}
 }  // namespace
+
 void NaiveObjectCache::notifyObjectCompiled(const llvm::Module *m,
                                             llvm::MemoryBufferRef obj_buffer) {
+  std::lock_guard<std::mutex> lock(mu_);
   cached_objects_[m->getModuleIdentifier()] =
       llvm::MemoryBuffer::getMemBufferCopy(obj_buffer.getBuffer(),
                                            obj_buffer.getBufferIdentifier());
+  auto it = pending_.find(m);
+  if (it != pending_.end()) {
+    DiskObjectCache::Global()->Store(it->second.key,
+                                     obj_buffer.getBuffer().str(),
+                                     it->second.timer.Stop());
+    pending_.erase(it);
+  }
 }
 
 std::unique_ptr<llvm::MemoryBuffer> NaiveObjectCache::getObject(
     const llvm::Module *m) {
+  std::lock_guard<std::mutex> lock(mu_);
   auto it = cached_objects_.find(m->getModuleIdentifier());
-  if (it == cached_objects_.end()) {
-    VLOG(1) << "No object for " << m->getModuleIdentifier()
-            << " in cache. Compiling.";
-    return nullptr;
+  if (it != cached_objects_.end()) {
+    VLOG(3) << "Object for " << m->getModuleIdentifier()
+            << " loaded from cache.";
+    return llvm::MemoryBuffer::getMemBuffer(it->second->getMemBufferRef());
+  }
+
+  if (auto *disk_cache = DiskObjectCache::Global()) {
+    const std::string key = ObjectKey(*m);
+    std::string object;
+    if (disk_cache->Load(key, &object)) {
+      VLOG(1) << "Object for " << m->getModuleIdentifier()
+              << " loaded from disk cache.";
+      auto &cached = cached_objects_[m->getModuleIdentifier()];
+      cached = llvm::MemoryBuffer::getMemBufferCopy(object,
+                                                    m->getModuleIdentifier());
+      return llvm::MemoryBuffer::getMemBuffer(cached->getMemBufferRef());
+    }
+    pending_[m].key = key;
+    pending_[m].timer.Start();
   }
+  VLOG(1) << "No object for " << m->getModuleIdentifier()
+          << " in cache. Compiling.";
+  return nullptr;
+}
 
-  VLOG(3) << "Object for " << m->getModuleIdentifier() << " loaded from cache.";
-  return llvm::MemoryBuffer::getMemBuffer(it->second->getMemBufferRef());
+llvm::StringRef NaiveObjectCache::GetObject(const std::string &id) const {
+  std::lock_guard<std::mutex> lock(mu_);
+  auto it = cached_objects_.find(id);
+  if (it == cached_objects_.end()) return {};
+  return it->second->getBuffer();
 }
 
 /*static*/ std::unique_ptr<ExecutionEngine> ExecutionEngine::Create(
@@ -194,11 +261,14 @@ void ExecutionEngine::Link(const ir::Module &module) {
     VLOG(5) << "function: " << DumpToString(f);
   }
 
-  llvm::raw_svector_ostream rawstream(buffer_);
-  llvm::legacy::PassManager pass_manager;
-  machine->addPassesToEmitFile(
-      pass_manager, rawstream, nullptr, llvm::CGFT_ObjectFile);
-  pass_manager.run(*m);
+  module_id_ = m->getModuleIdentifier();
+  module_symbol_.clear();
+  for (auto &f : *m) {
+    if (!f.isDeclaration() && f.hasExternalLinkage()) {
+      module_symbol_ = f.getName().str();
+      break;
+    }
+  }
 
   if (VLOG_IS_ON(5)) {
     VLOG(5) << "======= dump jit execution session ======";
@@ -248,9 +318,44 @@ bool ExecutionEngine::AddSelfModule() {
 }
 
 void ExecutionEngine::ExportObject(const std::string &path) {
-  FILE *of = fopen(path.c_str(), "w");
-  fwrite(buffer_.data(), 1, buffer_.size(), of);
+  // the object is compiled when the module is added to the jit, or here if
+  // it is not added yet
+  llvm::SmallString<0> buffer;
+  llvm::StringRef object;
+  if (m) {
+    auto machine = std::move(llvm::cantFail(
+        llvm::cantFail(llvm::orc::JITTargetMachineBuilder::detectHost())
+            .createTargetMachine()));
+    llvm::raw_svector_ostream rawstream(buffer);
+    llvm::legacy::PassManager pass_manager;
+    machine->addPassesToEmitFile(
+        pass_manager, rawstream, nullptr, llvm::CGFT_ObjectFile);
+    pass_manager.run(*m);
+    object = buffer;
+  } else {
+    object = cache_->GetObject(module_id_);
+    if (object.empty() && !module_symbol_.empty()) {
+      // LLJIT compiles a module at the first lookup of one of its symbols
+      Lookup(module_symbol_);
+      object = cache_->GetObject(module_id_);
+    }
+  }
+  PADDLE_ENFORCE_EQ(!object.empty(),
+                    true,
+                    ::common::errors::PreconditionNotMet(
+                        "No object is compiled for the module %s to export.",
+                        module_id_));
+  FILE *of = fopen(path.c_str(), "wb");
+  PADDLE_ENFORCE_NOT_NULL(
+      of,
+      ::common::errors::Unavailable("Failed to open %s to export the object.",
+                                    path));
+  size_t written = fwrite(object.data(), 1, object.size(), of);
   fclose(of);
+  PADDLE_ENFORCE_EQ(
+      written,
+      object.size(),
+      ::common::errors::Unavailable("Failed to write the object to %s.", path));
 }
 
 void *ExecutionEngine::Lookup(absl::string_view name) {
@@ -41,23 +41,42 @@
 #include <mutex>  // NOLINT
 #include <optional>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "paddle/cinn/backends/llvm/codegen_x86.h"
 #include "paddle/cinn/backends/llvm/llvm_util.h"
 #include "paddle/cinn/backends/llvm/runtime_symbol_registry.h"
 #include "paddle/cinn/ir/module.h"
+#include "paddle/cinn/utils/timer.h"
 
 namespace cinn::backends {
 
+/**
+ * The objects compiled in this process, by module identifier. With
+ * FLAGS_cinn_object_cache_dir set, the objects missed are looked up in the
+ * DiskObjectCache, by the hash of the module IR, the LLVM version and the
+ * host CPU, and the ones compiled are stored there.
+ */
 class NaiveObjectCache : public llvm::ObjectCache {
  public:
   void notifyObjectCompiled(const llvm::Module *,
                             llvm::MemoryBufferRef) override;
   std::unique_ptr<llvm::MemoryBuffer> getObject(const llvm::Module *) override;
 
+  // The object compiled for the module `id`, empty if it is not compiled.
+  llvm::StringRef GetObject(const std::string &id) const;
+
  private:
+  struct PendingObject {
+    std::string key;
+    utils::Timer timer;
+  };
+
+  mutable std::mutex mu_;
   llvm::StringMap<std::unique_ptr<llvm::MemoryBuffer>> cached_objects_;
+  // the modules missed in the disk cache, which are being compiled
+  std::unordered_map<const llvm::Module *, PendingObject> pending_;
 };
 
 struct ExecutionOptions {
@@ -103,7 +122,10 @@ class ExecutionEngine {
 
  private:
   mutable std::mutex mu_;
-  llvm::SmallString<0> buffer_;
+  // the identifier of the module linked, to export its object, and a
+  // symbol it defines, whose lookup compiles it
+  std::string module_id_;
+  std::string module_symbol_;
   std::unique_ptr<llvm::orc::LLJIT> jit_;
   std::unique_ptr<NaiveObjectCache> cache_;
   RuntimeSymbols module_symbols_;
@@ -227,6 +227,18 @@ PD_DEFINE_string(
     StringFromEnv("FLAGS_cinn_dump_group_instruction", ""),
     "Specify the path for dump instruction by group, which is used for debug.");
 
+PD_DEFINE_string(
+    cinn_object_cache_dir,
+    StringFromEnv("FLAGS_cinn_object_cache_dir", ""),
+    "Specify the directory where the objects compiled for the host modules "
+    "are cached across processes. The cache is disabled if it is empty.");
+
+PD_DEFINE_int64(
+    cinn_object_cache_max_size_mb,
+    Int64FromEnv("FLAGS_cinn_object_cache_max_size_mb", 2048L),
+    "The size bound of the directory of FLAGS_cinn_object_cache_dir in MB, "
+    "over which the least recently used objects are removed.");
+
 // Todo(CZ): support kernel name check for multiple kernel code gen.
 PD_DEFINE_string(cinn_debug_custom_code_path,
                  StringFromEnv("FLAGS_cinn_debug_custom_code_path", ""),
@@ -2027,6 +2027,64 @@ PHI_DEFINE_EXPORTED_bool(save_cf_stack_op,
                          false,
                          "Save cf stack op for higher-order derivatives.");
 
+/**
+ * Inference related FLAG
+ * Name: FLAGS_load_combine_params_by_mmap
+ * Value Range: bool, default=false
+ * Example:
+ * Note: Load combined parameter files by mmap. CPU parameters whose data is
+ *       64-byte aligned in the file are used in place from the page cache
+ *       instead of being copied into newly allocated memory.
+ */
+PHI_DEFINE_EXPORTED_bool(load_combine_params_by_mmap,
+                         false,
+                         "Load combined parameter files by mmap, CPU "
+                         "parameters share the mapped pages when possible.");
+
+/**
+ * Inference related FLAG
+ * Name: FLAGS_load_params_thread_num
+ * Value Range: int32, default=8
+ * Example:
+ * Note: Number of threads used to load parameters. Separate parameter files
+ *       are read in parallel, tensors of a combined file are cast and copied
+ *       to the target place while the file is still being read. 1 loads
+ *       everything on the calling thread.
+ */
+PHI_DEFINE_EXPORTED_int32(load_params_thread_num,
+                          8,
+                          "Number of threads used to load parameters.");
+
+/**
+ * Inference related FLAG
+ * Name: FLAGS_fc_amx_gemm_type
+ * Value Range: string, "", "bf16" or "int8", default=""
+ * Example: FLAGS_fc_amx_gemm_type=bf16
+ * Note: Run the float32 fc kernels on CPU with the AMX tiles of Sapphire
+ *       Rapids and later CPUs: the inputs rounded to bf16, or quantized to
+ *       int8 per row and per channel. The weights are packed at the first
+ *       run and must not change after. Ignored by the CPUs without AMX.
+ */
+PHI_DEFINE_EXPORTED_string(fc_amx_gemm_type,
+                           "",
+                           "Run the float32 fc kernels on CPU with the AMX "
+                           "tiles, in bf16 or int8. Empty to disable.");
+
+/**
+ * Inference related FLAG
+ * Name: FLAGS_fc_pack_weights
+ * Value Range: bool, default=false
+ * Example: FLAGS_fc_pack_weights=true
+ * Note: Pack the weights of the fc kernels on CPU once with the packed GEMM
+ *       of MKL, and run the GEMMs of every batch on the packed weights. The
+ *       weights are packed at the first run and must not change after.
+ *       Ignored by the builds without MKL.
+ */
+PHI_DEFINE_EXPORTED_bool(fc_pack_weights,
+                         false,
+                         "Pack the weights of the fc kernels on CPU once with "
+                         "the packed GEMM of MKL.");
+
 #if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
 /**
  * FlashAttention related FLAG
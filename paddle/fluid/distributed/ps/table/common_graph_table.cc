@@ -24,6 +24,7 @@
 
 #include "paddle/common/flags.h"
 #include "paddle/fluid/distributed/common/utils.h"
+#include "paddle/fluid/distributed/ps/table/graph/graph_edge_parser.h"
 #include "paddle/fluid/distributed/ps/table/graph/graph_node.h"
 #include "paddle/fluid/framework/fleet/fleet_wrapper.h"
 #include "paddle/fluid/framework/fleet/heter_ps/graph_gpu_wrapper.h"
@@ -57,6 +58,22 @@ PHI_DEFINE_EXPORTED_int32(graph_edges_debug_node_id, 0, "graph debug node id");
 PHI_DEFINE_EXPORTED_int32(graph_edges_debug_node_num,
                           2,
                           "graph debug node num");
+PHI_DEFINE_EXPORTED_bool(graph_edges_csr_storage,
+                         false,
+                         "freeze loaded edges into per-shard CSR arrays");
+PHI_DEFINE_EXPORTED_bool(graph_edges_csr_delta_encode,
+                         false,
+                         "varint delta-encode neighbor ids in CSR storage");
+PHI_DEFINE_EXPORTED_bool(graph_load_edges_by_mmap,
+                         false,
+                         "load local edge files by mmap and parallel parsing");
+PHI_DEFINE_EXPORTED_int32(graph_mmap_load_batch_mb,
+                          4096,
+                          "bytes of edge files mapped and parsed per batch");
+PHI_DEFINE_EXPORTED_int32(graph_sample_cache_expire_ms,
+                          0,
+                          "expire cached neighbor samples after this many "
+                          "milliseconds, 0 means only the hit-count ttl");
 
 namespace paddle::distributed {
 
@@ -1712,6 +1729,7 @@ int32_t GraphTable::add_comm_edge(int idx, uint64_t src_id, uint64_t dst_id) {
     return -1;
   }
   size_t index = src_shard_id - shard_start;
+  edge_shards[idx][index]->thaw();
   edge_shards[idx][index]->add_graph_node(src_id)->build_edges(false);
   edge_shards[idx][index]->add_neighbor(src_id, dst_id, 1.0);
   return 0;
@@ -1720,6 +1738,7 @@ int32_t GraphTable::add_graph_node(int idx,
                                    std::vector<uint64_t> &id_list,
                                    std::vector<bool> &is_weight_list) {
   auto &shards = edge_shards[idx];
+  thaw_edges(idx);
   size_t node_size = id_list.size();
   std::vector<std::vector<std::pair<uint64_t, bool>>> batch(task_pool_size_);
   for (size_t i = 0; i < node_size; i++) {
@@ -1777,6 +1796,35 @@ void GraphShard::clear() {
   }
   bucket.clear();
   node_location.clear();
+  csr.clear();
+  frozen = false;
+}
+
+void GraphShard::freeze(bool is_weighted, bool delta_encode) {
+  if (frozen) return;
+  bool has_alias = csr.has_alias();
+  csr.build(bucket, is_weighted, delta_encode);
+  if (has_alias) csr.build_alias();
+  for (auto &node : bucket) {
+    node->release_edges();
+  }
+  frozen = true;
+}
+
+void GraphShard::thaw() {
+  if (!frozen) return;
+  std::vector<uint64_t> row;
+  for (size_t i = 0; i < csr.node_num(); i++) {
+    Node *node = bucket[i];
+    node->build_edges(csr.is_weighted());
+    csr.get_neighbors(i, &row);
+    for (size_t j = 0; j < row.size(); j++) {
+      node->add_edge(row[j], csr.neighbor_weight(i, j));
+    }
+    node->build_sampler(sample_type);
+  }
+  csr.clear();
+  frozen = false;
 }
 
 GraphShard::~GraphShard() { clear(); }
@@ -1784,6 +1832,8 @@ GraphShard::~GraphShard() { clear(); }
 void GraphShard::delete_node(uint64_t id) {
   auto iter = node_location.find(id);
   if (iter == node_location.end()) return;
+  thaw();
+  csr.clear();
   int pos = iter->second;
   delete bucket[pos];
   if (pos != static_cast<int>(bucket.size()) - 1) {
@@ -1829,6 +1879,7 @@ FeatureNode *GraphShard::add_feature_node(uint64_t id,
 }
 
 void GraphShard::add_neighbor(uint64_t id, uint64_t dst_id, float weight) {
+  thaw();
   find_node(id)->add_edge(dst_id, weight);
 }
 
@@ -2016,6 +2067,9 @@ int32_t GraphTable::parse_edge_and_load(
   VLOG(0) << "Node id= " << node_id_
           << " Parallel Partition the graph successfully!";
   VLOG(0) << "load all etypes total edge nodes count=" << total_cnt;
+  if (FLAGS_graph_edges_csr_storage) {
+    freeze_edges(FLAGS_graph_edges_csr_delta_encode);
+  }
 
   return 0;
 }
@@ -2248,6 +2302,9 @@ int32_t GraphTable::load_node_and_edge_file(
     VLOG(0) << "Fail to load node_and_edge_file";
     return -1;
   }
+  if (FLAGS_graph_edges_csr_storage) {
+    freeze_edges(FLAGS_graph_edges_csr_delta_encode);
+  }
   return 0;
 }
 
@@ -2493,7 +2550,30 @@ int32_t GraphTable::load_nodes(const std::string &path,
 }
 
 int32_t GraphTable::build_sampler(int idx, std::string sample_type) {
+  if (sample_type == "alias") {
+    // one contiguous CSR + alias table per shard instead of per-node samplers
+    std::vector<std::future<size_t>> tasks;
+    auto &shards = edge_shards[idx];
+    for (size_t i = 0; i < shards.size(); i++) {
+      tasks.push_back(_shards_task_pool[i % task_pool_size_]->enqueue(
+          [&shards, i, this]() -> size_t {
+            shards[i]->build_csr(is_weighted_);
+            return shards[i]->csr.memory_size();
+          }));
+    }
+    size_t total_bytes = 0;
+    for (auto &task : tasks) total_bytes += task.get();
+    VLOG(0) << "build alias sampler for edge idx[" << idx
+            << "], csr memory bytes=" << total_bytes;
+    return 0;
+  }
   for (auto &shard : edge_shards[idx]) {
+    // restored by thaw
+    shard->sample_type = sample_type;
+    if (shard->is_frozen()) {
+      // frozen shards sample uniformly from csr unless "alias" is requested
+      continue;
+    }
     auto bucket = shard->get_bucket();
     for (auto item : bucket) {
       item->build_sampler(sample_type);
@@ -2502,6 +2582,59 @@ int32_t GraphTable::build_sampler(int idx, std::string sample_type) {
   return 0;
 }
 
+int32_t GraphTable::freeze_edges(bool delta_encode) {
+  for (size_t idx = 0; idx < edge_shards.size(); ++idx) {
+    freeze_edges(idx, delta_encode);
+  }
+  return 0;
+}
+
+int32_t GraphTable::freeze_edges(int idx, bool delta_encode) {
+  if (!build_sampler_on_cpu) {
+    VLOG(0) << "skip freezing edges to csr, gpugraph reads per-node edges";
+    return 0;
+  }
+  std::vector<std::future<std::pair<size_t, size_t>>> tasks;
+  for (size_t part_id = 0; part_id < edge_shards[idx].size(); ++part_id) {
+    tasks.push_back(load_node_edge_task_pool->enqueue(
+        [this, idx, part_id, delta_encode]() -> std::pair<size_t, size_t> {
+          auto &shard = edge_shards[idx][part_id];
+          shard->freeze(is_weighted_, delta_encode);
+          return {shard->csr.edge_num(), shard->csr.memory_size()};
+        }));
+  }
+  size_t edge_count = 0;
+  size_t bytes = 0;
+  for (auto &t : tasks) {
+    auto res = t.get();
+    edge_count += res.first;
+    bytes += res.second;
+  }
+  VLOG(0) << "freeze edges of edge idx[" << idx
+          << "] to csr, edge count=" << edge_count
+          << ", csr memory bytes=" << bytes
+          << ", delta encode=" << delta_encode;
+  return 0;
+}
+
+bool GraphTable::thaw_edges(int idx) {
+  std::vector<std::future<bool>> tasks;
+  for (size_t part_id = 0; part_id < edge_shards[idx].size(); ++part_id) {
+    tasks.push_back(
+        load_node_edge_task_pool->enqueue([this, idx, part_id]() -> bool {
+          auto &shard = edge_shards[idx][part_id];
+          bool frozen = shard->is_frozen();
+          shard->thaw();
+          return frozen;
+        }));
+  }
+  bool thawed = false;
+  for (auto &t : tasks) {
+    thawed = t.get() || thawed;
+  }
+  return thawed;
+}
+
 std::pair<uint64_t, uint64_t> GraphTable::parse_edge_file(
     const std::string &path, int idx, bool reverse, bool use_weight) {
   is_weighted_ = use_weight;
@@ -2583,6 +2716,166 @@ std::pair<uint64_t, uint64_t> GraphTable::parse_edge_file(
   return {local_count, local_valid_count};
 }
 
+std::pair<uint64_t, uint64_t> GraphTable::parse_edge_files_by_mmap(
+    const std::vector<std::string> &paths,
+    int idx,
+    bool reverse,
+    bool use_weight) {
+  struct ParsedEdge {
+    uint64_t src_id;
+    uint64_t dst_id;
+    float weight;
+  };
+  struct FileRange {
+    size_t file;
+    size_t begin;
+    size_t end;
+  };
+  is_weighted_ = use_weight;
+  const size_t local_shard_num = shard_end - shard_start;
+  const size_t batch_bytes =
+      static_cast<size_t>(std::max(FLAGS_graph_mmap_load_batch_mb, 1)) << 20;
+  const bool hard_split = FLAGS_graph_edges_split_mode == "hard" ||
+                          FLAGS_graph_edges_split_mode == "HARD";
+  uint64_t count = 0;
+  uint64_t valid_count = 0;
+  uint64_t total_bytes = 0;
+  platform::Timer map_timer, parse_timer, insert_timer;
+
+  size_t file_pos = 0;
+  while (file_pos < paths.size()) {
+    // stage 1: map a batch of files and cut them into line-aligned ranges
+    map_timer.Resume();
+    std::vector<std::unique_ptr<MmapEdgeFile>> files;
+    std::vector<uint64_t> part_nums;
+    size_t mapped_bytes = 0;
+    while (file_pos < paths.size() &&
+           (files.empty() || mapped_bytes < batch_bytes)) {
+      const std::string &path = paths[file_pos++];
+      files.emplace_back(new MmapEdgeFile(path));
+      mapped_bytes += files.back()->size();
+      uint64_t part_num = 0;
+      if (FLAGS_graph_load_in_parallel) {
+        auto path_split =
+            ::paddle::string::split_string<std::string>(path, "/");
+        auto part_name_split = ::paddle::string::split_string<std::string>(
+            path_split[path_split.size() - 1], "-");
+        part_num = std::stoull(part_name_split[part_name_split.size() - 1]);
+      }
+      part_nums.push_back(part_num);
+    }
+    total_bytes += mapped_bytes;
+    size_t chunk_size = std::max<size_t>(
+        1 << 22, mapped_bytes / std::max(load_thread_num_, 1) + 1);
+    std::vector<FileRange> ranges;
+    for (size_t f = 0; f < files.size(); f++) {
+      for (auto &r : files[f]->split(chunk_size)) {
+        ranges.push_back({f, r.first, r.second});
+      }
+    }
+    map_timer.Pause();
+
+    // stage 2: parse ranges in parallel, bucketing edges by local shard
+    parse_timer.Resume();
+    std::vector<std::vector<std::vector<ParsedEdge>>> buckets(ranges.size());
+    std::vector<std::future<std::pair<uint64_t, uint64_t>>> parse_tasks;
+    for (size_t r = 0; r < ranges.size(); r++) {
+      parse_tasks.push_back(load_node_edge_task_pool->enqueue(
+          [&, r, this]() -> std::pair<uint64_t, uint64_t> {
+            auto &range = ranges[r];
+            auto &bucket = buckets[r];
+            bucket.resize(local_shard_num);
+            const char *data = files[range.file]->data();
+            const char *p = data + range.begin;
+            const char *end = data + range.end;
+            uint64_t part_num = part_nums[range.file];
+            uint64_t local_count = 0;
+            uint64_t local_valid_count = 0;
+            while (p < end) {
+              const char *line_end = static_cast<const char *>(
+                  memchr(p, '\n', end - p));
+              if (line_end == nullptr) line_end = end;
+              const char *line = p;
+              p = line_end + 1;
+              uint64_t src_id, dst_id;
+              const char *q = scan_uint64(line, line_end, &src_id);
+              if (q == nullptr || q == line_end || *q != '\t') continue;
+              local_count++;
+              const char *tab = q;
+              q = scan_uint64(q + 1, line_end, &dst_id);
+              if (q == nullptr) continue;
+              float weight = 1;
+              const char *last = line_end;
+              while (last > tab && *(last - 1) != '\t') --last;
+              if (last - 1 != tab &&
+                  scan_float(last, line_end, &weight) == nullptr) {
+                weight = 1;
+              }
+              if (reverse) {
+                std::swap(src_id, dst_id);
+              }
+              size_t src_shard_id = src_id % shard_num;
+              if (FLAGS_graph_load_in_parallel &&
+                  src_shard_id != (part_num % shard_num)) {
+                continue;
+              }
+              if (src_shard_id >= shard_end || src_shard_id < shard_start) {
+                continue;
+              }
+              if (hard_split) {
+                if (!is_key_for_self_rank(src_id)) continue;
+                if (!FLAGS_graph_edges_split_only_by_src_id &&
+                    !is_key_for_self_rank(dst_id)) {
+                  continue;
+                }
+              }
+              bucket[src_shard_id - shard_start].push_back(
+                  {src_id, dst_id, weight});
+              local_valid_count++;
+            }
+            return {local_count, local_valid_count};
+          }));
+    }
+    for (auto &t : parse_tasks) {
+      auto res = t.get();
+      count += res.first;
+      valid_count += res.second;
+    }
+    parse_timer.Pause();
+
+    // stage 3: bulk insert, every shard is written by exactly one task
+    insert_timer.Resume();
+    std::vector<std::future<int>> insert_tasks;
+    for (size_t s = 0; s < local_shard_num; s++) {
+      insert_tasks.push_back(
+          load_node_edge_task_pool->enqueue([&, s, this]() -> int {
+            auto *shard = edge_shards[idx][s];
+            for (auto &bucket : buckets) {
+              for (auto &e : bucket[s]) {
+                auto node = shard->add_graph_node(e.src_id);
+                node->build_edges(is_weighted_);
+                node->add_edge(e.dst_id, e.weight);
+              }
+              std::vector<ParsedEdge>().swap(bucket[s]);
+            }
+            return 0;
+          }));
+    }
+    for (auto &t : insert_tasks) t.get();
+    insert_timer.Pause();
+  }
+  double parse_sec = std::max(parse_timer.ElapsedSec(), 1e-9);
+  double insert_sec = std::max(insert_timer.ElapsedSec(), 1e-9);
+  VLOG(0) << "mmap load " << paths.size() << " edge files, " << total_bytes
+          << " bytes, " << valid_count << "/" << count
+          << " edges; map cost=" << map_timer.ElapsedSec()
+          << "s, parse cost=" << parse_sec << "s ("
+          << total_bytes / parse_sec / (1 << 20) << " MB/s, "
+          << count / parse_sec << " edges/s), insert cost=" << insert_sec
+          << "s (" << valid_count / insert_sec << " edges/s)";
+  return {count, valid_count};
+}
+
 std::pair<uint64_t, uint64_t> GraphTable::load_edges(
     const std::string &path,
     bool reverse_edge,
@@ -2607,9 +2900,16 @@ std::pair<uint64_t, uint64_t> GraphTable::load_edges(
   auto paths = ::paddle::string::split_string<std::string>(path, ";");
   uint64_t count = 0;
   uint64_t valid_count = 0;
+  // edges are inserted into per-node edges, frozen shards are frozen again
+  // after the load
+  bool refreeze = thaw_edges(idx);
 
   VLOG(0) << "Begin GraphTable::load_edges() edge_type[" << edge_type << "]";
-  if (FLAGS_graph_load_in_parallel) {
+  if (FLAGS_graph_load_edges_by_mmap) {
+    auto res = parse_edge_files_by_mmap(paths, idx, reverse_edge, use_weight);
+    count += res.first;
+    valid_count += res.second;
+  } else if (FLAGS_graph_load_in_parallel) {
     std::vector<std::future<std::pair<uint64_t, uint64_t>>> tasks;
     for (size_t i = 0; i < paths.size(); i++) {
       tasks.push_back(load_node_edge_task_pool->enqueue(
@@ -2661,6 +2961,9 @@ std::pair<uint64_t, uint64_t> GraphTable::load_edges(
       }
     }
   }
+  if (refreeze) {
+    freeze_edges(idx, FLAGS_graph_edges_csr_delta_encode);
+  }
 
   return {count, valid_count};
 }
@@ -2704,6 +3007,14 @@ Node *GraphTable::find_node(GraphTableType table_type, int idx, uint64_t id) {
   Node *node = search_shards[index]->find_node(id);
   return node;
 }
+const GraphCSR *GraphTable::find_csr(int idx, uint64_t id, int *pos) {
+  size_t shard_id = id % shard_num;
+  if (shard_id >= shard_end || shard_id < shard_start) {
+    return nullptr;
+  }
+  return edge_shards[idx][shard_id - shard_start]->find_csr(id, pos);
+}
+
 uint32_t GraphTable::get_thread_pool_index(uint64_t node_id) {
   return node_id % shard_num % shard_num_per_server % task_pool_size_;
 }
@@ -2817,79 +3128,115 @@ int32_t GraphTable::random_sample_neighbors(
     if (seq_id[i].empty()) continue;
     tasks.push_back(_shards_task_pool[i]->enqueue([&, i, this]() -> int {
       uint64_t node_id;
-      std::vector<std::pair<SampleKey, SampleResult>> r;
-      LRUResponse response = LRUResponse::blocked;
+      std::vector<SampleResult> r;
+      std::vector<uint8_t> hit;
+      size_t hit_num = 0;
       if (use_cache) {
-        response =
-            scaled_lru->query(i, id_list[i].data(), id_list[i].size(), r);
+        hit_num = sample_cache->query(
+            i, id_list[i].data(), id_list[i].size(), &r, &hit);
       }
-      size_t index = 0;
       std::vector<SampleResult> sample_res;
       std::vector<SampleKey> sample_keys;
+      if (use_cache) {
+        sample_res.reserve(id_list[i].size() - hit_num);
+        sample_keys.reserve(id_list[i].size() - hit_num);
+      }
+      // the sampled neighbors of the whole batch share one block, the
+      // buffer of a node points into it and keeps it alive
+      struct Sampled {
+        size_t k;
+        const GraphCSR *csr;
+        int csr_pos;
+        Node *node;
+        std::vector<int> res;
+      };
+      std::vector<Sampled> sampled;
+      size_t block_size = 0;
+      const size_t unit_size =
+          need_weight ? Node::id_size + Node::weight_size : Node::id_size;
       auto &rng = _shards_task_rng_pool[i];
       for (size_t k = 0; k < id_list[i].size(); k++) {
-        if (index < r.size() &&
-            r[index].first.node_key == id_list[i][k].node_key) {
-          int idy = seq_id[i][k];
-          actual_sizes[idy] = r[index].second.actual_size;
-          buffers[idy] = r[index].second.buffer;
-          index++;
-        } else {
-          node_id = id_list[i][k].node_key;
-          Node *node = find_node(GraphTableType::EDGE_TABLE, idx, node_id);
-          int idy = seq_id[i][k];
-          int &actual_size = actual_sizes[idy];
-          if (node == nullptr) {
+        int idy = seq_id[i][k];
+        if (hit_num > 0 && hit[k]) {
+          actual_sizes[idy] = r[k].actual_size;
+          buffers[idy] = r[k].buffer;
+          continue;
+        }
+        node_id = id_list[i][k].node_key;
+        int csr_pos = -1;
+        const GraphCSR *csr = find_csr(idx, node_id, &csr_pos);
+        Node *node = nullptr;
+        if (csr == nullptr) {
+          node = find_node(GraphTableType::EDGE_TABLE, idx, node_id);
+        }
+        int &actual_size = actual_sizes[idy];
+        if (csr == nullptr && node == nullptr) {
 #ifdef PADDLE_WITH_HETERPS
-            if (search_level == 2) {
-              VLOG(2) << "enter sample from ssd for node_id " << node_id;
-              char *buffer_addr = random_sample_neighbor_from_ssd(
-                  idx, node_id, sample_size, rng, actual_size);
-              if (actual_size != 0) {
-                std::shared_ptr<char> &buffer = buffers[idy];
-                buffer.reset(buffer_addr, char_del);
-              }
-              VLOG(2) << "actual sampled size from ssd = " << actual_sizes[idy];
-              continue;
+          if (search_level == 2) {
+            VLOG(2) << "enter sample from ssd for node_id " << node_id;
+            char *buffer_addr = random_sample_neighbor_from_ssd(
+                idx, node_id, sample_size, rng, actual_size);
+            if (actual_size != 0) {
+              std::shared_ptr<char> &buffer = buffers[idy];
+              buffer.reset(buffer_addr, char_del);
             }
-#endif
-            actual_size = 0;
+            VLOG(2) << "actual sampled size from ssd = " << actual_sizes[idy];
             continue;
           }
-          std::shared_ptr<char> &buffer = buffers[idy];
-          std::vector<int> res = node->sample_k(sample_size, rng);
-          actual_size =
-              res.size() * (need_weight ? (Node::id_size + Node::weight_size)
-                                        : Node::id_size);
-          int offset = 0;
-          uint64_t id;
-          float weight;
-          char *buffer_addr = new char[actual_size];
-          if (response == LRUResponse::ok) {
-            sample_keys.emplace_back(idx, node_id, sample_size, need_weight);
-            sample_res.emplace_back(actual_size, buffer_addr);
-            buffer = sample_res.back().buffer;
-          } else {
-            buffer.reset(buffer_addr, char_del);
-          }
-          for (int &x : res) {
-            id = node->get_neighbor_id(x);
-            memcpy(buffer_addr + offset, &id, Node::id_size);
-            offset += Node::id_size;
-            if (need_weight) {
+#endif
+          actual_size = 0;
+          continue;
+        }
+        sampled.push_back({k, csr, csr_pos, node, {}});
+        sampled.back().res = csr != nullptr
+                                 ? csr->sample_k(csr_pos, sample_size, rng)
+                                 : node->sample_k(sample_size, rng);
+        actual_size = sampled.back().res.size() * unit_size;
+        block_size += actual_size;
+      }
+
+      std::shared_ptr<char> block;
+      if (block_size > 0) {
+        block.reset(new char[block_size], char_del);
+      }
+      size_t block_offset = 0;
+      std::vector<uint64_t> csr_ids;
+      for (auto &item : sampled) {
+        int idy = seq_id[i][item.k];
+        char *buffer_addr = block.get() + block_offset;
+        block_offset += actual_sizes[idy];
+        // aliasing the block allocates nothing
+        buffers[idy] = std::shared_ptr<char>(block, buffer_addr);
+        if (use_cache) {
+          sample_keys.push_back(id_list[i][item.k]);
+          sample_res.emplace_back(actual_sizes[idy], buffers[idy]);
+        }
+        if (item.csr != nullptr) {
+          item.csr->neighbor_ids(item.csr_pos, item.res, &csr_ids);
+        }
+        int offset = 0;
+        uint64_t id;
+        float weight;
+        for (size_t j = 0; j < item.res.size(); j++) {
+          int x = item.res[j];
+          id = item.csr != nullptr ? csr_ids[j] : item.node->get_neighbor_id(x);
+          memcpy(buffer_addr + offset, &id, Node::id_size);
+          offset += Node::id_size;
+          if (need_weight) {
 #if defined(PADDLE_WITH_HETERPS) && defined(PADDLE_WITH_PSCORE)
-              weight = node->get_neighbor_weight(x);
+            weight = item.csr != nullptr
+                         ? item.csr->neighbor_weight(item.csr_pos, x)
+                         : item.node->get_neighbor_weight(x);
 #else
-              weight = 1.0;
+            weight = 1.0;
 #endif
-              memcpy(buffer_addr + offset, &weight, Node::weight_size);
-              offset += Node::weight_size;
-            }
+            memcpy(buffer_addr + offset, &weight, Node::weight_size);
+            offset += Node::weight_size;
           }
         }
       }
       if (!sample_res.empty()) {
-        scaled_lru->insert(
+        sample_cache->insert(
             i, sample_keys.data(), sample_res.data(), sample_keys.size());
       }
       return 0;
@@ -2901,6 +3248,32 @@ int32_t GraphTable::random_sample_neighbors(
   return 0;
 }
 
+int32_t GraphTable::make_neighbor_sample_cache(size_t size_limit,
+                                               size_t ttl) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  if (sample_cache == nullptr) {
+    sample_cache = std::make_shared<NeighborSampleCache>(
+        task_pool_size_, size_limit, ttl, FLAGS_graph_sample_cache_expire_ms);
+    VLOG(0) << "make neighbor sample cache, size_limit=" << size_limit
+            << ", ttl=" << ttl
+            << ", expire_ms=" << FLAGS_graph_sample_cache_expire_ms;
+  }
+  use_cache = true;
+  return 0;
+}
+
+SampleCacheStat GraphTable::get_neighbor_sample_cache_stat() const {
+  if (sample_cache == nullptr) {
+    return SampleCacheStat();
+  }
+  auto stat = sample_cache->stat();
+  VLOG(1) << "neighbor sample cache hit=" << stat.hit << " miss=" << stat.miss
+          << " hit_rate=" << stat.hit_rate() << " insert=" << stat.insert
+          << " evict=" << stat.evict << " expire=" << stat.expire
+          << " lookup_ns=" << stat.lookup_ns;
+  return stat;
+}
+
 int32_t GraphTable::get_nodes_ids_by_ranges(
     GraphTableType table_type,
     int idx,
@@ -3467,8 +3840,8 @@ int32_t GraphTable::Initialize(const GraphParameter &graph) {
     _shard_idx = 0;
     shard_num = graph.shard_num();
   }
-  use_cache = graph.use_cache();
-  if (use_cache) {
+  use_cache = false;
+  if (graph.use_cache()) {
     cache_size_limit = graph.cache_size_limit();
     cache_ttl = graph.cache_ttl();
     make_neighbor_sample_cache(cache_size_limit, cache_ttl);
@@ -0,0 +1,205 @@
+// Copyright (c) 2025 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/fluid/distributed/ps/table/graph/graph_csr.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "paddle/fluid/distributed/ps/table/graph/graph_weighted_sampler.h"
+namespace paddle::distributed {
+
+namespace {
+
+inline void put_varint(uint64_t v, std::vector<uint8_t> *out) {
+  while (v >= 0x80) {
+    out->push_back(static_cast<uint8_t>(v | 0x80));
+    v >>= 7;
+  }
+  out->push_back(static_cast<uint8_t>(v));
+}
+
+inline const uint8_t *get_varint(const uint8_t *p, uint64_t *v) {
+  uint64_t res = 0;
+  int shift = 0;
+  while (*p & 0x80) {
+    res |= static_cast<uint64_t>(*p++ & 0x7f) << shift;
+    shift += 7;
+  }
+  *v = res | (static_cast<uint64_t>(*p++) << shift);
+  return p;
+}
+
+}  // namespace
+
+void GraphCSR::build(const std::vector<Node *> &bucket,
+                     bool is_weighted,
+                     bool delta_encode) {
+  clear();
+  size_t node_num = bucket.size();
+  offsets.resize(node_num + 1);
+  offsets[0] = 0;
+  for (size_t i = 0; i < node_num; i++) {
+    offsets[i + 1] = offsets[i] + bucket[i]->get_neighbor_size();
+  }
+  size_t edge_num = offsets[node_num];
+  if (is_weighted) {
+    weights.resize(edge_num);
+  }
+  if (delta_encode) {
+    delta_offsets.resize(node_num + 1);
+    delta_offsets[0] = 0;
+    // most deltas of a sorted row fit in two bytes
+    delta_bytes.reserve(edge_num * 2);
+  } else {
+    neighbors.resize(edge_num);
+  }
+  std::vector<std::pair<uint64_t, float>> row;
+  for (size_t i = 0; i < node_num; i++) {
+    Node *node = bucket[i];
+    uint64_t start = offsets[i];
+    int degree = static_cast<int>(offsets[i + 1] - start);
+    if (!delta_encode) {
+      for (int j = 0; j < degree; j++) {
+        neighbors[start + j] = node->get_neighbor_id(j);
+        if (is_weighted) {
+          weights[start + j] =
+              static_cast<float>(node->get_neighbor_weight(j));
+        }
+      }
+      continue;
+    }
+    row.resize(degree);
+    for (int j = 0; j < degree; j++) {
+      row[j].first = node->get_neighbor_id(j);
+      row[j].second =
+          is_weighted ? static_cast<float>(node->get_neighbor_weight(j)) : 1.0;
+    }
+    std::sort(row.begin(), row.end());
+    uint64_t last = 0;
+    for (int j = 0; j < degree; j++) {
+      put_varint(row[j].first - last, &delta_bytes);
+      last = row[j].first;
+      if (is_weighted) {
+        weights[start + j] = row[j].second;
+      }
+    }
+    delta_offsets[i + 1] = delta_bytes.size();
+  }
+  delta_bytes.shrink_to_fit();
+}
+
+void GraphCSR::build_alias() {
+  if (weights.empty()) return;
+  alias_prob.resize(weights.size());
+  alias_idx.resize(weights.size());
+  for (size_t i = 0; i + 1 < offsets.size(); i++) {
+    uint64_t start = offsets[i];
+    int degree = static_cast<int>(offsets[i + 1] - start);
+    if (degree == 0) continue;
+    AliasSampler::build_table(
+        &weights[start], degree, &alias_prob[start], &alias_idx[start]);
+  }
+}
+
+void GraphCSR::clear() {
+  offsets.clear();
+  offsets.shrink_to_fit();
+  neighbors.clear();
+  neighbors.shrink_to_fit();
+  delta_offsets.clear();
+  delta_offsets.shrink_to_fit();
+  delta_bytes.clear();
+  delta_bytes.shrink_to_fit();
+  weights.clear();
+  weights.shrink_to_fit();
+  alias_prob.clear();
+  alias_prob.shrink_to_fit();
+  alias_idx.clear();
+  alias_idx.shrink_to_fit();
+}
+
+uint64_t GraphCSR::neighbor_id(int pos, int idx) const {
+  if (delta_offsets.empty()) {
+    return neighbors[offsets[pos] + idx];
+  }
+  const uint8_t *p = delta_bytes.data() + delta_offsets[pos];
+  uint64_t id = 0, delta = 0;
+  for (int j = 0; j <= idx; j++) {
+    p = get_varint(p, &delta);
+    id += delta;
+  }
+  return id;
+}
+
+void GraphCSR::get_neighbors(int pos, std::vector<uint64_t> *res) const {
+  int n = degree(pos);
+  res->resize(n);
+  if (delta_offsets.empty()) {
+    std::copy(neighbors.begin() + offsets[pos],
+              neighbors.begin() + offsets[pos] + n,
+              res->begin());
+    return;
+  }
+  const uint8_t *p = delta_bytes.data() + delta_offsets[pos];
+  uint64_t id = 0, delta = 0;
+  for (int j = 0; j < n; j++) {
+    p = get_varint(p, &delta);
+    id += delta;
+    (*res)[j] = id;
+  }
+}
+
+void GraphCSR::neighbor_ids(int pos,
+                            const std::vector<int> &idx,
+                            std::vector<uint64_t> *res) const {
+  res->resize(idx.size());
+  if (delta_offsets.empty()) {
+    const uint64_t *row = neighbors.data() + offsets[pos];
+    for (size_t j = 0; j < idx.size(); j++) {
+      (*res)[j] = row[idx[j]];
+    }
+    return;
+  }
+  thread_local std::vector<uint64_t> row;
+  get_neighbors(pos, &row);
+  for (size_t j = 0; j < idx.size(); j++) {
+    (*res)[j] = row[idx[j]];
+  }
+}
+
+std::vector<int> GraphCSR::sample_k(
+    int pos, int k, const std::shared_ptr<std::mt19937_64> rng) const {
+  int n = degree(pos);
+  if (n == 0) {
+    return std::vector<int>();
+  }
+  if (alias_prob.empty()) {
+    return RandomSampler::sample_from_range(n, k, rng);
+  }
+  uint64_t start = offsets[pos];
+  return AliasSampler::sample_from_table(
+      &weights[start], &alias_prob[start], &alias_idx[start], n, k, rng);
+}
+
+size_t GraphCSR::memory_size() const {
+  return offsets.capacity() * sizeof(uint64_t) +
+         neighbors.capacity() * sizeof(uint64_t) +
+         delta_offsets.capacity() * sizeof(uint64_t) +
+         delta_bytes.capacity() * sizeof(uint8_t) +
+         weights.capacity() * sizeof(float) +
+         alias_prob.capacity() * sizeof(float) +
+         alias_idx.capacity() * sizeof(int);
+}
+}  // namespace paddle::distributed
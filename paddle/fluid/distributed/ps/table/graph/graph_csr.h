@@ -0,0 +1,83 @@
+// Copyright (c) 2025 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "paddle/fluid/distributed/ps/table/graph/graph_node.h"
+namespace paddle {
+namespace distributed {
+
+// Compact adjacency of one GraphShard. Row i holds the neighbors of
+// shard->bucket[i], so rows are addressed through GraphShard::node_location.
+// Weighted rows can also carry a Vose alias table (see AliasSampler) stored in
+// the same CSR layout, so sampling touches a few contiguous cache lines
+// instead of chasing Node/GraphEdgeBlob/WeightedSampler pointers.
+//
+// With delta_encode, each row is sorted by neighbor id and stored as varint
+// deltas; random access to a neighbor then decodes its row.
+class GraphCSR {
+ public:
+  GraphCSR() {}
+  ~GraphCSR() {}
+
+  void build(const std::vector<Node *> &bucket,
+             bool is_weighted,
+             bool delta_encode = false);
+  // Builds alias tables from the stored weights; no-op for unweighted rows.
+  void build_alias();
+  void clear();
+  bool empty() const { return offsets.empty(); }
+  bool is_weighted() const { return !weights.empty(); }
+  bool has_alias() const { return !alias_prob.empty(); }
+  bool is_delta_encoded() const { return !delta_offsets.empty(); }
+  size_t node_num() const { return offsets.empty() ? 0 : offsets.size() - 1; }
+  size_t edge_num() const { return offsets.empty() ? 0 : offsets.back(); }
+  int degree(int pos) const {
+    return static_cast<int>(offsets[pos + 1] - offsets[pos]);
+  }
+  uint64_t neighbor_id(int pos, int idx) const;
+  float neighbor_weight(int pos, int idx) const {
+    return weights.empty() ? 1.0 : weights[offsets[pos] + idx];
+  }
+  // Gathers the ids of the given row-local neighbor indices, decoding the
+  // row at most once.
+  void neighbor_ids(int pos,
+                    const std::vector<int> &idx,
+                    std::vector<uint64_t> *res) const;
+  void get_neighbors(int pos, std::vector<uint64_t> *res) const;
+  // Weighted rows with alias tables are sampled by weight, the rest
+  // uniformly, matching the per-node "alias" and "random" samplers.
+  std::vector<int> sample_k(int pos,
+                            int k,
+                            const std::shared_ptr<std::mt19937_64> rng) const;
+  size_t memory_size() const;
+
+ private:
+  std::vector<uint64_t> offsets;
+  // plain layout: neighbors[offsets[i]...offsets[i + 1])
+  std::vector<uint64_t> neighbors;
+  // delta layout: varint bytes of row i start at delta_offsets[i]
+  std::vector<uint64_t> delta_offsets;
+  std::vector<uint8_t> delta_bytes;
+  // the following are empty for unweighted graphs
+  std::vector<float> weights;
+  std::vector<float> alias_prob;
+  std::vector<int> alias_idx;
+};
+}  // namespace distributed
+}  // namespace paddle
@@ -0,0 +1,155 @@
+// Copyright (c) 2025 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "paddle/common/enforce.h"
+namespace paddle {
+namespace distributed {
+
+// Read-only mapping of a local edge file.
+class MmapEdgeFile {
+ public:
+  explicit MmapEdgeFile(const std::string &path) {
+    fd_ = open(path.c_str(), O_RDONLY);
+    PADDLE_ENFORCE_NE(
+        fd_,
+        -1,
+        common::errors::Unavailable("Fail to open edge file: %s, error: %s.",
+                                    path.c_str(),
+                                    strerror(errno)));
+    struct stat sb = {};
+    fstat(fd_, &sb);
+    size_ = static_cast<size_t>(sb.st_size);
+    if (size_ == 0) return;
+    void *addr = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd_, 0);
+    PADDLE_ENFORCE_NE(addr,
+                      MAP_FAILED,
+                      common::errors::Unavailable(
+                          "Fail to mmap edge file: %s, error: %s.",
+                          path.c_str(),
+                          strerror(errno)));
+    madvise(addr, size_, MADV_SEQUENTIAL);
+    data_ = reinterpret_cast<const char *>(addr);
+  }
+  ~MmapEdgeFile() {
+    if (data_ != nullptr) {
+      munmap(const_cast<char *>(data_), size_);
+    }
+    if (fd_ != -1) {
+      close(fd_);
+    }
+  }
+  MmapEdgeFile(const MmapEdgeFile &) = delete;
+  MmapEdgeFile &operator=(const MmapEdgeFile &) = delete;
+
+  const char *data() const { return data_; }
+  size_t size() const { return size_; }
+
+  // Splits the file into byte ranges of about chunk_size bytes. Every range
+  // starts at a line start and ends right after a '\n' (or at EOF).
+  std::vector<std::pair<size_t, size_t>> split(size_t chunk_size) const {
+    std::vector<std::pair<size_t, size_t>> ranges;
+    size_t begin = 0;
+    while (begin < size_) {
+      size_t end = begin + chunk_size;
+      if (end >= size_) {
+        end = size_;
+      } else {
+        const void *nl = memchr(data_ + end, '\n', size_ - end);
+        end = nl == nullptr
+                  ? size_
+                  : static_cast<const char *>(nl) - data_ + 1;
+      }
+      ranges.emplace_back(begin, end);
+      begin = end;
+    }
+    return ranges;
+  }
+
+ private:
+  int fd_ = -1;
+  const char *data_ = nullptr;
+  size_t size_ = 0;
+};
+
+// Scanners for "src\tdst[\tweight]" lines that never read past end and
+// need no terminating '\0'. They return the position after the parsed
+// token, or nullptr if no digit was found.
+inline const char *scan_uint64(const char *p, const char *end, uint64_t *v) {
+  uint64_t res = 0;
+  const char *start = p;
+  while (p < end && static_cast<unsigned>(*p - '0') < 10) {
+    res = res * 10 + (*p - '0');
+    ++p;
+  }
+  if (p == start) return nullptr;
+  *v = res;
+  return p;
+}
+
+inline const char *scan_float(const char *p, const char *end, float *v) {
+  const char *token = p;
+  bool neg = false;
+  if (p < end && (*p == '-' || *p == '+')) {
+    neg = *p == '-';
+    ++p;
+  }
+  const char *start = p;
+  double res = 0;
+  while (p < end && static_cast<unsigned>(*p - '0') < 10) {
+    res = res * 10 + (*p - '0');
+    ++p;
+  }
+  if (p < end && *p == '.') {
+    ++p;
+    double scale = 0.1;
+    while (p < end && static_cast<unsigned>(*p - '0') < 10) {
+      res += (*p - '0') * scale;
+      scale *= 0.1;
+      ++p;
+    }
+  }
+  if (p == start) return nullptr;
+  if (p < end && (*p == 'e' || *p == 'E')) {
+    // rare in edge files, let strtod handle the exponent
+    char buf[64];
+    size_t len = 0;
+    const char *q = token;
+    while (q < end && len + 1 < sizeof(buf) && *q != '\t' && *q != '\n' &&
+           *q != '\r' && *q != ' ') {
+      buf[len++] = *q++;
+    }
+    buf[len] = '\0';
+    *v = static_cast<float>(std::strtod(buf, nullptr));
+    return q;
+  }
+  *v = static_cast<float>(neg ? -res : res);
+  return p;
+}
+
+}  // namespace distributed
+}  // namespace paddle
@@ -64,6 +64,16 @@ void GraphNode::build_edges(bool is_weighted) {
     }
   }
 }
+void GraphNode::release_edges() {
+  if (sampler != nullptr) {
+    delete sampler;
+    sampler = nullptr;
+  }
+  if (edges != nullptr) {
+    delete edges;
+    edges = nullptr;
+  }
+}
 void GraphNode::build_sampler(std::string sample_type) {
   if (sampler != nullptr) {
     return;
@@ -72,6 +82,8 @@ void GraphNode::build_sampler(std::string sample_type) {
     sampler = new RandomSampler();
   } else if (sample_type == "weighted") {
     sampler = new WeightedSampler();
+  } else if (sample_type == "alias") {
+    sampler = new AliasSampler();
   }
   if (sampler != nullptr) {
     sampler->build(edges);
@@ -43,6 +43,7 @@ class Node {
 
   virtual void build_edges(bool is_weighted UNUSED) {}
   virtual void build_sampler(std::string sample_type UNUSED) {}
+  virtual void release_edges() {}
   virtual void add_edge(uint64_t id UNUSED, float weight UNUSED) {}
   virtual std::vector<int> sample_k(
       int k UNUSED, const std::shared_ptr<std::mt19937_64> rng UNUSED) {
@@ -97,6 +98,8 @@ class GraphNode : public Node {
   virtual ~GraphNode();
   virtual void build_edges(bool is_weighted);
   virtual void build_sampler(std::string sample_type);
+  // Frees edges and sampler once the shard keeps them in a GraphCSR.
+  virtual void release_edges();
   virtual void add_edge(uint64_t id, float weight) {
     edges->add_edge(id, weight);
   }
@@ -110,7 +113,9 @@ class GraphNode : public Node {
 #else
   virtual float get_neighbor_weight(int idx) { return edges->get_weight(idx); }
 #endif
-  virtual size_t get_neighbor_size() { return edges->size(); }
+  virtual size_t get_neighbor_size() {
+    return edges == nullptr ? 0 : edges->size();
+  }
 
  protected:
   Sampler *sampler;
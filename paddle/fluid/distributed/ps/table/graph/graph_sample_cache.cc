@@ -0,0 +1,237 @@
+// Copyright (c) 2025 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/fluid/distributed/ps/table/graph/graph_sample_cache.h"
+
+#include <algorithm>
+#include <chrono>
+#include <utility>
+
+#include "paddle/phi/core/platform/monitor.h"
+
+DEFINE_INT_STATUS(STAT_graph_sample_cache_hit)
+DEFINE_INT_STATUS(STAT_graph_sample_cache_miss)
+DEFINE_INT_STATUS(STAT_graph_sample_cache_evict)
+DEFINE_INT_STATUS(STAT_graph_sample_cache_lookup_ns)
+
+namespace paddle::distributed {
+
+namespace {
+
+inline int64_t now_ms() {
+  return std::chrono::duration_cast<std::chrono::milliseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+}  // namespace
+
+NeighborSampleCache::NeighborSampleCache(size_t shard_num,
+                                         size_t size_limit,
+                                         size_t ttl,
+                                         int64_t expire_ms)
+    : ttl_(ttl), expire_ms_(expire_ms) {
+  shard_num = std::max<size_t>(shard_num, 1);
+  size_t capacity = std::max<size_t>(size_limit / shard_num, 1);
+  // keep the load factor under 0.5 so probe chains stay short
+  size_t slots = 2;
+  while (slots < capacity * 2) slots <<= 1;
+  for (size_t i = 0; i < shard_num; i++) {
+    shards_.emplace_back(new Shard());
+    shards_[i]->entries.resize(slots);
+    shards_[i]->mask = slots - 1;
+    shards_[i]->capacity = capacity;
+  }
+}
+
+uint64_t NeighborSampleCache::hash(const SampleKey &key) {
+  // splitmix64 finalizer over all key fields
+  uint64_t h = key.node_key ^ (static_cast<uint64_t>(key.idx) << 48) ^
+               (static_cast<uint64_t>(key.sample_size) << 16) ^
+               static_cast<uint64_t>(key.is_weighted);
+  h += 0x9e3779b97f4a7c15ULL;
+  h = (h ^ (h >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  h = (h ^ (h >> 27)) * 0x94d049bb133111ebULL;
+  return h ^ (h >> 31);
+}
+
+int64_t NeighborSampleCache::find(const Shard &shard,
+                                  const SampleKey &key) const {
+  size_t pos = hash(key) & shard.mask;
+  while (shard.entries[pos].used) {
+    if (shard.entries[pos].match(key)) {
+      return static_cast<int64_t>(pos);
+    }
+    pos = (pos + 1) & shard.mask;
+  }
+  return -1;
+}
+
+void NeighborSampleCache::erase(Shard *shard, size_t pos) {
+  auto &entries = shard->entries;
+  entries[pos].used = false;
+  entries[pos].result = SampleResult();
+  shard->count--;
+  // backward-shift the rest of the probe chain into the hole
+  size_t hole = pos;
+  size_t next = (pos + 1) & shard->mask;
+  while (entries[next].used) {
+    size_t home = hash(SampleKey(entries[next].idx,
+                                 entries[next].node_key,
+                                 entries[next].sample_size,
+                                 entries[next].is_weighted)) &
+                  shard->mask;
+    // move next into hole unless its home lies cyclically in (hole, next]
+    bool in_range = hole <= next ? (hole < home && home <= next)
+                                 : (hole < home || home <= next);
+    if (!in_range) {
+      entries[hole] = std::move(entries[next]);
+      entries[next].used = false;
+      entries[next].result = SampleResult();
+      hole = next;
+    }
+    next = (next + 1) & shard->mask;
+  }
+}
+
+void NeighborSampleCache::evict_one(Shard *shard) {
+  auto &entries = shard->entries;
+  while (true) {
+    Entry &entry = entries[shard->hand];
+    if (entry.used) {
+      if (!entry.ref) {
+        erase(shard, shard->hand);
+        return;
+      }
+      entry.ref = false;
+    }
+    shard->hand = (shard->hand + 1) & shard->mask;
+  }
+}
+
+size_t NeighborSampleCache::query(size_t index,
+                                  const SampleKey *keys,
+                                  size_t length,
+                                  std::vector<SampleResult> *res,
+                                  std::vector<uint8_t> *hit) {
+  auto start = std::chrono::steady_clock::now();
+  Shard *shard = shards_[index].get();
+  res->resize(length);
+  hit->assign(length, 0);
+  int64_t now = expire_ms_ > 0 ? now_ms() : 0;
+  size_t hit_num = 0, expire_num = 0;
+  for (size_t i = 0; i < length; i++) {
+    int64_t pos = find(*shard, keys[i]);
+    if (pos < 0) continue;
+    Entry &entry = shard->entries[pos];
+    if (expire_ms_ > 0 && entry.expire_at <= now) {
+      erase(shard, pos);
+      expire_num++;
+      continue;
+    }
+    (*res)[i] = entry.result;
+    (*hit)[i] = 1;
+    hit_num++;
+    if (--entry.ttl == 0) {
+      erase(shard, pos);
+      expire_num++;
+    } else {
+      entry.ref = true;
+    }
+  }
+  uint64_t cost = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                      std::chrono::steady_clock::now() - start)
+                      .count();
+  shard->hit.fetch_add(hit_num, std::memory_order_relaxed);
+  shard->miss.fetch_add(length - hit_num, std::memory_order_relaxed);
+  shard->expire.fetch_add(expire_num, std::memory_order_relaxed);
+  shard->lookup_ns.fetch_add(cost, std::memory_order_relaxed);
+  STAT_ADD(STAT_graph_sample_cache_hit, hit_num);
+  STAT_ADD(STAT_graph_sample_cache_miss, length - hit_num);
+  STAT_ADD(STAT_graph_sample_cache_lookup_ns, cost);
+  return hit_num;
+}
+
+void NeighborSampleCache::insert(size_t index,
+                                 const SampleKey *keys,
+                                 const SampleResult *data,
+                                 size_t length) {
+  if (ttl_ == 0) return;
+  Shard *shard = shards_[index].get();
+  int64_t expire_at = expire_ms_ > 0 ? now_ms() + expire_ms_ : 0;
+  size_t evict_num = 0;
+  for (size_t i = 0; i < length; i++) {
+    int64_t pos = find(*shard, keys[i]);
+    if (pos < 0) {
+      if (shard->count >= shard->capacity) {
+        evict_one(shard);
+        evict_num++;
+      }
+      pos = hash(keys[i]) & shard->mask;
+      while (shard->entries[pos].used) {
+        pos = (pos + 1) & shard->mask;
+      }
+      shard->count++;
+    }
+    Entry &entry = shard->entries[pos];
+    entry.node_key = keys[i].node_key;
+    entry.sample_size = keys[i].sample_size;
+    entry.idx = keys[i].idx;
+    entry.is_weighted = keys[i].is_weighted;
+    entry.used = true;
+    entry.ref = false;
+    entry.ttl = static_cast<uint32_t>(ttl_);
+    entry.expire_at = expire_at;
+    entry.result = data[i];
+  }
+  shard->insert.fetch_add(length, std::memory_order_relaxed);
+  if (evict_num > 0) {
+    shard->evict.fetch_add(evict_num, std::memory_order_relaxed);
+    STAT_ADD(STAT_graph_sample_cache_evict, evict_num);
+  }
+}
+
+void NeighborSampleCache::clear() {
+  for (auto &shard : shards_) {
+    for (auto &entry : shard->entries) {
+      entry.used = false;
+      entry.result = SampleResult();
+    }
+    shard->count = 0;
+    shard->hand = 0;
+  }
+}
+
+size_t NeighborSampleCache::size() const {
+  size_t res = 0;
+  for (auto &shard : shards_) {
+    res += shard->count;
+  }
+  return res;
+}
+
+SampleCacheStat NeighborSampleCache::stat() const {
+  SampleCacheStat res;
+  for (auto &shard : shards_) {
+    res.hit += shard->hit.load(std::memory_order_relaxed);
+    res.miss += shard->miss.load(std::memory_order_relaxed);
+    res.insert += shard->insert.load(std::memory_order_relaxed);
+    res.evict += shard->evict.load(std::memory_order_relaxed);
+    res.expire += shard->expire.load(std::memory_order_relaxed);
+    res.lookup_ns += shard->lookup_ns.load(std::memory_order_relaxed);
+  }
+  return res;
+}
+
+}  // namespace paddle::distributed
@@ -0,0 +1,147 @@
+// Copyright (c) 2025 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace paddle {
+namespace distributed {
+
+struct SampleKey {
+  int idx;
+  uint64_t node_key;
+  size_t sample_size;
+  bool is_weighted;
+  SampleKey(int _idx,
+            uint64_t _node_key,
+            size_t _sample_size,
+            bool _is_weighted) {
+    idx = _idx;
+    node_key = _node_key;
+    sample_size = _sample_size;
+    is_weighted = _is_weighted;
+  }
+  bool operator==(const SampleKey &s) const {
+    return idx == s.idx && node_key == s.node_key &&
+           sample_size == s.sample_size && is_weighted == s.is_weighted;
+  }
+};
+
+class SampleResult {
+ public:
+  size_t actual_size;
+  std::shared_ptr<char> buffer;
+  SampleResult() : actual_size(0) {}
+  SampleResult(size_t _actual_size, std::shared_ptr<char> &_buffer)  // NOLINT
+      : actual_size(_actual_size), buffer(_buffer) {}
+  SampleResult(size_t _actual_size, char *_buffer)
+      : actual_size(_actual_size),
+        buffer(_buffer, [](char *p) { delete[] p; }) {}
+  ~SampleResult() {}
+};
+
+struct SampleCacheStat {
+  uint64_t hit = 0;
+  uint64_t miss = 0;
+  uint64_t insert = 0;
+  uint64_t evict = 0;
+  uint64_t expire = 0;
+  uint64_t lookup_ns = 0;
+  double hit_rate() const {
+    return hit + miss == 0 ? 0 : 1.0 * hit / (hit + miss);
+  }
+};
+
+// Neighbor sample cache of GraphTable. Each shard is an open-addressing
+// table (linear probing, backward-shift deletion) whose entries sit in one
+// contiguous array and are evicted by the CLOCK algorithm, so lookups and
+// inserts allocate nothing per entry. Sample buffers are shared with the
+// callers through SampleResult::buffer. GraphTable writes the samples of the
+// misses of a batch into one block, the buffer of an entry aliases it, so a
+// block is freed once no entry or caller of its batch holds it.
+//
+// An entry expires after `ttl` hits and, when expire_ms > 0, expire_ms
+// milliseconds after it was inserted.
+//
+// A shard is not locked: shard `index` must only be used by one thread at a
+// time. GraphTable guarantees this by routing each shard to its own
+// single-threaded task pool.
+class NeighborSampleCache {
+ public:
+  NeighborSampleCache(size_t shard_num,
+                      size_t size_limit,
+                      size_t ttl,
+                      int64_t expire_ms = 0);
+  ~NeighborSampleCache() {}
+
+  // Looks up a whole request batch. For k in [0, length), hit[k] tells
+  // whether keys[k] was cached and res[k] then holds the cached sample.
+  // Returns the number of hits.
+  size_t query(size_t index,
+               const SampleKey *keys,
+               size_t length,
+               std::vector<SampleResult> *res,
+               std::vector<uint8_t> *hit);
+  void insert(size_t index,
+              const SampleKey *keys,
+              const SampleResult *data,
+              size_t length);
+  void clear();
+  size_t size() const;
+  size_t get_ttl() const { return ttl_; }
+  SampleCacheStat stat() const;
+
+ private:
+  struct Entry {
+    uint64_t node_key = 0;
+    uint64_t sample_size = 0;
+    int64_t expire_at = 0;
+    int32_t idx = 0;
+    uint32_t ttl = 0;
+    bool used = false;
+    bool is_weighted = false;
+    bool ref = false;
+    SampleResult result;
+    bool match(const SampleKey &key) const {
+      return node_key == key.node_key && idx == key.idx &&
+             sample_size == key.sample_size && is_weighted == key.is_weighted;
+    }
+  };
+  struct Shard {
+    std::vector<Entry> entries;
+    size_t mask = 0;
+    size_t capacity = 0;
+    size_t count = 0;
+    size_t hand = 0;
+    std::atomic<uint64_t> hit{0}, miss{0}, insert{0}, evict{0}, expire{0},
+        lookup_ns{0};
+  };
+
+  static uint64_t hash(const SampleKey &key);
+  // Returns the slot holding key, or -1.
+  int64_t find(const Shard &shard, const SampleKey &key) const;
+  void erase(Shard *shard, size_t pos);
+  void evict_one(Shard *shard);
+
+  std::vector<std::unique_ptr<Shard>> shards_;
+  size_t ttl_;
+  int64_t expire_ms_;
+};
+
+}  // namespace distributed
+}  // namespace paddle
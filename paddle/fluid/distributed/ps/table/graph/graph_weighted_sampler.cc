@@ -14,9 +14,13 @@
 
 #include "paddle/fluid/distributed/ps/table/graph/graph_weighted_sampler.h"
 
+#include <algorithm>
+#include <cmath>
 #include <iostream>
+#include <limits>
 #include <memory>
 #include <unordered_map>
+#include <unordered_set>
 
 #include "paddle/phi/core/generator.h"
 namespace paddle::distributed {
@@ -25,7 +29,11 @@ void RandomSampler::build(GraphEdgeBlob *edges) { this->edges = edges; }
 
 std::vector<int> RandomSampler::sample_k(
     int k, const std::shared_ptr<std::mt19937_64> rng) {
-  int n = edges->size();
+  return sample_from_range(edges->size(), k, rng);
+}
+
+std::vector<int> RandomSampler::sample_from_range(
+    int n, int k, const std::shared_ptr<std::mt19937_64> rng) {
   if (k >= n) {
     k = n;
     std::vector<int> sample_result;
@@ -165,4 +173,146 @@ int WeightedSampler::sample(
   subtract_count_map[this]++;
   return return_idx;
 }
+
+void AliasSampler::build(GraphEdgeBlob *edges) {
+  int n = edges->size();
+  weights.resize(n);
+  for (int i = 0; i < n; i++) {
+    weights[i] = static_cast<float>(edges->get_weight(i));
+  }
+  prob.resize(n);
+  alias.resize(n);
+  build_table(weights.data(), n, prob.data(), alias.data());
+}
+
+std::vector<int> AliasSampler::sample_k(
+    int k, const std::shared_ptr<std::mt19937_64> rng) {
+  return sample_from_table(weights.data(),
+                           prob.data(),
+                           alias.data(),
+                           static_cast<int>(prob.size()),
+                           k,
+                           rng);
+}
+
+void AliasSampler::build_table(const float *weights,
+                               int n,
+                               float *prob,
+                               int *alias) {
+  if (n <= 0) return;
+  double sum = 0;
+  for (int i = 0; i < n; i++) {
+    sum += weights[i] > 0 ? weights[i] : 0;
+  }
+  if (sum <= 0) {
+    for (int i = 0; i < n; i++) {
+      prob[i] = 1.0;
+      alias[i] = i;
+    }
+    return;
+  }
+  // small indices grow from the front of the work list, large ones from the
+  // back, so both stacks share one allocation.
+  std::vector<double> scaled(n);
+  std::vector<int> work(n);
+  int small_end = 0, large_begin = n;
+  for (int i = 0; i < n; i++) {
+    scaled[i] = (weights[i] > 0 ? weights[i] : 0) * n / sum;
+    if (scaled[i] < 1.0) {
+      work[small_end++] = i;
+    } else {
+      work[--large_begin] = i;
+    }
+  }
+  while (small_end > 0 && large_begin < n) {
+    int s = work[--small_end];
+    int l = work[large_begin];
+    prob[s] = static_cast<float>(scaled[s]);
+    alias[s] = l;
+    scaled[l] = (scaled[l] + scaled[s]) - 1.0;
+    if (scaled[l] < 1.0) {
+      large_begin++;
+      work[small_end++] = l;
+    }
+  }
+  // leftovers are 1.0 up to rounding error
+  while (small_end > 0) {
+    int s = work[--small_end];
+    prob[s] = 1.0;
+    alias[s] = s;
+  }
+  while (large_begin < n) {
+    int l = work[large_begin++];
+    prob[l] = 1.0;
+    alias[l] = l;
+  }
+}
+
+std::vector<int> AliasSampler::sample_from_table(
+    const float *weights,
+    const float *prob,
+    const int *alias,
+    int n,
+    int k,
+    const std::shared_ptr<std::mt19937_64> rng) {
+  std::vector<int> sample_result;
+  if (k >= n) {
+    sample_result.reserve(n);
+    for (int i = 0; i < n; i++) {
+      sample_result.push_back(i);
+    }
+    return sample_result;
+  }
+  sample_result.reserve(k);
+  std::uniform_real_distribution<double> distrib(0, 1.0);
+  // Rejection is cheap while k is small compared with the degree; each draw
+  // is one slot lookup plus a duplicate check.
+  if (2 * k <= n) {
+    const int max_tries = 8 * k + 16;
+    std::unordered_set<int> picked;
+    bool use_set = k > 32;
+    if (use_set) picked.reserve(2 * k);
+    int tries = 0;
+    while (static_cast<int>(sample_result.size()) < k && tries < max_tries) {
+      ++tries;
+      double u = distrib(*rng) * n;
+      int slot = std::min(static_cast<int>(u), n - 1);
+      int idx = (u - slot) < prob[slot] ? slot : alias[slot];
+      bool duplicate =
+          use_set ? !picked.insert(idx).second
+                  : std::find(sample_result.begin(),
+                              sample_result.end(),
+                              idx) != sample_result.end();
+      if (!duplicate) {
+        sample_result.push_back(idx);
+      }
+    }
+    if (static_cast<int>(sample_result.size()) == k) {
+      return sample_result;
+    }
+    // heavily skewed weights keep hitting the same few edges
+    sample_result.clear();
+  }
+  // Efraimidis-Spirakis: keep the k largest log(u) / w keys.
+  std::vector<std::pair<double, int>> keys;
+  keys.reserve(n);
+  for (int i = 0; i < n; i++) {
+    double w = weights[i];
+    double u = std::max(distrib(*rng), std::numeric_limits<double>::min());
+    keys.emplace_back(w > 0 ? std::log(u) / w
+                            : -std::numeric_limits<double>::infinity(),
+                      i);
+  }
+  std::partial_sort(keys.begin(),
+                    keys.begin() + k,
+                    keys.end(),
+                    [](const std::pair<double, int> &a,
+                       const std::pair<double, int> &b) {
+                      return a.first > b.first;
+                    });
+  for (int i = 0; i < k; i++) {
+    sample_result.push_back(keys[i].second);
+  }
+  return sample_result;
+}
 }  // namespace paddle::distributed
@@ -37,6 +37,9 @@ class RandomSampler : public Sampler {
   virtual void build(GraphEdgeBlob *edges);
   virtual std::vector<int> sample_k(int k,
                                     const std::shared_ptr<std::mt19937_64> rng);
+  // Draws k distinct indices uniformly from [0, n).
+  static std::vector<int> sample_from_range(
+      int n, int k, const std::shared_ptr<std::mt19937_64> rng);
   GraphEdgeBlob *edges;
 };
 
@@ -62,5 +65,34 @@ class WeightedSampler : public Sampler {
       std::unordered_map<WeightedSampler *, int> &subtract_count_map,  // NOLINT
       float &subtract);                                                // NOLINT
 };
+
+// Vose alias table over the edge weights of one node. The table lives in two
+// contiguous arrays, so a weighted draw is O(1) instead of walking the
+// WeightedSampler tree. Sampling without replacement rejects duplicates and
+// falls back to exponential-key selection when k is close to the degree.
+class AliasSampler : public Sampler {
+ public:
+  AliasSampler() {}
+  virtual ~AliasSampler() {}
+  virtual void build(GraphEdgeBlob *edges);
+  virtual std::vector<int> sample_k(int k,
+                                    const std::shared_ptr<std::mt19937_64> rng);
+
+  // Fills prob/alias (both of length n) from n non-negative weights.
+  static void build_table(const float *weights, int n, float *prob, int *alias);
+  // Draws k distinct indices in [0, n) from a table built by build_table.
+  static std::vector<int> sample_from_table(
+      const float *weights,
+      const float *prob,
+      const int *alias,
+      int n,
+      int k,
+      const std::shared_ptr<std::mt19937_64> rng);
+
+ private:
+  std::vector<float> weights;
+  std::vector<float> prob;
+  std::vector<int> alias;
+};
 }  // namespace distributed
 }  // namespace paddle
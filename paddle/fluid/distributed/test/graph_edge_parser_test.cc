@@ -0,0 +1,145 @@
+// Copyright (c) 2025 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "paddle/fluid/distributed/ps/table/common_graph_table.h"
+#include "paddle/fluid/distributed/ps/table/graph/graph_edge_parser.h"
+#include "paddle/fluid/distributed/the_one_ps.pb.h"
+
+namespace distributed = paddle::distributed;
+
+TEST(GraphEdgeParser, Scan) {
+  std::string s = "12345\t678\t0.25\n";
+  const char *end = s.data() + s.size();
+  uint64_t v = 0;
+  const char *p = distributed::scan_uint64(s.data(), end, &v);
+  ASSERT_NE(p, nullptr);
+  EXPECT_EQ(v, 12345UL);
+  p = distributed::scan_uint64(p + 1, end, &v);
+  ASSERT_NE(p, nullptr);
+  EXPECT_EQ(v, 678UL);
+  float w = 0;
+  p = distributed::scan_float(p + 1, end, &w);
+  ASSERT_NE(p, nullptr);
+  EXPECT_FLOAT_EQ(w, 0.25);
+  EXPECT_EQ(*p, '\n');
+
+  std::string e = "-1.5e2\t";
+  p = distributed::scan_float(e.data(), e.data() + e.size(), &w);
+  EXPECT_FLOAT_EQ(w, -150);
+  EXPECT_EQ(*p, '\t');
+  EXPECT_EQ(distributed::scan_uint64(e.data(), e.data() + e.size(), &v),
+            nullptr);
+}
+
+TEST(GraphEdgeParser, SplitFile) {
+  const char *file_name = "graph_edge_parser_test.txt";
+  std::vector<std::string> lines;
+  {
+    std::ofstream ofile(file_name);
+    for (int i = 0; i < 1000; i++) {
+      lines.push_back(std::to_string(i) + "\t" + std::to_string(i * 31));
+      ofile << lines.back();
+      if (i != 999) ofile << "\n";
+    }
+  }
+  distributed::MmapEdgeFile file(file_name);
+  for (size_t chunk : {1UL, 7UL, 100UL, 1UL << 20}) {
+    std::vector<std::string> parsed;
+    size_t last_end = 0;
+    for (auto &r : file.split(chunk)) {
+      EXPECT_EQ(r.first, last_end);
+      last_end = r.second;
+      std::string text(file.data() + r.first, r.second - r.first);
+      size_t pos = 0;
+      while (pos < text.size()) {
+        size_t nl = text.find('\n', pos);
+        if (nl == std::string::npos) nl = text.size();
+        parsed.push_back(text.substr(pos, nl - pos));
+        pos = nl + 1;
+      }
+    }
+    EXPECT_EQ(last_end, file.size());
+    EXPECT_EQ(parsed, lines);
+  }
+  std::remove(file_name);
+}
+
+namespace {
+
+void init_edge_table(distributed::GraphTable *graph_table) {
+  ::paddle::distributed::GraphParameter table_proto;
+  table_proto.set_task_pool_size(4);
+  table_proto.set_shard_num(8);
+  table_proto.add_node_types("user");
+  table_proto.add_node_types("item");
+  table_proto.add_edge_types("user2item");
+  table_proto.add_graph_feature();
+  table_proto.add_graph_feature();
+  graph_table->Initialize(table_proto);
+}
+
+// The (neighbor, weight) pairs of every node of the edge shards, sorted.
+std::vector<std::pair<uint64_t, std::vector<std::pair<uint64_t, float>>>>
+loaded_edges(distributed::GraphTable *graph_table) {
+  std::vector<std::pair<uint64_t, std::vector<std::pair<uint64_t, float>>>>
+      res;
+  for (auto *shard : graph_table->edge_shards[0]) {
+    for (auto *node : shard->get_bucket()) {
+      std::vector<std::pair<uint64_t, float>> row;
+      for (size_t j = 0; j < node->get_neighbor_size(); j++) {
+        row.emplace_back(node->get_neighbor_id(j),
+                         static_cast<float>(node->get_neighbor_weight(j)));
+      }
+      std::sort(row.begin(), row.end());
+      res.emplace_back(node->get_id(), std::move(row));
+    }
+  }
+  std::sort(res.begin(), res.end());
+  return res;
+}
+
+}  // namespace
+
+TEST(GraphEdgeParser, LoadSameAsParseEdgeFile) {
+  const char *file_name = "graph_edge_parser_load_test.txt";
+  {
+    std::ofstream ofile(file_name);
+    for (int i = 0; i < 3000; i++) {
+      ofile << i % 97 << "\t" << 1000 + i * 13 % 1009;
+      // weighted and unweighted lines
+      if (i % 3 != 0) ofile << "\t" << 0.25 * (i % 11);
+      ofile << "\n";
+    }
+  }
+  distributed::GraphTable by_line, by_mmap;
+  init_edge_table(&by_line);
+  init_edge_table(&by_mmap);
+  auto line_res = by_line.parse_edge_file(file_name, 0, false, true);
+  auto mmap_res =
+      by_mmap.parse_edge_files_by_mmap({file_name}, 0, false, true);
+  EXPECT_EQ(line_res, mmap_res);
+  EXPECT_EQ(mmap_res.second, 3000UL);
+  auto expected = loaded_edges(&by_line);
+  ASSERT_EQ(expected.size(), 97UL);
+  EXPECT_EQ(loaded_edges(&by_mmap), expected);
+  std::remove(file_name);
+}
@@ -0,0 +1,154 @@
+// Copyright (c) 2025 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "paddle/fluid/distributed/ps/table/graph/graph_sample_cache.h"
+
+namespace distributed = paddle::distributed;
+
+namespace {
+
+distributed::SampleResult make_result(uint64_t v) {
+  char *buffer = new char[sizeof(uint64_t)];
+  memcpy(buffer, &v, sizeof(uint64_t));
+  return distributed::SampleResult(sizeof(uint64_t), buffer);
+}
+
+uint64_t read_result(const distributed::SampleResult &r) {
+  uint64_t v = 0;
+  memcpy(&v, r.buffer.get(), r.actual_size);
+  return v;
+}
+
+}  // namespace
+
+TEST(NeighborSampleCache, QueryInsertTtl) {
+  distributed::NeighborSampleCache cache(1, 16, 3);
+  std::vector<distributed::SampleKey> keys;
+  std::vector<distributed::SampleResult> data;
+  for (uint64_t i = 0; i < 4; i++) {
+    keys.emplace_back(0, i, 10, false);
+    data.push_back(make_result(i * 100));
+  }
+  std::vector<distributed::SampleResult> res;
+  std::vector<uint8_t> hit;
+  ASSERT_EQ(cache.query(0, keys.data(), keys.size(), &res, &hit), 0UL);
+  // only even keys are cached
+  for (size_t i = 0; i < keys.size(); i += 2) {
+    cache.insert(0, &keys[i], &data[i], 1);
+  }
+  ASSERT_EQ(cache.size(), 2UL);
+  for (size_t round = 0; round < cache.get_ttl(); round++) {
+    ASSERT_EQ(cache.query(0, keys.data(), keys.size(), &res, &hit), 2UL);
+    for (size_t i = 0; i < keys.size(); i++) {
+      ASSERT_EQ(hit[i], i % 2 == 0);
+      if (hit[i]) {
+        EXPECT_EQ(read_result(res[i]), i * 100);
+      }
+    }
+  }
+  // the ttl is used up
+  EXPECT_EQ(cache.query(0, keys.data(), keys.size(), &res, &hit), 0UL);
+  EXPECT_EQ(cache.size(), 0UL);
+  // keys differing in any field do not collide
+  distributed::SampleKey other(1, 0, 10, false), weighted(0, 0, 10, true);
+  cache.insert(0, keys.data(), data.data(), 1);
+  EXPECT_EQ(cache.query(0, &other, 1, &res, &hit), 0UL);
+  EXPECT_EQ(cache.query(0, &weighted, 1, &res, &hit), 0UL);
+
+  auto stat = cache.stat();
+  EXPECT_EQ(stat.hit, 2UL * cache.get_ttl());
+  EXPECT_EQ(stat.insert, 3UL);
+  EXPECT_EQ(stat.expire, 2UL);
+}
+
+TEST(NeighborSampleCache, ClockEviction) {
+  const size_t limit = 64;
+  distributed::NeighborSampleCache cache(1, limit, 1000);
+  std::vector<distributed::SampleResult> res;
+  std::vector<uint8_t> hit;
+  distributed::SampleKey hot(0, 7, 10, false);
+  auto hot_data = make_result(7);
+  cache.insert(0, &hot, &hot_data, 1);
+  for (uint64_t i = 100; i < 100 + 10 * limit; i++) {
+    // keep the hot key referenced so CLOCK gives it a second chance
+    ASSERT_EQ(cache.query(0, &hot, 1, &res, &hit), 1UL);
+    distributed::SampleKey key(0, i, 10, false);
+    auto data = make_result(i);
+    cache.insert(0, &key, &data, 1);
+    ASSERT_LE(cache.size(), limit);
+  }
+  EXPECT_EQ(cache.query(0, &hot, 1, &res, &hit), 1UL);
+  EXPECT_EQ(read_result(res[0]), 7UL);
+  // every cached key must still be reachable after backward-shift deletes
+  size_t found = 0;
+  for (uint64_t i = 100; i < 100 + 10 * limit; i++) {
+    distributed::SampleKey key(0, i, 10, false);
+    if (cache.query(0, &key, 1, &res, &hit) == 1) {
+      EXPECT_EQ(read_result(res[0]), i);
+      found++;
+    }
+  }
+  EXPECT_EQ(found + 1, cache.size());
+  EXPECT_GT(cache.stat().evict, 0UL);
+}
+
+TEST(NeighborSampleCache, Expire) {
+  distributed::NeighborSampleCache cache(2, 16, 100, 20);
+  distributed::SampleKey key(0, 1, 10, false);
+  auto data = make_result(1);
+  std::vector<distributed::SampleResult> res;
+  std::vector<uint8_t> hit;
+  cache.insert(1, &key, &data, 1);
+  EXPECT_EQ(cache.query(1, &key, 1, &res, &hit), 1UL);
+  std::this_thread::sleep_for(std::chrono::milliseconds(40));
+  EXPECT_EQ(cache.query(1, &key, 1, &res, &hit), 0UL);
+  EXPECT_EQ(cache.size(), 0UL);
+}
+
+TEST(NeighborSampleCache, SharedBlock) {
+  distributed::NeighborSampleCache cache(1, 2, 100);
+  // the samples of a batch alias one block, as GraphTable writes them
+  std::shared_ptr<char> block(new char[4 * sizeof(uint64_t)],
+                              [](char *p) { delete[] p; });
+  std::weak_ptr<char> weak_block = block;
+  std::vector<distributed::SampleKey> keys;
+  std::vector<distributed::SampleResult> data;
+  for (uint64_t i = 0; i < 4; i++) {
+    char *buffer = block.get() + i * sizeof(uint64_t);
+    uint64_t v = i * 100;
+    memcpy(buffer, &v, sizeof(uint64_t));
+    std::shared_ptr<char> alias(block, buffer);
+    keys.emplace_back(0, i, 10, false);
+    data.emplace_back(sizeof(uint64_t), alias);
+  }
+  cache.insert(0, keys.data(), data.data(), 2);
+  data.clear();
+  block.reset();
+  // the cached entries keep the block alive
+  std::vector<distributed::SampleResult> res;
+  std::vector<uint8_t> hit;
+  ASSERT_EQ(cache.query(0, keys.data(), 2, &res, &hit), 2UL);
+  EXPECT_EQ(read_result(res[0]), 0UL);
+  EXPECT_EQ(read_result(res[1]), 100UL);
+  res.clear();
+  cache.clear();
+  EXPECT_TRUE(weak_block.expired());
+}
@@ -0,0 +1,180 @@
+// Copyright (c) 2025 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <set>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "paddle/fluid/distributed/ps/table/graph/graph_csr.h"
+#include "paddle/fluid/distributed/ps/table/graph/graph_edge.h"
+#include "paddle/fluid/distributed/ps/table/graph/graph_node.h"
+#include "paddle/fluid/distributed/ps/table/graph/graph_weighted_sampler.h"
+
+namespace distributed = paddle::distributed;
+
+namespace {
+
+std::unique_ptr<distributed::WeightedGraphEdgeBlob> make_edges(int degree) {
+  std::unique_ptr<distributed::WeightedGraphEdgeBlob> edges(
+      new distributed::WeightedGraphEdgeBlob());
+  for (int i = 0; i < degree; i++) {
+    edges->add_edge(i, 1.0 + (i % 7));
+  }
+  return edges;
+}
+
+void check_distinct(const std::vector<int> &res, int k, int degree) {
+  ASSERT_EQ(static_cast<int>(res.size()), std::min(k, degree));
+  std::set<int> uniq(res.begin(), res.end());
+  ASSERT_EQ(uniq.size(), res.size());
+  for (int x : res) {
+    ASSERT_GE(x, 0);
+    ASSERT_LT(x, degree);
+  }
+}
+
+template <typename SamplerT>
+double sample_throughput(distributed::GraphEdgeBlob *edges,
+                         int k,
+                         int rounds,
+                         std::shared_ptr<std::mt19937_64> rng) {
+  SamplerT sampler;
+  sampler.build(edges);
+  size_t total = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < rounds; i++) {
+    total += sampler.sample_k(k, rng).size();
+  }
+  std::chrono::duration<double> cost = std::chrono::steady_clock::now() - start;
+  return total / cost.count();
+}
+
+}  // namespace
+
+TEST(AliasSampler, Distinct) {
+  auto rng = std::make_shared<std::mt19937_64>(2025);
+  for (int degree : {1, 5, 64, 1000}) {
+    auto edges = make_edges(degree);
+    distributed::AliasSampler sampler;
+    sampler.build(edges.get());
+    for (int k : {1, 3, 10, 40, 600, 2000}) {
+      check_distinct(sampler.sample_k(k, rng), k, degree);
+    }
+  }
+}
+
+TEST(AliasSampler, FollowsWeights) {
+  auto rng = std::make_shared<std::mt19937_64>(2025);
+  distributed::WeightedGraphEdgeBlob edges;
+  edges.add_edge(0, 1.0);
+  edges.add_edge(1, 3.0);
+  edges.add_edge(2, 0.0);
+  distributed::AliasSampler sampler;
+  sampler.build(&edges);
+  std::vector<int> hits(3, 0);
+  const int rounds = 40000;
+  for (int i = 0; i < rounds; i++) {
+    hits[sampler.sample_k(1, rng)[0]]++;
+  }
+  EXPECT_EQ(hits[2], 0);
+  EXPECT_NEAR(1.0 * hits[1] / rounds, 0.75, 0.02);
+}
+
+TEST(GraphCSR, SampleNeighbors) {
+  auto rng = std::make_shared<std::mt19937_64>(2025);
+  std::vector<distributed::Node *> bucket;
+  for (int i = 0; i < 4; i++) {
+    auto *node = new distributed::GraphNode(i);
+    node->build_edges(true);
+    for (int j = 0; j < i * 10; j++) {
+      node->add_edge(100 * i + j, 1.0 + j);
+    }
+    bucket.push_back(node);
+  }
+  distributed::GraphCSR csr;
+  csr.build(bucket, true);
+  csr.build_alias();
+  ASSERT_EQ(csr.node_num(), 4UL);
+  ASSERT_EQ(csr.edge_num(), 60UL);
+  EXPECT_TRUE(csr.sample_k(0, 5, rng).empty());
+  for (int i = 1; i < 4; i++) {
+    auto res = csr.sample_k(i, 5, rng);
+    check_distinct(res, 5, i * 10);
+    for (int x : res) {
+      EXPECT_EQ(csr.neighbor_id(i, x), 100UL * i + x);
+      EXPECT_FLOAT_EQ(csr.neighbor_weight(i, x), 1.0 + x);
+    }
+  }
+  for (auto *node : bucket) delete node;
+}
+
+TEST(GraphCSR, DeltaEncode) {
+  auto rng = std::make_shared<std::mt19937_64>(2025);
+  std::vector<distributed::Node *> bucket;
+  for (int i = 0; i < 3; i++) {
+    auto *node = new distributed::GraphNode(i);
+    node->build_edges(true);
+    // unsorted ids with large gaps
+    for (int j = 0; j < 50; j++) {
+      uint64_t id = (static_cast<uint64_t>(j * 7919 % 50) << (i * 20)) + i;
+      node->add_edge(id, 1.0 + id % 5);
+    }
+    bucket.push_back(node);
+  }
+  distributed::GraphCSR plain, delta;
+  plain.build(bucket, true);
+  delta.build(bucket, true, true);
+  ASSERT_TRUE(delta.is_delta_encoded());
+  EXPECT_LT(delta.memory_size(), plain.memory_size());
+  std::vector<uint64_t> row, ids;
+  for (int i = 0; i < 3; i++) {
+    delta.get_neighbors(i, &row);
+    ASSERT_EQ(row.size(), 50UL);
+    EXPECT_TRUE(std::is_sorted(row.begin(), row.end()));
+    std::vector<uint64_t> expect;
+    plain.get_neighbors(i, &expect);
+    std::sort(expect.begin(), expect.end());
+    EXPECT_EQ(row, expect);
+    auto res = delta.sample_k(i, 10, rng);
+    delta.neighbor_ids(i, res, &ids);
+    for (size_t j = 0; j < res.size(); j++) {
+      EXPECT_EQ(ids[j], delta.neighbor_id(i, res[j]));
+      EXPECT_FLOAT_EQ(delta.neighbor_weight(i, res[j]), 1.0 + ids[j] % 5);
+    }
+  }
+  for (auto *node : bucket) delete node;
+}
+
+TEST(AliasSampler, Throughput) {
+  auto rng = std::make_shared<std::mt19937_64>(2025);
+  for (int degree : {100, 10000, 200000}) {
+    auto edges = make_edges(degree);
+    for (int k : {10, 50}) {
+      int rounds = 2000;
+      double tree = sample_throughput<distributed::WeightedSampler>(
+          edges.get(), k, rounds, rng);
+      double alias = sample_throughput<distributed::AliasSampler>(
+          edges.get(), k, rounds, rng);
+      std::cout << "degree=" << degree << " k=" << k
+                << " tree sampler: " << tree
+                << " samples/s, alias sampler: " << alias
+                << " samples/s, speedup=" << alias / tree << std::endl;
+    }
+  }
+}
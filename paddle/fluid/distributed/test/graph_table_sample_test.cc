@@ -14,8 +14,10 @@
 
 #include <unistd.h>
 
+#include <algorithm>
 #include <chrono>
 #include <condition_variable>  // NOLINT
+#include <cstdio>
 #include <fstream>
 #include <iomanip>
 #include <string>
@@ -83,3 +85,62 @@ void testGraphSample() {
 }
 
 TEST(testGraphSample, Run) { testGraphSample(); }
+
+void init_edge_table(distributed::GraphTable *graph_table) {
+  ::paddle::distributed::GraphParameter table_proto;
+  table_proto.set_task_pool_size(4);
+  table_proto.set_shard_num(4);
+  table_proto.add_node_types("user");
+  table_proto.add_node_types("item");
+  table_proto.add_edge_types("user2item");
+  table_proto.add_graph_feature();
+  table_proto.add_graph_feature();
+  graph_table->Initialize(table_proto);
+}
+
+std::vector<uint64_t> all_neighbor_ids(distributed::GraphTable *graph_table) {
+  std::vector<std::vector<uint64_t>> res;
+  graph_table->get_all_neighbor_id(distributed::GraphTableType::EDGE_TABLE,
+                                   0,
+                                   1,
+                                   &res);
+  return res[0];
+}
+
+TEST(testGraphSample, LoadIntoFrozenShards) {
+  distributed::GraphTable graph_table;
+  init_edge_table(&graph_table);
+  prepare_file(edge_file_name, edges);
+  graph_table.load_edges(edge_file_name, false, "user2item", true);
+  graph_table.build_sampler(0, "weighted");
+  graph_table.freeze_edges(false);
+  for (auto *shard : graph_table.edge_shards[0]) {
+    ASSERT_TRUE(shard->is_frozen());
+  }
+  ASSERT_EQ(all_neighbor_ids(&graph_table).size(), 7UL);
+
+  // the new edges are seen, and the loaded shards are frozen again
+  char more_edge_file_name[] = "more_edges.txt";  // NOLINT
+  prepare_file(more_edge_file_name,
+               {std::string("37\t46\t0.5"), std::string("98\t49\t0.5")});
+  graph_table.load_edges(more_edge_file_name, false, "user2item", true);
+  for (auto *shard : graph_table.edge_shards[0]) {
+    ASSERT_TRUE(shard->is_frozen());
+  }
+  auto ids = all_neighbor_ids(&graph_table);
+  EXPECT_EQ(ids.size(), 9UL);
+  EXPECT_NE(std::find(ids.begin(), ids.end(), 46), ids.end());
+  EXPECT_NE(std::find(ids.begin(), ids.end(), 49), ids.end());
+
+  // add_graph_node thaws the shards, with the sampler type of the table
+  std::vector<uint64_t> id_list = {99};
+  std::vector<bool> is_weight_list = {true};
+  graph_table.add_graph_node(0, id_list, is_weight_list);
+  for (auto *shard : graph_table.edge_shards[0]) {
+    EXPECT_FALSE(shard->is_frozen());
+    EXPECT_EQ(shard->sample_type, "weighted");
+  }
+  EXPECT_EQ(all_neighbor_ids(&graph_table).size(), 9UL);
+  std::remove(edge_file_name);
+  std::remove(more_edge_file_name);
+}
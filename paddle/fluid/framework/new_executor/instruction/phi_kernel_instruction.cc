@@ -183,6 +183,17 @@ PhiKernelInstruction::PhiKernelInstruction(
 
 PhiKernelInstruction::~PhiKernelInstruction() { delete phi_kernel_; }
 
+bool PhiKernelInstruction::InferMetaReadsTensorData() const {
+  for (size_t i = 0; i < infer_meta_context_.AttrsSize(); ++i) {
+    const auto& attr = infer_meta_context_.AttrAt(i);
+    if (paddle::holds_alternative<phi::TensorRef>(attr) ||
+        paddle::holds_alternative<std::vector<phi::TensorRef>>(attr)) {
+      return true;
+    }
+  }
+  return false;
+}
+
 void PhiKernelInstruction::Run() {
   if (FLAGS_print_kernel_run_info) {
 #if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
@@ -211,7 +222,7 @@ void PhiKernelInstruction::Run() {
 #endif
   }
   VLOG(6) << "Begin run op " << phi_op_name_ << " infer meta.";
-  if (infer_meta_interface_) {
+  if (infer_meta_interface_ && !skip_infer_meta_) {
     phi::RecordEvent record_event("PhiKernelInstruction::infermeta",
                                   phi::TracerEventType::UserDefined,
                                   1);
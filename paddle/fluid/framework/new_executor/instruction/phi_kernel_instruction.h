@@ -50,6 +50,13 @@ class PhiKernelInstruction : public InstructionBase {
 
   void Run() override;
 
+  // The output metas were set by the caller, e.g. from a shape plan.
+  void SetSkipInferMeta(bool skip) { skip_infer_meta_ = skip; }
+
+  // Whether InferMeta reads tensor values through tensor attributes, so
+  // the output metas are not determined by the input metas alone.
+  bool InferMetaReadsTensorData() const;
+
   const std::string& Name() const override { return phi_op_name_; }
 
  private:
@@ -62,6 +69,8 @@ class PhiKernelInstruction : public InstructionBase {
 
   phi::Kernel* phi_kernel_{nullptr};  // not owned
 
+  bool skip_infer_meta_{false};
+
   std::string phi_op_name_;
 
   std::string kernel_name_;
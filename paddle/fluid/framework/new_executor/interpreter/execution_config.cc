@@ -142,7 +142,10 @@ void ExecutionConfig::Log(int log_level) {
           << "used_for_jit = " << used_for_jit << "\n"
           << "used_for_sot = " << used_for_sot << "\n"
           << "device_num_threads = " << device_num_threads << "\n"
-          << "host_num_threads = " << host_num_threads << "\n";
+          << "host_num_threads = " << host_num_threads << "\n"
+          << "shape_plan_cache_capacity = " << shape_plan_cache_capacity
+          << "\n"
+          << "schedule_fetch_first = " << schedule_fetch_first << "\n";
 
   log_str << "force_root_scope_vars = [";
   for (const std::string& var : force_root_scope_vars) {
@@ -35,6 +35,16 @@ struct ExecutionConfig {
   size_t device_num_threads{0};
   size_t host_num_threads{0};
 
+  // Number of input shapes whose output metas are cached so that a run with
+  // a cached shape skips InferMeta, 0 to disable. Only for trace run.
+  size_t shape_plan_cache_capacity{0};
+
+  // If true, fetch instructions and the producers of the inputs of
+  // shadow_output ops are scheduled as soon as their inputs are ready
+  // instead of in program order, so that the output hooks see the outputs
+  // before the rest of the program has run. Only for trace run.
+  bool schedule_fetch_first{false};
+
   std::set<std::pair<int, std::string>>
       force_sync_ops;  // set{pair<op_id, name>}, -1 matches any op_id, ""
                        // matches any name
@@ -0,0 +1,125 @@
+// Copyright (c) 2025 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/fluid/framework/new_executor/interpreter/shape_plan_cache.h"
+
+#include <algorithm>
+
+#include "paddle/phi/core/platform/monitor.h"
+
+DEFINE_INT_STATUS(STAT_shape_plan_cache_hit)
+DEFINE_INT_STATUS(STAT_shape_plan_cache_miss)
+DEFINE_INT_STATUS(STAT_shape_plan_cache_invalidate)
+DEFINE_INT_STATUS(STAT_shape_plan_presized_outputs)
+
+namespace paddle::framework::interpreter {
+
+namespace {
+
+constexpr size_t kBufferAlignment = 64;
+
+template <typename T>
+void AppendPod(T value, std::string* key) {
+  key->append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+}  // namespace
+
+ShapePlanCache::ShapePlanCache(size_t capacity, size_t instr_num)
+    : capacity_(std::max<size_t>(capacity, 1)), instr_num_(instr_num) {}
+
+void ShapePlanCache::AppendKey(const phi::DenseTensorMeta& meta,
+                               std::string* key) {
+  AppendPod(static_cast<int32_t>(meta.dtype), key);
+  AppendPod(static_cast<int32_t>(meta.layout), key);
+  AppendPod(static_cast<int32_t>(meta.dims.size()), key);
+  for (int i = 0; i < meta.dims.size(); ++i) {
+    AppendPod(meta.dims[i], key);
+  }
+  AppendPod(meta.legacy_lod.size(), key);
+  for (auto& level : meta.legacy_lod) {
+    AppendPod(level.size(), key);
+    key->append(reinterpret_cast<const char*>(level.data()),
+                level.size() * sizeof(level[0]));
+  }
+}
+
+size_t ShapePlanCache::LayoutBuffers(std::vector<ShapePlanBuffer>* buffers) {
+  auto& bufs = *buffers;
+  size_t memory_size = 0;
+  std::vector<std::pair<size_t, size_t>> busy;
+  for (size_t b = 0; b < bufs.size(); ++b) {
+    auto& buf = bufs[b];
+    buf.size = (buf.size + kBufferAlignment - 1) / kBufferAlignment *
+               kBufferAlignment;
+    // the ranges of the buffers still alive when buf is written
+    busy.clear();
+    for (size_t o = 0; o < b; ++o) {
+      if (bufs[o].end >= buf.begin) {
+        busy.emplace_back(bufs[o].offset, bufs[o].offset + bufs[o].size);
+      }
+    }
+    std::sort(busy.begin(), busy.end());
+    // the lowest gap large enough
+    size_t offset = 0;
+    for (auto& range : busy) {
+      if (offset + buf.size <= range.first) {
+        break;
+      }
+      offset = std::max(offset, range.second);
+    }
+    buf.offset = offset;
+    buf.overlaps.clear();
+    for (size_t o = 0; o < b; ++o) {
+      if (bufs[o].end < buf.begin && bufs[o].offset < offset + buf.size &&
+          offset < bufs[o].offset + bufs[o].size) {
+        buf.overlaps.push_back(o);
+      }
+    }
+    memory_size = std::max(memory_size, offset + buf.size);
+  }
+  return memory_size;
+}
+
+ShapePlan* ShapePlanCache::Get(const std::string& key, bool* hit) {
+  auto it = index_.find(key);
+  if (it != index_.end()) {
+    plans_.splice(plans_.begin(), plans_, it->second);
+    stat_.hit++;
+    STAT_ADD(STAT_shape_plan_cache_hit, 1);
+    *hit = true;
+    return &plans_.front().second;
+  }
+  stat_.miss++;
+  STAT_ADD(STAT_shape_plan_cache_miss, 1);
+  if (plans_.size() >= capacity_) {
+    index_.erase(plans_.back().first);
+    plans_.pop_back();
+    stat_.evict++;
+  }
+  plans_.emplace_front(key, ShapePlan());
+  index_[key] = plans_.begin();
+  auto* plan = &plans_.front().second;
+  plan->metas.resize(instr_num_);
+  plan->ready.assign(instr_num_, 0);
+  *hit = false;
+  return plan;
+}
+
+void ShapePlanCache::Invalidate() {
+  stat_.invalidate++;
+  STAT_ADD(STAT_shape_plan_cache_invalidate, 1);
+}
+
+}  // namespace paddle::framework::interpreter
@@ -0,0 +1,114 @@
+// Copyright (c) 2025 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "paddle/phi/core/allocator.h"
+#include "paddle/phi/core/tensor_meta.h"
+
+namespace paddle {
+namespace framework {
+namespace interpreter {
+
+// The memory of one output of a ShapePlan, a range of ShapePlan::memory.
+struct ShapePlanBuffer {
+  size_t instr_id = 0;
+  // index of the output in ShapePlan::metas[instr_id]
+  size_t output = 0;
+  // positions in the run order of the writer and of the last reader
+  size_t begin = 0;
+  size_t end = 0;
+  size_t offset = 0;
+  size_t size = 0;
+  // buffers placed before this one on bytes it shares, their tensors must
+  // have been released before this buffer is handed out
+  std::vector<size_t> overlaps;
+  std::shared_ptr<phi::Allocation> holder;
+};
+
+// The output metas of every instruction of a block, recorded in one run.
+// Replaying them lets a later run with the same input metas skip InferMeta.
+struct ShapePlan {
+  // metas[i] holds the metas of the DenseTensor outputs of instruction i,
+  // it is only used if ready[i] is set.
+  std::vector<std::vector<phi::DenseTensorMeta>> metas;
+  std::vector<uint8_t> ready;
+
+  // The pre-sized memory of the plan, laid out at the first replay: the
+  // intermediate outputs of the instructions skipping InferMeta get a range
+  // of one block, outputs not alive at the same time share bytes.
+  bool memory_planned = false;
+  std::vector<ShapePlanBuffer> buffers;
+  // buffer_of[i][k] is the index in buffers of output k of instruction i,
+  // or -1; empty if instruction i has no buffer
+  std::vector<std::vector<int>> buffer_of;
+  size_t memory_size = 0;
+  std::shared_ptr<phi::Allocation> memory;
+};
+
+struct ShapePlanCacheStat {
+  uint64_t hit = 0;
+  uint64_t miss = 0;
+  uint64_t evict = 0;
+  // Runs in which an instruction produced other metas than its plan, e.g.
+  // an output whose shape depends on the data, so the rest of the plan was
+  // recorded again.
+  uint64_t invalidate = 0;
+};
+
+// An LRU cache of ShapePlans keyed by the metas of the inputs of a block.
+// It belongs to one interpreter and is not thread safe.
+class ShapePlanCache {
+ public:
+  ShapePlanCache(size_t capacity, size_t instr_num);
+
+  // Appends the dims, dtype, layout and lod of meta to a plan key.
+  static void AppendKey(const phi::DenseTensorMeta& meta, std::string* key);
+
+  // Sets the offset and overlaps of buffers, sorted by begin, so that
+  // buffers whose [begin, end] intersect do not share bytes. Sizes are
+  // rounded up to the alignment. Returns the size of the memory.
+  static size_t LayoutBuffers(std::vector<ShapePlanBuffer>* buffers);
+
+  // Returns the plan of key, hit tells whether it was used before. A new
+  // plan is empty, the least recently used plan is evicted to make room.
+  ShapePlan* Get(const std::string& key, bool* hit);
+
+  void Invalidate();
+
+  size_t size() const { return plans_.size(); }
+  const ShapePlanCacheStat& stat() const { return stat_; }
+
+ private:
+  using PlanList = std::list<std::pair<std::string, ShapePlan>>;
+
+  size_t capacity_;
+  size_t instr_num_;
+  // most recently used first
+  PlanList plans_;
+  std::unordered_map<std::string, PlanList::iterator> index_;
+  ShapePlanCacheStat stat_;
+};
+
+}  // namespace interpreter
+}  // namespace framework
+}  // namespace paddle
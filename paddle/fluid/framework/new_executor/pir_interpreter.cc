@@ -14,7 +14,9 @@
 
 #include "paddle/fluid/framework/new_executor/pir_interpreter.h"
 
+#include <algorithm>
 #include <chrono>
+#include <set>
 #include <unordered_set>
 
 #include "paddle/common/flags.h"
@@ -26,8 +28,10 @@
 #include "paddle/fluid/platform/profiler/supplement_tracing.h"
 #include "paddle/phi/common/place.h"
 #include "paddle/phi/core/kernel_context.h"
+#include "paddle/phi/core/memory/malloc.h"
 #include "paddle/phi/core/os_info.h"
 #include "paddle/phi/core/platform/device/gpu/gpu_info.h"
+#include "paddle/phi/core/platform/monitor.h"
 #include "paddle/phi/core/platform/profiler/event_tracing.h"
 #include "paddle/phi/core/sparse_coo_tensor.h"
 #include "paddle/phi/core/sparse_csr_tensor.h"
@@ -92,12 +96,33 @@ COMMON_DECLARE_bool(enable_collect_shape);
 COMMON_DECLARE_int32(low_precision_op_list);
 COMMON_DECLARE_bool(pir_interpreter_record_stream_for_gc_cache);
 
+USE_INT_STAT(STAT_shape_plan_presized_outputs);
+
 #define CREATE_INSTR(instr_name)                                   \
   vec_instruction_base_.emplace_back(std::make_unique<instr_name>( \
       op_idx++, place_, &op, value_exe_info_.get()));
 
 namespace paddle::framework {
 
+namespace {
+
+// A range of the memory of a shape plan, it keeps the memory alive.
+class ShapePlanAllocation : public phi::Allocation {
+ public:
+  ShapePlanAllocation(std::shared_ptr<phi::Allocation> memory,
+                      size_t offset,
+                      size_t size)
+      : phi::Allocation(static_cast<char*>(memory->ptr()) + offset,
+                        size,
+                        memory->place()),
+        memory_(std::move(memory)) {}
+
+ private:
+  std::shared_ptr<phi::Allocation> memory_;
+};
+
+}  // namespace
+
 void RecordLowPrecisionOp(const InstructionBase* instr_node) {
   if (FLAGS_low_precision_op_list) {
     std::string op_name = instr_node->Name();
@@ -811,6 +836,7 @@ void PirInterpreter::AnalyzeForceSyncOps() {
 void PirInterpreter::BuildInstruction() {
   VLOG(6) << "Build Instructions for pir ... ";
   vec_instruction_base_.clear();
+  shape_plan_cache_.reset();
   size_t op_idx = 0;
   for (auto& op : *ir_block_) {
     VLOG(6) << "Build Instruction for op: " << op_idx;
@@ -1725,18 +1751,57 @@ void PirInterpreter::TraceRunInstructionList(
     }
   }
 
+  interpreter::ShapePlan* plan = nullptr;
+  bool replay = false;
+  if (execution_config_.shape_plan_cache_capacity > 0 &&
+      &vec_instr == &vec_instruction_base_) {
+    if (!shape_plan_cache_) {
+      PrepareShapePlan();
+    }
+    std::string key;
+    if (GetShapePlanKey(&key)) {
+      plan = shape_plan_cache_->Get(key, &replay);
+    }
+    if (replay) {
+      PrepareShapePlanMemory(plan);
+    }
+  }
+
   for (size_t idx = 0; idx < trace_execute_order_.size(); idx++) {
     auto instr_id = trace_execute_order_[idx];
     InstructionBase* instr_node = vec_instruction_base_.at(instr_id).get();
 
     VLOG(6) << "Run InstructionBase " << instr_node->Name() << "[" << instr_id
             << "], op id: " << instr_node->Operation()->id();
+    PhiKernelInstruction* skip_instr = nullptr;
+    if (replay && shape_plan_skippable_[instr_id] &&
+        plan->ready[instr_id]) {
+      skip_instr = shape_plan_skippable_[instr_id];
+      ApplyShapePlan(instr_id, plan);
+      skip_instr->SetSkipInferMeta(true);
+    }
     RunInstructionBase(instr_node);
+    if (skip_instr) {
+      skip_instr->SetSkipInferMeta(false);
+    }
 
     if (UNLIKELY(exception_holder_.IsCaught())) {
       VLOG(4) << "Exception caught";
       break;
     }
+
+    if (plan != nullptr) {
+      if (replay && !MatchShapePlan(instr_id, *plan)) {
+        // The instructions after it may see other input metas than the
+        // plan, infer them again and record the new metas.
+        VLOG(4) << "Shape plan mismatch at " << instr_node->Name();
+        shape_plan_cache_->Invalidate();
+        replay = false;
+      }
+      if (!replay) {
+        RecordShapePlan(instr_id, plan);
+      }
+    }
   }
 
   if (UNLIKELY(exception_holder_.IsCaught())) {
@@ -1752,6 +1817,215 @@ void PirInterpreter::TraceRunInstructionList(
   VLOG(4) << "Done TraceRunInstructionList";
 }
 
+void PirInterpreter::PrepareShapePlan() {
+  size_t instr_num = vec_instruction_base_.size();
+  shape_plan_cache_ = std::make_unique<interpreter::ShapePlanCache>(
+      execution_config_.shape_plan_cache_capacity, instr_num);
+  shape_plan_input_vars_.clear();
+  shape_plan_output_vars_.assign(instr_num, {});
+  shape_plan_skippable_.assign(instr_num, nullptr);
+
+  std::set<size_t> read_vars, written_vars;
+  for (size_t i = 0; i < instr_num; ++i) {
+    auto* instr = vec_instruction_base_[i].get();
+    std::set<size_t> inputs, outputs;
+    for (auto& item : instr->Inputs()) {
+      inputs.insert(item.second.begin(), item.second.end());
+    }
+    for (auto& item : instr->Outputs()) {
+      outputs.insert(item.second.begin(), item.second.end());
+    }
+    read_vars.insert(inputs.begin(), inputs.end());
+    written_vars.insert(outputs.begin(), outputs.end());
+
+    bool all_dense = true, inplace = false;
+    for (size_t var_id : outputs) {
+      auto* var = value_exe_info_->GetVarList()[var_id];
+      if (var->IsType<phi::DenseTensor>()) {
+        shape_plan_output_vars_[i].push_back(var_id);
+      } else {
+        all_dense = false;
+      }
+      inplace = inplace || inputs.count(var_id);
+    }
+    // The plan replaces InferMeta only if the output metas are a function
+    // of the input metas and setting them ahead does not touch an input.
+    auto* phi_instr = dynamic_cast<PhiKernelInstruction*>(instr);
+    if (phi_instr && phi_instr->InferMetaInterface() && all_dense &&
+        !inplace && !phi_instr->InferMetaReadsTensorData()) {
+      shape_plan_skippable_[i] = phi_instr;
+    }
+  }
+  for (size_t var_id : read_vars) {
+    if (!written_vars.count(var_id) &&
+        !parameter_var_names_.count(value_exe_info_->GetNameById(var_id))) {
+      shape_plan_input_vars_.push_back(var_id);
+    }
+  }
+
+  // A var gets a range of the memory of a plan if it is written by one
+  // instruction and only read by CPU phi kernels, so that it does not leave
+  // the run and is released by GC after its last reader.
+  size_t var_num = value_exe_info_->GetVarList().size();
+  shape_plan_var_end_.assign(var_num, -1);
+  std::vector<int> writers(var_num, 0);
+  std::vector<uint8_t> escapes(var_num, 0);
+  for (size_t pos = 0; pos < trace_execute_order_.size(); ++pos) {
+    auto* instr = vec_instruction_base_[trace_execute_order_[pos]].get();
+    bool cpu_kernel = dynamic_cast<PhiKernelInstruction*>(instr) &&
+                      phi::is_cpu_place(instr->DeviceContext().GetPlace());
+    for (auto& item : instr->Inputs()) {
+      for (size_t var_id : item.second) {
+        escapes[var_id] = escapes[var_id] || !cpu_kernel;
+        shape_plan_var_end_[var_id] = static_cast<int64_t>(pos);
+      }
+    }
+    for (auto& item : instr->Outputs()) {
+      for (size_t var_id : item.second) {
+        writers[var_id]++;
+      }
+    }
+  }
+  for (size_t var_id = 0; var_id < var_num; ++var_id) {
+    const auto& name = value_exe_info_->GetNameById(var_id);
+    if (escapes[var_id] || writers[var_id] != 1 ||
+        parameter_var_names_.count(name) ||
+        execution_config_.skip_gc_vars.count(name)) {
+      shape_plan_var_end_[var_id] = -1;
+    }
+  }
+  VLOG(4) << "Shape plan: " << shape_plan_input_vars_.size()
+          << " input vars, "
+          << std::count_if(shape_plan_skippable_.begin(),
+                           shape_plan_skippable_.end(),
+                           [](PhiKernelInstruction* p) { return p; })
+          << " of " << instr_num << " instructions skip InferMeta";
+}
+
+bool PirInterpreter::GetShapePlanKey(std::string* key) const {
+  for (size_t var_id : shape_plan_input_vars_) {
+    auto* var = value_exe_info_->GetVarList()[var_id];
+    if (!var->IsType<phi::DenseTensor>()) {
+      return false;
+    }
+    interpreter::ShapePlanCache::AppendKey(var->Get<phi::DenseTensor>().meta(),
+                                           key);
+  }
+  return true;
+}
+
+void PirInterpreter::PrepareShapePlanMemory(interpreter::ShapePlan* plan) {
+  if (!plan->memory_planned) {
+    plan->memory_planned = true;
+    plan->buffers.clear();
+    plan->buffer_of.assign(plan->metas.size(), {});
+    plan->memory.reset();
+    for (size_t pos = 0; pos < trace_execute_order_.size(); ++pos) {
+      size_t instr_id = trace_execute_order_[pos];
+      if (!shape_plan_skippable_[instr_id] || !plan->ready[instr_id] ||
+          !phi::is_cpu_place(
+              shape_plan_skippable_[instr_id]->DeviceContext().GetPlace())) {
+        continue;
+      }
+      auto& vars = shape_plan_output_vars_[instr_id];
+      plan->buffer_of[instr_id].assign(vars.size(), -1);
+      for (size_t k = 0; k < vars.size(); ++k) {
+        const auto& meta = plan->metas[instr_id][k];
+        int64_t end = shape_plan_var_end_[vars[k]];
+        int64_t numel = common::product(meta.dims);
+        if (end < 0 || numel <= 0 || !meta.is_contiguous()) {
+          continue;
+        }
+        interpreter::ShapePlanBuffer buffer;
+        buffer.instr_id = instr_id;
+        buffer.output = k;
+        buffer.begin = pos;
+        buffer.end = end;
+        buffer.size = numel * phi::SizeOf(meta.dtype) + meta.offset;
+        plan->buffer_of[instr_id][k] = static_cast<int>(plan->buffers.size());
+        plan->buffers.push_back(std::move(buffer));
+      }
+    }
+    plan->memory_size =
+        interpreter::ShapePlanCache::LayoutBuffers(&plan->buffers);
+    VLOG(4) << "Shape plan memory: " << plan->buffers.size()
+            << " outputs in " << plan->memory_size << " bytes";
+  }
+  if (plan->memory_size == 0) {
+    return;
+  }
+  // A tensor of the last run may still hold a buffer, e.g. a view of an
+  // output, then the plan moves to new memory and leaves the old one to it.
+  bool reuse = plan->memory != nullptr;
+  for (auto& buffer : plan->buffers) {
+    reuse = reuse && buffer.holder.use_count() == 1;
+  }
+  if (reuse) {
+    return;
+  }
+  plan->memory = memory::AllocShared(place_, plan->memory_size);
+  for (auto& buffer : plan->buffers) {
+    buffer.holder = std::make_shared<ShapePlanAllocation>(
+        plan->memory, buffer.offset, buffer.size);
+  }
+}
+
+void PirInterpreter::ApplyShapePlan(size_t instr_id,
+                                    interpreter::ShapePlan* plan) {
+  auto& vars = shape_plan_output_vars_[instr_id];
+  auto& buffer_of = plan->buffer_of[instr_id];
+  for (size_t k = 0; k < vars.size(); ++k) {
+    auto* tensor =
+        value_exe_info_->GetVarList()[vars[k]]->GetMutable<phi::DenseTensor>();
+    tensor->set_meta(plan->metas[instr_id][k]);
+    if (buffer_of.empty() || buffer_of[k] < 0) {
+      continue;
+    }
+    // The bytes are shared with outputs released before this one, unless
+    // GC has not dropped them yet, the kernel then allocates as usual.
+    auto& buffer = plan->buffers[buffer_of[k]];
+    bool released = true;
+    for (size_t o : buffer.overlaps) {
+      released = released && plan->buffers[o].holder.use_count() == 1;
+    }
+    if (released) {
+      tensor->ResetHolder(buffer.holder);
+      STAT_ADD(STAT_shape_plan_presized_outputs, 1);
+    }
+  }
+}
+
+bool PirInterpreter::MatchShapePlan(size_t instr_id,
+                                    const interpreter::ShapePlan& plan) const {
+  if (!plan.ready[instr_id]) {
+    return false;
+  }
+  auto& vars = shape_plan_output_vars_[instr_id];
+  for (size_t k = 0; k < vars.size(); ++k) {
+    auto* var = value_exe_info_->GetVarList()[vars[k]];
+    if (!(var->Get<phi::DenseTensor>().meta() == plan.metas[instr_id][k])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void PirInterpreter::RecordShapePlan(size_t instr_id,
+                                     interpreter::ShapePlan* plan) const {
+  auto& vars = shape_plan_output_vars_[instr_id];
+  auto& metas = plan->metas[instr_id];
+  metas.clear();
+  // the memory is laid out again from the new metas
+  plan->memory_planned = false;
+  bool valid = true;
+  for (size_t var_id : vars) {
+    auto* var = value_exe_info_->GetVarList()[var_id];
+    metas.push_back(var->Get<phi::DenseTensor>().meta());
+    valid = valid && metas.back().valid();
+  }
+  plan->ready[instr_id] = valid;
+}
+
 void PirInterpreter::MultiThreadRunInstructionList(
     const std::vector<std::unique_ptr<InstructionBase>>& vec_instr) {
   unfinished_op_number_ = vec_instr.size();
@@ -2057,6 +2331,26 @@ void PirInterpreter::PreAnalysis() {
     }
   }
 
+  if (execution_config_.schedule_fetch_first) {
+    // Instructions with a lower priority value are popped first, see
+    // ir_instruction_scheduling_priority_less. The fetch ops of inference
+    // programs are replaced by shadow_output ops, which are no
+    // instructions, so the producers of their inputs go first instead.
+    for (auto& instr : vec_instruction_base_) {
+      bool fetch = instr->Name() == "pd_op.fetch";
+      for (auto& output : instr->Outputs()) {
+        ::pir::Value value = output.first;
+        for (auto it = value.use_begin(); !fetch && it != value.use_end();
+             ++it) {
+          fetch = it->owner()->isa<::pir::ShadowOutputOp>();
+        }
+      }
+      if (fetch) {
+        instr->SetSchedulingPriority(-1);
+      }
+    }
+  }
+
   AnalyseExecuteOrderForTrace(ir_dependency_builder_.OpDownstreamMap(),
                               ir_instruction_scheduling_priority_less);
   VLOG(4) << "Done AnalyseExecuteOrderForTrace";
@@ -15,6 +15,7 @@
 #pragma once
 #include <memory>
 #include "paddle/fluid/framework/new_executor/instruction/instruction_base.h"
+#include "paddle/fluid/framework/new_executor/interpreter/shape_plan_cache.h"
 #include "paddle/fluid/framework/new_executor/interpreter_base_impl.h"
 #include "paddle/pir/include/core/value.h"
 
@@ -28,6 +29,7 @@ class Block;
 
 namespace paddle {
 namespace framework {
+class PhiKernelInstruction;
 class ValueExecutionInfo;
 class PirInterpreter : public InterpreterBaseImpl {
   using ExecutionConfig = interpreter::ExecutionConfig;
@@ -209,6 +211,19 @@ class PirInterpreter : public InterpreterBaseImpl {
   std::vector<PirHookFunc> pir_output_hookfuncs_;
   std::vector<PirHookFunc> pir_input_hookfuncs_;
 
+  // used for shape plan
+  std::unique_ptr<interpreter::ShapePlanCache> shape_plan_cache_;
+  // vars read by the block but not written by any instruction, except
+  // parameters
+  std::vector<size_t> shape_plan_input_vars_;
+  // DenseTensor outputs of each instruction, ordered by var id
+  std::vector<std::vector<size_t>> shape_plan_output_vars_;
+  // instructions whose InferMeta can be replaced by the plan, or nullptr
+  std::vector<PhiKernelInstruction*> shape_plan_skippable_;
+  // position in trace_execute_order_ of the last reader of each var, or -1
+  // if the var can not be placed in the memory of a plan
+  std::vector<int64_t> shape_plan_var_end_;
+
   /// ======================== ///
   ///        For new ir        ///
   /// ======================== ///
@@ -245,6 +260,15 @@ class PirInterpreter : public InterpreterBaseImpl {
 
   void RecordMemcpyD2H(InstructionBase* instr_node);
 
+  // shape plan, see ExecutionConfig::shape_plan_cache_capacity
+  void PrepareShapePlan();
+  bool GetShapePlanKey(std::string* key) const;
+  void PrepareShapePlanMemory(interpreter::ShapePlan* plan);
+  void ApplyShapePlan(size_t instr_id, interpreter::ShapePlan* plan);
+  bool MatchShapePlan(size_t instr_id,
+                      const interpreter::ShapePlan& plan) const;
+  void RecordShapePlan(size_t instr_id, interpreter::ShapePlan* plan) const;
+
   ::pir::Value GetValueByName(const std::string& var_name);
 
   void CheckGC(InstructionBase* instr);
@@ -575,8 +575,15 @@ AnalysisConfig::AnalysisConfig(const AnalysisConfig &other) {
   CP_MEMBER(specify_input_name_);
 
   CP_MEMBER(use_optimized_model_);
+  CP_MEMBER(use_optimized_program_cache_);
 
   CP_MEMBER(cpu_math_library_num_threads_);
+  CP_MEMBER(async_run_num_threads_);
+  CP_MEMBER(shape_plan_cache_capacity_);
+  CP_MEMBER(shape_buckets_);
+  CP_MEMBER(use_shared_weights_);
+  CP_MEMBER(use_request_arena_);
+  CP_MEMBER(use_streaming_fetch_);
 
   CP_MEMBER(serialized_info_cache_);
 
@@ -1217,6 +1224,38 @@ void AnalysisConfig::SetCpuMathLibraryNumThreads(
   Update();
 }
 
+void AnalysisConfig::SetAsyncRunNumThreads(int num_threads) {
+  PADDLE_ENFORCE_GT(num_threads,
+                    0,
+                    common::errors::InvalidArgument(
+                        "The number of async run threads should be greater "
+                        "than 0, but received %d.",
+                        num_threads));
+  async_run_num_threads_ = num_threads;
+}
+
+void AnalysisConfig::EnableShapeBucketPlanCache(
+    int capacity, const std::vector<int64_t> &buckets) {
+  PADDLE_ENFORCE_GT(capacity,
+                    0,
+                    common::errors::InvalidArgument(
+                        "The shape plan cache capacity should be greater "
+                        "than 0, but received %d.",
+                        capacity));
+  for (size_t i = 0; i < buckets.size(); ++i) {
+    PADDLE_ENFORCE_EQ(
+        buckets[i] > 0 && (i == 0 || buckets[i] > buckets[i - 1]),
+        true,
+        common::errors::InvalidArgument(
+            "The shape buckets should be positive and strictly ascending, "
+            "but the %d-th bucket is %d.",
+            i,
+            buckets[i]));
+  }
+  shape_plan_cache_capacity_ = capacity;
+  shape_buckets_ = buckets;
+}
+
 float AnalysisConfig::fraction_of_gpu_memory_for_pool() const {
 #if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
   // Get the GPU memory details and calculate the fraction of memory for the
@@ -1311,6 +1350,19 @@ std::string AnalysisConfig::Summary() {
   // cpu info
   os.InsertRow(
       {"cpu_math_thread", std::to_string(cpu_math_library_num_threads_)});
+  os.InsertRow({"async_run_thread", std::to_string(async_run_num_threads_)});
+  if (shape_plan_cache_capacity_ > 0) {
+    os.InsertRow({"shape_plan_cache_capacity",
+                  std::to_string(shape_plan_cache_capacity_)});
+    std::string buckets;
+    for (auto bucket : shape_buckets_) {
+      buckets += (buckets.empty() ? "" : ",") + std::to_string(bucket);
+    }
+    os.InsertRow({"shape_buckets", buckets.empty() ? "none" : buckets});
+  }
+  os.InsertRow({"shared_weights", use_shared_weights_ ? "true" : "false"});
+  os.InsertRow({"request_arena", use_request_arena_ ? "true" : "false"});
+  os.InsertRow({"streaming_fetch", use_streaming_fetch_ ? "true" : "false"});
   os.InsertRow({"enable_mkldnn", use_mkldnn_ ? "true" : "false"});
   os.InsertRow(
       {"mkldnn_cache_capacity", std::to_string(mkldnn_cache_capacity_)});
@@ -1461,6 +1513,8 @@ std::string AnalysisConfig::Summary() {
   os.InsertRow({"ir_debug", ir_debug_ ? "true" : "false"});
   os.InsertRow(
       {"use_optimized_model", use_optimized_model_ ? "true" : "false"});
+  os.InsertRow({"use_optimized_program_cache",
+                use_optimized_program_cache_ ? "true" : "false"});
   os.InsertRow({"memory_optim", enable_memory_optim_ ? "true" : "false"});
   os.InsertRow({"enable_profile", with_profile_ ? "true" : "false"});
   os.InsertRow({"enable_log", with_glog_info_ ? "true" : "false"});
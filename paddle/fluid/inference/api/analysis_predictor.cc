@@ -17,12 +17,20 @@
 #include <glog/logging.h>
 
 #include <algorithm>
+#include <chrono>
 #include <cstdlib>
+#include <cstring>
 #include <filesystem>
 #include <fstream>
+#include <future>
 #include <memory>
+#include <random>
 #include <set>
+#include <sstream>
+#include <stdexcept>
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -38,6 +46,7 @@
 #include "paddle/fluid/framework/op_proto_maker.h"
 #include "paddle/fluid/framework/operator.h"
 #include "paddle/fluid/framework/scope.h"
+#include "paddle/fluid/framework/tensor_util.h"
 #include "paddle/fluid/framework/transfer_scope_cache.h"
 #include "paddle/fluid/framework/var_type_traits.h"
 #include "paddle/fluid/framework/version.h"
@@ -51,6 +60,7 @@
 #include "paddle/fluid/inference/api/paddle_inference_api.h"
 #include "paddle/fluid/inference/api/paddle_inference_pass.h"
 #include "paddle/fluid/inference/api/resource_manager.h"
+#include "paddle/fluid/inference/api/weight_registry.h"
 #include "paddle/fluid/inference/utils/io_utils.h"
 #include "paddle/fluid/inference/utils/model_utils.h"
 #include "paddle/fluid/inference/utils/singleton.h"
@@ -62,14 +72,17 @@
 #include "paddle/phi/common/backend.h"
 #include "paddle/phi/common/data_type.h"
 #include "paddle/phi/common/place.h"
+#include "paddle/phi/core/memory/malloc.h"
 #include "paddle/phi/core/memory/memcpy.h"
 #include "paddle/phi/core/platform/cpu_helper.h"
 #include "paddle/phi/core/platform/device/gpu/gpu_info.h"
 #include "paddle/phi/core/platform/device/gpu/gpu_types.h"
 #include "paddle/phi/core/platform/device_context.h"
+#include "paddle/phi/core/platform/monitor.h"
 #include "paddle/phi/core/platform/profiler.h"
 
 #include "paddle/phi/core/generator.h"
+#include "paddle/phi/core/tensor_utils.h"
 #include "paddle/phi/kernels/funcs/data_type_transform.h"
 #include "paddle/utils/string/split.h"
 
@@ -135,6 +148,11 @@
 
 COMMON_DECLARE_bool(pir_apply_inplace_pass);
 COMMON_DECLARE_bool(enable_auto_layout_pass);
+
+DEFINE_INT_STATUS(STAT_optimized_program_cache_hit)
+DEFINE_INT_STATUS(STAT_optimized_program_cache_miss)
+DEFINE_INT_STATUS(STAT_optimized_program_cache_cold_prepare_ms)
+DEFINE_INT_STATUS(STAT_optimized_program_cache_warm_prepare_ms)
 namespace paddle {
 namespace {
 #if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
@@ -201,6 +219,21 @@ using inference::tensorrt::TRTInt8Calibrator;
 int AnalysisPredictor::clone_num_ = 1;
 
 namespace {
+// Moves a file written aside to its place. On failure, e.g. when another
+// process holds the target on Windows, the file is dropped and the next
+// predictor misses the optimized model instead of failing.
+bool MoveFileToPlace(const std::string &from, const std::string &to) {
+  std::error_code ec;
+  std::filesystem::rename(from, to, ec);
+  if (ec) {
+    LOG(WARNING) << "Failed to move " << from << " to " << to << ": "
+                 << ec.message() << ", the optimized model is not saved.";
+    std::filesystem::remove(from, ec);
+    return false;
+  }
+  return true;
+}
+
 bool IsPersistable(const framework::VarDesc *var) {
   if (var->Persistable() &&
       var->GetType() != framework::proto::VarType::FEED_MINIBATCH &&
@@ -442,8 +475,9 @@ bool AnalysisPredictor::Init(
 
   std::string model_path = config_.prog_file();
   if (!model_path.empty()) {
-    load_pir_model_ =
-        model_path.substr(model_path.find_last_of(".") + 1) == "json";
+    // pirb is the binary program of the optimized program cache
+    std::string extension = model_path.substr(model_path.find_last_of(".") + 1);
+    load_pir_model_ = extension == "json" || extension == "pirb";
   } else if (!config_.model_dir().empty()) {
     std::string model_dir = config_.model_dir();
     load_pir_model_ = false;
@@ -461,17 +495,24 @@ bool AnalysisPredictor::Init(
     config_.use_new_executor_ = true;
   }
 
+  auto prepare_start = std::chrono::steady_clock::now();
+  bool use_program_cache = config_.optimized_program_cache_enabled() &&
+                           load_pir_model_ && config_.ir_optim() &&
+                           !config_.use_optimized_model_ && !status_is_cloned_;
+  if (use_program_cache) {
+    optimized_program_cache_key_ = "_" + GetOptimizedProgramCacheKey();
+    config_.UseOptimizedModel(true);
+  }
+
   // Use Optimized model to inference
   if (config_.use_optimized_model_) {
-    std::string optimized_model_path = GetOptimizedModelPath();
     std::string optimized_model;
     if (config_.new_ir_enabled()) {
-      optimized_model = optimized_model_path + "/" + "_optimized.json";
+      optimized_model = GetOptimizedPirProgramFile();
     } else {
-      optimized_model = optimized_model_path + "/" + "_optimized.pdmodel";
+      optimized_model = GetOptimizedModelPrefix() + ".pdmodel";
     }
-    std::string optimized_params =
-        optimized_model_path + "/" + "_optimized.pdiparams";
+    std::string optimized_params = GetOptimizedModelPrefix() + ".pdiparams";
     if (FileExists(optimized_model) && FileExists(optimized_params)) {
       config_.SetModel(optimized_model, optimized_params);
       if (config_.new_ir_enabled()) {
@@ -508,6 +549,27 @@ bool AnalysisPredictor::Init(
       return false;
     }
   }
+  if (use_program_cache) {
+    // A hit leaves UseOptimizedModel on, a miss falls back to the passes.
+    bool hit = config_.use_optimized_model_;
+    int64_t cost = std::chrono::duration_cast<std::chrono::milliseconds>(
+                       std::chrono::steady_clock::now() - prepare_start)
+                       .count();
+    if (hit) {
+      STAT_ADD(STAT_optimized_program_cache_hit, 1);
+      STAT_ADD(STAT_optimized_program_cache_warm_prepare_ms, cost);
+    } else {
+      STAT_ADD(STAT_optimized_program_cache_miss, 1);
+      STAT_ADD(STAT_optimized_program_cache_cold_prepare_ms, cost);
+    }
+    LOG(INFO) << "Optimized program cache " << (hit ? "hit" : "miss")
+              << ", the program is prepared in " << cost << " ms ("
+              << (hit ? "warm" : "cold") << " start)";
+  }
+  // Clones share the scope of their parent already.
+  if (config_.shared_weights_enabled() && !status_is_cloned_) {
+    ShareWeights();
+  }
 
   // Get the feed_target_names and fetch_target_names
 
@@ -553,6 +615,9 @@ bool AnalysisPredictor::Init(
     InitDeviceContexts();
   }
 #endif
+  if (config_.request_arena_enabled()) {
+    InitRequestArena();
+  }
 
   TryShrinkMemory();
 
@@ -606,6 +671,39 @@ void AnalysisPredictor::InitPlace() {
   }
 }
 
+std::string AnalysisPredictor::GetOptimizedModelPrefix() {
+  return GetOptimizedModelPath() + "/_optimized" + optimized_program_cache_key_;
+}
+
+std::string AnalysisPredictor::GetOptimizedPirProgramFile() {
+  return GetOptimizedModelPrefix() +
+         (optimized_program_cache_key_.empty() ? ".json" : ".pirb");
+}
+
+std::string AnalysisPredictor::GetOptimizedProgramCacheKey() {
+  // The params file is identified by its size and modification time rather
+  // than hashed, reading it would cost as much as the load it saves.
+  std::stringstream ss;
+  ss << paddle_infer::GetVersion() << ";";
+  ss << config_.SerializeInfoCache() << ";";
+  for (auto &pass : config_.pass_builder()->AllPasses()) ss << pass << ",";
+  ss << ";";
+  for (auto &pass : config_.deleted_passes_) ss << pass << ",";
+  ss << ";";
+  std::ifstream prog(config_.prog_file(), std::ios::binary);
+  ss << prog.rdbuf() << ";";
+  if (FileExists(config_.params_file())) {
+    std::error_code ec;
+    ss << std::filesystem::file_size(config_.params_file(), ec) << ";";
+    ss << std::filesystem::last_write_time(config_.params_file(), ec)
+              .time_since_epoch()
+              .count();
+  }
+  std::stringstream key;
+  key << std::hex << std::hash<std::string>()(ss.str());
+  return key.str();
+}
+
 std::string AnalysisPredictor::GetOptimizedModelPath() {
   std::string model_opt_cache_dir = config_.opt_cache_dir_;
   if (!model_opt_cache_dir.empty()) {
@@ -703,6 +801,9 @@ void AnalysisPredictor::InitDeviceContexts() {
               ResourceManager::Instance().GetGPUResource(predictor_stream_);
           auto *gpu_context = new InferGPUContext(place_);
           UpdatePrivateDeviceContext(gpu_context, gpu_resource, place_);
+          if (request_arena_) {
+            gpu_context->SetAllocator(request_arena_.get());
+          }
           return std::unique_ptr<phi::DeviceContext>(gpu_context);
         }));
   }
@@ -748,6 +849,99 @@ void AnalysisPredictor::InitDeviceContexts() {
 #endif
 }
 
+void AnalysisPredictor::InitRequestArena() {
+  // Alignment of the tensors carved out of the arena, enough for the
+  // vectorized CPU kernels and for cuDNN.
+  constexpr size_t kArenaAlignment = 256;
+  auto &instance = memory::allocation::AllocatorFacade::Instance();
+  request_arena_persistables_ = GetPersistableNames();
+  if (place_.GetType() == phi::AllocationType::CPU) {
+    request_arena_ = std::make_shared<memory::allocation::ArenaAllocator>(
+        instance.GetAllocator(place_), kArenaAlignment);
+    device_contexts_.emplace(
+        place_, std::async(std::launch::deferred, [=] {
+#ifdef PADDLE_WITH_DNNL
+          auto *cpu_context = new phi::OneDNNContext(place_);
+#else
+          auto *cpu_context = new phi::CPUContext(place_);
+#endif
+          auto &facade = memory::allocation::AllocatorFacade::Instance();
+          cpu_context->SetAllocator(request_arena_.get());
+          cpu_context->SetHostAllocator(
+              facade.GetAllocator(phi::CPUPlace()).get());
+          cpu_context->SetZeroAllocator(
+              facade.GetZeroAllocator(place_).get());
+          cpu_context->SetHostZeroAllocator(
+              facade.GetZeroAllocator(phi::CPUPlace()).get());
+          cpu_context->SetGenerator(phi::DefaultCPUGenerator().get());
+          cpu_context->SetHostGenerator(phi::DefaultCPUGenerator().get());
+          return std::unique_ptr<phi::DeviceContext>(cpu_context);
+        }));
+    private_context_ = true;
+    return;
+  }
+#if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
+  // The private GPUContext of InitDeviceContexts is created lazily and picks
+  // up the arena.
+  if (place_.GetType() == phi::AllocationType::GPU &&
+      device_contexts_.count(place_)) {
+    request_arena_ = std::make_shared<memory::allocation::ArenaAllocator>(
+        instance.GetAllocator(place_,
+                              reinterpret_cast<gpuStream_t>(predictor_stream_)),
+        kArenaAlignment);
+    return;
+  }
+#endif
+  LOG(WARNING) << "The request arena is only supported on CPU and on GPU "
+                  "with an external stream, it is not used.";
+}
+
+void AnalysisPredictor::EndRequestArena(framework::Scope *scope) {
+  if (!request_arena_) return;
+  auto *dev_ctxs = reinterpret_cast<const std::map<
+      phi::Place,
+      std::shared_future<std::unique_ptr<phi::DeviceContext>>> *>(
+      GetDeviceContexts());
+  phi::DeviceContext *dev_ctx = dev_ctxs->at(place_).get().get();
+  // The outputs outlive the run, and so do the persistable tensors written
+  // by it, which would keep the arena from ever being reset. Copy them out
+  // of the arena, into memory of the underlying allocator on the stream of
+  // the predictor.
+  auto move_out = [&](const std::string &name) {
+    auto *var = scope->FindVar(name);
+    if (var == nullptr || !var->IsType<phi::DenseTensor>()) return;
+    auto *tensor = var->GetMutable<phi::DenseTensor>();
+    if (!tensor->initialized() ||
+        !request_arena_->Contains(tensor->Holder()->ptr())) {
+      return;
+    }
+    size_t size = tensor->numel() * phi::SizeOf(tensor->dtype());
+    phi::DenseTensor out;
+    out.Resize(tensor->dims());
+    out.ResetHolderWithType(
+        place_.GetType() == phi::AllocationType::CPU
+            ? memory::AllocShared(place_, size)
+            : memory::AllocShared(place_,
+                                  size,
+                                  phi::Stream(reinterpret_cast<phi::StreamId>(
+                                      predictor_stream_))),
+        tensor->dtype());
+    phi::Copy(*dev_ctx, *tensor, place_, false, &out);
+    tensor->ShareBufferWith(out);
+  };
+  for (auto &item : idx2fetches_) {
+    move_out(item.second);
+  }
+  for (auto &name : request_arena_persistables_) {
+    move_out(name);
+  }
+  // The arena tensors copied from are freed once the copies are done.
+  dev_ctx->Wait();
+  request_arena_->EndRequest();
+  VLOG(4) << "Request arena of " << request_arena_->GetStat().capacity
+          << " bytes";
+}
+
 void *AnalysisPredictor::GetExecStream() const {
 #if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
   if (place_.GetType() == phi::AllocationType::GPU) {
@@ -1042,11 +1236,22 @@ void AnalysisPredictor::OptimizeInferencePirProgram() {
     pass_pm.Run(pir_program_.get());
 
     if (config_.save_optimized_model_) {
-      std::string optimized_model =
-          GetOptimizedModelPath() + "/" + "_optimized.json";
-      pir::WriteModule(*pir_program_, optimized_model, 1, true, false, true);
-      LOG(INFO) << "Optimized model saved to " << optimized_model;
-      SaveOrLoadPirParameters(true);
+      // Save the parameters first and move each file in place once written,
+      // so that a predictor starting concurrently never sees a partial
+      // model.
+      std::string optimized_model = GetOptimizedPirProgramFile();
+      std::string tmp_model = optimized_model + ".tmp" +
+                              std::to_string(std::random_device()());
+      // Programs of the optimized program cache are only read back by the
+      // predictor, so they use the faster binary format.
+      bool binary = !optimized_program_cache_key_.empty();
+      if (SaveOrLoadPirParameters(true)) {
+        pir::WriteModule(
+            *pir_program_, tmp_model, 1, true, false, true, binary);
+        if (MoveFileToPlace(tmp_model, optimized_model)) {
+          LOG(INFO) << "Optimized model saved to " << optimized_model;
+        }
+      }
     }
   }
 
@@ -1252,73 +1457,32 @@ bool AnalysisPredictor::SaveOrLoadPirParameters(bool for_save) {
   }
 
   if (for_save) {
-    std::string optimized_params =
-        GetOptimizedModelPath() + "/" + "_optimized.pdiparams";
+    std::string optimized_params = GetOptimizedModelPrefix() + ".pdiparams";
+    std::string tmp_params =
+        optimized_params + ".tmp" + std::to_string(std::random_device()());
     std::vector<const phi::DenseTensor *> const_tensor_out(tensor_out.begin(),
                                                            tensor_out.end());
     pir::SaveCombineFunction(
-        const_tensor_out, param_names, optimized_params, true, false, true);
+        const_tensor_out, param_names, tmp_params, true, false, true);
+    if (!MoveFileToPlace(tmp_params, optimized_params)) {
+      return false;
+    }
     LOG(INFO) << "Optimized params saved to " << optimized_params;
   } else {
     if (load_separate_params_) {
-      std::string params_dir = config_.model_dir();
-
-      auto process_params = [this, &params_dir, &filter_param_names](
-                                size_t start_idx, size_t end_idx) {
-        std::vector<phi::DenseTensor *> local_tensor_out;
-
-        for (size_t j = start_idx; j < end_idx; ++j) {
-          const auto &param_name = filter_param_names[j];
-          std::string param_file = params_dir + "/" + param_name;
-
-          auto *var = sub_scope_->FindVar(param_name);
-          VLOG(4) << "persistable variable's name: " << param_name;
-          if (var == nullptr) {
-            VLOG(4) << "Variable " << param_name << " not found in scope";
-            continue;
-          }
-          auto *tensor_temp = var->GetMutable<phi::DenseTensor>();
-
-          pir::LoadFunction(param_file, -1, {}, false, tensor_temp, place_);
-
-          local_tensor_out.push_back(tensor_temp);
+      std::vector<std::string> param_files;
+      std::vector<phi::DenseTensor *> param_tensors;
+      for (const auto &param_name : filter_param_names) {
+        auto *var = sub_scope_->FindVar(param_name);
+        VLOG(4) << "persistable variable's name: " << param_name;
+        if (var == nullptr) {
+          VLOG(4) << "Variable " << param_name << " not found in scope";
+          continue;
         }
-
-        return local_tensor_out;
-      };
-
-      size_t num_threads = 8;
-      size_t chunk_size = std::max(static_cast<size_t>(1),
-                                   filter_param_names.size() / num_threads);
-      num_threads =
-          std::min(num_threads, filter_param_names.size() / chunk_size);
-      size_t remain_size = filter_param_names.size() % num_threads;
-      VLOG(4) << "Start Load with multi-thread: " << num_threads
-              << " chund size: " << chunk_size;
-
-      std::vector<std::future<std::vector<phi::DenseTensor *>>> futures;
-
-      for (size_t i = 0; i < num_threads; ++i) {
-        size_t start_idx = i * chunk_size;
-        size_t end_idx = start_idx + chunk_size;
-
-        futures.push_back(
-            std::async(std::launch::async, process_params, start_idx, end_idx));
+        param_files.emplace_back(config_.model_dir() + "/" + param_name);
+        param_tensors.push_back(var->GetMutable<phi::DenseTensor>());
       }
-      if (remain_size > 0) {
-        futures.push_back(std::async(std::launch::async,
-                                     process_params,
-                                     filter_param_names.size() - remain_size,
-                                     filter_param_names.size()));
-      }
-
-      std::vector<phi::DenseTensor *> tensor_out;
-      for (auto &future : futures) {
-        auto local_tensor_out = future.get();
-        tensor_out.insert(
-            tensor_out.end(), local_tensor_out.begin(), local_tensor_out.end());
-      }
-
+      pir::LoadFunctions(param_files, param_tensors, false, place_);
     } else {
       pir::LoadCombineFunction(config_.params_file(),
                                filter_param_names,
@@ -1469,6 +1633,9 @@ bool AnalysisPredictor::PrepareExecutor() {
     framework::interpreter::ExecutionConfig execution_config;
     execution_config.create_local_scope = false;
     execution_config.used_for_inference = true;
+    execution_config.shape_plan_cache_capacity =
+        config_.shape_plan_cache_capacity();
+    execution_config.schedule_fetch_first = config_.streaming_fetch_enabled();
 
     auto input_names = GetInputNames();
 
@@ -1588,6 +1755,7 @@ bool AnalysisPredictor::Run(const std::vector<PaddleTensor> &inputs,
     LOG(ERROR) << "fail to set feed";
     return false;
   }
+  PadInputsToShapeBuckets(scope);
 #ifdef PADDLE_WITH_TENSORRT
   if (config_.tensorrt_engine_enabled()) {
     inference::tensorrt::TensorRTEngine::predictor_id_per_thread =
@@ -1667,6 +1835,7 @@ bool AnalysisPredictor::Run(const std::vector<paddle::Tensor> &inputs,
     LOG(ERROR) << "fail to set feed";
     return false;
   }
+  PadInputsToShapeBuckets(scope);
 #ifdef PADDLE_WITH_TENSORRT
   if (config_.tensorrt_engine_enabled()) {
     inference::tensorrt::TensorRTEngine::predictor_id_per_thread =
@@ -1721,6 +1890,7 @@ bool AnalysisPredictor::Run(const std::vector<paddle::Tensor> &inputs,
     infer_xpu_ctx->L3CacheAutotune();
   }
 #endif
+  EndRequestArena(scope);
   // get fetch variable
   if (!GetFetch(outputs, scope)) {
     LOG(ERROR) << "fail to get fetches";
@@ -1749,6 +1919,147 @@ bool AnalysisPredictor::Run(const std::vector<paddle::Tensor> &inputs,
   return true;
 }
 
+void AnalysisPredictor::PadInputsToShapeBuckets(framework::Scope *scope) {
+  const auto &buckets = config_.shape_buckets();
+  if (buckets.empty() || !phi::is_cpu_place(place_) || scope == nullptr) {
+    return;
+  }
+  if (!shape_bucket_inputs_ready_) {
+    for (auto &item : GetInputTensorShape()) {
+      for (size_t d = 1; d < item.second.size(); ++d) {
+        if (item.second[d] < 0) {
+          shape_bucket_inputs_.insert(item);
+          break;
+        }
+      }
+    }
+    shape_bucket_inputs_ready_ = true;
+  }
+
+  for (auto &item : shape_bucket_inputs_) {
+    auto *var = scope->FindVar(item.first);
+    if (var == nullptr || !var->IsType<phi::DenseTensor>()) continue;
+    auto *tensor = var->GetMutable<phi::DenseTensor>();
+    // Padding would break the sequence offsets of a LoD tensor.
+    if (!tensor->initialized() || !tensor->lod().empty() ||
+        tensor->numel() == 0) {
+      continue;
+    }
+    auto src_dims = tensor->dims();
+    auto dst_dims = src_dims;
+    bool pad = false;
+    int rank = std::min<int>(src_dims.size(), item.second.size());
+    for (int d = 1; d < rank; ++d) {
+      if (item.second[d] >= 0) continue;
+      auto it = std::lower_bound(buckets.begin(), buckets.end(), src_dims[d]);
+      if (it != buckets.end() && *it != src_dims[d]) {
+        dst_dims[d] = *it;
+        pad = true;
+      }
+    }
+    if (!pad) continue;
+
+    VLOG(4) << "Pad input " << item.first << " from " << src_dims << " to "
+            << dst_dims;
+    phi::DenseTensor padded;
+    padded.Resize(dst_dims);
+    size_t elem_size = phi::SizeOf(tensor->dtype());
+    auto *dst =
+        static_cast<char *>(padded.mutable_data(place_, tensor->dtype()));
+    std::memset(dst, 0, padded.numel() * elem_size);
+    const auto *src = static_cast<const char *>(tensor->data());
+    // copy the innermost rows one by one to their padded offsets
+    int last = src_dims.size() - 1;
+    size_t row_bytes = src_dims[last] * elem_size;
+    int64_t rows = tensor->numel() / src_dims[last];
+    std::vector<int64_t> dst_strides(src_dims.size(), 1);
+    for (int d = last - 1; d >= 0; --d) {
+      dst_strides[d] = dst_strides[d + 1] * dst_dims[d + 1];
+    }
+    for (int64_t r = 0; r < rows; ++r) {
+      int64_t offset = 0, rest = r;
+      for (int d = last - 1; d >= 0; --d) {
+        offset += (rest % src_dims[d]) * dst_strides[d];
+        rest /= src_dims[d];
+      }
+      std::memcpy(dst + offset * elem_size, src + r * row_bytes, row_bytes);
+    }
+    *tensor = padded;
+  }
+}
+
+void AnalysisPredictor::InitAsyncRun() {
+  int num = config_.async_run_num_threads();
+  VLOG(3) << "Init RunAsync with " << num << " predictors";
+  for (int i = 0; i < num; ++i) {
+    // TensorRT engines can not be shared by clones, the same as
+    // PredictorPool.
+    if (config_.tensorrt_engine_enabled()) {
+      async_predictors_.emplace_back(
+          CreatePaddlePredictor<AnalysisConfig, PaddleEngineKind::kAnalysis>(
+              config_));
+    } else {
+      async_predictors_.emplace_back(Clone(predictor_stream_));
+    }
+    async_idle_predictors_.push_back(
+        static_cast<AnalysisPredictor *>(async_predictors_.back().get()));
+  }
+  async_queue_ = framework::CreateMultiThreadedWorkQueue(
+      framework::WorkQueueOptions("RunAsync",
+                                  static_cast<size_t>(num),
+                                  /*allow_spinning*/ false,
+                                  /*track_task*/ false));
+}
+
+AnalysisPredictor *AnalysisPredictor::AcquireAsyncPredictor() {
+  std::unique_lock<std::mutex> lock(async_mutex_);
+  async_cv_.wait(lock, [this] { return !async_idle_predictors_.empty(); });
+  auto *predictor = async_idle_predictors_.back();
+  async_idle_predictors_.pop_back();
+  return predictor;
+}
+
+void AnalysisPredictor::ReleaseAsyncPredictor(AnalysisPredictor *predictor) {
+  {
+    std::lock_guard<std::mutex> lock(async_mutex_);
+    async_idle_predictors_.push_back(predictor);
+  }
+  async_cv_.notify_one();
+}
+
+void AnalysisPredictor::RunAsync(const std::vector<paddle::Tensor> &inputs,
+                                 paddle_infer::RunAsyncCallback callback) {
+  PADDLE_ENFORCE_EQ(
+      static_cast<bool>(callback),
+      true,
+      common::errors::InvalidArgument("The RunAsync callback is empty."));
+  std::call_once(async_run_init_flag_, [this] { InitAsyncRun(); });
+  async_queue_->AddTask([this, inputs, callback = std::move(callback)] {
+    std::vector<paddle::Tensor> outputs;
+    bool success = false;
+    auto *predictor = AcquireAsyncPredictor();
+    try {
+      std::vector<paddle::Tensor> fetches;
+      success = predictor->Run(inputs, &fetches);
+      // The fetched tensors share memory with the scope of the predictor,
+      // which is overwritten by its next run, so the call owns a copy.
+      outputs.reserve(fetches.size());
+      for (auto &fetch : fetches) {
+        if (!success) break;
+        auto out = fetch.copy_to(fetch.place(), /*blocking*/ true);
+        out.set_name(fetch.name());
+        outputs.emplace_back(std::move(out));
+      }
+    } catch (const std::exception &e) {
+      LOG(ERROR) << "RunAsync failed: " << e.what();
+      success = false;
+    }
+    ReleaseAsyncPredictor(predictor);
+    if (!success) outputs.clear();
+    callback(success, &outputs);
+  });
+}
+
 bool AnalysisPredictor::SetFeed(const std::vector<PaddleTensor> &inputs,
                                 framework::Scope *scope) {
   VLOG(3) << "Predictor::set_feed";
@@ -2603,6 +2914,7 @@ bool AnalysisPredictor::ZeroCopyRun(bool switch_stream) {
   }
 #endif
 
+  PadInputsToShapeBuckets(executor_->GetScope());
   if (config_.new_ir_enabled()) {
     auto *scope = sub_scope_ ? sub_scope_ : scope_.get();
     if (scope != nullptr) {
@@ -2643,6 +2955,7 @@ bool AnalysisPredictor::ZeroCopyRun(bool switch_stream) {
     executor_->Run();
   }
   inference::DisplayMemoryInfo(place_, "after run");
+  EndRequestArena(executor_->GetScope());
 
 #ifdef PADDLE_WITH_XPU
   if (config_.use_xpu_ && infer_xpu_ctx != nullptr &&
@@ -2959,6 +3272,93 @@ bool AnalysisPredictor::LoadProgramDesc() {
   return true;
 }
 
+std::vector<std::string> AnalysisPredictor::GetPersistableNames() const {
+  std::vector<std::string> names;
+  if (load_pir_model_) {
+    for (auto &op : *pir_program_->block()) {
+      if (op.isa<::pir::ParameterOp>()) {
+        names.push_back(op.attribute<pir::StrAttribute>("parameter_name")
+                            .AsString());
+      } else if (op.isa<::pir::ConstantTensorOp>()) {
+        names.push_back(op.dyn_cast<::pir::ConstantTensorOp>().tensor_name());
+      }
+    }
+  } else {
+    for (auto *var : inference_program_->Block(0).AllVars()) {
+      if (IsPersistable(var)) {
+        names.push_back(var->Name());
+      }
+    }
+  }
+  return names;
+}
+
+std::unordered_set<std::string> AnalysisPredictor::GetWrittenPersistableNames()
+    const {
+  std::unordered_set<std::string> names;
+  if (load_pir_model_) {
+    auto persistable_name = [](pir::Value value) -> std::string {
+      auto *op = value ? value.defining_op() : nullptr;
+      if (op == nullptr) return "";
+      if (op->isa<::pir::ParameterOp>()) {
+        return op->attribute<pir::StrAttribute>("parameter_name").AsString();
+      }
+      if (op->isa<::pir::ConstantTensorOp>()) {
+        return op->dyn_cast<::pir::ConstantTensorOp>().tensor_name();
+      }
+      return "";
+    };
+    pir_program_->block()->Walk([&](pir::Operation *op) {
+      if (op->isa<::pir::ShadowOutputOp>()) {
+        names.insert(
+            op->attribute<pir::StrAttribute>("output_name").AsString());
+      } else if (op->isa<::pir::SetParameterOp>()) {
+        names.insert(
+            op->attribute<pir::StrAttribute>("parameter_name").AsString());
+      } else if (op->HasAttribute("is_inplace") &&
+                 op->attribute<pir::BoolAttribute>("is_inplace").data()) {
+        // any input of an inplace op may be written
+        for (uint32_t i = 0; i < op->num_operands(); ++i) {
+          auto name = persistable_name(op->operand_source(i));
+          if (!name.empty()) names.insert(name);
+        }
+      }
+    });
+  } else {
+    for (size_t i = 0; i < inference_program_->Size(); ++i) {
+      for (auto *op : inference_program_->Block(i).AllOps()) {
+        for (auto &name : op->OutputArgumentNames()) {
+          names.insert(name);
+        }
+      }
+    }
+  }
+  return names;
+}
+
+void AnalysisPredictor::ShareWeights() {
+  std::vector<std::string> names = GetPersistableNames();
+  // Persistables written at run time, e.g. caches, stay private.
+  auto written = GetWrittenPersistableNames();
+
+  auto &registry = SharedWeightRegistry::Instance();
+  auto *scope = sub_scope_ ? sub_scope_ : scope_.get();
+  size_t shared_num = 0, shared_bytes = 0;
+  for (auto &name : names) {
+    if (written.count(name)) continue;
+    auto *var = scope->FindVar(name);
+    if (var == nullptr || !var->IsType<phi::DenseTensor>()) continue;
+    auto *tensor = var->GetMutable<phi::DenseTensor>();
+    if (registry.Share(tensor, this)) {
+      shared_num++;
+      shared_bytes += tensor->numel() * phi::SizeOf(tensor->dtype());
+    }
+  }
+  LOG(INFO) << "Share " << shared_num << " of " << names.size()
+            << " parameters with other predictors, saving "
+            << shared_bytes / 1024 / 1024 << " MB";
+}
+
 bool AnalysisPredictor::LoadParameters() {
   PADDLE_ENFORCE_NOT_NULL(inference_program_.get(),
                           common::errors::PreconditionNotMet(
@@ -2972,6 +3372,9 @@ bool AnalysisPredictor::LoadParameters() {
       new framework::ProgramDesc());
   framework::BlockDesc *load_block = load_program->MutableBlock(0);
   std::vector<std::string> params;
+  // Separate dense tensor files are loaded in parallel outside the program.
+  std::vector<std::string> param_files;
+  std::vector<phi::DenseTensor *> param_tensors;
 
   for (auto *var : global_block->AllVars()) {
     if (IsPersistable(var)) {
@@ -2986,6 +3389,10 @@ bool AnalysisPredictor::LoadParameters() {
 
       if (!config_.params_file().empty()) {
         params.push_back(new_var->Name());
+      } else if (var->GetType() == framework::proto::VarType::DENSE_TENSOR) {
+        param_files.emplace_back(config_.model_dir() + "/" + var->Name());
+        param_tensors.push_back(
+            scope_->Var(var->Name())->GetMutable<phi::DenseTensor>());
       } else {
         // append_op
         framework::OpDesc *op = load_block->AppendOp();
@@ -3012,12 +3419,16 @@ bool AnalysisPredictor::LoadParameters() {
   framework::NaiveExecutor e(place_);
   e.Prepare(scope_.get(), *load_program, 0);
   e.Run();
+  pir::LoadFunctions(param_files, param_tensors, false, place_);
   VLOG(3) << "get " << scope_->LocalVarNames().size() << " vars after load";
 
   return true;
 }
 
 uint64_t AnalysisPredictor::TryShrinkMemory() {
+  if (request_arena_) {
+    request_arena_->Release(place_);
+  }
 #if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
   if (config_.use_gpu()) {
     paddle::platform::EmptyCache();
@@ -3107,6 +3518,10 @@ bool AnalysisPredictor::SaveTrtCalibToDisk() {
 #endif
 
 AnalysisPredictor::~AnalysisPredictor() {  // NOLINT
+  // Finish the pending RunAsync calls before tearing down the scope.
+  async_queue_.reset();
+  async_predictors_.clear();
+
 #ifdef PADDLE_WITH_TENSORRT
   if (config_.tensorrt_engine_enabled() &&
       config_.tensorrt_precision_mode_ == AnalysisConfig::Precision::kInt8 &&
@@ -3289,6 +3704,67 @@ void AnalysisPredictor::RegisterInputHook(const InputTensorHookFunc &hookfunc) {
   }
 }
 
+void AnalysisPredictor::RegisterFetchCallback(
+    const FetchCallbackFunc &callback) {
+  if (!config_.new_ir_enabled()) {
+    LOG(WARNING) << "RegisterFetchCallback only supports PIR programs, the "
+                    "callback is ignored.";
+    return;
+  }
+  std::call_once(register_fetch_callback_flag_, [this] {
+    // replace_fetch_with_shadow_output_pass turns the fetch ops into
+    // shadow_output ops, which do not run, so the callbacks are keyed on
+    // the producers of the fetched values. A fetch op left in the program
+    // runs and is handled as well.
+    std::set<std::string> fetch_names;
+    for (auto &item : idx2fetches_) {
+      fetch_names.insert(item.second);
+    }
+    std::unordered_map<::pir::Value, std::string> fetch_values;
+    for (auto &op : *pir_program_->block()) {
+      if (!op.isa<::pir::ShadowOutputOp>()) continue;
+      auto name = op.attribute<pir::StrAttribute>("output_name").AsString();
+      if (fetch_names.count(name)) {
+        fetch_values[op.operand_source(0)] = name;
+      }
+    }
+    executor_->RegisterOutputHook(
+        [this, fetch_values](framework::InstructionBase *instr,
+                             framework::ValueExecutionInfo *value_exe_info,
+                             framework::Scope *scope) {
+          auto *op = instr->Operation();
+          std::vector<std::pair<std::string, ::pir::Value>> fetches;
+          if (instr->Name() == "pd_op.fetch") {
+            fetches.emplace_back(
+                op->attribute<pir::StrAttribute>("name").AsString(),
+                op->result(0));
+          } else {
+            for (auto &output : instr->Outputs()) {
+              auto it = fetch_values.find(output.first);
+              if (it != fetch_values.end()) {
+                fetches.emplace_back(it->second, output.first);
+              }
+            }
+          }
+          for (auto &fetch : fetches) {
+            auto *var =
+                scope->FindVar(value_exe_info->GetVarName(fetch.second));
+            if (!var || !var->IsType<phi::DenseTensor>()) continue;
+            auto dense_tensor = var->Get<phi::DenseTensor>();
+            if (!dense_tensor.initialized()) continue;
+            // The output must be complete before it leaves the run.
+            instr->DeviceContext().Wait();
+            auto tensor = paddle::Tensor(
+                std::make_shared<phi::DenseTensor>(dense_tensor), fetch.first);
+            for (auto &callback : this->fetch_callbacks_) {
+              callback(fetch.first, tensor);
+            }
+          }
+        });
+  });
+  fetch_callbacks_.push_back(callback);
+}
+
 template <>
 std::unique_ptr<PaddlePredictor> CreatePaddlePredictor<AnalysisConfig>(
     const AnalysisConfig &config) {
@@ -3576,6 +4052,36 @@ bool Predictor::Run(const std::vector<paddle::Tensor> &inputs,
   return predictor_->Run(inputs, outputs);
 }
 
+void Predictor::RunAsync(const std::vector<paddle::Tensor> &inputs,
+                         RunAsyncCallback callback) {
+  auto *analysis_pred =
+      dynamic_cast<paddle::AnalysisPredictor *>(predictor_.get());
+  if (analysis_pred != nullptr) {
+    analysis_pred->RunAsync(inputs, std::move(callback));
+    return;
+  }
+  // Other engines have no worker pool, run in the calling thread.
+  std::vector<paddle::Tensor> outputs;
+  bool success = predictor_->Run(inputs, &outputs);
+  callback(success, &outputs);
+}
+
+std::future<std::vector<paddle::Tensor>> Predictor::RunAsync(
+    const std::vector<paddle::Tensor> &inputs) {
+  auto promise = std::make_shared<std::promise<std::vector<paddle::Tensor>>>();
+  auto future = promise->get_future();
+  RunAsync(inputs,
+           [promise](bool success, std::vector<paddle::Tensor> *outputs) {
+             if (success) {
+               promise->set_value(std::move(*outputs));
+             } else {
+               promise->set_exception(std::make_exception_ptr(
+                   std::runtime_error("Predictor::RunAsync failed.")));
+             }
+           });
+  return future;
+}
+
 std::unique_ptr<Predictor> Predictor::Clone(void *stream) {
   auto analysis_pred = predictor_->Clone(stream);
   std::unique_ptr<Predictor> pred(new Predictor(std::move(analysis_pred)));
@@ -3594,6 +4100,9 @@ void Predictor::RegisterOutputHook(const OutputTensorHookFunc &hookfunc) {
 void Predictor::RegisterInputHook(const InputTensorHookFunc &hookfunc) {
   predictor_->RegisterInputHook(hookfunc);
 }
+void Predictor::RegisterFetchCallback(const FetchCallbackFunc &callback) {
+  predictor_->RegisterFetchCallback(callback);
+}
 
 void *Predictor::GetExecStream() const { return predictor_->GetExecStream(); }
 
@@ -3607,6 +4116,16 @@ int GetNumBytesOfDataType(DataType dtype) {
       return sizeof(int32_t);
     case DataType::UINT8:
       return sizeof(uint8_t);
+    case DataType::INT8:
+      return sizeof(int8_t);
+    case DataType::FLOAT16:
+      return sizeof(phi::dtype::float16);
+    case DataType::BOOL:
+      return sizeof(bool);
+    case DataType::FLOAT64:
+      return sizeof(double);
+    case DataType::BFLOAT16:
+      return sizeof(phi::dtype::bfloat16);
     default:
       assert(false);
       return -1;
@@ -3754,6 +4273,21 @@ void InternalUtils::DisableTensorRtHalfOps(
 #endif
 }
 
+std::map<std::string, const void *> InternalUtils::GetParameterData(
+    paddle_infer::Predictor *p) {
+  auto *pred = dynamic_cast<paddle::AnalysisPredictor *>(p->predictor_.get());
+  std::map<std::string, const void *> data;
+  auto *scope = pred->scope();
+  for (auto &name : scope->LocalVarNames()) {
+    auto *var = scope->FindLocalVar(name);
+    if (var->IsType<phi::DenseTensor>() &&
+        var->Get<phi::DenseTensor>().initialized()) {
+      data[name] = var->Get<phi::DenseTensor>().data();
+    }
+  }
+  return data;
+}
+
 void InternalUtils::SyncStream(paddle_infer::Predictor *p) {
 #if defined(PADDLE_WITH_CUDA) || defined(PADDLE_WITH_HIP)
   auto *pred = dynamic_cast<paddle::AnalysisPredictor *>(p->predictor_.get());
@@ -15,12 +15,16 @@
 #pragma once
 
 #include <algorithm>
+#include <condition_variable>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_set>
 #include <vector>
 
 #include "paddle/fluid/framework/naive_executor.h"
+#include "paddle/fluid/framework/new_executor/workqueue/workqueue.h"
 #include "paddle/fluid/framework/op_compatible_info.h"
 #include "paddle/fluid/inference/analysis/analyzer.h"
 #include "paddle/fluid/inference/api/api_impl.h"
@@ -30,6 +34,7 @@
 #include "paddle/fluid/inference/api/resource_manager.h"
 #include "paddle/phi/common/bfloat16.h"
 #include "paddle/phi/common/float16.h"
+#include "paddle/phi/core/memory/allocation/arena_allocator.h"
 #include "paddle/phi/core/platform/device/gpu/gpu_types.h"
 #include "paddle/utils/string/printf.h"
 
@@ -148,6 +153,16 @@ class AnalysisPredictor : public PaddlePredictor {
   bool Run(const std::vector<paddle::Tensor> &inputs,
            std::vector<paddle::Tensor> *outputs) override;
 
+  ///
+  /// \brief Run the prediction engine asynchronously on a worker pool built
+  /// from clones of this predictor on the first call.
+  ///
+  /// \param[in] inputs input tensors
+  /// \param[in] callback called with the outputs on the worker thread
+  ///
+  void RunAsync(const std::vector<paddle::Tensor> &inputs,
+                paddle_infer::RunAsyncCallback callback);
+
   ///
   /// \brief Get the input names
   ///
@@ -325,6 +340,12 @@ class AnalysisPredictor : public PaddlePredictor {
   /// \brief Same as RegisterOutputHook
   void RegisterInputHook(const InputTensorHookFunc &hookfunc) override;
 
+  ///
+  /// \brief Register a callback called with every fetch output of a run
+  /// once the fetch op has run, see Config::EnableStreamingFetch.
+  ///
+  void RegisterFetchCallback(const FetchCallbackFunc &callback) override;
+
   ///
   /// \brief Initialize onednn quantizer and execute onednn quantization pass
   ///
@@ -503,11 +524,49 @@ class AnalysisPredictor : public PaddlePredictor {
  private:
   void StatisticShapeRangeInfo();
   void HookCollectShapeRangeInfo();
+  ///
+  /// \brief Pad the dynamic dims of the inputs up to the shape buckets of
+  /// the config, see AnalysisConfig::EnableShapeBucketPlanCache.
+  ///
+  void PadInputsToShapeBuckets(framework::Scope *scope);
+  ///
+  /// \brief The names of the parameters and constant tensors of the program.
+  ///
+  std::vector<std::string> GetPersistableNames() const;
+  ///
+  /// \brief The names of the persistables the ops of the program write.
+  ///
+  std::unordered_set<std::string> GetWrittenPersistableNames() const;
+  ///
+  /// \brief Replace the parameters equal to ones of other predictors by the
+  /// shared copy, see AnalysisConfig::EnableSharedWeights.
+  ///
+  void ShareWeights();
+  ///
+  /// \brief Create the arena of AnalysisConfig::EnableRequestArena and the
+  /// private device context allocating from it.
+  ///
+  void InitRequestArena();
+  ///
+  /// \brief Move the outputs and the persistable tensors written by the run
+  /// out of the request arena, so that it can be reset, and let it size
+  /// itself for the next run.
+  ///
+  void EndRequestArena(framework::Scope *scope);
   void InitPlace();
   void InitDeviceContexts();
   void InitResourceManager(void *stream);
   std::string GetOptimizedModelPath();
+  // path of the optimized model files without the extension
+  std::string GetOptimizedModelPrefix();
+  // path of the optimized PIR program, the optimized program cache keeps it
+  // in the binary format under its own extension
+  std::string GetOptimizedPirProgramFile();
+  std::string GetOptimizedProgramCacheKey();
   void ClearExtraParams();
+  void InitAsyncRun();
+  AnalysisPredictor *AcquireAsyncPredictor();
+  void ReleaseAsyncPredictor(AnalysisPredictor *predictor);
 
  private:
   AnalysisConfig config_;
@@ -526,6 +585,11 @@ class AnalysisPredictor : public PaddlePredictor {
   // Sorted according to the idx.
   std::map<size_t, std::string> idx2feeds_;
   std::map<std::string, std::vector<int64_t>> feed_name2shapes_;
+  // program shapes of the inputs having a dynamic non-batch dim
+  std::map<std::string, std::vector<int64_t>> shape_bucket_inputs_;
+  bool shape_bucket_inputs_ready_{false};
+  // key of the optimized program cache, empty if it is not used
+  std::string optimized_program_cache_key_;
   std::vector<framework::OpDesc *> fetches_;
   std::vector<pir::Operation *> pir_fetches_;
   std::map<size_t, std::string> idx2fetches_;
@@ -549,6 +613,8 @@ class AnalysisPredictor : public PaddlePredictor {
   std::once_flag register_output_hook_flag_;
   std::vector<OutputTensorHookFunc> output_hookfuncs_;
   std::vector<InputTensorHookFunc> input_hookfuncs_;
+  std::once_flag register_fetch_callback_flag_;
+  std::vector<FetchCallbackFunc> fetch_callbacks_;
   // Some status here that help to determine the status inside the predictor.
   bool status_is_cloned_{false};
 
@@ -557,9 +623,21 @@ class AnalysisPredictor : public PaddlePredictor {
 
   bool private_context_{false};
   void *predictor_stream_{nullptr};
+  // Declared before device_contexts_, which allocate from it.
+  std::shared_ptr<memory::allocation::ArenaAllocator> request_arena_;
+  std::vector<std::string> request_arena_persistables_;
   std::map<phi::Place, std::shared_future<std::unique_ptr<phi::DeviceContext>>>
       device_contexts_;
 
+  // Resources of RunAsync, created by its first call. The queue is declared
+  // last so that its threads are joined before the predictors go away.
+  std::once_flag async_run_init_flag_;
+  std::vector<std::unique_ptr<PaddlePredictor>> async_predictors_;
+  std::vector<AnalysisPredictor *> async_idle_predictors_;
+  std::mutex async_mutex_;
+  std::condition_variable async_cv_;
+  std::unique_ptr<framework::WorkQueue> async_queue_;
+
   friend class paddle_infer::experimental::InternalUtils;
 };
 
@@ -0,0 +1,485 @@
+// Copyright (c) 2025 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/fluid/inference/api/paddle_batching_predictor.h"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+#include "glog/logging.h"
+#include "paddle/common/enforce.h"
+#include "paddle/phi/common/bfloat16.h"
+#include "paddle/phi/common/float16.h"
+
+namespace paddle_infer {
+namespace services {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+int64_t NumElements(const std::vector<int>& shape) {
+  int64_t res = 1;
+  for (int d : shape) res *= d;
+  return res;
+}
+
+template <typename T>
+void FillAs(char* data, int64_t num, float value) {
+  std::fill_n(reinterpret_cast<T*>(data), num, static_cast<T>(value));
+}
+
+void Fill(char* data, int64_t num, DataType dtype, float value) {
+  switch (dtype) {
+    case DataType::FLOAT32:
+      return FillAs<float>(data, num, value);
+    case DataType::INT64:
+      return FillAs<int64_t>(data, num, value);
+    case DataType::INT32:
+      return FillAs<int32_t>(data, num, value);
+    case DataType::UINT8:
+      return FillAs<uint8_t>(data, num, value);
+    case DataType::INT8:
+      return FillAs<int8_t>(data, num, value);
+    case DataType::FLOAT16:
+      return FillAs<phi::dtype::float16>(data, num, value);
+    case DataType::BOOL:
+      return FillAs<bool>(data, num, value);
+    case DataType::FLOAT64:
+      return FillAs<double>(data, num, value);
+    case DataType::BFLOAT16:
+      return FillAs<phi::dtype::bfloat16>(data, num, value);
+  }
+}
+
+void CopyFromHost(Tensor* tensor, const char* data, DataType dtype) {
+  switch (dtype) {
+    case DataType::FLOAT32:
+      return tensor->CopyFromCpu(reinterpret_cast<const float*>(data));
+    case DataType::INT64:
+      return tensor->CopyFromCpu(reinterpret_cast<const int64_t*>(data));
+    case DataType::INT32:
+      return tensor->CopyFromCpu(reinterpret_cast<const int32_t*>(data));
+    case DataType::UINT8:
+      return tensor->CopyFromCpu(reinterpret_cast<const uint8_t*>(data));
+    case DataType::INT8:
+      return tensor->CopyFromCpu(reinterpret_cast<const int8_t*>(data));
+    case DataType::FLOAT16:
+      return tensor->CopyFromCpu(
+          reinterpret_cast<const phi::dtype::float16*>(data));
+    case DataType::BOOL:
+      return tensor->CopyFromCpu(reinterpret_cast<const bool*>(data));
+    case DataType::FLOAT64:
+      return tensor->CopyFromCpu(reinterpret_cast<const double*>(data));
+    case DataType::BFLOAT16:
+      return tensor->CopyFromCpu(
+          reinterpret_cast<const phi::dtype::bfloat16*>(data));
+  }
+}
+
+void CopyToHost(const Tensor& tensor, char* data, DataType dtype) {
+  switch (dtype) {
+    case DataType::FLOAT32:
+      return tensor.CopyToCpu(reinterpret_cast<float*>(data));
+    case DataType::INT64:
+      return tensor.CopyToCpu(reinterpret_cast<int64_t*>(data));
+    case DataType::INT32:
+      return tensor.CopyToCpu(reinterpret_cast<int32_t*>(data));
+    case DataType::UINT8:
+      return tensor.CopyToCpu(reinterpret_cast<uint8_t*>(data));
+    case DataType::INT8:
+      return tensor.CopyToCpu(reinterpret_cast<int8_t*>(data));
+    case DataType::FLOAT16:
+      return tensor.CopyToCpu(reinterpret_cast<phi::dtype::float16*>(data));
+    case DataType::BOOL:
+      return tensor.CopyToCpu(reinterpret_cast<bool*>(data));
+    case DataType::FLOAT64:
+      return tensor.CopyToCpu(reinterpret_cast<double*>(data));
+    case DataType::BFLOAT16:
+      return tensor.CopyToCpu(reinterpret_cast<phi::dtype::bfloat16*>(data));
+  }
+}
+
+// Copies a tensor of src_shape into the leading corner of a tensor of
+// dst_shape, where dst_shape[i] >= src_shape[i] for every dim.
+void CopyPadded(const char* src,
+                const std::vector<int>& src_shape,
+                char* dst,
+                const std::vector<int>& dst_shape,
+                size_t elem_size,
+                size_t dim = 0) {
+  if (dim + 1 >= src_shape.size()) {
+    size_t len = (src_shape.empty() ? 1 : src_shape.back()) * elem_size;
+    std::memcpy(dst, src, len);
+    return;
+  }
+  size_t src_stride = elem_size, dst_stride = elem_size;
+  for (size_t i = dim + 1; i < src_shape.size(); i++) {
+    src_stride *= src_shape[i];
+    dst_stride *= dst_shape[i];
+  }
+  for (int i = 0; i < src_shape[dim]; i++) {
+    CopyPadded(src + i * src_stride,
+               src_shape,
+               dst + i * dst_stride,
+               dst_shape,
+               elem_size,
+               dim + 1);
+  }
+}
+
+}  // namespace
+
+struct BatchingPredictor::Impl {
+  struct Request {
+    BatchingTensorMap inputs;
+    int batch{0};
+    Clock::time_point enqueue_time;
+    std::promise<BatchingTensorMap> promise;
+  };
+  using RequestPtr = std::unique_ptr<Request>;
+
+  Impl(const Config& config, const BatchingConfig& batching_config)
+      : batching(batching_config),
+        pool(config, static_cast<size_t>(batching_config.num_workers)),
+        start_time(Clock::now()) {
+    for (int i = 0; i < batching.num_workers; i++) {
+      workers.emplace_back(&Impl::WorkerLoop, this, pool.Retrieve(i));
+    }
+  }
+
+  ~Impl() {
+    {
+      std::lock_guard<std::mutex> lock(mu);
+      stop = true;
+    }
+    cv.notify_all();
+    for (auto& worker : workers) worker.join();
+  }
+
+  bool Compatible(const Request& a, const Request& b) const {
+    if (a.inputs.size() != b.inputs.size()) return false;
+    for (auto& item : a.inputs) {
+      auto it = b.inputs.find(item.first);
+      if (it == b.inputs.end()) return false;
+      auto& x = item.second;
+      auto& y = it->second;
+      if (x.dtype != y.dtype || x.shape.size() != y.shape.size()) {
+        return false;
+      }
+      if (!batching.enable_padding &&
+          !std::equal(
+              x.shape.begin() + 1, x.shape.end(), y.shape.begin() + 1)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // Rows that would join a batch started by the queue front, capped at
+  // max_batch_size. Requires mu.
+  int ReadyRows() const {
+    const Request& front = *queue.front();
+    int rows = front.batch;
+    for (size_t i = 1; i < queue.size() && rows < batching.max_batch_size;
+         i++) {
+      if (rows + queue[i]->batch <= batching.max_batch_size &&
+          Compatible(front, *queue[i])) {
+        rows += queue[i]->batch;
+      }
+    }
+    return rows;
+  }
+
+  // Blocks until a batch is ready, returns an empty batch on shutdown.
+  std::vector<RequestPtr> NextBatch() {
+    std::unique_lock<std::mutex> lock(mu);
+    std::vector<RequestPtr> batch;
+    while (true) {
+      cv.wait(lock, [this] { return stop || !queue.empty(); });
+      if (queue.empty()) return batch;
+      // Wait for more rows until the oldest request has waited long enough.
+      // Other workers may take the front meanwhile, so re-read it each time.
+      while (!stop && !queue.empty() &&
+             ReadyRows() < batching.max_batch_size) {
+        auto deadline = queue.front()->enqueue_time +
+                        std::chrono::microseconds(batching.max_delay_us);
+        if (Clock::now() >= deadline) break;
+        cv.wait_until(lock, deadline);
+      }
+      if (!queue.empty()) break;
+    }
+    int rows = queue.front()->batch;
+    batch.push_back(std::move(queue.front()));
+    queue.pop_front();
+    for (auto it = queue.begin();
+         it != queue.end() && rows < batching.max_batch_size;) {
+      if (rows + (*it)->batch <= batching.max_batch_size &&
+          Compatible(*batch[0], **it)) {
+        rows += (*it)->batch;
+        batch.push_back(std::move(*it));
+        it = queue.erase(it);
+      } else {
+        ++it;
+      }
+    }
+    if (!queue.empty()) cv.notify_all();
+    return batch;
+  }
+
+  void WorkerLoop(Predictor* predictor) {
+    while (true) {
+      auto batch = NextBatch();
+      if (batch.empty()) return;
+      RunBatch(predictor, &batch);
+    }
+  }
+
+  void RunBatch(Predictor* predictor, std::vector<RequestPtr>* batch) {
+    auto run_start = Clock::now();
+    int rows = 0;
+    for (auto& req : *batch) rows += req->batch;
+    int64_t total_elems = 0, pad_elems = 0;
+    std::vector<BatchingTensorMap> results(batch->size());
+    std::exception_ptr error;
+    try {
+      for (auto& item : (*batch)[0]->inputs) {
+        const std::string& name = item.first;
+        DataType dtype = item.second.dtype;
+        size_t elem_size = GetNumBytesOfDataType(dtype);
+        std::vector<int> shape = item.second.shape;
+        shape[0] = rows;
+        for (auto& req : *batch) {
+          auto& x = req->inputs.at(name);
+          for (size_t d = 1; d < shape.size(); d++) {
+            shape[d] = std::max(shape[d], x.shape[d]);
+          }
+        }
+        int64_t row_elems = NumElements(shape) / std::max(rows, 1);
+        std::vector<char> merged(NumElements(shape) * elem_size);
+        char* dst = merged.data();
+        for (auto& req : *batch) {
+          auto& x = req->inputs.at(name);
+          int64_t x_elems = NumElements(x.shape);
+          std::vector<int> dst_shape(shape);
+          dst_shape[0] = x.shape[0];
+          if (x_elems == row_elems * x.shape[0]) {
+            std::memcpy(dst, x.data.data(), x.data.size());
+          } else {
+            auto pad = batching.pad_values.find(name);
+            Fill(dst,
+                 row_elems * x.shape[0],
+                 dtype,
+                 pad == batching.pad_values.end() ? 0.f : pad->second);
+            CopyPadded(x.data.data(), x.shape, dst, dst_shape, elem_size);
+            pad_elems += row_elems * x.shape[0] - x_elems;
+          }
+          dst += row_elems * x.shape[0] * elem_size;
+        }
+        total_elems += NumElements(shape);
+        auto input = predictor->GetInputHandle(name);
+        input->Reshape(shape);
+        CopyFromHost(input.get(), merged.data(), dtype);
+      }
+
+      if (!predictor->Run()) {
+        throw std::runtime_error("Predictor failed to run a merged batch.");
+      }
+
+      for (auto& name : predictor->GetOutputNames()) {
+        auto output = predictor->GetOutputHandle(name);
+        BatchingTensor merged;
+        merged.shape = output->shape();
+        merged.dtype = output->type();
+        size_t elem_size = GetNumBytesOfDataType(merged.dtype);
+        merged.data.resize(NumElements(merged.shape) * elem_size);
+        CopyToHost(*output, merged.data.data(), merged.dtype);
+        if (merged.shape.empty() || merged.shape[0] != rows) {
+          for (auto& res : results) res[name] = merged;
+          continue;
+        }
+        size_t row_bytes = merged.data.size() / std::max(rows, 1);
+        const char* src = merged.data.data();
+        for (size_t i = 0; i < batch->size(); i++) {
+          BatchingTensor& out = results[i][name];
+          out.shape = merged.shape;
+          out.shape[0] = (*batch)[i]->batch;
+          out.dtype = merged.dtype;
+          out.data.assign(src, src + row_bytes * out.shape[0]);
+          src += row_bytes * out.shape[0];
+        }
+      }
+    } catch (...) {
+      LOG(WARNING) << "Batching predictor failed to run a batch of "
+                   << batch->size() << " requests.";
+      error = std::current_exception();
+    }
+
+    // Update the stats before waking the callers, so that they observe
+    // their own requests in GetStats.
+    RecordStats(*batch, rows, total_elems, pad_elems, run_start);
+    for (size_t i = 0; i < batch->size(); i++) {
+      if (error) {
+        (*batch)[i]->promise.set_exception(error);
+      } else {
+        (*batch)[i]->promise.set_value(std::move(results[i]));
+      }
+    }
+  }
+
+  void RecordStats(const std::vector<RequestPtr>& batch,
+                   int rows,
+                   int64_t total_elems,
+                   int64_t pad_elems,
+                   Clock::time_point run_start) {
+    auto run_end = Clock::now();
+    std::lock_guard<std::mutex> lock(stats_mu);
+    stats.num_requests += batch.size();
+    stats.num_batches++;
+    total_rows += rows;
+    total_input_elems += total_elems;
+    total_pad_elems += pad_elems;
+    for (auto& req : batch) {
+      double queue_us = std::chrono::duration<double, std::micro>(
+                            run_start - req->enqueue_time)
+                            .count();
+      total_queue_us += queue_us;
+      stats.max_queue_latency_us =
+          std::max(stats.max_queue_latency_us, queue_us);
+    }
+    total_run_us +=
+        std::chrono::duration<double, std::micro>(run_end - run_start).count();
+    VLOG(4) << "Batching predictor ran " << batch.size() << " requests, "
+            << rows << " rows, " << pad_elems << " padding elements";
+  }
+
+  BatchingConfig batching;
+  PredictorPool pool;
+
+  std::mutex mu;
+  std::condition_variable cv;
+  std::deque<RequestPtr> queue;
+  bool stop{false};
+  std::vector<std::thread> workers;
+
+  mutable std::mutex stats_mu;
+  BatchingStats stats;
+  Clock::time_point start_time;
+  uint64_t total_rows{0};
+  uint64_t total_input_elems{0};
+  uint64_t total_pad_elems{0};
+  double total_queue_us{0};
+  double total_run_us{0};
+};
+
+BatchingPredictor::BatchingPredictor(const Config& config,
+                                     const BatchingConfig& batching) {
+  PADDLE_ENFORCE_GT(batching.max_batch_size,
+                    0,
+                    common::errors::InvalidArgument(
+                        "The max_batch_size of BatchingConfig should be "
+                        "greater than 0, but received %d.",
+                        batching.max_batch_size));
+  PADDLE_ENFORCE_GE(batching.max_delay_us,
+                    0,
+                    common::errors::InvalidArgument(
+                        "The max_delay_us of BatchingConfig should not be "
+                        "negative, but received %d.",
+                        batching.max_delay_us));
+  PADDLE_ENFORCE_GT(batching.num_workers,
+                    0,
+                    common::errors::InvalidArgument(
+                        "The num_workers of BatchingConfig should be "
+                        "greater than 0, but received %d.",
+                        batching.num_workers));
+  impl_ = std::make_unique<Impl>(config, batching);
+}
+
+BatchingPredictor::~BatchingPredictor() = default;
+
+std::future<BatchingTensorMap> BatchingPredictor::Submit(
+    BatchingTensorMap inputs) {
+  PADDLE_ENFORCE_EQ(
+      inputs.empty(),
+      false,
+      common::errors::InvalidArgument("A batching request has no inputs."));
+  auto req = std::make_unique<Impl::Request>();
+  req->batch = -1;
+  for (auto& item : inputs) {
+    auto& x = item.second;
+    PADDLE_ENFORCE_EQ(x.shape.empty(),
+                      false,
+                      common::errors::InvalidArgument(
+                          "Input %s of a batching request needs a batch dim.",
+                          item.first));
+    PADDLE_ENFORCE_EQ(
+        x.data.size(),
+        static_cast<size_t>(NumElements(x.shape) *
+                            GetNumBytesOfDataType(x.dtype)),
+        common::errors::InvalidArgument(
+            "The data size of input %s does not match its shape.",
+            item.first));
+    if (req->batch < 0) req->batch = x.shape[0];
+    PADDLE_ENFORCE_EQ(x.shape[0],
+                      req->batch,
+                      common::errors::InvalidArgument(
+                          "All inputs of a batching request should have the "
+                          "same batch dim, but input %s has %d instead of %d.",
+                          item.first,
+                          x.shape[0],
+                          req->batch));
+  }
+  req->inputs = std::move(inputs);
+  req->enqueue_time = Clock::now();
+  auto result = req->promise.get_future();
+  {
+    std::lock_guard<std::mutex> lock(impl_->mu);
+    impl_->queue.push_back(std::move(req));
+  }
+  impl_->cv.notify_all();
+  return result;
+}
+
+BatchingStats BatchingPredictor::GetStats() const {
+  std::lock_guard<std::mutex> lock(impl_->stats_mu);
+  BatchingStats res = impl_->stats;
+  if (res.num_batches > 0) {
+    res.avg_requests_per_batch = 1.0 * res.num_requests / res.num_batches;
+    res.avg_batch_size = 1.0 * impl_->total_rows / res.num_batches;
+    res.avg_run_latency_us = impl_->total_run_us / res.num_batches;
+  }
+  if (res.num_requests > 0) {
+    res.avg_queue_latency_us = impl_->total_queue_us / res.num_requests;
+  }
+  if (impl_->total_input_elems > 0) {
+    res.padding_ratio =
+        1.0 * impl_->total_pad_elems / impl_->total_input_elems;
+  }
+  double elapsed = std::chrono::duration<double>(Clock::now() -
+                                                 impl_->start_time)
+                       .count();
+  if (elapsed > 0) res.requests_per_second = res.num_requests / elapsed;
+  return res;
+}
+
+}  // namespace services
+}  // namespace paddle_infer
@@ -856,6 +856,28 @@ struct PD_INFER_DECL AnalysisConfig {
   ///
   void UseOptimizedModel(bool x = true) { use_optimized_model_ = x; }
 
+  ///
+  /// \brief Cache the optimized PIR program and its parameters in the
+  /// optimization cache directory, keyed by the model files, the config,
+  /// the passes and the Paddle version. A predictor whose key is cached
+  /// loads the optimized program and skips the IR passes, otherwise it runs
+  /// them and fills the cache.
+  ///
+  /// \param x Whether to use the optimized program cache.
+  ///
+  void EnableOptimizedProgramCache(bool x = true) {
+    use_optimized_program_cache_ = x;
+  }
+  ///
+  /// \brief A boolean state telling whether the optimized program cache is
+  /// used.
+  ///
+  /// \return bool Whether the optimized program cache is used.
+  ///
+  bool optimized_program_cache_enabled() const {
+    return use_optimized_program_cache_;
+  }
+
   ///
   /// \brief Control whether to debug IR graph analysis phase.
   /// This will generate DOT files for visualizing the computation graph after
@@ -910,6 +932,101 @@ struct PD_INFER_DECL AnalysisConfig {
     return cpu_math_library_num_threads_;
   }
 
+  ///
+  /// \brief Set the number of threads serving Predictor::RunAsync. Each
+  /// thread runs requests on its own clone of the predictor, so this is
+  /// also the number of requests computed concurrently.
+  ///
+  /// \param num_threads The number of async run threads.
+  ///
+  void SetAsyncRunNumThreads(int num_threads);
+  ///
+  /// \brief An int state telling how many threads serve RunAsync.
+  ///
+  /// \return int The number of async run threads.
+  ///
+  int async_run_num_threads() const { return async_run_num_threads_; }
+
+  ///
+  /// \brief Cache the output metas of every op per input shape, so that a
+  /// run whose input shapes are cached skips the shape inference of the
+  /// ops. Works with the new executor. On CPU each cached shape also keeps
+  /// one block of memory, sized at its first reuse, that holds the outputs
+  /// of the ops which are consumed within the run.
+  ///
+  /// \param capacity The max number of input shapes cached.
+  /// \param buckets Sorted ascending. If not empty, every dynamic dim
+  /// except the first (batch) dim of a CPU input is rounded up to the
+  /// smallest bucket not less than it by padding the input with zeros, so
+  /// that requests with close lengths share one plan. The model must ignore
+  /// the padding, and the outputs keep the padded shape.
+  ///
+  void EnableShapeBucketPlanCache(int capacity = 8,
+                                  const std::vector<int64_t>& buckets = {});
+  ///
+  /// \brief A boolean state telling whether the shape plan cache is enabled.
+  ///
+  /// \return bool Whether the shape plan cache is enabled.
+  ///
+  bool shape_plan_cache_enabled() const {
+    return shape_plan_cache_capacity_ > 0;
+  }
+  int shape_plan_cache_capacity() const { return shape_plan_cache_capacity_; }
+  const std::vector<int64_t>& shape_buckets() const { return shape_buckets_; }
+
+  ///
+  /// \brief Share the parameters with the other predictors of the process
+  /// holding equal ones, e.g. model variants with a common backbone. Each
+  /// parameter is compared by content once it is loaded and optimized, and
+  /// equal parameters are kept in memory only once. Only for CPU.
+  ///
+  /// \param x Whether to share the parameters.
+  ///
+  void EnableSharedWeights(bool x = true) { use_shared_weights_ = x; }
+  ///
+  /// \brief A boolean state telling whether the parameters are shared.
+  ///
+  /// \return bool Whether the parameters are shared.
+  ///
+  bool shared_weights_enabled() const { return use_shared_weights_; }
+
+  ///
+  /// \brief Allocate the intermediate tensors of ZeroCopyRun from an arena
+  /// owned by the predictor instead of the global allocator. The arena is
+  /// sized from the memory the first runs need and is reset after every
+  /// run, so steady-state runs do not call the global allocator and
+  /// concurrent predictors do not contend on it. The outputs and the
+  /// persistable tensors written by a run are copied out of the arena at its
+  /// end. TryShrinkMemory releases it. For CPU, and GPU with an external
+  /// stream.
+  ///
+  /// \param x Whether to use the request arena.
+  ///
+  void EnableRequestArena(bool x = true) { use_request_arena_ = x; }
+  ///
+  /// \brief A boolean state telling whether the request arena is used.
+  ///
+  /// \return bool Whether the request arena is used.
+  ///
+  bool request_arena_enabled() const { return use_request_arena_; }
+
+  ///
+  /// \brief Run every fetch op of the PIR program right after the op that
+  /// produces its input, so that the callbacks of
+  /// Predictor::RegisterFetchCallback receive each output while the rest of
+  /// the program is still running. Without it the callbacks are called in
+  /// the order of the fetch ops, usually at the end of the run.
+  ///
+  /// \param x Whether to stream the fetch outputs.
+  ///
+  void EnableStreamingFetch(bool x = true) { use_streaming_fetch_ = x; }
+  ///
+  /// \brief A boolean state telling whether fetch outputs are streamed.
+  ///
+  /// \return bool Whether fetch outputs are streamed.
+  ///
+  bool streaming_fetch_enabled() const { return use_streaming_fetch_; }
+
   ///
   /// \brief Transform the AnalysisConfig to NativeConfig.
   ///
@@ -1257,12 +1374,19 @@ struct PD_INFER_DECL AnalysisConfig {
   bool ir_debug_{false};
 
   bool use_optimized_model_{false};
+  bool use_optimized_program_cache_{false};
 
   bool use_new_executor_{false};
 
   bool specify_input_name_{false};
 
   int cpu_math_library_num_threads_{1};
+  int async_run_num_threads_{1};
+  int shape_plan_cache_capacity_{0};
+  std::vector<int64_t> shape_buckets_;
+  bool use_shared_weights_{false};
+  bool use_request_arena_{false};
+  bool use_streaming_fetch_{false};
 
   bool with_profile_{false};
 
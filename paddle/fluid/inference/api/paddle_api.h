@@ -39,6 +39,7 @@ namespace paddle {
 using PaddleDType = paddle_infer::DataType;
 using PaddlePlace = paddle_infer::PlaceType;
 using PaddleDataLayout = paddle_infer::DataLayout;
+using paddle_infer::FetchCallbackFunc;
 using paddle_infer::InputTensorHookFunc;
 using paddle_infer::OutputTensorHookFunc;
 
@@ -328,6 +329,10 @@ class PD_INFER_DECL PaddlePredictor {
   /// \brief Same as RegisterOutputHook
   virtual void RegisterInputHook(const InputTensorHookFunc& hookfunc) {}
 
+  /// \brief Register a callback called with every output of a run as soon
+  /// as it is computed, see Predictor::RegisterFetchCallback.
+  virtual void RegisterFetchCallback(const FetchCallbackFunc& callback) {}
+
   /// \brief Clone an existing predictor
   /// When using clone, the same network will be created,
   /// and the parameters between them are shared.
@@ -521,6 +526,11 @@ class PD_INFER_DECL InternalUtils {
   static void DisableTensorRtHalfOps(
       paddle_infer::Config* c, const std::unordered_set<std::string>& ops);
 
+  // The data pointers of the initialized tensors of the parameter scope of
+  // pred, by name.
+  static std::map<std::string, const void*> GetParameterData(
+      paddle_infer::Predictor* pred);
+
   static void SyncStream(paddle_infer::Predictor* pred);
   static void SyncStream(cudaStream_t stream);
   static void SyncStream(hipStream_t stream);
@@ -0,0 +1,127 @@
+// Copyright (c) 2025 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <future>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "paddle_inference_api.h"  // NOLINT
+
+///
+/// \file paddle_batching_predictor.h
+///
+/// \brief Dynamic request batching on top of Predictor.
+///
+/// \since 3.0.0
+///
+
+namespace paddle_infer {
+namespace services {
+
+///
+/// \brief A host tensor passed to or returned from a BatchingPredictor.
+/// The first dim of shape is the batch dim, data holds the elements in
+/// row-major order.
+///
+struct PD_INFER_DECL BatchingTensor {
+  std::vector<int> shape;
+  DataType dtype{DataType::FLOAT32};
+  std::vector<char> data;
+};
+
+using BatchingTensorMap = std::map<std::string, BatchingTensor>;
+
+struct PD_INFER_DECL BatchingConfig {
+  /// Max number of rows (sum of the batch dims of the requests) of a merged
+  /// batch. A request larger than this runs alone.
+  int max_batch_size{16};
+  /// Max time in microseconds the oldest queued request waits for more
+  /// requests before its batch is run anyway.
+  int64_t max_delay_us{2000};
+  /// Number of predictors running batches concurrently.
+  int num_workers{1};
+  /// If true, requests whose inputs differ in the non-batch dims are still
+  /// merged: every input is padded to the largest shape of the batch with
+  /// the value from pad_values (0 if the input is not listed). Outputs are
+  /// returned with the padded shape, the caller crops them.
+  bool enable_padding{false};
+  std::map<std::string, float> pad_values;
+};
+
+struct PD_INFER_DECL BatchingStats {
+  uint64_t num_requests{0};
+  uint64_t num_batches{0};
+  /// Mean number of requests and rows per run.
+  double avg_requests_per_batch{0};
+  double avg_batch_size{0};
+  /// Share of the merged input elements that are padding.
+  double padding_ratio{0};
+  /// Time from Submit to the start of the run, and of the run itself.
+  double avg_queue_latency_us{0};
+  double max_queue_latency_us{0};
+  double avg_run_latency_us{0};
+  /// Completed requests per second since the predictor was created.
+  double requests_per_second{0};
+};
+
+///
+/// \class BatchingPredictor
+///
+/// \brief Queues requests with small batches, merges them along the batch
+/// dim and runs them together on a pool of predictors. Every request gets
+/// its own rows of each output through the returned future.
+///
+/// \code{cpp}
+///   services::BatchingConfig batching;
+///   batching.max_batch_size = 32;
+///   batching.max_delay_us = 1000;
+///   services::BatchingPredictor predictor(config, batching);
+///   auto result = predictor.Submit(inputs);
+///   auto outputs = result.get();
+/// \endcode
+///
+/// Outputs whose first dim is not the merged batch size are not split, each
+/// request receives a full copy of them. Submit is thread safe.
+///
+class PD_INFER_DECL BatchingPredictor {
+ public:
+  BatchingPredictor(const Config& config, const BatchingConfig& batching);
+  BatchingPredictor(const BatchingPredictor&) = delete;
+  BatchingPredictor& operator=(const BatchingPredictor&) = delete;
+  /// Finishes the queued requests before returning.
+  ~BatchingPredictor();
+
+  ///
+  /// \brief Enqueue a request.
+  ///
+  /// \param[in] inputs The model inputs by name, all with the same batch dim.
+  /// \return The outputs by name. A failed run is reported as an exception
+  /// stored in the future.
+  ///
+  std::future<BatchingTensorMap> Submit(BatchingTensorMap inputs);
+
+  BatchingStats GetStats() const;
+
+ private:
+  struct Impl;
+  std::unique_ptr<Impl> impl_;
+};
+
+}  // namespace services
+}  // namespace paddle_infer
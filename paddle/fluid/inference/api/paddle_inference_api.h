@@ -22,6 +22,7 @@ limitations under the License. */
 #pragma once
 
 #include <cassert>
+#include <future>
 #include <map>
 #include <memory>
 #include <string>
@@ -139,6 +140,27 @@ class PD_INFER_DECL Predictor {
   bool Run(const std::vector<paddle::Tensor>& inputs,
            std::vector<paddle::Tensor>* outputs);
 
+  ///
+  /// \brief Run the prediction engine on an internal worker thread and
+  /// return immediately. Requests are computed on
+  /// Config::async_run_num_threads() clones of this predictor, so a caller
+  /// may keep many of them in flight. The inputs are shared with the call
+  /// and must not be modified until the callback is invoked.
+  ///
+  /// \param[in] inputs An list of Tensor as the input to the network.
+  /// \param[in] callback Invoked on the worker thread when the run is done.
+  ///
+  void RunAsync(const std::vector<paddle::Tensor>& inputs,
+                RunAsyncCallback callback);
+
+  ///
+  /// \brief The same as RunAsync with a callback, but returns the outputs
+  /// through a future. A failed run is reported as an exception stored in
+  /// the future.
+  ///
+  std::future<std::vector<paddle::Tensor>> RunAsync(
+      const std::vector<paddle::Tensor>& inputs);
+
   ///
   /// \brief Get the output names
   ///
@@ -202,6 +224,17 @@ class PD_INFER_DECL Predictor {
   /// The same as RegisterOutputHook.
   void RegisterInputHook(const InputTensorHookFunc& hookfunc);
 
+  ///
+  /// \brief Register a callback called with the name and the value of every
+  /// output of a run, on the thread of the run, once the output has been
+  /// computed. With Config::EnableStreamingFetch this happens right after
+  /// the op producing the output, so that post-processing of an early
+  /// output can overlap with the rest of the run; long work should be
+  /// handed off to another thread since the run waits for the callback.
+  /// The tensor is valid until the next run. Only for PIR programs.
+  ///
+  void RegisterFetchCallback(const FetchCallbackFunc& callback);
+
   ///
   /// \brief Get the execution stream on devices with a concept of stream,
   /// otherwise returns nullptr.
@@ -40,6 +40,17 @@ using OutputTensorHookFunc = std::function<void(
     const std::string&, const std::string&, const paddle::Tensor&)>;
 using InputTensorHookFunc = OutputTensorHookFunc;
 
+/// \brief Completion callback of Predictor::RunAsync. The first argument
+/// tells whether the run succeeded, the outputs belong to the call and may
+/// be moved out by the callback.
+using RunAsyncCallback =
+    std::function<void(bool, std::vector<paddle::Tensor>*)>;
+
+/// \brief Callback of Predictor::RegisterFetchCallback, called with the
+/// name and the value of an output as soon as it is computed.
+using FetchCallbackFunc =
+    std::function<void(const std::string&, const paddle::Tensor&)>;
+
 typedef void (*CallbackFunc)(void*);
 
 #if defined(PADDLE_WITH_TESTING) && defined(PADDLE_WITH_INFERENCE_API_TEST)
@@ -0,0 +1,122 @@
+// Copyright (c) 2025 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/fluid/inference/api/weight_registry.h"
+
+#include <cstring>
+
+#include "glog/logging.h"
+
+namespace paddle {
+
+namespace {
+
+inline uint64_t Mix(uint64_t h) {
+  h ^= h >> 33;
+  h *= 0xff51afd7ed558ccdULL;
+  h ^= h >> 33;
+  h *= 0xc4ceb9fe1a85ec53ULL;
+  h ^= h >> 33;
+  return h;
+}
+
+}  // namespace
+
+SharedWeightRegistry& SharedWeightRegistry::Instance() {
+  static SharedWeightRegistry* registry = new SharedWeightRegistry;
+  return *registry;
+}
+
+uint64_t SharedWeightRegistry::Hash(const phi::DenseTensor& tensor) {
+  uint64_t h = Mix(static_cast<uint64_t>(tensor.dtype()) + 1);
+  for (int i = 0; i < tensor.dims().size(); ++i) {
+    h = Mix(h ^ static_cast<uint64_t>(tensor.dims()[i]));
+  }
+  // four independent lanes over 8-byte words keep the multiplies pipelined
+  const auto* data = static_cast<const char*>(tensor.data());
+  size_t bytes = tensor.numel() * phi::SizeOf(tensor.dtype());
+  uint64_t lanes[4] = {h, h + 1, h + 2, h + 3};
+  size_t i = 0;
+  for (; i + 32 <= bytes; i += 32) {
+    for (int k = 0; k < 4; ++k) {
+      uint64_t word;
+      std::memcpy(&word, data + i + k * 8, 8);
+      lanes[k] = (lanes[k] ^ word) * 0x9e3779b97f4a7c15ULL;
+      lanes[k] ^= lanes[k] >> 29;
+    }
+  }
+  for (; i < bytes; ++i) {
+    lanes[0] = (lanes[0] ^ static_cast<uint8_t>(data[i])) * 0x100000001b3ULL;
+  }
+  return Mix(lanes[0] ^ Mix(lanes[1]) ^ Mix(lanes[2] + lanes[3]) ^ bytes);
+}
+
+void SharedWeightRegistry::RemoveExpired() {
+  for (auto it = weights_.begin(); it != weights_.end();) {
+    if (it->second.holder.expired()) {
+      it = weights_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+bool SharedWeightRegistry::Share(phi::DenseTensor* tensor,
+                                 const void* owner) {
+  if (!tensor->initialized() || !phi::is_cpu_place(tensor->place()) ||
+      tensor->numel() == 0 || tensor->meta().offset != 0) {
+    return false;
+  }
+  size_t bytes = tensor->numel() * phi::SizeOf(tensor->dtype());
+  uint64_t key = Hash(*tensor);
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto range = weights_.equal_range(key);
+  for (auto it = range.first; it != range.second;) {
+    auto holder = it->second.holder.lock();
+    if (!holder) {
+      it = weights_.erase(it);
+      continue;
+    }
+    const auto& meta = it->second.meta;
+    if (holder != tensor->Holder() && it->second.owner != owner &&
+        meta.dtype == tensor->dtype() && meta.layout == tensor->layout() &&
+        meta.dims == tensor->dims() && it->second.bytes == bytes &&
+        std::memcmp(holder->ptr(), tensor->data(), bytes) == 0) {
+      tensor->ResetHolder(holder);
+      saved_bytes_ += bytes;
+      return true;
+    }
+    if (holder == tensor->Holder()) {
+      return false;
+    }
+    ++it;
+  }
+  weights_.emplace(key, Entry{tensor->Holder(), tensor->meta(), bytes, owner});
+  return false;
+}
+
+SharedWeightStat SharedWeightRegistry::GetStat() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  RemoveExpired();
+  SharedWeightStat stat;
+  stat.num_weights = weights_.size();
+  for (auto& item : weights_) {
+    stat.weight_bytes += item.second.bytes;
+  }
+  stat.saved_bytes = saved_bytes_;
+  return stat;
+}
+
+}  // namespace paddle
@@ -0,0 +1,76 @@
+// Copyright (c) 2025 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include "paddle/common/macros.h"
+#include "paddle/phi/core/dense_tensor.h"
+#include "paddle/utils/test_macros.h"
+
+namespace paddle {
+
+struct SharedWeightStat {
+  // distinct tensors alive in the registry and their bytes
+  size_t num_weights{0};
+  size_t weight_bytes{0};
+  // bytes not allocated because an equal tensor was already registered
+  size_t saved_bytes{0};
+};
+
+// A process-wide, content addressed registry of the parameters of the
+// predictors. Predictors loading equal parameters, e.g. model variants
+// sharing an embedding or a backbone, keep one copy of them.
+//
+// Tensors are matched by dtype, dims and a hash of their data, and compared
+// byte by byte before being shared. Only tensors of different owners are
+// shared, equal tensors of one predictor keep their own memory. The registry
+// only holds weak references, a weight is released when the last predictor
+// using it is destroyed. Shared weights must be treated as read only, tensors
+// written at run time must not be passed to Share.
+class SharedWeightRegistry {
+ public:
+  SharedWeightRegistry() = default;
+  TEST_API static SharedWeightRegistry& Instance();
+
+  // If a tensor equal to *tensor is registered by another owner, makes
+  // *tensor share its memory and returns true. Otherwise registers *tensor
+  // for owner and returns false. Only initialized CPU tensors are handled.
+  TEST_API bool Share(phi::DenseTensor* tensor, const void* owner);
+
+  TEST_API SharedWeightStat GetStat();
+
+ private:
+  struct Entry {
+    std::weak_ptr<phi::Allocation> holder;
+    phi::DenseTensorMeta meta;
+    size_t bytes;
+    const void* owner;
+  };
+
+  static uint64_t Hash(const phi::DenseTensor& tensor);
+  void RemoveExpired();
+
+  std::mutex mutex_;
+  std::unordered_multimap<uint64_t, Entry> weights_;
+  size_t saved_bytes_{0};
+
+  DISABLE_COPY_AND_ASSIGN(SharedWeightRegistry);
+};
+
+}  // namespace paddle
@@ -0,0 +1,75 @@
+// Copyright (c) 2025 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "paddle/fluid/pir/serialize_deserialize/include/third_party.h"
+
+namespace pir {
+/**
+ * Binary container of a serialized program, written by WriteModule with
+ * binary = true and detected by ReadModule from its magic.
+ *
+ * The content is the json of ProgramWriter with three changes:
+ *  - every value type (TYPE_TYPE) is replaced by its index in a table of the
+ *    distinct types,
+ *  - every op attribute ({NAME, ATTR_TYPE} in ATTRS and OPRESULTS_ATTRS) is
+ *    replaced by its index in a table of the distinct attributes,
+ *  - every region is replaced by the index of a separately encoded chunk.
+ *
+ * Layout:
+ *   "PIRB" | uint32 format version | uint64 header size | header | chunks
+ * The header and each region chunk are MessagePack. The header holds the
+ * base code, the program json, the type and attribute tables and the
+ * [offset, size] of every chunk, relative to the end of the header. Regions
+ * are only decoded when the reader reaches the op that owns them, so the
+ * json of the whole program is never held at once.
+ *
+ * The tables keep the json form of types and attributes, so that patches
+ * of the version compat mechanism apply to them unchanged.
+ */
+class BinaryModule {
+ public:
+  static bool IsBinary(const std::string& file_path);
+
+  // Encodes the base code and the program json of WriteModule. The program
+  // json is modified in place.
+  static std::string Encode(const Json& base_code, Json* program);
+
+  explicit BinaryModule(const std::string& file_path);
+
+  BinaryModule(const BinaryModule&) = delete;
+  BinaryModule& operator=(const BinaryModule&) = delete;
+
+  Json* base_code() { return &header_.at("base_code"); }
+  Json* program() { return &header_.at("program"); }
+
+  size_t num_types() const { return header_.at("types").size(); }
+  size_t num_attrs() const { return header_.at("attrs").size(); }
+  const Json& type(int64_t index) const;
+  const Json& attr(int64_t index) const;
+
+  Json DecodeRegion(int64_t index) const;
+
+ private:
+  std::string content_;
+  size_t payload_offset_ = 0;
+  Json header_;
+};
+
+}  // namespace pir
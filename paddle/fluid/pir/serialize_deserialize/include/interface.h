@@ -32,6 +32,9 @@ namespace pir {
  * @param[in] trainable    (Optional parameter, default to true) If true,
  * operation has opresult_attrs for training like stop_gradient,persistable;
  * Otherwise, it may only has opinfo attrs.
+ * @param[in] binary       (Optional parameter, default to false) If true, the
+ * program is written in the binary format of BinaryModule, which is smaller
+ * and faster to read than json. ReadModule detects the format by itself.
  *
  * @return void。
  *
@@ -43,7 +46,8 @@ void IR_API WriteModule(const pir::Program& program,
                         uint64_t pir_version,
                         bool overwrite,
                         bool readable = false,
-                        bool trainable = true);
+                        bool trainable = true,
+                        bool binary = false);
 
 /**
  * @brief Gets a PIR program from the specified file path.
@@ -101,6 +105,8 @@ void IR_API SaveFunction(const phi::DenseTensor& x,
  * @param[in] save_to_memory    If the flag is true, the tensor will be saved in
  * memory.
  *
+ * The data of every tensor starts at a 64-byte aligned file offset.
+ *
  * @return void。
  *
  */
@@ -132,6 +138,24 @@ void IR_API LoadFunction(const std::string& file_path,
                          phi::DenseTensor* out,
                          phi::Place place = phi::Place());
 
+/**
+ * @brief Load tensors from separate files, each with LoadFunction.
+ *
+ * @param[in] file_paths        The file of each tensor.
+ * @param[out] out              The tensors to be loaded, one per file.
+ * @param[in] load_as_fp16      If the flag is true, the tensors will be loaded
+ * as fp16 type.
+ *
+ * The files are loaded by up to FLAGS_load_params_thread_num threads.
+ *
+ * @return void。
+ *
+ */
+void IR_API LoadFunctions(const std::vector<std::string>& file_paths,
+                          const std::vector<phi::DenseTensor*>& out,
+                          bool load_as_fp16,
+                          phi::Place place = phi::Place());
+
 /**
  * @brief Save the given tensor into a single file at the specified file path
  * with its name.
@@ -142,6 +166,12 @@ void IR_API LoadFunction(const std::string& file_path,
  * @param[in] load_as_fp16      If the flag is true, the tensor will be loaded
  * as fp16 type.
  *
+ * With FLAGS_load_combine_params_by_mmap the file is mapped instead of read,
+ * and CPU tensors with aligned data share the mapped pages. Otherwise, when
+ * the tensors need a cast or a copy to a device, the file is read on the
+ * calling thread while up to FLAGS_load_params_thread_num threads convert the
+ * tensors already read.
+ *
  * @return void。
  *
  */
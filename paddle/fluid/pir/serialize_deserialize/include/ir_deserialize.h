@@ -14,7 +14,10 @@
 #pragma once
 
 #include <fstream>
+#include <utility>
+#include <vector>
 #include "paddle/common/enforce.h"
+#include "paddle/fluid/pir/serialize_deserialize/include/binary_module.h"
 #include "paddle/fluid/pir/serialize_deserialize/include/schema.h"
 #include "paddle/fluid/pir/serialize_deserialize/include/third_party.h"
 #include "paddle/fluid/pir/serialize_deserialize/include/version_compat.h"
@@ -39,6 +42,9 @@ class ProgramReader {
                              pir::PatchBuilder* builder);
   pir::Type RecoverType(Json* type_json);
   pir::AttributeMap RecoverOpAttributesMap(Json* attrs_json);
+  // Resolves the interned types, attributes and regions of `module` while
+  // the program json of it is read.
+  void SetBinaryModule(BinaryModule* module);
   ~ProgramReader() = default;
 
  private:
@@ -46,6 +52,11 @@ class ProgramReader {
   std::map<int64_t, pir::Value> id_value_map;
   pir::PatchBuilder* patch_builder = nullptr;
 
+  BinaryModule* binary_module_ = nullptr;
+  // decoded entries of the type and attribute tables of binary_module_
+  std::vector<pir::Type> binary_types_;
+  std::vector<std::pair<std::string, pir::Attribute>> binary_attrs_;
+
   void ReadProgram(Json* program_json, pir::Program* program);
   void ReadRegion(Json* region_json, pir::Region* region);
   void ReadBlock(Json* block_json, pir::Block* block);
@@ -58,6 +69,13 @@ class ProgramReader {
   pir::Type ReadType(Json* type_json);
 
   pir::Operation* ReadParameterOp(Json* op_json);
+
+  // Replaces the table indices of a binary module in the op json by the
+  // entries, so that op patches see the same json as in a text module.
+  void InflateBinaryOp(Json* op_json);
+  Json ReadBinaryRegion(Json* region_json);
+  const std::pair<std::string, pir::Attribute>& ReadBinaryAttribute(
+      int64_t index);
 };
 
 }  // namespace pir
@@ -0,0 +1,230 @@
+// Copyright (c) 2025 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/fluid/pir/serialize_deserialize/include/binary_module.h"
+
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <unordered_map>
+
+#include "paddle/common/enforce.h"
+#include "paddle/fluid/pir/serialize_deserialize/include/schema.h"
+
+namespace pir {
+
+namespace {
+
+constexpr char kMagic[4] = {'P', 'I', 'R', 'B'};
+constexpr uint32_t kFormatVersion = 1;
+constexpr size_t kPreambleSize =
+    sizeof(kMagic) + sizeof(uint32_t) + sizeof(uint64_t);
+
+class Interner {
+ public:
+  int64_t Get(Json&& item) {
+    auto key = item.dump();
+    auto it = index_.find(key);
+    if (it != index_.end()) return it->second;
+    int64_t id = static_cast<int64_t>(items_.size());
+    index_.emplace(std::move(key), id);
+    items_.emplace_back(std::move(item));
+    return id;
+  }
+  Json Release() { return Json(std::move(items_)); }
+
+ private:
+  std::vector<Json> items_;
+  std::unordered_map<std::string, int64_t> index_;
+};
+
+class Encoder {
+ public:
+  int64_t EncodeRegion(Json* region_json) {
+    // Reserve the index first, nested regions are encoded while the blocks
+    // of this one are walked.
+    int64_t id = static_cast<int64_t>(chunks_.size());
+    chunks_.emplace_back();
+    for (auto& block_json : region_json->at(BLOCKS)) {
+      for (auto& arg_json : block_json.at(BLOCKARGS)) {
+        InternType(&arg_json);
+      }
+      if (block_json.contains(KEYWORDBLOCKARGS)) {
+        for (auto& kwarg_json : block_json.at(KEYWORDBLOCKARGS)) {
+          InternType(&kwarg_json);
+        }
+      }
+      for (auto& op_json : block_json.at(BLOCKOPS)) {
+        EncodeOp(&op_json);
+      }
+    }
+    auto chunk = Json::to_msgpack(*region_json);
+    chunks_[id].assign(chunk.begin(), chunk.end());
+    return id;
+  }
+
+  std::string Finish(const Json& base_code, Json&& program_json) {
+    Json offsets = Json::array();
+    uint64_t offset = 0;
+    for (auto& chunk : chunks_) {
+      offsets.push_back({offset, chunk.size()});
+      offset += chunk.size();
+    }
+    Json header;
+    header["base_code"] = base_code;
+    header["program"] = std::move(program_json);
+    header["types"] = types_.Release();
+    header["attrs"] = attrs_.Release();
+    header["regions"] = std::move(offsets);
+    auto header_bytes = Json::to_msgpack(header);
+
+    std::string out;
+    out.reserve(kPreambleSize + header_bytes.size() + offset);
+    uint64_t header_size = header_bytes.size();
+    out.append(kMagic, sizeof(kMagic));
+    out.append(reinterpret_cast<const char*>(&kFormatVersion),
+               sizeof(kFormatVersion));
+    out.append(reinterpret_cast<const char*>(&header_size),
+               sizeof(header_size));
+    out.append(header_bytes.begin(), header_bytes.end());
+    for (auto& chunk : chunks_) {
+      out.append(chunk);
+    }
+    return out;
+  }
+
+ private:
+  void InternType(Json* value_json) {
+    if (value_json->contains(TYPE_TYPE)) {
+      auto& type_json = value_json->at(TYPE_TYPE);
+      type_json = types_.Get(std::move(type_json));
+    }
+  }
+
+  void InternAttrs(Json* op_json, const char* key) {
+    if (!op_json->contains(key)) return;
+    for (auto& attr_json : op_json->at(key)) {
+      if (attr_json.is_object() && attr_json.contains(ATTR_TYPE)) {
+        attr_json = attrs_.Get(std::move(attr_json));
+      }
+    }
+  }
+
+  void EncodeOp(Json* op_json) {
+    auto& results_json = op_json->at(OPRESULTS);
+    if (results_json.is_array()) {
+      for (auto& result_json : results_json) {
+        InternType(&result_json);
+      }
+    } else {
+      // ParameterOp keeps its only result as an object.
+      InternType(&results_json);
+    }
+    // The attributes of ParameterOp are stored as plain values.
+    if (op_json->at(ID) != PARAMETEROP) {
+      InternAttrs(op_json, ATTRS);
+      InternAttrs(op_json, OPRESULTS_ATTRS);
+    }
+    if (op_json->contains(REGIONS)) {
+      for (auto& region_json : op_json->at(REGIONS)) {
+        region_json = EncodeRegion(&region_json);
+      }
+    }
+  }
+
+  Interner types_;
+  Interner attrs_;
+  std::vector<std::string> chunks_;
+};
+
+}  // namespace
+
+bool BinaryModule::IsBinary(const std::string& file_path) {
+  std::ifstream fin(file_path, std::ios::binary);
+  char magic[sizeof(kMagic)] = {0};
+  fin.read(magic, sizeof(magic));
+  return fin.gcount() == sizeof(magic) &&
+         std::memcmp(magic, kMagic, sizeof(kMagic)) == 0;
+}
+
+std::string BinaryModule::Encode(const Json& base_code, Json* program) {
+  Encoder encoder;
+  for (auto& region_json : program->at(REGIONS)) {
+    region_json = encoder.EncodeRegion(&region_json);
+  }
+  return encoder.Finish(base_code, std::move(*program));
+}
+
+BinaryModule::BinaryModule(const std::string& file_path) {
+  std::ifstream fin(file_path, std::ios::binary);
+  PADDLE_ENFORCE_EQ(static_cast<bool>(fin),
+                    true,
+                    common::errors::Unavailable(
+                        "Cannot open %s to load the program.", file_path));
+  content_.assign(std::istreambuf_iterator<char>(fin),
+                  std::istreambuf_iterator<char>());
+  PADDLE_ENFORCE_GE(
+      content_.size(),
+      kPreambleSize,
+      common::errors::InvalidArgument("Invalid model file %s.", file_path));
+  uint32_t format_version = 0;
+  uint64_t header_size = 0;
+  std::memcpy(&format_version,
+              content_.data() + sizeof(kMagic),
+              sizeof(format_version));
+  std::memcpy(&header_size,
+              content_.data() + sizeof(kMagic) + sizeof(format_version),
+              sizeof(header_size));
+  PADDLE_ENFORCE_EQ(format_version,
+                    kFormatVersion,
+                    common::errors::InvalidArgument(
+                        "The binary program format version of %s is %d, "
+                        "only version %d is supported.",
+                        file_path,
+                        format_version,
+                        kFormatVersion));
+  PADDLE_ENFORCE_LE(
+      kPreambleSize + header_size,
+      content_.size(),
+      common::errors::InvalidArgument("Invalid model file %s.", file_path));
+  const char* header_begin = content_.data() + kPreambleSize;
+  header_ = Json::from_msgpack(header_begin, header_begin + header_size);
+  payload_offset_ = kPreambleSize + header_size;
+  VLOG(6) << "Read binary program " << file_path << " with " << num_types()
+          << " types, " << num_attrs() << " attributes and "
+          << header_.at("regions").size() << " regions.";
+}
+
+const Json& BinaryModule::type(int64_t index) const {
+  return header_.at("types").at(index);
+}
+
+const Json& BinaryModule::attr(int64_t index) const {
+  return header_.at("attrs").at(index);
+}
+
+Json BinaryModule::DecodeRegion(int64_t index) const {
+  auto& region = header_.at("regions").at(index);
+  uint64_t offset = region.at(0).template get<uint64_t>();
+  uint64_t size = region.at(1).template get<uint64_t>();
+  PADDLE_ENFORCE_LE(
+      payload_offset_ + offset + size,
+      content_.size(),
+      common::errors::InvalidArgument(
+          "Region %d is out of the range of the binary program.", index));
+  const char* begin = content_.data() + payload_offset_ + offset;
+  return Json::from_msgpack(begin, begin + size);
+}
+
+}  // namespace pir
@@ -14,7 +14,9 @@
 
 #include "paddle/fluid/pir/serialize_deserialize/include/interface.h"
 #include <stdio.h>
+#include <memory>
 #include "paddle/common/enforce.h"
+#include "paddle/fluid/pir/serialize_deserialize/include/binary_module.h"
 #include "paddle/fluid/pir/serialize_deserialize/include/ir_deserialize.h"
 #include "paddle/fluid/pir/serialize_deserialize/include/ir_serialize.h"
 #include "paddle/phi/common/port.h"
@@ -31,7 +33,8 @@ void WriteModule(const pir::Program& program,
                  uint64_t pir_version,
                  bool overwrite,
                  bool readable,
-                 bool trainable) {
+                 bool trainable,
+                 bool binary) {
   PADDLE_ENFORCE_EQ(
       FileExists(file_path) && !overwrite,
       false,
@@ -50,7 +53,9 @@ void WriteModule(const pir::Program& program,
   // write program
   total[PROGRAM] = writer.GetProgramJson(&program);
   std::string total_str;
-  if (readable) {
+  if (binary) {
+    total_str = BinaryModule::Encode(total[BASE_CODE], &total[PROGRAM]);
+  } else if (readable) {
     total_str = total.dump(4);
   } else {
     total_str = total.dump();
@@ -69,8 +74,24 @@ void WriteModule(const pir::Program& program,
 bool ReadModule(const std::string& file_path,
                 pir::Program* program,
                 int64_t pir_version) {
-  std::ifstream f(file_path);
-  Json data = Json::parse(f);
+  std::unique_ptr<BinaryModule> binary_module;
+  Json data;
+  Json* base_code = nullptr;
+  Json* program_json = nullptr;
+  if (BinaryModule::IsBinary(file_path)) {
+    binary_module = std::make_unique<BinaryModule>(file_path);
+    base_code = binary_module->base_code();
+    program_json = binary_module->program();
+  } else {
+    std::ifstream f(file_path);
+    data = Json::parse(f);
+    PADDLE_ENFORCE_EQ(
+        data.contains(BASE_CODE) && data.contains(PROGRAM),
+        true,
+        common::errors::InvalidArgument("Invalid model file."));
+    base_code = &data[BASE_CODE];
+    program_json = &data[PROGRAM];
+  }
   if (pir_version < 0) {
     pir_version = DEVELOP_VERSION;
     VLOG(6) << "pir_version is null, get pir_version: " << pir_version;
@@ -78,10 +99,8 @@ bool ReadModule(const std::string& file_path,
 
   PatchBuilder builder(pir_version);
 
-  if (data.contains(BASE_CODE) && data[BASE_CODE].contains(MAGIC) &&
-      data[BASE_CODE][MAGIC] == PIR) {
-    uint64_t file_version =
-        data.at(BASE_CODE).at(PIRVERSION).template get<uint64_t>();
+  if (base_code->contains(MAGIC) && base_code->at(MAGIC) == PIR) {
+    uint64_t file_version = base_code->at(PIRVERSION).template get<uint64_t>();
     if (file_version != (uint64_t)pir_version) {
       builder.SetFileVersion(file_version);
       // Set max_version to the max version number of release pir plus 1.
@@ -100,10 +119,13 @@ bool ReadModule(const std::string& file_path,
   }
 
   ProgramReader reader(pir_version);
-  reader.RecoverProgram(&(data[PROGRAM]), program, &builder);
+  if (binary_module) {
+    reader.SetBinaryModule(binary_module.get());
+  }
+  reader.RecoverProgram(program_json, program, &builder);
 
-  if (data[BASE_CODE].contains(TRAINABLE)) {
-    return data[BASE_CODE][TRAINABLE].get<bool>();
+  if (base_code->contains(TRAINABLE)) {
+    return base_code->at(TRAINABLE).get<bool>();
   } else {
     return false;
   }
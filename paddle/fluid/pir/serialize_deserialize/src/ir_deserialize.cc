@@ -36,6 +36,49 @@ pir::AttributeMap ProgramReader::RecoverOpAttributesMap(Json* attrs_json) {
   return ReadAttributesMap(attrs_json, &empty_json, attr_patch);
 }
 
+void ProgramReader::SetBinaryModule(BinaryModule* module) {
+  binary_module_ = module;
+  binary_types_.assign(module->num_types(), pir::Type());
+  binary_attrs_.assign(module->num_attrs(), {});
+}
+
+void ProgramReader::InflateBinaryOp(Json* op_json) {
+  if (!binary_module_) return;
+  auto inflate_type = [this](Json* value_json) {
+    if (value_json->contains(TYPE_TYPE) &&
+        value_json->at(TYPE_TYPE).is_number_integer()) {
+      auto index = value_json->at(TYPE_TYPE).template get<int64_t>();
+      value_json->at(TYPE_TYPE) = binary_module_->type(index);
+    }
+  };
+  Json& results_json = op_json->at(OPRESULTS);
+  if (results_json.is_array()) {
+    for (auto& result_json : results_json) inflate_type(&result_json);
+  } else {
+    inflate_type(&results_json);
+  }
+  // The attributes of ParameterOp are plain values, they are not interned.
+  if (op_json->at(ID) == PARAMETEROP) return;
+  for (auto key : {ATTRS, OPRESULTS_ATTRS}) {
+    if (!op_json->contains(key)) continue;
+    for (auto& attr_json : op_json->at(key)) {
+      if (attr_json.is_number_integer()) {
+        attr_json = binary_module_->attr(attr_json.template get<int64_t>());
+      }
+    }
+  }
+}
+
+Json ProgramReader::ReadBinaryRegion(Json* region_json) {
+  PADDLE_ENFORCE_NOT_NULL(
+      binary_module_,
+      common::errors::InvalidArgument(
+          "The program json refers to region %d of a binary module, but no "
+          "binary module is set.",
+          region_json->template get<int64_t>()));
+  return binary_module_->DecodeRegion(region_json->template get<int64_t>());
+}
+
 void ProgramReader::ReadProgram(Json* program_json, pir::Program* program) {
   auto top_level_op = program->module_op();
   PADDLE_ENFORCE_EQ(
@@ -44,8 +87,13 @@ void ProgramReader::ReadProgram(Json* program_json, pir::Program* program) {
       common::errors::InvalidArgument(
           "The regions size of program module should be 1 but got %d.",
           program_json->at(REGIONS).size()));
-  auto& region_json = program_json->at(REGIONS).at(0);
-  auto& block_json = region_json.at(BLOCKS).at(0);
+  Json* region_json = &program_json->at(REGIONS).at(0);
+  Json binary_region_json;
+  if (region_json->is_number_integer()) {
+    binary_region_json = ReadBinaryRegion(region_json);
+    region_json = &binary_region_json;
+  }
+  auto& block_json = region_json->at(BLOCKS).at(0);
   auto& block = top_level_op.block();
   ReadBlock(&block_json, &block);
 
@@ -138,6 +186,7 @@ pir::Operation* ProgramReader::ReadParameterOp(Json* op_json) {
   // attr is_distributed; is_parameter; need_clip; parameter_name; persistable;
   // stop_gradient; trainable;
   if (patch_builder->HasOpPatch(PARAMETEROP)) {
+    InflateBinaryOp(op_json);
     VLOG(8) << PARAMETEROP << " before: " << *op_json;
     Json op_patch = patch_builder->GetJsonOpPatch(PARAMETEROP);
     VLOG(8) << " get op patch:  " << op_patch;
@@ -231,6 +280,7 @@ pir::Operation* ProgramReader::ReadOp(Json* op_json) {
     return ReadParameterOp(op_json);
   }
   if (patch_builder->HasOpPatch(op_name)) {
+    InflateBinaryOp(op_json);
     VLOG(8) << op_name << " before: " << *op_json;
     Json op_patch = patch_builder->GetJsonOpPatch(op_name);
     VLOG(8) << " get op patch:  " << op_patch;
@@ -304,6 +354,9 @@ pir::Operation* ProgramReader::ReadOp(Json* op_json) {
     VLOG(6) << op->name() << " has " << num_regions << " regions.";
     for (uint64_t i = 0; i < regions_json.size(); i++) {
       auto region_json = regions_json.at(i);
+      if (region_json.is_number_integer()) {
+        region_json = ReadBinaryRegion(&region_json);
+      }
       ReadRegion(&region_json, &(op->region(i)));
     }
     VLOG(6) << "Finish Read OP's regions.";
@@ -340,6 +393,11 @@ pir::AttributeMap ProgramReader::ReadAttributesMap(
     VLOG(8) << "attr has been added: " << *attrs_json;
   }
   for (auto& attr_json : *attrs_json) {
+    // An interned attribute of a binary module, the op has no patch.
+    if (attr_json.is_number_integer()) {
+      attributes.insert(ReadBinaryAttribute(attr_json.template get<int64_t>()));
+      continue;
+    }
     auto attr_name = attr_json.at(NAME).template get<std::string>();
     if (attr_patch.count(attr_name)) {
       Json patch = attr_patch.at(attr_name);
@@ -364,6 +422,10 @@ pir::AttributeMap ProgramReader::ReadAttributesMap(
     VLOG(8) << "opresult attr has been added: " << *opresult_attrs_json;
   }
   for (auto& attr_json : *opresult_attrs_json) {
+    if (attr_json.is_number_integer()) {
+      attributes.insert(ReadBinaryAttribute(attr_json.template get<int64_t>()));
+      continue;
+    }
     auto attr_name = attr_json.at(NAME).template get<std::string>();
     VLOG(8) << attr_name << " patch: " << attr_patch;
     if (attr_patch.count(attr_name)) {
@@ -398,8 +460,28 @@ pir::Attribute ProgramReader::ReadAttribute(Json* attr_json) {
   return pir::parseAttr(&attr_json->at(ATTR_TYPE));
 }
 
+const std::pair<std::string, pir::Attribute>&
+ProgramReader::ReadBinaryAttribute(int64_t index) {
+  auto& entry = binary_attrs_.at(index);
+  if (!entry.second) {
+    Json attr_json = binary_module_->attr(index);
+    entry.first = attr_json.at(NAME).template get<std::string>();
+    entry.second = ReadAttribute(&attr_json);
+  }
+  return entry;
+}
+
 pir::Type ProgramReader::ReadType(Json* type_json) {
   VLOG(6) << "Begin Read Type. ";
+  if (type_json->is_number_integer()) {
+    auto index = type_json->template get<int64_t>();
+    auto& type = binary_types_.at(index);
+    if (!type) {
+      Json table_json = binary_module_->type(index);
+      type = ReadType(&table_json);
+    }
+    return type;
+  }
   auto type_name = type_json->at(ID).template get<std::string>();
   VLOG(8) << "Check patches for: " << type_name;
   if (patch_builder && patch_builder->HasTypePatch(type_name)) {
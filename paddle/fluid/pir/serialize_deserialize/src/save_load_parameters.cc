@@ -9,18 +9,144 @@ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
 See the License for the specific language governing permissions and
 limitations under the License. */
 
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
 #include <cstdint>
+#include <cstring>
+#include <deque>
+#include <exception>
 #include <fstream>
+#include <future>
+#include <mutex>
 #include <numeric>
+#include <utility>
 
 #include "glog/logging.h"
+#include "paddle/common/flags.h"
 #include "paddle/fluid/framework/lod_tensor.h"
 #include "paddle/fluid/pir/serialize_deserialize/include/interface.h"
 #include "paddle/phi/common/port.h"
+#include "paddle/phi/core/framework/var_type_helper.h"
+#include "paddle/phi/core/tensor_utils.h"
 #include "paddle/phi/kernels/funcs/data_type_transform.h"
+#ifndef _WIN32
+#include "paddle/phi/core/memory/allocation/mmap_allocator.h"
+#endif
+
+COMMON_DECLARE_bool(load_combine_params_by_mmap);
+COMMON_DECLARE_int32(load_params_thread_num);
 
 namespace pir {
 
+// Tensor data in combined parameter files starts at offsets aligned to this,
+// so that the mmap loader can use the mapped pages in place.
+constexpr size_t kCombineParamsAlignment = 64;
+
+#ifndef _WIN32
+using paddle::memory::allocation::MemoryMapFileAllocation;
+using paddle::memory::allocation::MemoryMappedFile;
+
+// Parses tensors in the layout written by phi::SerializeToStream directly
+// from a mapped file. CPU tensors whose data starts at a
+// kCombineParamsAlignment boundary share the mapped pages instead of owning
+// a copy.
+class MappedTensorReader {
+ public:
+  explicit MappedTensorReader(const std::string& file_path)
+      : file_(std::make_shared<MemoryMappedFile>(file_path)) {}
+
+  void ReadTensor(phi::DenseTensor* tensor, const phi::DeviceContext& dev_ctx) {
+    uint32_t version = Read<uint32_t>();
+    PADDLE_ENFORCE_EQ(
+        version,
+        0U,
+        common::errors::InvalidArgument(
+            "Deserialize to tensor failed, maybe the loaded file is "
+            "not a paddle model(expected file format: 0, but %u found).",
+            version));
+    uint64_t lod_level = Read<uint64_t>();
+    auto& lod = *tensor->mutable_lod();
+    lod.resize(lod_level);
+    for (uint64_t i = 0; i < lod_level; ++i) {
+      uint64_t size = Read<uint64_t>();
+      lod[i].resize(size / sizeof(size_t));
+      std::memcpy(lod[i].data(), Take(size), size);
+    }
+
+    uint32_t tensor_version = Read<uint32_t>();
+    PADDLE_ENFORCE_EQ(
+        tensor_version,
+        0U,
+        common::errors::InvalidArgument(
+            "tensor version %u is not supported, Only version 0 is supported",
+            tensor_version));
+    int32_t desc_size = Read<int32_t>();
+    PADDLE_ENFORCE_GE(desc_size,
+                      0,
+                      common::errors::InvalidArgument(
+                          "phi::DenseTensor desc size should >= 0"));
+    paddle::framework::proto::VarType::TensorDesc desc;
+    PADDLE_ENFORCE_EQ(
+        desc.ParseFromArray(Take(desc_size), desc_size),
+        true,
+        common::errors::InvalidArgument("Cannot parse tensor desc"));
+
+    std::vector<int64_t> dims(desc.dims().begin(), desc.dims().end());
+    tensor->Resize(common::make_ddim(dims));
+    auto dtype = phi::TransToPhiDataType(desc.data_type());
+    size_t offset = offset_;
+    size_t size = tensor->numel() * phi::SizeOfType(desc.data_type());
+    const char* data = Take(size);
+    if (phi::is_cpu_place(dev_ctx.GetPlace())) {
+      if (offset % kCombineParamsAlignment == 0) {
+        tensor->ResetHolderWithType(
+            std::make_shared<MemoryMapFileAllocation>(file_, offset, size),
+            dtype);
+        shared_bytes_ += size;
+      } else {
+        std::memcpy(dev_ctx.Alloc(tensor, dtype), data, size);
+      }
+    } else {
+      phi::DenseTensor cpu_tensor;
+      cpu_tensor.Resize(tensor->dims());
+      cpu_tensor.ResetHolderWithType(
+          std::make_shared<MemoryMapFileAllocation>(file_, offset, size),
+          dtype);
+      phi::Copy(dev_ctx, cpu_tensor, dev_ctx.GetPlace(), true, tensor);
+    }
+  }
+
+  bool eof() const { return offset_ == file_->size(); }
+  size_t shared_bytes() const { return shared_bytes_; }
+
+ private:
+  template <typename T>
+  T Read() {
+    T value;
+    std::memcpy(&value, Take(sizeof(T)), sizeof(T));
+    return value;
+  }
+
+  const char* Take(size_t size) {
+    PADDLE_ENFORCE_LE(
+        size,
+        file_->size() - offset_,
+        common::errors::Unavailable(
+            "Load operator fail to read file %s, please check "
+            "whether the model file is complete or damaged.",
+            file_->path()));
+    const char* res = file_->data() + offset_;
+    offset_ += size;
+    return res;
+  }
+
+  std::shared_ptr<MemoryMappedFile> file_;
+  size_t offset_ = 0;
+  size_t shared_bytes_ = 0;
+};
+#endif
+
 const phi::DeviceContext* GetDeviceContext(
     const phi::DenseTensor& x, const phi::Place& place = phi::Place()) {
   phi::DeviceContextPool& pool = phi::DeviceContextPool::Instance();
@@ -138,9 +264,9 @@ void SaveCombineFunction(const std::vector<const phi::DenseTensor*>& x,
     auto out_dtype = save_as_fp16 ? phi::DataType::FLOAT16 : in_dtype;
     if (in_dtype != out_dtype) {
       auto out = CastTensorType(dev_ctx, tensor, out_dtype);
-      phi::SerializeToStream(fout, out, *dev_ctx);
+      phi::SerializeToStream(fout, out, *dev_ctx, kCombineParamsAlignment);
     } else {
-      phi::SerializeToStream(fout, tensor, *dev_ctx);
+      phi::SerializeToStream(fout, tensor, *dev_ctx, kCombineParamsAlignment);
     }
   }
   fout.close();
@@ -183,11 +309,193 @@ void LoadFunction(const std::string& file_path,
   }
 }
 
+void LoadFunctions(const std::vector<std::string>& file_paths,
+                   const std::vector<phi::DenseTensor*>& out,
+                   bool load_as_fp16,
+                   phi::Place place) {
+  PADDLE_ENFORCE_EQ(file_paths.size(),
+                    out.size(),
+                    common::errors::InvalidArgument(
+                        "The number of files (%d) and tensors (%d) to be "
+                        "loaded should be equal.",
+                        file_paths.size(),
+                        out.size()));
+  size_t num_threads = std::min<size_t>(
+      std::max(FLAGS_load_params_thread_num, 1), file_paths.size());
+  // Workers take the next file from a shared index, so that a few large
+  // files do not leave the other threads idle.
+  std::atomic<size_t> next{0};
+  auto load = [&]() {
+    for (size_t i = next++; i < file_paths.size(); i = next++) {
+      LoadFunction(file_paths[i], -1, {}, load_as_fp16, out[i], place);
+    }
+  };
+  std::vector<std::future<void>> futures;
+  for (size_t i = 1; i < num_threads; ++i) {
+    futures.emplace_back(std::async(std::launch::async, load));
+  }
+  load();
+  for (auto& future : futures) {
+    future.get();
+  }
+  VLOG(4) << "Load " << file_paths.size() << " params with " << num_threads
+          << " threads";
+}
+
+// Reads the tensors of a combined file on the calling thread into CPU
+// staging tensors and casts and copies them to `place` on other threads, so
+// the file I/O overlaps with the conversion. The number of staged tensors is
+// bounded to keep the extra host memory small.
+static void LoadCombineFunctionPipelined(const std::string& file_path,
+                                         const std::vector<std::string>& names,
+                                         std::vector<phi::DenseTensor*>* out,
+                                         bool load_as_fp16,
+                                         phi::Place place,
+                                         size_t num_threads) {
+  std::ifstream fin(file_path, std::ios::binary);
+  PADDLE_ENFORCE_EQ(static_cast<bool>(fin),
+                    true,
+                    common::errors::Unavailable(
+                        "Load operator fail to open file %s, please check "
+                        "whether the model file is complete or damaged.",
+                        file_path));
+  const phi::DeviceContext* dev_ctx = GetDeviceContext(*(out->at(0)), place);
+  auto* cpu_ctx = phi::DeviceContextPool::Instance().Get(phi::CPUPlace());
+  auto dst_place = dev_ctx->GetPlace();
+  auto convert = [&](phi::DenseTensor* staged, phi::DenseTensor* tensor) {
+    if (load_as_fp16 && staged->dtype() != phi::DataType::FLOAT16) {
+      *staged = CastTensorType(cpu_ctx, *staged, phi::DataType::FLOAT16);
+    }
+    if (phi::is_cpu_place(dst_place)) {
+      *tensor = *staged;
+    } else {
+      phi::Copy(*dev_ctx, *staged, dst_place, true, tensor);
+    }
+  };
+
+  std::mutex mutex;
+  std::condition_variable cv;
+  std::deque<std::pair<phi::DenseTensor, phi::DenseTensor*>> queue;
+  bool done = false;
+  std::exception_ptr error;
+  size_t max_queued = num_threads * 2;
+  auto worker = [&]() {
+    while (true) {
+      std::pair<phi::DenseTensor, phi::DenseTensor*> task;
+      {
+        std::unique_lock<std::mutex> lock(mutex);
+        cv.wait(lock, [&] { return done || !queue.empty(); });
+        if (queue.empty()) return;
+        task = std::move(queue.front());
+        queue.pop_front();
+      }
+      cv.notify_all();
+      try {
+        convert(&task.first, task.second);
+      } catch (...) {
+        // Keep draining the queue so that the reader is never blocked.
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!error) error = std::current_exception();
+      }
+    }
+  };
+  std::vector<std::future<void>> workers;
+  for (size_t i = 0; i < num_threads; ++i) {
+    workers.emplace_back(std::async(std::launch::async, worker));
+  }
+  auto finish = [&]() {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      done = true;
+    }
+    cv.notify_all();
+    for (auto& w : workers) w.get();
+    if (error) std::rethrow_exception(error);
+  };
+  try {
+    for (size_t i = 0; i < names.size(); i++) {
+      phi::DenseTensor staged;
+      phi::DeserializeFromStream(fin, &staged);
+      std::unique_lock<std::mutex> lock(mutex);
+      cv.wait(lock, [&] { return queue.size() < max_queued; });
+      if (error) break;
+      queue.emplace_back(std::move(staged), out->at(i));
+      lock.unlock();
+      cv.notify_all();
+    }
+  } catch (...) {
+    finish();
+    throw;
+  }
+  finish();
+  fin.peek();
+  PADDLE_ENFORCE_EQ(fin.eof(),
+                    true,
+                    common::errors::Unavailable(
+                        "Not allowed to load partial data via "
+                        "load_combine_op, please use load_op instead."));
+}
+
+#ifndef _WIN32
+static void LoadCombineFunctionByMmap(const std::string& file_path,
+                                      const std::vector<std::string>& names,
+                                      std::vector<phi::DenseTensor*>* out,
+                                      bool load_as_fp16,
+                                      phi::Place place) {
+  PADDLE_ENFORCE_GT(out->size(),
+                    0UL,
+                    common::errors::InvalidArgument(
+                        "The number of variables to be loaded is %d, expect "
+                        "it to be greater than 0.",
+                        out->size()));
+  MappedTensorReader reader(file_path);
+  const phi::DeviceContext* dev_ctx = GetDeviceContext(*(out->at(0)), place);
+  for (size_t i = 0; i < names.size(); i++) {
+    auto tensor = out->at(i);
+    reader.ReadTensor(tensor, *dev_ctx);
+
+    auto in_dtype = tensor->dtype();
+    auto out_dtype = load_as_fp16 ? phi::DataType::FLOAT16 : in_dtype;
+    if (in_dtype != out_dtype) {
+      auto cast_in = *tensor;
+      *tensor = CastTensorType(dev_ctx, cast_in, out_dtype);
+    }
+  }
+  PADDLE_ENFORCE_EQ(reader.eof(),
+                    true,
+                    common::errors::Unavailable(
+                        "Not allowed to load partial data via "
+                        "load_combine_op, please use load_op instead."));
+  VLOG(4) << "Load " << names.size() << " params from " << file_path
+          << " by mmap, " << reader.shared_bytes()
+          << " bytes are shared with the mapped file";
+}
+#endif
+
 void LoadCombineFunction(const std::string& file_path,
                          const std::vector<std::string>& names,
                          std::vector<phi::DenseTensor*>* out,
                          bool load_as_fp16,
                          phi::Place place) {
+#ifndef _WIN32
+  if (FLAGS_load_combine_params_by_mmap) {
+    LoadCombineFunctionByMmap(file_path, names, out, load_as_fp16, place);
+    return;
+  }
+#endif
+  if (FLAGS_load_params_thread_num > 1 && !out->empty()) {
+    auto dst_place = GetDeviceContext(*(out->at(0)), place)->GetPlace();
+    // Reading into CPU tensors leaves nothing to overlap with the I/O.
+    if (load_as_fp16 || !phi::is_cpu_place(dst_place)) {
+      LoadCombineFunctionPipelined(file_path,
+                                   names,
+                                   out,
+                                   load_as_fp16,
+                                   place,
+                                   FLAGS_load_params_thread_num);
+      return;
+    }
+  }
   std::ifstream fin(file_path, std::ios::binary);
   PADDLE_ENFORCE_EQ(static_cast<bool>(fin),
                     true,
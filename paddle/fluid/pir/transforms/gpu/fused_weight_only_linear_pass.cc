@@ -27,6 +27,10 @@
 
 namespace {
 
+// The arch of weight_quantize and weight_only_linear selecting the weight
+// layout of the CPU kernels.
+constexpr int kCPUArch = 0;
+
 int getSMVersion() {
   int sm_version = -1;
 #if defined(PADDLE_WITH_CUDA) && defined(PADDLE_WITH_CUTLASS)
@@ -76,7 +80,9 @@ class FusedWeightOnlyLinearWithBiasPattern
     //
     // Constraints.
     //
-    src.AddConstraint([](const paddle::drr::MatchContext &match_ctx) -> bool {
+    bool on_cpu = sm_version_ == kCPUArch;
+    src.AddConstraint([on_cpu](const paddle::drr::MatchContext &match_ctx)
+                          -> bool {
       if (!pir::ValueIsPersistable(match_ctx.Tensor("w"))) {
         return false;
       }
@@ -86,7 +92,8 @@ class FusedWeightOnlyLinearWithBiasPattern
 
       auto w_dtype = pir::GetDataTypeFromValue(match_ctx.Tensor("w"));
       if (!w_dtype.isa<pir::Float16Type>() &&
-          !w_dtype.isa<pir::BFloat16Type>()) {
+          !w_dtype.isa<pir::BFloat16Type>() &&
+          !(on_cpu && w_dtype.isa<pir::Float32Type>())) {
         return false;
       }
 
@@ -108,7 +115,7 @@ class FusedWeightOnlyLinearWithBiasPattern
     //
     paddle::drr::ResultPattern res = src.ResultPattern();
 
-    if (algo_ == "weight_only_int4") {
+    if (algo_ == "weight_only_int4" && sm_version_ != kCPUArch) {
       // TODO(liuyuanle): When the operator weight_quantize supports
       // weight_only_int4 on gpu version, delete the memory copy.
       const auto &memcpy_d2h =
@@ -190,7 +197,9 @@ class FusedWeightOnlyLinearNoBiasPattern : public paddle::drr::DrrPatternBase {
     //
     // Constraints.
     //
-    src.AddConstraint([](const paddle::drr::MatchContext &match_ctx) -> bool {
+    bool on_cpu = sm_version_ == kCPUArch;
+    src.AddConstraint([on_cpu](const paddle::drr::MatchContext &match_ctx)
+                          -> bool {
       if (!pir::ValueIsPersistable(match_ctx.Tensor("w"))) {
         return false;
       }
@@ -207,7 +216,9 @@ class FusedWeightOnlyLinearNoBiasPattern : public paddle::drr::DrrPatternBase {
       if (w_dims.at(0) % 64 != 0 || w_dims.at(1) % 16 != 0) return false;
 
       auto w_dtype = pir::GetDataTypeFromValue(match_ctx.Tensor("w"));
-      if (!w_dtype.isa<pir::Float16Type>() && !w_dtype.isa<pir::BFloat16Type>())
+      if (!w_dtype.isa<pir::Float16Type>() &&
+          !w_dtype.isa<pir::BFloat16Type>() &&
+          !(on_cpu && w_dtype.isa<pir::Float32Type>()))
         return false;
 
       if (x_dims.at(x_dims.size() - 1) != w_dims.at(0)) return false;
@@ -219,7 +230,7 @@ class FusedWeightOnlyLinearNoBiasPattern : public paddle::drr::DrrPatternBase {
     //
     paddle::drr::ResultPattern res = src.ResultPattern();
 
-    if (algo_ == "weight_only_int4") {
+    if (algo_ == "weight_only_int4" && sm_version_ != kCPUArch) {
       // TODO(liuyuanle): When the operator weight_quantize supports
       // weight_only_int4 on gpu version, delete the memory copy.
       const auto &memcpy_d2h =
@@ -277,6 +288,12 @@ class FusedWeightOnlyLinearPass : public pir::PatternRewritePass {
         sm_version_(getSMVersion()) {}
 
   pir::RewritePatternSet InitializePatterns(pir::IrContext *context) override {
+    // On CPU the weights are quantized to the layout of the CPU kernels.
+    if (Has(pir::Pass::kPlaceAttr) &&
+        Get<phi::Place>(pir::Pass::kPlaceAttr).GetType() ==
+            phi::AllocationType::CPU) {
+      sm_version_ = kCPUArch;
+    }
     std::string algo = "weight_only_int8";
     if (Has("weight_only_algo")) {
       algo = Get<std::string>("weight_only_algo");
@@ -310,8 +327,9 @@ class FusedWeightOnlyLinearPass : public pir::PatternRewritePass {
   }
 
   bool CanApplyOn(pir::Operation *op) const override {
-    if (sm_version_ != 70 && sm_version_ != 75 && sm_version_ != 80 &&
-        sm_version_ != 86 && sm_version_ != 89 && sm_version_ != 90) {
+    if (sm_version_ != kCPUArch && sm_version_ != 70 && sm_version_ != 75 &&
+        sm_version_ != 80 && sm_version_ != 86 && sm_version_ != 89 &&
+        sm_version_ != 90) {
       return false;
     }
     return op->num_regions() > 0;
@@ -873,6 +873,10 @@ void BindAnalysisConfig(py::module *m) {
            py::arg("x") = true)
       .def("enable_new_ir", &AnalysisConfig::EnableNewIR, py::arg("x") = true)
       .def("new_ir_enabled", &AnalysisConfig::new_ir_enabled)
+      .def("enable_streaming_fetch",
+           &AnalysisConfig::EnableStreamingFetch,
+           py::arg("x") = true)
+      .def("streaming_fetch_enabled", &AnalysisConfig::streaming_fetch_enabled)
       .def("enable_profile", &AnalysisConfig::EnableProfile)
       .def("disable_glog_info", &AnalysisConfig::DisableGlogInfo)
       .def("glog_info_disabled", &AnalysisConfig::glog_info_disabled)
@@ -1146,6 +1150,8 @@ void BindPaddleInferPredictor(py::module *m) {
       .def("clear_intermediate_tensor",
            &paddle_infer::Predictor::ClearIntermediateTensor)
       .def("register_output_hook", &paddle_infer::Predictor::RegisterOutputHook)
+      .def("register_fetch_callback",
+           &paddle_infer::Predictor::RegisterFetchCallback)
       .def("register_input_hook", &paddle_infer::Predictor::RegisterInputHook);
 }
 
@@ -27,6 +27,11 @@ limitations under the License. */
 #include <unistd.h>
 #endif  // _WIN32
 
+#if defined(__linux__) && defined(__x86_64__)
+#include <cpuid.h>
+#include <sys/syscall.h>
+#endif
+
 #ifdef PADDLE_WITH_XBYAK
 #include "xbyak/xbyak_util.h"
 #endif
@@ -111,6 +116,38 @@ size_t CUDAPinnedMaxChunkSize() {
   return CUDAPinnedMaxAllocSize() / 256;
 }
 
+// AMX needs the tile state enabled by the OS in XCR0, and Linux only gives
+// it to the processes asking for it. edx_bit is the bit of the AMX feature
+// in CPUID.(EAX=7, ECX=0):EDX.
+static bool MayIUseAMX(int edx_bit) {
+#if defined(__linux__) && defined(__x86_64__)
+  static const bool tile_enabled = []() {
+    unsigned int eax, ebx, ecx, edx;
+    // OSXSAVE, then XTILECFG and XTILEDATA in XCR0
+    if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx) || !(ecx & (1u << 27))) {
+      return false;
+    }
+    unsigned int xcr0_low, xcr0_high;
+    __asm__ volatile("xgetbv" : "=a"(xcr0_low), "=d"(xcr0_high) : "c"(0));
+    if ((xcr0_low & (3u << 17)) != (3u << 17)) {
+      return false;
+    }
+    constexpr int kArchReqXcompPerm = 0x1023;
+    constexpr int kXfeatureXtiledata = 18;
+    return syscall(SYS_arch_prctl, kArchReqXcompPerm, kXfeatureXtiledata) ==
+           0;
+  }();
+  unsigned int eax, ebx, ecx, edx;
+  if (!__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx)) {
+    return false;
+  }
+  // AMX-TILE: EDX Bit 24
+  return (edx & (1u << 24)) && (edx & (1u << edx_bit)) && tile_enabled;
+#else
+  return false;
+#endif
+}
+
 #ifdef PADDLE_WITH_XBYAK
 static Xbyak::util::Cpu cpu;
 bool MayIUse(const cpu_isa_t cpu_isa) {
@@ -139,6 +176,12 @@ bool MayIUse(const cpu_isa_t cpu_isa) {
              cpu.has(Cpu::tAVX512_4VNNIW);
     case avx512_bf16:
       return true && cpu.has(Cpu::tAVX512_BF16);
+    case amx_bf16:
+      // AMX-BF16: EDX Bit 22
+      return MayIUseAMX(22);
+    case amx_int8:
+      // AMX-INT8: EDX Bit 25
+      return MayIUseAMX(25);
     case isa_any:
       return true;
   }
@@ -148,6 +191,10 @@ bool MayIUse(const cpu_isa_t cpu_isa) {
 bool MayIUse(const cpu_isa_t cpu_isa) {
   if (cpu_isa == isa_any) {
     return true;
+  } else if (cpu_isa == amx_bf16) {
+    return MayIUseAMX(22);
+  } else if (cpu_isa == amx_int8) {
+    return MayIUseAMX(25);
   } else {
 #if !defined(WITH_NV_JETSON) && !defined(PADDLE_WITH_ARM) &&  \
     !defined(PADDLE_WITH_SW) && !defined(PADDLE_WITH_MIPS) && \
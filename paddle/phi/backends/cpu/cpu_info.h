@@ -88,6 +88,8 @@ typedef enum {
   avx512_mic,
   avx512_mic_4ops,
   avx512_bf16,
+  amx_bf16,
+  amx_int8,
 } cpu_isa_t;  // Instruction set architecture
 
 // May I use some instruction
@@ -20,7 +20,8 @@ namespace phi {
 
 void SerializeToStream(std::ostream &os,
                        const phi::DenseTensor &tensor,
-                       const phi::DeviceContext &dev_ctx) {
+                       const phi::DeviceContext &dev_ctx,
+                       size_t payload_alignment) {
   constexpr uint32_t kCurTensorVersion = 0;
   {  // the 1st field, uint32_t version for DenseTensor
     os.write(reinterpret_cast<const char *>(&kCurTensorVersion),
@@ -44,7 +45,8 @@ void SerializeToStream(std::ostream &os,
     }
   }
   // the 3st field, Tensor
-  TensorToStream(os, static_cast<phi::DenseTensor>(tensor), dev_ctx);
+  TensorToStream(
+      os, static_cast<phi::DenseTensor>(tensor), dev_ctx, payload_alignment);
 }
 
 void SerializeToStream(std::ostream &os, const phi::DenseTensor &tensor) {
@@ -33,10 +33,13 @@ namespace phi {
  * Serialize/Deserialize phi::DenseTensor to std::ostream
  * You can pass ofstream or ostringstream to serialize to file
  * or to a in memory string. GPU tensor will be copied to CPU.
+ * A non-zero payload_alignment aligns the tensor data to that stream
+ * offset, see TensorToStream.
  */
 void SerializeToStream(std::ostream& os,
                        const phi::DenseTensor& tensor,
-                       const phi::DeviceContext& dev_ctx);
+                       const phi::DeviceContext& dev_ctx,
+                       size_t payload_alignment = 0);
 void DeserializeFromStream(std::istream& is,
                            phi::DenseTensor* tensor,
                            const phi::DeviceContext& dev_ctx);
@@ -94,9 +94,39 @@ phi::DenseTensor InnerTensorContiguous(const phi::DenseTensor& tensor) {
   return tensor;
 }
 
+// Field number of the padding appended to TensorDesc, far above the
+// numbers used by framework.proto.
+constexpr uint32_t kTensorDescPaddingField = 1000;
+
+// Appends an unknown length-delimited field to the serialized desc so that
+// header_end + padding is a multiple of alignment.
+static void PadTensorDesc(size_t header_end,
+                          size_t alignment,
+                          std::string* desc) {
+  // tag varint (2 bytes for field 1000) + length varint (1 byte) + payload
+  constexpr size_t kMinPad = 3;
+  size_t pad = (alignment - header_end % alignment) % alignment;
+  while (pad != 0 && pad < kMinPad) {
+    pad += alignment;
+  }
+  if (pad == 0) return;
+  size_t len = pad - kMinPad;
+  PADDLE_ENFORCE_LT(
+      len,
+      128UL,
+      common::errors::InvalidArgument(
+          "Tensor payload alignment %d is too large.", alignment));
+  uint32_t tag = (kTensorDescPaddingField << 3) | 2;
+  desc->push_back(static_cast<char>((tag & 0x7f) | 0x80));
+  desc->push_back(static_cast<char>(tag >> 7));
+  desc->push_back(static_cast<char>(len));
+  desc->append(len, '\0');
+}
+
 void TensorToStream(std::ostream& os,
                     const phi::DenseTensor& tensor,
-                    const phi::DeviceContext& dev_ctx) {
+                    const phi::DeviceContext& dev_ctx,
+                    size_t payload_alignment) {
   const auto ensure_contiguous = [](const phi::DenseTensor& tensor) {
     if (tensor.meta().is_contiguous()) {
       return tensor;
@@ -118,9 +148,16 @@ void TensorToStream(std::ostream& os,
     auto* pb_dims = desc.mutable_dims();
     pb_dims->Resize(static_cast<int>(dims.size()), 0);
     std::copy(dims.begin(), dims.end(), pb_dims->begin());
-    int32_t size = desc.ByteSize();
-    os.write(reinterpret_cast<const char*>(&size), sizeof(size));
     auto out = desc.SerializeAsString();
+    std::streamoff pos = payload_alignment > 0 ? os.tellp() : -1;
+    if (pos >= 0) {
+      PadTensorDesc(
+          static_cast<size_t>(pos) + sizeof(int32_t) + out.size(),
+          payload_alignment,
+          &out);
+    }
+    int32_t size = static_cast<int32_t>(out.size());
+    os.write(reinterpret_cast<const char*>(&size), sizeof(size));
     os.write(out.data(), size);
   }
   {  // the 3rd field, tensor data
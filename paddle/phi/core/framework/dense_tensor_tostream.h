@@ -27,9 +27,14 @@
 
 namespace phi {
 
+// With payload_alignment > 0 and a seekable stream, the tensor desc is
+// padded with an unknown protobuf field so that the tensor data starts at a
+// stream offset that is a multiple of payload_alignment. Readers that parse
+// the desc as usual are not affected by the padding.
 TEST_API void TensorToStream(std::ostream& os,
                              const phi::DenseTensor& tensor,
-                             const phi::DeviceContext& dev_ctx);
+                             const phi::DeviceContext& dev_ctx,
+                             size_t payload_alignment = 0);
 TEST_API void TensorFromStream(std::istream& is,
                                phi::DenseTensor* tensor,
                                const phi::DeviceContext& dev_ctx);
@@ -0,0 +1,162 @@
+// Copyright (c) 2025 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/phi/core/memory/allocation/arena_allocator.h"
+
+#include <algorithm>
+#include <iterator>
+
+#include "glog/logging.h"
+#include "paddle/phi/core/enforce.h"
+
+namespace paddle::memory::allocation {
+
+ArenaAllocator::ArenaAllocator(std::shared_ptr<Allocator> underlying_allocator,
+                               size_t alignment)
+    : underlying_allocator_(std::move(underlying_allocator)),
+      alignment_(alignment) {
+  PADDLE_ENFORCE_NOT_NULL(
+      underlying_allocator_,
+      common::errors::InvalidArgument(
+          "Underlying allocator of ArenaAllocator is NULL"));
+  PADDLE_ENFORCE_EQ(
+      alignment_ > 0 && (alignment_ & (alignment_ - 1)) == 0,
+      true,
+      common::errors::InvalidArgument(
+          "The alignment of ArenaAllocator should be a power of 2, but got %d.",
+          alignment_));
+}
+
+size_t ArenaAllocator::AlignedSize(size_t size) const {
+  return (size + alignment_ - 1) & ~(alignment_ - 1);
+}
+
+size_t ArenaAllocator::Footprint() const {
+  size_t end = capacity_;
+  if (!free_.empty()) {
+    auto last = free_.rbegin();
+    if (last->first + last->second == capacity_) {
+      end = last->first;
+    }
+  }
+  return end + fallback_bytes_;
+}
+
+phi::Allocation* ArenaAllocator::AllocateImpl(size_t size) {
+  size_t aligned_size = AlignedSize(size);
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    if (live_ == 0 && demand_ > capacity_) {
+      // The block underlying_allocator_ hands out is aligned to at least
+      // alignment_ on every place this is used with.
+      block_.reset();
+      base_ = nullptr;
+      block_ = underlying_allocator_->Allocate(demand_);
+      base_ = static_cast<char*>(block_->ptr());
+      capacity_ = demand_;
+      free_.clear();
+      free_[0] = capacity_;
+      VLOG(4) << "Arena of " << capacity_ << " bytes on " << block_->place();
+    }
+    stat_.request_bytes += size;
+    for (auto it = free_.begin(); it != free_.end(); ++it) {
+      if (it->second < aligned_size) continue;
+      const size_t offset = it->first;
+      if (it->second > aligned_size) {
+        free_[offset + aligned_size] = it->second - aligned_size;
+      }
+      free_.erase(it);
+      live_++;
+      stat_.arena_allocs++;
+      peak_ = std::max(peak_, Footprint());
+      return new Allocation(base_ + offset, size, block_->place());
+    }
+    fallback_bytes_ += aligned_size;
+    peak_ = std::max(peak_, Footprint());
+    stat_.fallback_allocs++;
+  }
+  return underlying_allocator_->Allocate(size).release();
+}
+
+void ArenaAllocator::FreeImpl(phi::Allocation* allocation) {
+  if (!Contains(allocation->ptr())) {
+    {
+      std::lock_guard<std::mutex> guard(mutex_);
+      stat_.request_bytes -= allocation->size();
+      fallback_bytes_ -= AlignedSize(allocation->size());
+    }
+    underlying_allocator_->Free(allocation);
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    stat_.request_bytes -= allocation->size();
+    size_t offset = static_cast<char*>(allocation->ptr()) - base_;
+    size_t size = AlignedSize(allocation->size());
+    // coalesce with the free ranges before and after
+    auto next = free_.lower_bound(offset);
+    if (next != free_.end() && offset + size == next->first) {
+      size += next->second;
+      next = free_.erase(next);
+    }
+    if (next != free_.begin()) {
+      auto prev = std::prev(next);
+      if (prev->first + prev->second == offset) {
+        offset = prev->first;
+        size += prev->second;
+        free_.erase(prev);
+      }
+    }
+    free_[offset] = size;
+    if (--live_ == 0) {
+      stat_.resets++;
+    }
+  }
+  delete allocation;
+}
+
+void ArenaAllocator::EndRequest() {
+  std::lock_guard<std::mutex> guard(mutex_);
+  demand_ = std::max(demand_, peak_);
+  // the allocations still alive count for the next request
+  peak_ = Footprint();
+}
+
+bool ArenaAllocator::Contains(const void* ptr) const {
+  std::lock_guard<std::mutex> guard(mutex_);
+  auto* p = static_cast<const char*>(ptr);
+  return base_ != nullptr && p >= base_ && p < base_ + capacity_;
+}
+
+uint64_t ArenaAllocator::ReleaseImpl(const phi::Place& place UNUSED) {
+  // The block goes back to the underlying allocator, which is released by
+  // its owner. It grows back to the known demand on the next request.
+  std::lock_guard<std::mutex> guard(mutex_);
+  if (live_ > 0 || !block_) return 0;
+  uint64_t released = capacity_;
+  block_.reset();
+  base_ = nullptr;
+  capacity_ = 0;
+  free_.clear();
+  return released;
+}
+
+ArenaStat ArenaAllocator::GetStat() const {
+  std::lock_guard<std::mutex> guard(mutex_);
+  ArenaStat stat = stat_;
+  stat.capacity = capacity_;
+  return stat;
+}
+
+}  // namespace paddle::memory::allocation
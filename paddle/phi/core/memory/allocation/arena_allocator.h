@@ -0,0 +1,97 @@
+// Copyright (c) 2025 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <map>
+#include <memory>
+#include <mutex>  // NOLINT
+
+#include "paddle/phi/core/memory/allocation/allocator.h"
+
+namespace paddle {
+namespace memory {
+namespace allocation {
+
+struct ArenaStat {
+  size_t capacity{0};
+  // bytes in use, from the arena and from the underlying allocator
+  size_t request_bytes{0};
+  uint64_t arena_allocs{0};
+  uint64_t fallback_allocs{0};
+  uint64_t resets{0};
+};
+
+// An allocator over one block of the underlying allocator, for the
+// intermediate tensors of one request at a time.
+//
+// The arena is empty until the first EndRequest(). Every allocation falls
+// back to the underlying allocator until then, and the arena records the
+// peak of the bytes the request held at once. The block is then allocated
+// with that size, and grows the same way when a later request does not fit.
+//
+// The free ranges of the block are kept sorted by offset and coalesced on
+// free, an allocation takes the first range large enough, so the space of
+// the intermediates freed early is reused within the request. The peak
+// counts the end of the last live allocation in the block plus the live
+// fallback allocations, which also covers the gaps left by fragmentation.
+// The block is only (re)allocated while none of its allocations is alive,
+// so that no live allocation ever points into a released block.
+class ArenaAllocator : public Allocator {
+ public:
+  ArenaAllocator(std::shared_ptr<Allocator> underlying_allocator,
+                 size_t alignment);
+
+  bool IsAllocThreadSafe() const override { return true; }
+
+  // Marks the end of a request, whose demand sizes the next block.
+  void EndRequest();
+
+  bool Contains(const void* ptr) const;
+
+  ArenaStat GetStat() const;
+
+ protected:
+  phi::Allocation* AllocateImpl(size_t size) override;
+  void FreeImpl(phi::Allocation* allocation) override;
+  // Releases the block if the arena is empty, not the underlying allocator.
+  uint64_t ReleaseImpl(const phi::Place& place) override;
+
+ private:
+  size_t AlignedSize(size_t size) const;
+  // The end of the last live allocation in the block plus the live fallback
+  // bytes, the footprint the block has to cover. Requires mutex_.
+  size_t Footprint() const;
+
+  std::shared_ptr<Allocator> underlying_allocator_;
+  size_t alignment_;
+
+  mutable std::mutex mutex_;
+  AllocationPtr block_;
+  char* base_{nullptr};
+  size_t capacity_{0};
+  // the free ranges of the block, size by offset
+  std::map<size_t, size_t> free_;
+  size_t live_{0};
+  // aligned bytes of the live fallback allocations
+  size_t fallback_bytes_{0};
+  // the largest footprint of the current request and of all requests
+  size_t peak_{0};
+  size_t demand_{0};
+  ArenaStat stat_;
+};
+
+}  // namespace allocation
+}  // namespace memory
+}  // namespace paddle
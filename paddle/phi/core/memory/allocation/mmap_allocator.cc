@@ -18,7 +18,11 @@
 
 #include <fcntl.h>
 #include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cerrno>
 #include <cstdlib>
+#include <cstring>
 
 #include <atomic>
 #include <random>
@@ -323,6 +327,41 @@ std::shared_ptr<MemoryMapReaderAllocation> RebuildMemoryMapReaderAllocation(
   return std::make_shared<MemoryMapReaderAllocation>(ptr, size, ipc_name);
 }
 
+MemoryMappedFile::MemoryMappedFile(const std::string &path) : path_(path) {
+  int fd = open(path.c_str(), O_RDONLY);
+  PADDLE_ENFORCE_NE(fd,
+                    -1,
+                    common::errors::Unavailable(
+                        "Fail to open file %s to map, error: %s.",
+                        path.c_str(),
+                        strerror(errno)));
+  struct stat sb = {};
+  PADDLE_ENFORCE_EQ(
+      fstat(fd, &sb),
+      0,
+      common::errors::Unavailable("Fail to stat file %s.", path.c_str()));
+  size_ = static_cast<size_t>(sb.st_size);
+  if (size_ > 0) {
+    void *ptr =
+        mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    PADDLE_ENFORCE_NE(ptr,
+                      MAP_FAILED,
+                      common::errors::Unavailable(
+                          "Memory map failed for file %s, error: %s.",
+                          path.c_str(),
+                          strerror(errno)));
+    data_ = static_cast<char *>(ptr);
+  }
+  close(fd);
+  VLOG(4) << "Map file " << path_ << " of " << size_ << " bytes";
+}
+
+MemoryMappedFile::~MemoryMappedFile() {
+  if (data_ != nullptr && munmap(data_, size_) == -1) {
+    LOG(WARNING) << "Could not unmap the file " << path_;
+  }
+}
+
 MemoryMapFdSet &MemoryMapFdSet::Instance() {  // NOLINT
   static MemoryMapFdSet set;
   return set;
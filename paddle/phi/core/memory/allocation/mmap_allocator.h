@@ -154,6 +154,44 @@ std::shared_ptr<MemoryMapWriterAllocation> AllocateMemoryMapWriterAllocation(
 std::shared_ptr<MemoryMapReaderAllocation> RebuildMemoryMapReaderAllocation(
     const std::string &ipc_name, size_t size);
 
+// Private read-write mapping of a whole regular file. Writes go to
+// copy-on-write pages and never reach the file, so tensors backed by the
+// mapping may be modified in place.
+class MemoryMappedFile {
+ public:
+  explicit MemoryMappedFile(const std::string &path);
+  ~MemoryMappedFile();
+  MemoryMappedFile(const MemoryMappedFile &) = delete;
+  MemoryMappedFile &operator=(const MemoryMappedFile &) = delete;
+
+  inline char *data() const { return data_; }
+  inline size_t size() const { return size_; }
+  inline const std::string &path() const { return path_; }
+
+ private:
+  std::string path_;
+  char *data_ = nullptr;
+  size_t size_ = 0;
+};
+
+// A CPU allocation pointing into a MemoryMappedFile, the mapping lives as
+// long as any allocation that refers to it.
+class MemoryMapFileAllocation : public Allocation {
+ public:
+  MemoryMapFileAllocation(std::shared_ptr<MemoryMappedFile> file,
+                          size_t offset,
+                          size_t size)
+      : Allocation(file->data() + offset, size, phi::CPUPlace()),
+        file_(std::move(file)) {}
+
+  inline const std::shared_ptr<MemoryMappedFile> &file() const {
+    return file_;
+  }
+
+ private:
+  std::shared_ptr<MemoryMappedFile> file_;
+};
+
 class MemoryMapFdSet {
  public:
   static MemoryMapFdSet &Instance();  // NOLINT
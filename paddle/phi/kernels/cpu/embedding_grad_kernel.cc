@@ -17,6 +17,7 @@
 #include "paddle/phi/backends/cpu/cpu_context.h"
 #include "paddle/phi/common/data_type.h"
 #include "paddle/phi/core/kernel_registry.h"
+#include "paddle/phi/kernels/funcs/cpu_gather_scatter.h"
 #include "paddle/phi/kernels/funcs/embedding_util.h"
 
 namespace phi {
@@ -59,10 +60,7 @@ struct EmbeddingGradCPUFunctor {
 
       memset(d_table_data, 0, weight_grad_->numel() * sizeof(T));
       for (int64_t i = 0; i < ids_num; ++i) {
-        if (padding_idx_ != kNoPadding && ids_data[i] == padding_idx_) {
-          // the gradient of padding_idx should be 0, already done by memset, so
-          // do nothing.
-        } else {
+        if (padding_idx_ == kNoPadding || ids_data[i] != padding_idx_) {
           PADDLE_ENFORCE_LT(
               ids_data[i],
               N,
@@ -83,11 +81,23 @@ struct EmbeddingGradCPUFunctor {
                   "value.",
                   N,
                   ids_data[i]));
-          for (int j = 0; j < D; ++j) {
-            d_table_data[ids_data[i] * D + j] += d_output_data[i * D + j];
-          }
         }
       }
+      // the rows of duplicated ids are reduced in parallel, each by one
+      // thread
+      funcs::ScatterRows(d_output_data,
+                         1,
+                         N,
+                         ids_data,
+                         ids_num,
+                         D,
+                         false,
+                         false,
+                         d_table_data);
+      if (padding_idx_ != kNoPadding && padding_idx_ >= 0 && padding_idx_ < N) {
+        // the gradient of padding_idx should be 0
+        memset(d_table_data + padding_idx_ * D, 0, D * sizeof(T));
+      }
     }
   }
 
@@ -145,31 +155,65 @@ struct EmbeddingSparseGradCPUFunctor {
     // paddings makes no sense and we don't deal with it in backward.
     auto* d_table = weight_grad_;
     auto* d_output = &out_grad_;
-    d_table->set_rows(ids);
-
-    auto* d_table_value = d_table->mutable_value();
-    d_table_value->Resize({ids_num, table_dim[1]});
-
-    dev_ctx_.template Alloc<T>(d_table_value);
-
-    d_table->set_height(table_dim[0]);
-
-    auto* d_output_data = d_output->template data<T>();
-    auto* d_table_data = d_table_value->template data<T>();
+    const int64_t D = table_dim[1];
 
     auto d_output_dims = d_output->dims();
     auto d_output_dims_2d =
         flatten_to_2d(d_output_dims, d_output_dims.size() - 1);
-    PADDLE_ENFORCE_EQ(d_table_value->dims(),
+    PADDLE_ENFORCE_EQ(common::make_ddim({ids_num, D}),
                       d_output_dims_2d,
                       common::errors::InvalidArgument(
                           "ShapeError: The shape of lookup_table@Grad and "
                           "output@Grad should be same. "
                           "But received lookup_table@Grad's shape = [%s], "
                           "output@Grad's shape = [%s].",
-                          d_table_value->dims(),
+                          common::make_ddim({ids_num, D}),
                           d_output_dims_2d));
-    memcpy(d_table_data, d_output_data, sizeof(T) * d_output->numel());
+
+    for (int64_t i = 0; i < ids_num; ++i) {
+      PADDLE_ENFORCE_EQ(
+          ids[i] >= 0 && ids[i] < table_dim[0],
+          true,
+          common::errors::InvalidArgument(
+              "Variable value (input) of OP(paddle.nn.functional.embedding) "
+              "expected >= 0 and < %ld, but got %ld. Please check input "
+              "value.",
+              table_dim[0],
+              ids[i]));
+    }
+    // The gradient holds one row per distinct id, so that the optimizer
+    // updates each row once without merging the duplicates: the positions
+    // of the ids are radix sorted by id and the rows of each id are summed
+    // by one thread, in the order of the ids.
+    std::vector<int64_t> order, segments;
+    funcs::IndexSegments(ids.data(), ids_num, table_dim[0], &order, &segments);
+    const int64_t num_rows = static_cast<int64_t>(segments.size());
+    std::vector<int64_t> rows(num_rows);
+    for (int64_t s = 0; s < num_rows; ++s) {
+      rows[s] = ids[order[segments[s]]];
+    }
+    d_table->set_rows(rows);
+    d_table->set_height(table_dim[0]);
+
+    auto* d_table_value = d_table->mutable_value();
+    d_table_value->Resize({num_rows, D});
+    auto* d_table_data = dev_ctx_.template Alloc<T>(d_table_value);
+    auto* d_output_data = d_output->template data<T>();
+
+#ifdef PADDLE_WITH_MKLML
+#pragma omp parallel for schedule(dynamic, 16) if (ids_num * D >= 1 << 14)
+#endif
+    for (int64_t s = 0; s < num_rows; ++s) {
+      const int64_t end = s + 1 < num_rows ? segments[s + 1] : ids_num;
+      T* row = d_table_data + s * D;
+      std::memcpy(row, d_output_data + order[segments[s]] * D, D * sizeof(T));
+      for (int64_t i = segments[s] + 1; i < end; ++i) {
+        const T* grad = d_output_data + order[i] * D;
+        for (int64_t j = 0; j < D; ++j) {
+          row[j] += grad[j];
+        }
+      }
+    }
   }
 
  private:
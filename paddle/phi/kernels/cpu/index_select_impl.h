@@ -18,40 +18,11 @@
 
 #include "paddle/phi/core/dense_tensor.h"
 #include "paddle/phi/core/tensor_utils.h"
-#include "paddle/phi/kernels/funcs/blas/blas.h"
-#include "paddle/phi/kernels/funcs/eigen/common.h"
+#include "paddle/phi/kernels/funcs/cpu_gather_scatter.h"
 #include "paddle/phi/kernels/funcs/math_function.h"
 
 namespace phi {
 
-template <typename Context, typename T, class Enable = void>
-struct IndexSelectAdd {
-  void operator()(const Context& ctx UNUSED,
-                  int slice_size,
-                  const T* src_pointer,
-                  const T* p_pointer,
-                  T* dist_pointer) {
-    for (int i = 0; i < slice_size; i++) {
-      dist_pointer[i] = src_pointer[i] + p_pointer[i];
-    }
-  }
-};
-
-template <typename Context, typename T>
-struct IndexSelectAdd<
-    Context,
-    T,
-    typename std::enable_if<std::is_floating_point<T>::value>::type> {
-  void operator()(const Context& ctx,
-                  int slice_size,
-                  const T* src_pointer,
-                  const T* p_pointer,
-                  T* dist_pointer) {
-    auto blas = phi::funcs::GetBlas<Context, T>(ctx);
-    blas.VADD(slice_size, src_pointer, p_pointer, dist_pointer);
-  }
-};
-
 template <typename Context, typename T, typename IndexT = int>
 void IndexSelectInner(const Context& ctx,
                       DenseTensor* input,
@@ -60,7 +31,6 @@ void IndexSelectInner(const Context& ctx,
                       int dim) {
   auto input_dim = input->dims();
   auto input_dim_size = input_dim.size();
-  auto output_dim = output->dims();
   auto index_size = index.dims()[0];
 
   DenseTensor index_cpu_copy;
@@ -72,12 +42,12 @@ void IndexSelectInner(const Context& ctx,
                                  : index_cpu_copy.data<IndexT>();
   ctx.template Alloc<T>(output);
 
-  auto slice_size = 1;
+  int64_t slice_size = 1;
   for (auto i = dim + 1; i < input_dim_size; i++) {
     slice_size *= input_dim[i];
   }
 
-  auto outer_nums = 1;
+  int64_t outer_nums = 1;
   for (auto i = 0; i < dim; i++) {
     outer_nums *= input_dim[i];
   }
@@ -108,24 +78,13 @@ void IndexSelectInner(const Context& ctx,
   VLOG(3) << "Index_Select_Debug; outer_nums: " << outer_nums
           << "; slice_size: " << slice_size << "; index_size: " << index_size;
 
-  input->Resize(common::make_ddim({outer_nums, input_dim[dim], slice_size}));
-  output->Resize(common::make_ddim({outer_nums, index_size, slice_size}));
-
-  auto input_tensor = EigenTensor<T, 3>::From(*input);
-  auto output_tensor = EigenTensor<T, 3>::From(*output);
-
-  auto& place = *ctx.eigen_device();
-
-  for (auto j = 0; j < index_size; j++) {
-    IndexT index_value = index_data[j];
-    if (index_value < 0) {
-      index_value += input_dim[dim];
-    }
-    auto output_t = output_tensor.chip(j, 1);
-    output_t.device(place) = input_tensor.chip(index_value, 1);
-  }
-  input->Resize(input_dim);
-  output->Resize(output_dim);
+  phi::funcs::GatherRows(input->data<T>(),
+                         outer_nums,
+                         input_dim[dim],
+                         index_data,
+                         index_size,
+                         slice_size,
+                         output->data<T>());
 }
 
 template <typename Context, typename T, typename IndexT = int>
@@ -137,7 +96,6 @@ void IndexSelectGradInner(const Context& ctx,
   const T* input_data = out_grad.data<T>();
   const IndexT* index_data = index.data<IndexT>();
 
-  const T* p_output = ctx.template Alloc<T>(x_grad);
   T* out_data = ctx.template Alloc<T>(x_grad);
 
   auto input_dim = out_grad.dims();
@@ -147,7 +105,7 @@ void IndexSelectGradInner(const Context& ctx,
   phi::funcs::SetConstant<Context, T> set_constant;
   set_constant(ctx, x_grad, static_cast<T>(0.0));
 
-  auto slice_size = 1;
+  int64_t slice_size = 1;
   for (auto i = dim + 1; i < input_dim_size; i++) {
     slice_size *= input_dim[i];
   }
@@ -155,7 +113,7 @@ void IndexSelectGradInner(const Context& ctx,
   auto input_width = slice_size * input_dim[dim];
   auto output_width = slice_size * output_dim[dim];
 
-  auto outer_nums = 1;
+  int64_t outer_nums = 1;
   for (auto i = 0; i < dim; i++) {
     outer_nums *= input_dim[i];
   }
@@ -166,22 +124,15 @@ void IndexSelectGradInner(const Context& ctx,
           << "; output_width: " << output_width
           << "; index_size: " << index_size;
 
-  for (auto i = 0; i < outer_nums; i++) {
-    auto input_start_offset = i * input_width;
-    auto output_start_offset = i * output_width;
-
-    for (auto j = 0; j < index_size; j++) {
-      IndexT index_value = index_data[j];
-      if (index_value < 0) {
-        index_value += input_dim[dim];
-      }
-      auto src = input_data + input_start_offset + j * slice_size;
-      auto p_out = p_output + output_start_offset + index_value * slice_size;
-      auto dst = out_data + output_start_offset + index_value * slice_size;
-      IndexSelectAdd<Context, T> index_select_add;
-      index_select_add(ctx, slice_size, src, p_out, dst);
-    }
-  }
+  phi::funcs::ScatterRows(input_data,
+                          outer_nums,
+                          output_dim[dim],
+                          index_data,
+                          index_size,
+                          slice_size,
+                          false,
+                          false,
+                          out_data);
   x_grad->Resize(output_dim);
 }
 
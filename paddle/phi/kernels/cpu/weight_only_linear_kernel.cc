@@ -0,0 +1,174 @@
+// Copyright (c) 2025 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/phi/kernels/weight_only_linear_kernel.h"
+
+#include <algorithm>
+#include <type_traits>
+
+#include "paddle/phi/backends/cpu/cpu_context.h"
+#include "paddle/phi/core/kernel_registry.h"
+#include "paddle/phi/kernels/funcs/blas/blas.h"
+#include "paddle/phi/kernels/funcs/weight_only_gemm.h"
+
+namespace phi {
+
+namespace {
+
+// From this number of rows the GEMM is compute bound: the weights are
+// dequantized once per block of channels and multiplied by BLAS. Below it
+// the microkernels read the quantized weights directly.
+constexpr int64_t kBlasMinRows = 32;
+constexpr int64_t kBlasChannelBlock = 256;
+// Output channels per parallel task of the microkernels.
+constexpr int64_t kTaskChannels = 16;
+
+template <typename T>
+const float* AsFloat(const CPUContext& dev_ctx,
+                     const DenseTensor& x,
+                     DenseTensor* buffer) {
+  if (std::is_same<T, float>::value) {
+    return x.data<float>();
+  }
+  buffer->Resize(x.dims());
+  float* data = dev_ctx.template Alloc<float>(buffer);
+  const T* x_data = x.data<T>();
+  for (int64_t i = 0; i < x.numel(); ++i) {
+    data[i] = static_cast<float>(x_data[i]);
+  }
+  return data;
+}
+
+}  // namespace
+
+template <typename T, typename Context>
+void WeightOnlyLinearKernel(const Context& dev_ctx,
+                            const DenseTensor& x,
+                            const DenseTensor& weight,
+                            const paddle::optional<DenseTensor>& bias,
+                            const DenseTensor& weight_scale,
+                            const std::string& weight_dtype,
+                            const int32_t arch,
+                            const int32_t group_size,
+                            DenseTensor* out) {
+  PADDLE_ENFORCE_EQ(
+      arch,
+      funcs::kWeightOnlyCPUArch,
+      common::errors::InvalidArgument(
+          "The CPU kernel of weight_only_linear takes the weight layout of "
+          "weight_quantize with arch %d, but got arch %d.",
+          funcs::kWeightOnlyCPUArch,
+          arch));
+  dev_ctx.template Alloc<T>(out);
+
+  funcs::WeightOnlyGemmParam param;
+  param.bits = weight_dtype == "int4" ? 4 : 8;
+  param.k = weight.dims()[1];
+  param.n = group_size > 0 ? weight_scale.dims()[1] : weight_scale.dims()[0];
+  param.m = x.numel() / param.k;
+  param.group_size = group_size > 0 ? group_size : param.k;
+  PADDLE_ENFORCE_EQ(
+      param.n % funcs::kWeightOnlyChannelBlock,
+      0,
+      common::errors::InvalidArgument(
+          "The number of output channels of weight_only_linear must be "
+          "divisible by %d, but got %d.",
+          funcs::kWeightOnlyChannelBlock,
+          param.n));
+  if (group_size > 0) {
+    PADDLE_ENFORCE_EQ(
+        weight_scale.dims()[0],
+        (param.k + group_size - 1) / group_size,
+        common::errors::InvalidArgument(
+            "The group-wise scale of weight_only_linear must have "
+            "ceil(k / group_size) = %d rows, but got %d.",
+            (param.k + group_size - 1) / group_size,
+            weight_scale.dims()[0]));
+  }
+  if (param.m == 0) {
+    return;
+  }
+
+  DenseTensor x_float, scale_float, bias_float, out_float;
+  param.x = AsFloat<T>(dev_ctx, x, &x_float);
+  param.weight = weight.data<int8_t>();
+  param.scale = AsFloat<T>(dev_ctx, weight_scale, &scale_float);
+  param.bias = bias ? AsFloat<T>(dev_ctx, bias.get(), &bias_float) : nullptr;
+  if (std::is_same<T, float>::value) {
+    param.out = out->data<float>();
+  } else {
+    out_float.Resize(out->dims());
+    param.out = dev_ctx.template Alloc<float>(&out_float);
+  }
+
+  if (param.m >= kBlasMinRows) {
+    auto blas = funcs::GetBlas<Context, float>(dev_ctx);
+    DenseTensor dequantized;
+    dequantized.Resize({std::min(kBlasChannelBlock, param.n), param.k});
+    float* w = dev_ctx.template Alloc<float>(&dequantized);
+    for (int64_t n = 0; n < param.n; n += kBlasChannelBlock) {
+      int64_t n_end = std::min(n + kBlasChannelBlock, param.n);
+      funcs::WeightOnlyDequantize(param, n, n_end, w);
+      blas.GEMM(false,
+                true,
+                param.m,
+                n_end - n,
+                param.k,
+                1.f,
+                param.x,
+                param.k,
+                w,
+                param.k,
+                0.f,
+                param.out + n,
+                param.n);
+    }
+    if (param.bias != nullptr) {
+      for (int64_t m = 0; m < param.m; ++m) {
+        for (int64_t n = 0; n < param.n; ++n) {
+          param.out[m * param.n + n] += param.bias[n];
+        }
+      }
+    }
+  } else {
+    int64_t num_tasks = (param.n + kTaskChannels - 1) / kTaskChannels;
+#ifdef PADDLE_WITH_MKLML
+#pragma omp parallel for
+#endif
+    for (int64_t task = 0; task < num_tasks; ++task) {
+      funcs::WeightOnlyGemmTile(param,
+                                0,
+                                param.m,
+                                task * kTaskChannels,
+                                std::min((task + 1) * kTaskChannels, param.n));
+    }
+  }
+
+  if (!std::is_same<T, float>::value) {
+    T* out_data = out->data<T>();
+    for (int64_t i = 0; i < out->numel(); ++i) {
+      out_data[i] = static_cast<T>(param.out[i]);
+    }
+  }
+}
+
+}  // namespace phi
+
+PD_REGISTER_KERNEL(weight_only_linear,
+                   CPU,
+                   ALL_LAYOUT,
+                   phi::WeightOnlyLinearKernel,
+                   float,
+                   phi::dtype::float16,
+                   phi::dtype::bfloat16) {}
@@ -13,11 +13,15 @@ See the License for the specific language governing permissions and
 limitations under the License. */
 
 #include "paddle/phi/kernels/weight_quantize_kernel.h"
+
+#include <algorithm>
+
 #include "paddle/phi/backends/cpu/cpu_context.h"
 #include "paddle/phi/core/dense_tensor.h"
 #include "paddle/phi/core/kernel_registry.h"
 #include "paddle/phi/kernels/funcs/blas/blas.h"
 #include "paddle/phi/kernels/funcs/common_shape.h"
+#include "paddle/phi/kernels/funcs/weight_only_gemm.h"
 #include "paddle/phi/kernels/impl/weight_quantize_kernel_impl.h"
 
 namespace phi {
@@ -36,11 +40,11 @@ void quant_compute(const DeviceContext& dev_ctx,
                    const int32_t group_size) {
 #ifndef PADDLE_WITH_HIP
   PADDLE_ENFORCE_EQ(
-      ((arch == 70) || (arch == 75) || (arch == 80) || (arch == 86) ||
-       (arch == 89) || (arch == 90)),
+      ((arch == funcs::kWeightOnlyCPUArch) || (arch == 70) || (arch == 75) ||
+       (arch == 80) || (arch == 86) || (arch == 89) || (arch == 90)),
       true,
       common::errors::InvalidArgument(
-          "Currently, arch only support 70, 75, 80, 86, 89, 90."));
+          "Currently, arch only support 0 (cpu), 70, 75, 80, 86, 89, 90."));
 
 #endif
   const auto x_dims = x.dims();
@@ -62,8 +66,8 @@ void quant_compute(const DeviceContext& dev_ctx,
 #ifdef PADDLE_WITH_HIP
   x_int.Resize({static_cast<int64_t>(m), static_cast<int64_t>(n)});
 #else
-  if ((arch == 80) || (arch == 75) || (arch == 86) || (arch == 89) ||
-      (arch == 90)) {
+  if ((arch == funcs::kWeightOnlyCPUArch) || (arch == 80) || (arch == 75) ||
+      (arch == 86) || (arch == 89) || (arch == 90)) {
     x_int.Resize({static_cast<int64_t>(m), static_cast<int64_t>(n)});
   } else {
     // phi::Copy may change tensor meta info, here we transpose the quanted
@@ -124,7 +128,19 @@ void quant_compute(const DeviceContext& dev_ctx,
       trans(dev_ctx, x_int_tmp, out, axis);
     }
 #else
-    if (arch == 70) {
+    if (arch == funcs::kWeightOnlyCPUArch) {
+      // Row j of out holds output channel j, or channels 2 * j and
+      // 2 * j + 1 in the low and high nibbles for int4, see
+      // funcs::kWeightOnlyCPUArch.
+      DenseTensor x_packed(x_int.type());
+      x_packed.Resize(
+          {static_cast<int64_t>(m), static_cast<int64_t>(n * bits / 8)});
+      dev_ctx.template Alloc<D>(&x_packed);
+      std::copy(x_int_data, x_int_data + x_packed.numel(), x_packed.data<D>());
+      std::vector<int> axis = {1, 0};
+      funcs::Transpose<DeviceContext, int8_t, 2> trans;
+      trans(dev_ctx, x_packed, out, axis);
+    } else if (arch == 70) {
       // Note(Zhengzekang): In sm70, we only need RowMajor layout, just add bias
       // to make it unsigned.
       add_bias_and_interleave_inplace<bits>(x_int_data, num);
@@ -182,5 +198,6 @@ PD_REGISTER_KERNEL(weight_quantize,
                    CPU,
                    ALL_LAYOUT,
                    phi::WeightQuantizeKernel,
+                   float,
                    phi::dtype::float16,
                    phi::dtype::bfloat16) {}
@@ -0,0 +1,270 @@
+// Copyright (c) 2025 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/phi/kernels/funcs/amx_gemm.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "paddle/phi/backends/cpu/cpu_info.h"
+#include "paddle/phi/core/dense_tensor.h"
+#include "paddle/phi/core/enforce.h"
+#include "paddle/phi/kernels/funcs/packed_weight_cache.h"
+
+namespace phi {
+namespace funcs {
+
+namespace {
+
+// Rows and channels of a parallel task.
+constexpr int64_t kTaskRows = 2 * kAmxTileRows;
+constexpr int64_t kTaskChannels = 4 * kAmxTileChannels;
+
+inline int64_t RoundUp(int64_t x, int64_t multiple) {
+  return (x + multiple - 1) / multiple * multiple;
+}
+
+// The symmetric int8 scale of values whose largest magnitude is max_abs,
+// and the values quantized with it.
+inline float Int8Scale(float max_abs) { return max_abs / 127.f; }
+
+inline int8_t QuantizeInt8(float value, float inv_scale) {
+  float q = std::nearbyint(value * inv_scale);
+  return static_cast<int8_t>(std::min(127.f, std::max(-127.f, q)));
+}
+
+void AmxGemmTileRef(const AmxGemmParam& param,
+                    const detail::AmxPackedInput& input,
+                    int64_t m_begin,
+                    int64_t m_end,
+                    int64_t n_begin,
+                    int64_t n_end) {
+  const AmxPackedWeight& w = *param.weight;
+  const int64_t vnni = AmxVnni(w.type);
+  const int64_t tile_k = AmxTileK(w.type);
+  for (int64_t m = m_begin; m < m_end; m += kAmxTileRows) {
+    for (int64_t n = n_begin; n < n_end; n += kAmxTileChannels) {
+      float acc_float[kAmxTileRows * kAmxTileChannels] = {0};
+      int32_t acc_int[kAmxTileRows * kAmxTileChannels] = {0};
+      for (int64_t kb = 0; kb < w.k_padded / tile_k; ++kb) {
+        const void* tile = w.Tile(n / kAmxTileChannels, kb);
+        for (int64_t r = 0; r < kAmxTileRows; ++r) {
+          for (int64_t c = 0; c < kAmxTileChannels; ++c) {
+            // row i of the tile of B holds k values kb * tile_k + i * vnni
+            // and the next ones
+            for (int64_t i = 0; i < kAmxTileRows; ++i) {
+              for (int64_t v = 0; v < vnni; ++v) {
+                const int64_t a = (m + r) * w.k_padded + kb * tile_k +
+                                  i * vnni + v;
+                const int64_t b = (i * kAmxTileChannels + c) * vnni + v;
+                if (w.type == AmxGemmType::kBF16) {
+                  acc_float[r * kAmxTileChannels + c] +=
+                      static_cast<float>(input.bf16[a]) *
+                      static_cast<float>(
+                          static_cast<const phi::dtype::bfloat16*>(tile)[b]);
+                } else {
+                  acc_int[r * kAmxTileChannels + c] +=
+                      static_cast<int32_t>(input.int8[a]) *
+                      static_cast<const int8_t*>(tile)[b];
+                }
+              }
+            }
+          }
+        }
+      }
+      detail::AmxGemmEpilogue(param,
+                              input,
+                              w.type == AmxGemmType::kBF16
+                                  ? static_cast<const void*>(acc_float)
+                                  : static_cast<const void*>(acc_int),
+                              m,
+                              n);
+    }
+  }
+}
+
+}  // namespace
+
+std::unique_ptr<AmxPackedWeight> AmxPackWeight(const float* w,
+                                               int64_t k,
+                                               int64_t n,
+                                               AmxGemmType type) {
+  auto packed = std::make_unique<AmxPackedWeight>();
+  packed->type = type;
+  packed->k = k;
+  packed->n = n;
+  packed->k_padded = RoundUp(k, AmxTileK(type));
+  packed->n_padded = RoundUp(n, kAmxTileChannels);
+  const int64_t vnni = AmxVnni(type);
+  const int64_t tile_k = AmxTileK(type);
+  const int64_t size = packed->k_padded * packed->n_padded;
+  std::vector<float> inv_scale;
+  if (type == AmxGemmType::kBF16) {
+    packed->bf16.resize(size, phi::dtype::bfloat16(0.f));
+  } else {
+    packed->int8.resize(size, 0);
+    packed->scale.resize(packed->n_padded, 0.f);
+    inv_scale.resize(n, 0.f);
+    for (int64_t j = 0; j < n; ++j) {
+      float max_abs = 0.f;
+      for (int64_t i = 0; i < k; ++i) {
+        max_abs = std::max(max_abs, std::abs(w[i * n + j]));
+      }
+      packed->scale[j] = Int8Scale(max_abs);
+      inv_scale[j] = max_abs > 0.f ? 1.f / packed->scale[j] : 0.f;
+    }
+  }
+
+  for (int64_t i = 0; i < k; ++i) {
+    for (int64_t j = 0; j < n; ++j) {
+      // row i % tile_k / vnni of the tile, at the place of channel j
+      const int64_t idx =
+          packed->TileOffset(j / kAmxTileChannels, i / tile_k) +
+          (i % tile_k / vnni * kAmxTileChannels + j % kAmxTileChannels) *
+              vnni +
+          i % vnni;
+      if (type == AmxGemmType::kBF16) {
+        packed->bf16[idx] = phi::dtype::bfloat16(w[i * n + j]);
+      } else {
+        packed->int8[idx] = QuantizeInt8(w[i * n + j], inv_scale[j]);
+      }
+    }
+  }
+  return packed;
+}
+
+std::shared_ptr<const AmxPackedWeight> GetAmxPackedWeight(
+    const DenseTensor& w, AmxGemmType type) {
+  PADDLE_ENFORCE_EQ(
+      w.dims().size(),
+      2,
+      common::errors::InvalidArgument(
+          "The weight packed for the AMX GEMM must be 2-D, but got %d-D.",
+          w.dims().size()));
+  return PackedWeightCache::Instance().Get<AmxPackedWeight>(
+      w,
+      type == AmxGemmType::kBF16 ? "amx_bf16" : "amx_int8",
+      [&w, type]() {
+        return AmxPackWeight(w.data<float>(), w.dims()[0], w.dims()[1], type);
+      });
+}
+
+bool AmxGemmAvailable(AmxGemmType type) {
+  namespace cpu = phi::backends::cpu;
+  static const bool bf16 =
+      detail::AmxGemmAMXCompiled() && cpu::MayIUse(cpu::amx_bf16);
+  static const bool int8 =
+      detail::AmxGemmAMXCompiled() && cpu::MayIUse(cpu::amx_int8);
+  return type == AmxGemmType::kBF16 ? bf16 : int8;
+}
+
+void AmxGemm(const AmxGemmParam& param) {
+  const AmxPackedWeight& w = *param.weight;
+  const int64_t m_padded = RoundUp(param.m, kAmxTileRows);
+  const int64_t k = w.k;
+
+  // the rows of x in the layout of the tiles of A, padded with zeros
+  std::vector<phi::dtype::bfloat16> x_bf16;
+  std::vector<int8_t> x_int8;
+  std::vector<float> x_scale;
+  if (w.type == AmxGemmType::kBF16) {
+    x_bf16.resize(m_padded * w.k_padded, phi::dtype::bfloat16(0.f));
+  } else {
+    x_int8.resize(m_padded * w.k_padded, 0);
+    x_scale.resize(m_padded, 0.f);
+  }
+#ifdef PADDLE_WITH_MKLML
+#pragma omp parallel for
+#endif
+  for (int64_t i = 0; i < param.m; ++i) {
+    const float* x = param.x + i * k;
+    if (w.type == AmxGemmType::kBF16) {
+      phi::dtype::bfloat16* row = x_bf16.data() + i * w.k_padded;
+      for (int64_t j = 0; j < k; ++j) {
+        row[j] = phi::dtype::bfloat16(x[j]);
+      }
+    } else {
+      float max_abs = 0.f;
+      for (int64_t j = 0; j < k; ++j) {
+        max_abs = std::max(max_abs, std::abs(x[j]));
+      }
+      x_scale[i] = Int8Scale(max_abs);
+      const float inv_scale = max_abs > 0.f ? 1.f / x_scale[i] : 0.f;
+      int8_t* row = x_int8.data() + i * w.k_padded;
+      for (int64_t j = 0; j < k; ++j) {
+        row[j] = QuantizeInt8(x[j], inv_scale);
+      }
+    }
+  }
+  detail::AmxPackedInput input{x_bf16.data(), x_int8.data(), x_scale.data()};
+
+  auto gemm_tile =
+      AmxGemmAvailable(w.type) ? detail::AmxGemmTileAMX : AmxGemmTileRef;
+  const int64_t row_tasks = (m_padded + kTaskRows - 1) / kTaskRows;
+  const int64_t channel_tasks =
+      (w.n_padded + kTaskChannels - 1) / kTaskChannels;
+#ifdef PADDLE_WITH_MKLML
+#pragma omp parallel for
+#endif
+  for (int64_t task = 0; task < row_tasks * channel_tasks; ++task) {
+    const int64_t m = task / channel_tasks * kTaskRows;
+    const int64_t n = task % channel_tasks * kTaskChannels;
+    gemm_tile(param,
+              input,
+              m,
+              std::min(m + kTaskRows, m_padded),
+              n,
+              std::min(n + kTaskChannels, w.n_padded));
+  }
+}
+
+namespace detail {
+
+void AmxGemmEpilogue(const AmxGemmParam& param,
+                     const AmxPackedInput& input,
+                     const void* acc,
+                     int64_t m,
+                     int64_t n) {
+  const AmxPackedWeight& w = *param.weight;
+  const int64_t rows = std::min(kAmxTileRows, param.m - m);
+  const int64_t cols = std::min(kAmxTileChannels, w.n - n);
+  for (int64_t r = 0; r < rows; ++r) {
+    float* out = param.out + (m + r) * w.n + n;
+    for (int64_t c = 0; c < cols; ++c) {
+      float value;
+      if (w.type == AmxGemmType::kBF16) {
+        value = static_cast<const float*>(acc)[r * kAmxTileChannels + c];
+      } else {
+        value = static_cast<float>(
+                    static_cast<const int32_t*>(acc)[r * kAmxTileChannels +
+                                                     c]) *
+                input.scale[m + r] * w.scale[n + c];
+      }
+      if (param.bias != nullptr) {
+        value += param.bias[n + c];
+      }
+      if (param.act == AmxActivation::kRelu) {
+        value = std::max(value, 0.f);
+      } else if (param.act == AmxActivation::kGelu) {
+        value = 0.5f * value * (1.f + std::erf(value * 0.70710678f));
+      }
+      out[c] = value;
+    }
+  }
+}
+
+}  // namespace detail
+
+}  // namespace funcs
+}  // namespace phi
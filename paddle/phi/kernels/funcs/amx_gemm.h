@@ -0,0 +1,141 @@
+// Copyright (c) 2025 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "paddle/phi/common/bfloat16.h"
+
+namespace phi {
+class DenseTensor;
+
+namespace funcs {
+
+enum class AmxGemmType { kBF16, kInt8 };
+
+enum class AmxActivation { kNone, kRelu, kGelu };
+
+// A tile holds 16 rows of 64 bytes. The tiles of A are 16 rows of x by 32
+// bf16 or 64 int8 values of k, the tiles of C 16 rows by 16 float or int32
+// output channels, and the rows of the tiles of B hold 2 bf16 or 4 int8
+// consecutive values of k for each of the 16 channels.
+constexpr int64_t kAmxTileRows = 16;
+constexpr int64_t kAmxTileChannels = 16;
+constexpr int64_t kAmxTileBytes = 64;
+
+// The values of k packed together in a row of a tile of B.
+inline int64_t AmxVnni(AmxGemmType type) {
+  return type == AmxGemmType::kBF16 ? 2 : 4;
+}
+
+// The values of k of a tile of A.
+inline int64_t AmxTileK(AmxGemmType type) {
+  return kAmxTileRows * AmxVnni(type);
+}
+
+// A [k, n] float weight as tiles of B: the tiles of the blocks of 16
+// channels, each the tiles along k, k and n padded with zeros. The int8
+// weights are quantized symmetrically per channel.
+struct AmxPackedWeight {
+  AmxGemmType type;
+  int64_t k;
+  int64_t n;
+  int64_t k_padded;
+  int64_t n_padded;
+  std::vector<phi::dtype::bfloat16> bf16;
+  std::vector<int8_t> int8;
+  // [n_padded] for int8
+  std::vector<float> scale;
+
+  // The offset of the tile of B of channel block nb and k block kb, in
+  // values.
+  int64_t TileOffset(int64_t nb, int64_t kb) const {
+    return (nb * (k_padded / AmxTileK(type)) + kb) * kAmxTileRows *
+           kAmxTileChannels * AmxVnni(type);
+  }
+
+  const void* Tile(int64_t nb, int64_t kb) const {
+    return type == AmxGemmType::kBF16
+               ? static_cast<const void*>(bf16.data() + TileOffset(nb, kb))
+               : static_cast<const void*>(int8.data() + TileOffset(nb, kb));
+  }
+};
+
+std::unique_ptr<AmxPackedWeight> AmxPackWeight(const float* w,
+                                               int64_t k,
+                                               int64_t n,
+                                               AmxGemmType type);
+
+// The packed weight of the [k, n] parameter w, packed at the first call
+// for its allocation and kept while it lives: the values of w must not
+// change after the first call.
+std::shared_ptr<const AmxPackedWeight> GetAmxPackedWeight(
+    const DenseTensor& w, AmxGemmType type);
+
+struct AmxGemmParam {
+  const float* x;  // [m, k]
+  const AmxPackedWeight* weight;
+  const float* bias;  // [n] or nullptr
+  AmxActivation act;
+  float* out;  // [m, n]
+  int64_t m;
+};
+
+// Whether the CPU has the AMX tiles of `type` and the build uses them.
+bool AmxGemmAvailable(AmxGemmType type);
+
+// out = act(x * w + bias). The rows of x are rounded to bf16, or quantized
+// to int8 symmetrically per row, and the products accumulated in float or
+// int32, with the AMX tiles when AmxGemmAvailable and with the same
+// arithmetic in scalar code otherwise.
+void AmxGemm(const AmxGemmParam& param);
+
+namespace detail {
+
+// x packed as the rows of the tiles of A: [m_padded, k_padded] bf16 or int8,
+// and the scale of each row for int8.
+struct AmxPackedInput {
+  const phi::dtype::bfloat16* bf16;
+  const int8_t* int8;
+  const float* scale;
+};
+
+// Writes acc, the 16x16 float or int32 tile of C at row m and channel n,
+// to out: scaled by the scales of the rows and the channels for int8, plus
+// the bias, through the activation, and without the padding.
+void AmxGemmEpilogue(const AmxGemmParam& param,
+                     const AmxPackedInput& input,
+                     const void* acc,
+                     int64_t m,
+                     int64_t n);
+
+// The AMX microkernel of amx_gemm_amx.cc, for the rows [m_begin, m_end)
+// and the channels [n_begin, n_end), multiples of 16 in the padded sizes.
+// AmxGemmAMXCompiled tells whether the file was built with AMX, the tiles
+// must not be called otherwise.
+bool AmxGemmAMXCompiled();
+void AmxGemmTileAMX(const AmxGemmParam& param,
+                    const AmxPackedInput& input,
+                    int64_t m_begin,
+                    int64_t m_end,
+                    int64_t n_begin,
+                    int64_t n_end);
+
+}  // namespace detail
+
+}  // namespace funcs
+}  // namespace phi
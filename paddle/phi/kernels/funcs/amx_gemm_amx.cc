@@ -0,0 +1,188 @@
+// Copyright (c) 2025 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/phi/kernels/funcs/amx_gemm.h"
+
+#if defined(__AMX_TILE__) && defined(__AMX_BF16__) && defined(__AMX_INT8__)
+#include <immintrin.h>
+#endif
+
+#include "paddle/phi/core/enforce.h"
+
+namespace phi {
+namespace funcs {
+namespace detail {
+
+#if defined(__AMX_TILE__) && defined(__AMX_BF16__) && defined(__AMX_INT8__)
+
+namespace {
+
+// tmm0 to tmm3 accumulate a 2x2 block of tiles of C, from the tiles of A in
+// tmm4 and tmm5 and the tiles of B in tmm6 and tmm7.
+struct alignas(64) TileConfig {
+  uint8_t palette_id;
+  uint8_t start_row;
+  uint8_t reserved[14];
+  uint16_t colsb[16];
+  uint8_t rows[16];
+};
+
+void LoadTileConfig() {
+  TileConfig config = {};
+  config.palette_id = 1;
+  for (int i = 0; i < 8; ++i) {
+    config.rows[i] = kAmxTileRows;
+    config.colsb[i] = kAmxTileBytes;
+  }
+  _tile_loadconfig(&config);
+}
+
+// The tiles of C of rows [m, m + 16 * kRows) and channels [n, n + 16 *
+// kCols), kRows and kCols 1 or 2.
+template <AmxGemmType kType, int kRows, int kCols>
+void GemmBlock(const AmxGemmParam& param,
+               const AmxPackedInput& input,
+               int64_t m,
+               int64_t n) {
+  const AmxPackedWeight& w = *param.weight;
+  const int64_t tile_k = AmxTileK(kType);
+  const int64_t a_stride =
+      w.k_padded * (kType == AmxGemmType::kBF16 ? sizeof(uint16_t) : 1);
+  const char* a0 =
+      kType == AmxGemmType::kBF16
+          ? reinterpret_cast<const char*>(input.bf16 + m * w.k_padded)
+          : reinterpret_cast<const char*>(input.int8 + m * w.k_padded);
+  const char* a1 = a0 + kAmxTileRows * a_stride;
+  const int64_t nb = n / kAmxTileChannels;
+
+  _tile_zero(0);
+  if (kCols == 2) _tile_zero(1);
+  if (kRows == 2) _tile_zero(2);
+  if (kRows == 2 && kCols == 2) _tile_zero(3);
+  for (int64_t kb = 0; kb < w.k_padded / tile_k; ++kb) {
+    const int64_t a_offset = kb * kAmxTileBytes;
+    _tile_loadd(4, a0 + a_offset, a_stride);
+    _tile_loadd(6, w.Tile(nb, kb), kAmxTileBytes);
+    if (kType == AmxGemmType::kBF16) {
+      _tile_dpbf16ps(0, 4, 6);
+    } else {
+      _tile_dpbssd(0, 4, 6);
+    }
+    if (kCols == 2) {
+      _tile_loadd(7, w.Tile(nb + 1, kb), kAmxTileBytes);
+      if (kType == AmxGemmType::kBF16) {
+        _tile_dpbf16ps(1, 4, 7);
+      } else {
+        _tile_dpbssd(1, 4, 7);
+      }
+    }
+    if (kRows == 2) {
+      _tile_loadd(5, a1 + a_offset, a_stride);
+      if (kType == AmxGemmType::kBF16) {
+        _tile_dpbf16ps(2, 5, 6);
+      } else {
+        _tile_dpbssd(2, 5, 6);
+      }
+      if (kCols == 2) {
+        if (kType == AmxGemmType::kBF16) {
+          _tile_dpbf16ps(3, 5, 7);
+        } else {
+          _tile_dpbssd(3, 5, 7);
+        }
+      }
+    }
+  }
+
+  // float and int32 accumulators have the same size
+  alignas(64) float acc[4][kAmxTileRows * kAmxTileChannels];
+  _tile_stored(0, acc[0], kAmxTileBytes);
+  if (kCols == 2) _tile_stored(1, acc[1], kAmxTileBytes);
+  if (kRows == 2) _tile_stored(2, acc[2], kAmxTileBytes);
+  if (kRows == 2 && kCols == 2) _tile_stored(3, acc[3], kAmxTileBytes);
+  for (int r = 0; r < kRows; ++r) {
+    for (int c = 0; c < kCols; ++c) {
+      AmxGemmEpilogue(param,
+                      input,
+                      acc[r * 2 + c],
+                      m + r * kAmxTileRows,
+                      n + c * kAmxTileChannels);
+    }
+  }
+}
+
+template <AmxGemmType kType>
+void GemmTile(const AmxGemmParam& param,
+              const AmxPackedInput& input,
+              int64_t m_begin,
+              int64_t m_end,
+              int64_t n_begin,
+              int64_t n_end) {
+  constexpr int64_t kBlockRows = 2 * kAmxTileRows;
+  constexpr int64_t kBlockChannels = 2 * kAmxTileChannels;
+  for (int64_t m = m_begin; m < m_end; m += kBlockRows) {
+    const bool two_rows = m_end - m >= kBlockRows;
+    for (int64_t n = n_begin; n < n_end; n += kBlockChannels) {
+      const bool two_cols = n_end - n >= kBlockChannels;
+      if (two_rows && two_cols) {
+        GemmBlock<kType, 2, 2>(param, input, m, n);
+      } else if (two_rows) {
+        GemmBlock<kType, 2, 1>(param, input, m, n);
+      } else if (two_cols) {
+        GemmBlock<kType, 1, 2>(param, input, m, n);
+      } else {
+        GemmBlock<kType, 1, 1>(param, input, m, n);
+      }
+    }
+  }
+}
+
+}  // namespace
+
+bool AmxGemmAMXCompiled() { return true; }
+
+void AmxGemmTileAMX(const AmxGemmParam& param,
+                    const AmxPackedInput& input,
+                    int64_t m_begin,
+                    int64_t m_end,
+                    int64_t n_begin,
+                    int64_t n_end) {
+  // the tile configuration belongs to the thread
+  LoadTileConfig();
+  if (param.weight->type == AmxGemmType::kBF16) {
+    GemmTile<AmxGemmType::kBF16>(param, input, m_begin, m_end, n_begin, n_end);
+  } else {
+    GemmTile<AmxGemmType::kInt8>(param, input, m_begin, m_end, n_begin, n_end);
+  }
+  _tile_release();
+}
+
+#else
+
+bool AmxGemmAMXCompiled() { return false; }
+
+void AmxGemmTileAMX(const AmxGemmParam& param,
+                    const AmxPackedInput& input,
+                    int64_t m_begin,
+                    int64_t m_end,
+                    int64_t n_begin,
+                    int64_t n_end) {
+  PADDLE_THROW(
+      common::errors::Unavailable("The AMX gemm is not built with AMX."));
+}
+
+#endif
+
+}  // namespace detail
+}  // namespace funcs
+}  // namespace phi
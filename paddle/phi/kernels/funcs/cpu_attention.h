@@ -0,0 +1,425 @@
+// Copyright (c) 2025 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#ifdef PADDLE_WITH_MKLML
+#include <omp.h>
+#endif
+
+namespace phi {
+namespace funcs {
+
+// Multi-head attention of variable length sequences on CPU, computed the way
+// of flash attention: a block of queries is multiplied by a block of keys at
+// a time and the softmax is computed online, rescaling the accumulated
+// output whenever the running maximum of the scores grows. The scores of a
+// whole sequence are never materialized, so a batch is not padded to its
+// longest sequence beyond the query rows of the tensors.
+//
+// The queries and the output are [batch, num_heads, max_query_len,
+// head_size] and [batch, num_heads, max_query_len, value_head_size].
+// Sequence b has seq_lens[b] queries, the output rows after them are zeroed.
+// Its keys are the first kv_seq_lens[b] + pre_cache_length rows of the key
+// and value cache, the cached prefix first; a sequence without queries has
+// no keys. The heads of the queries are shared in groups by the heads of
+// the keys, num_heads being a multiple of kv_num_heads.
+//
+// With `causal` the first query is aligned with the first key, as in the
+// CUTLASS kernel of variable_length_memory_efficient_attention: query i of
+// a sequence sees the keys up to i, cached prefix included.
+
+// Queries of a parallel task, sharing the loads of the blocks of keys.
+constexpr int64_t kAttentionQueryBlock = 32;
+// Keys of a block, whose scores are kept by the task.
+constexpr int64_t kAttentionKeyBlock = 64;
+
+struct AttentionParams {
+  int64_t batch_size = 0;
+  int64_t num_heads = 0;
+  int64_t kv_num_heads = 0;
+  int64_t max_query_len = 0;
+  int64_t head_size = 0;
+  int64_t value_head_size = 0;
+  const int* seq_lens = nullptr;
+  const int* kv_seq_lens = nullptr;
+  int pre_cache_length = 0;
+  float scale = 1.f;
+  bool causal = false;
+  // The optional additive mask is [batch, mask_num_heads, mask_rows,
+  // mask_cols], with mask_num_heads 1 or num_heads.
+  int64_t mask_num_heads = 1;
+  int64_t mask_rows = 0;
+  int64_t mask_cols = 0;
+};
+
+// Key and value cache of [batch, kv_num_heads, max_kv_len, head_size] and
+// [batch, kv_num_heads, max_kv_len, value_head_size].
+template <typename T>
+struct DenseKVCache {
+  const T* key;
+  const T* value;
+  int64_t kv_num_heads;
+  int64_t max_kv_len;
+  int64_t head_size;
+  int64_t value_head_size;
+
+  const T* Key(int64_t batch, int64_t head, int64_t pos) const {
+    return key + ((batch * kv_num_heads + head) * max_kv_len + pos) * head_size;
+  }
+  const T* Value(int64_t batch, int64_t head, int64_t pos) const {
+    return value +
+           ((batch * kv_num_heads + head) * max_kv_len + pos) * value_head_size;
+  }
+};
+
+// Key and value cache in blocks of block_size tokens, the layout of the
+// caches of block_multi_head_attention: [num_blocks, kv_num_heads,
+// block_size, head_size] and [.., value_head_size]. Row b of block_tables
+// [batch, max_blocks_per_seq] lists the blocks of sequence b in order.
+template <typename T>
+struct BlockKVCache {
+  const T* key;
+  const T* value;
+  const int* block_tables;
+  int64_t max_blocks_per_seq;
+  int64_t kv_num_heads;
+  int64_t block_size;
+  int64_t head_size;
+  int64_t value_head_size;
+
+  int64_t Row(int64_t batch, int64_t head, int64_t pos) const {
+    const int64_t block =
+        block_tables[batch * max_blocks_per_seq + pos / block_size];
+    return (block * kv_num_heads + head) * block_size + pos % block_size;
+  }
+  const T* Key(int64_t batch, int64_t head, int64_t pos) const {
+    return key + Row(batch, head, pos) * head_size;
+  }
+  const T* Value(int64_t batch, int64_t head, int64_t pos) const {
+    return value + Row(batch, head, pos) * value_head_size;
+  }
+};
+
+namespace detail {
+
+// The float buffers of a task, reused by the tasks of a thread.
+struct AttentionBuffers {
+  std::vector<float> query;    // [query block, head_size]
+  std::vector<float> key;      // [key block, head_size]
+  std::vector<float> value;    // [key block, value_head_size]
+  std::vector<float> scores;   // [rows of a group, key block]
+  std::vector<float> output;   // [query block, value_head_size]
+  std::vector<float> row_max;  // [query block]
+  std::vector<float> row_sum;  // [query block]
+};
+
+// The products are computed for groups of kAttentionGroupRows queries, which
+// reuse a row of keys or values while it is in the cache.
+constexpr int64_t kAttentionGroupRows = 4;
+constexpr int64_t kAttentionLanes = 16;
+
+// scores[r, j] = query[r, :] . key[j, :] for the rows of a group. The dot
+// products are accumulated in kAttentionLanes partial sums.
+inline void AttentionScores(const float* query,
+                            const float* key,
+                            int64_t group_rows,
+                            int64_t head_size,
+                            int64_t cols,
+                            float* scores) {
+  const int64_t D = head_size;
+  const int64_t vector_end = D - D % kAttentionLanes;
+  for (int64_t j = 0; j < cols; ++j) {
+    const float* k = key + j * D;
+    for (int64_t r = 0; r < group_rows; ++r) {
+      const float* q = query + r * D;
+      float acc[kAttentionLanes] = {};
+      for (int64_t d0 = 0; d0 < vector_end; d0 += kAttentionLanes) {
+        for (int64_t l = 0; l < kAttentionLanes; ++l) {
+          acc[l] += q[d0 + l] * k[d0 + l];
+        }
+      }
+      float dot = 0.f;
+      for (int64_t l = 0; l < kAttentionLanes; ++l) {
+        dot += acc[l];
+      }
+      for (int64_t d = vector_end; d < D; ++d) {
+        dot += q[d] * k[d];
+      }
+      scores[r * kAttentionKeyBlock + j] = dot;
+    }
+  }
+}
+
+// output[r, :] += scores[r, :] * value for kRows rows.
+template <int64_t kRows>
+void AttentionAccumulateRows(const float* scores,
+                             const float* value,
+                             int64_t value_head_size,
+                             int64_t cols,
+                             float* output) {
+  const int64_t Dv = value_head_size;
+  int64_t d0 = 0;
+  for (; d0 + kAttentionLanes <= Dv; d0 += kAttentionLanes) {
+    float acc[kRows][kAttentionLanes];
+    for (int64_t r = 0; r < kRows; ++r) {
+      std::copy_n(output + r * Dv + d0, kAttentionLanes, acc[r]);
+    }
+    for (int64_t j = 0; j < cols; ++j) {
+      const float* v = value + j * Dv + d0;
+      for (int64_t r = 0; r < kRows; ++r) {
+        const float s = scores[r * kAttentionKeyBlock + j];
+        for (int64_t l = 0; l < kAttentionLanes; ++l) {
+          acc[r][l] += s * v[l];
+        }
+      }
+    }
+    for (int64_t r = 0; r < kRows; ++r) {
+      std::copy_n(acc[r], kAttentionLanes, output + r * Dv + d0);
+    }
+  }
+  for (int64_t r = 0; r < kRows; ++r) {
+    for (int64_t j = 0; j < cols; ++j) {
+      const float s = scores[r * kAttentionKeyBlock + j];
+      for (int64_t d = d0; d < Dv; ++d) {
+        output[r * Dv + d] += s * value[j * Dv + d];
+      }
+    }
+  }
+}
+
+// output[r, :] += scores[r, :] * value for the rows of a group.
+inline void AttentionAccumulate(const float* scores,
+                                const float* value,
+                                int64_t group_rows,
+                                int64_t value_head_size,
+                                int64_t cols,
+                                float* output) {
+  if (group_rows == kAttentionGroupRows) {
+    AttentionAccumulateRows<kAttentionGroupRows>(
+        scores, value, value_head_size, cols, output);
+    return;
+  }
+  for (int64_t r = 0; r < group_rows; ++r) {
+    AttentionAccumulateRows<1>(scores + r * kAttentionKeyBlock,
+                               value,
+                               value_head_size,
+                               cols,
+                               output + r * value_head_size);
+  }
+}
+
+// Attention of the queries [q_begin, q_end) of head `head` of sequence
+// `batch`, which has kv_len keys.
+template <typename T, typename KVCache>
+void AttentionQueryBlock(const AttentionParams& p,
+                         const T* query,
+                         const KVCache& kv,
+                         const T* mask,
+                         int64_t batch,
+                         int64_t head,
+                         int64_t q_begin,
+                         int64_t q_end,
+                         int64_t kv_len,
+                         AttentionBuffers* buf,
+                         T* out) {
+  constexpr float kNegInf = -std::numeric_limits<float>::infinity();
+  const int64_t D = p.head_size;
+  const int64_t Dv = p.value_head_size;
+  const int64_t rows = q_end - q_begin;
+  const int64_t kv_head = head / (p.num_heads / p.kv_num_heads);
+  const int64_t offset = (batch * p.num_heads + head) * p.max_query_len;
+
+  buf->query.resize(rows * D);
+  buf->key.resize(kAttentionKeyBlock * D);
+  buf->value.resize(kAttentionKeyBlock * Dv);
+  buf->scores.resize(kAttentionGroupRows * kAttentionKeyBlock);
+  buf->output.assign(rows * Dv, 0.f);
+  buf->row_max.assign(rows, kNegInf);
+  buf->row_sum.assign(rows, 0.f);
+  // the scale is folded into the queries
+  for (int64_t i = 0; i < rows; ++i) {
+    const T* q = query + (offset + q_begin + i) * D;
+    for (int64_t d = 0; d < D; ++d) {
+      buf->query[i * D + d] = static_cast<float>(q[d]) * p.scale;
+    }
+  }
+  const T* mask_head =
+      mask == nullptr
+          ? nullptr
+          : mask + (batch * p.mask_num_heads +
+                    (p.mask_num_heads == 1 ? 0 : head)) *
+                       p.mask_rows * p.mask_cols;
+
+  // the keys after the one seen by the last query of the block are skipped
+  const int64_t kv_end = p.causal ? std::min(kv_len, q_end) : kv_len;
+  for (int64_t k_begin = 0; k_begin < kv_end; k_begin += kAttentionKeyBlock) {
+    const int64_t cols = std::min(kAttentionKeyBlock, kv_end - k_begin);
+    float* key = buf->key.data();
+    float* value = buf->value.data();
+    for (int64_t j = 0; j < cols; ++j) {
+      const T* k = kv.Key(batch, kv_head, k_begin + j);
+      for (int64_t d = 0; d < D; ++d) {
+        key[j * D + d] = static_cast<float>(k[d]);
+      }
+      const T* v = kv.Value(batch, kv_head, k_begin + j);
+      for (int64_t d = 0; d < Dv; ++d) {
+        value[j * Dv + d] = static_cast<float>(v[d]);
+      }
+    }
+
+    for (int64_t g = 0; g < rows; g += kAttentionGroupRows) {
+      float* scores = buf->scores.data();
+      const int64_t group_rows = std::min(kAttentionGroupRows, rows - g);
+      AttentionScores(
+          buf->query.data() + g * D, key, group_rows, D, cols, scores);
+      // the scores become the weights of the values, zero for the keys
+      // masked out
+      for (int64_t r = 0; r < group_rows; ++r) {
+        float* s = scores + r * kAttentionKeyBlock;
+        const int64_t i = g + r;
+        const int64_t qi = q_begin + i;
+        if (mask_head != nullptr) {
+          const T* m = mask_head + qi * p.mask_cols + k_begin;
+          for (int64_t j = 0; j < cols; ++j) {
+            s[j] += static_cast<float>(m[j]);
+          }
+        }
+        int64_t valid = cols;
+        if (p.causal) {
+          valid = std::max<int64_t>(0, std::min(cols, qi + 1 - k_begin));
+        }
+        std::fill(s + valid, s + cols, 0.f);
+
+        float block_max = kNegInf;
+        for (int64_t j = 0; j < valid; ++j) {
+          block_max = std::max(block_max, s[j]);
+        }
+        const float prev_max = buf->row_max[i];
+        const float new_max = std::max(prev_max, block_max);
+        if (new_max == kNegInf) {
+          // every key seen so far is masked out
+          std::fill_n(s, valid, 0.f);
+          continue;
+        }
+        float sum = 0.f;
+        for (int64_t j = 0; j < valid; ++j) {
+          s[j] = std::exp(s[j] - new_max);
+          sum += s[j];
+        }
+        if (prev_max != new_max) {
+          const float alpha = std::exp(prev_max - new_max);
+          float* o = buf->output.data() + i * Dv;
+          buf->row_sum[i] *= alpha;
+          for (int64_t d = 0; d < Dv; ++d) {
+            o[d] *= alpha;
+          }
+        }
+        buf->row_sum[i] += sum;
+        buf->row_max[i] = new_max;
+      }
+      AttentionAccumulate(
+          scores, value, group_rows, Dv, cols, buf->output.data() + g * Dv);
+    }
+  }
+
+  for (int64_t i = 0; i < rows; ++i) {
+    const float sum = buf->row_sum[i];
+    const float inv = sum > 0.f ? 1.f / sum : 0.f;
+    const float* o = buf->output.data() + i * Dv;
+    T* dst = out + (offset + q_begin + i) * Dv;
+    for (int64_t d = 0; d < Dv; ++d) {
+      dst[d] = static_cast<T>(o[d] * inv);
+    }
+  }
+}
+
+}  // namespace detail
+
+// out = softmax(query * key^T * scale + mask) * value for each sequence and
+// head, see above for the layouts. The lengths must have been checked by the
+// caller against the shapes of the tensors and of the cache.
+template <typename T, typename KVCache>
+void VarlenAttention(const AttentionParams& p,
+                     const T* query,
+                     const KVCache& kv,
+                     const T* mask,
+                     T* out) {
+  struct Task {
+    int64_t batch;
+    int64_t head;
+    int64_t q_begin;
+  };
+  std::vector<Task> tasks;
+  for (int64_t b = 0; b < p.batch_size; ++b) {
+    const int64_t q_len = p.seq_lens[b];
+    for (int64_t h = 0; h < p.num_heads; ++h) {
+      T* padding = out + ((b * p.num_heads + h) * p.max_query_len + q_len) *
+                             p.value_head_size;
+      std::fill_n(padding,
+                  (p.max_query_len - q_len) * p.value_head_size,
+                  static_cast<T>(0));
+      for (int64_t q = 0; q < q_len; q += kAttentionQueryBlock) {
+        tasks.push_back({b, h, q});
+      }
+    }
+  }
+
+  const int64_t num_tasks = static_cast<int64_t>(tasks.size());
+#ifdef PADDLE_WITH_MKLML
+  int64_t work = 0;
+  for (int64_t b = 0; b < p.batch_size; ++b) {
+    if (p.seq_lens[b] > 0) {
+      work += p.num_heads * p.seq_lens[b] *
+              (p.kv_seq_lens[b] + p.pre_cache_length) *
+              (p.head_size + p.value_head_size);
+    }
+  }
+#pragma omp parallel if (work >= (1 << 16) && num_tasks > 1)
+#endif
+  {
+    detail::AttentionBuffers buf;
+    // the tasks of long sequences take longer, hence the dynamic schedule
+#ifdef PADDLE_WITH_MKLML
+#pragma omp for schedule(dynamic, 1)
+#endif
+    for (int64_t t = 0; t < num_tasks; ++t) {
+      const Task& task = tasks[t];
+      const int64_t q_len = p.seq_lens[task.batch];
+      const int64_t kv_len = p.kv_seq_lens[task.batch] + p.pre_cache_length;
+      const int64_t q_end =
+          std::min(task.q_begin + kAttentionQueryBlock, q_len);
+      detail::AttentionQueryBlock(p,
+                                  query,
+                                  kv,
+                                  mask,
+                                  task.batch,
+                                  task.head,
+                                  task.q_begin,
+                                  q_end,
+                                  kv_len,
+                                  &buf,
+                                  out);
+    }
+  }
+}
+
+}  // namespace funcs
+}  // namespace phi
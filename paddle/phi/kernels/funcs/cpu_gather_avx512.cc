@@ -0,0 +1,156 @@
+// Copyright (c) 2025 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/phi/kernels/funcs/cpu_gather_scatter.h"
+
+#ifdef __AVX512F__
+#include <immintrin.h>
+#endif
+
+#include <limits>
+
+#include "paddle/phi/core/enforce.h"
+
+namespace phi {
+namespace funcs {
+namespace detail {
+
+#ifdef __AVX512F__
+
+namespace {
+
+inline void CopyElement(const void* src,
+                        int element_bytes,
+                        int64_t row,
+                        void* out) {
+  std::memcpy(out,
+              static_cast<const char*>(src) + row * element_bytes,
+              element_bytes);
+}
+
+// Negative indices count from the end.
+inline __m512i Normalize64(__m512i index, __m512i rows) {
+  __mmask8 negative = _mm512_cmplt_epi64_mask(index, _mm512_setzero_si512());
+  return _mm512_mask_add_epi64(index, negative, index, rows);
+}
+
+inline __m512i Normalize32(__m512i index, __m512i rows) {
+  __mmask16 negative =
+      _mm512_cmplt_epi32_mask(index, _mm512_setzero_si512());
+  return _mm512_mask_add_epi32(index, negative, index, rows);
+}
+
+// Eight 64 bits indices, loaded from int32 or int64.
+inline __m512i LoadIndex64(const int32_t* index) {
+  return _mm512_cvtepi32_epi64(
+      _mm256_loadu_si256(reinterpret_cast<const __m256i*>(index)));
+}
+
+inline __m512i LoadIndex64(const int64_t* index) {
+  return _mm512_loadu_si512(index);
+}
+
+template <typename IndexT>
+void Gather64BitIndices(const void* src,
+                        int element_bytes,
+                        int64_t rows,
+                        const IndexT* index,
+                        int64_t size,
+                        void* out) {
+  const __m512i rows_v = _mm512_set1_epi64(rows);
+  char* out_bytes = static_cast<char*>(out);
+  int64_t i = 0;
+  for (; i + 8 <= size; i += 8) {
+    __m512i idx = Normalize64(LoadIndex64(index + i), rows_v);
+    if (element_bytes == 4) {
+      __m256i v = _mm512_i64gather_epi32(idx, src, 4);
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(out_bytes + i * 4), v);
+    } else {
+      __m512i v = _mm512_i64gather_epi64(idx, src, 8);
+      _mm512_storeu_si512(out_bytes + i * 8, v);
+    }
+  }
+  for (; i < size; ++i) {
+    int64_t row = index[i] < 0 ? index[i] + rows : index[i];
+    CopyElement(src, element_bytes, row, out_bytes + i * element_bytes);
+  }
+}
+
+}  // namespace
+
+bool GatherAVX512Compiled() { return true; }
+
+void GatherElementsAVX512(const void* src,
+                          int element_bytes,
+                          int64_t rows,
+                          const int32_t* index,
+                          int64_t size,
+                          void* out) {
+  // 16 elements per gather when the normalized indices fit in 32 bits
+  if (element_bytes != 4 || rows > std::numeric_limits<int32_t>::max()) {
+    Gather64BitIndices(src, element_bytes, rows, index, size, out);
+    return;
+  }
+  const __m512i rows_v = _mm512_set1_epi32(static_cast<int32_t>(rows));
+  char* out_bytes = static_cast<char*>(out);
+  int64_t i = 0;
+  for (; i + 16 <= size; i += 16) {
+    __m512i idx = Normalize32(_mm512_loadu_si512(index + i), rows_v);
+    __m512i v = _mm512_i32gather_epi32(idx, src, 4);
+    _mm512_storeu_si512(out_bytes + i * 4, v);
+  }
+  for (; i < size; ++i) {
+    int64_t row = index[i] < 0 ? index[i] + rows : index[i];
+    CopyElement(src, 4, row, out_bytes + i * 4);
+  }
+}
+
+void GatherElementsAVX512(const void* src,
+                          int element_bytes,
+                          int64_t rows,
+                          const int64_t* index,
+                          int64_t size,
+                          void* out) {
+  Gather64BitIndices(src, element_bytes, rows, index, size, out);
+}
+
+#else
+
+bool GatherAVX512Compiled() { return false; }
+
+void GatherElementsAVX512(const void* src,
+                          int element_bytes,
+                          int64_t rows,
+                          const int32_t* index,
+                          int64_t size,
+                          void* out) {
+  PADDLE_THROW(common::errors::Unavailable(
+      "The vector gather is not built with AVX512F."));
+}
+
+void GatherElementsAVX512(const void* src,
+                          int element_bytes,
+                          int64_t rows,
+                          const int64_t* index,
+                          int64_t size,
+                          void* out) {
+  PADDLE_THROW(common::errors::Unavailable(
+      "The vector gather is not built with AVX512F."));
+}
+
+#endif
+
+}  // namespace detail
+}  // namespace funcs
+}  // namespace phi
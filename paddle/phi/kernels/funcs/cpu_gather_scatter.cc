@@ -0,0 +1,91 @@
+// Copyright (c) 2025 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/phi/kernels/funcs/cpu_gather_scatter.h"
+
+#include "glog/logging.h"
+#include "paddle/phi/backends/cpu/cpu_info.h"
+
+namespace phi {
+namespace funcs {
+
+namespace {
+
+// Elements gathered by a parallel task.
+constexpr int64_t kGatherElementsBlock = 1 << 14;
+
+bool SelectAVX512Gather() {
+  namespace cpu = phi::backends::cpu;
+  bool use = detail::GatherAVX512Compiled() && cpu::MayIUse(cpu::avx512f);
+  VLOG_IF(3, use) << "gather of narrow rows uses the avx512 vector gather";
+  return use;
+}
+
+bool UseAVX512Gather() {
+  static const bool use = SelectAVX512Gather();
+  return use;
+}
+
+template <typename IndexT>
+bool GatherElementsImpl(const void* src,
+                        int element_bytes,
+                        int64_t rows,
+                        const IndexT* index,
+                        int64_t size,
+                        void* out) {
+  if (!UseAVX512Gather()) {
+    return false;
+  }
+  const int64_t blocks =
+      (size + kGatherElementsBlock - 1) / kGatherElementsBlock;
+#ifdef PADDLE_WITH_MKLML
+  const bool parallel = size * element_bytes >= kGatherScatterMinParallelBytes;
+#pragma omp parallel for if (parallel)
+#endif
+  for (int64_t block = 0; block < blocks; ++block) {
+    const int64_t begin = block * kGatherElementsBlock;
+    const int64_t end = std::min(begin + kGatherElementsBlock, size);
+    detail::GatherElementsAVX512(
+        src,
+        element_bytes,
+        rows,
+        index + begin,
+        end - begin,
+        static_cast<char*>(out) + begin * element_bytes);
+  }
+  return true;
+}
+
+}  // namespace
+
+bool GatherElements(const void* src,
+                    int element_bytes,
+                    int64_t rows,
+                    const int32_t* index,
+                    int64_t size,
+                    void* out) {
+  return GatherElementsImpl(src, element_bytes, rows, index, size, out);
+}
+
+bool GatherElements(const void* src,
+                    int element_bytes,
+                    int64_t rows,
+                    const int64_t* index,
+                    int64_t size,
+                    void* out) {
+  return GatherElementsImpl(src, element_bytes, rows, index, size, out);
+}
+
+}  // namespace funcs
+}  // namespace phi
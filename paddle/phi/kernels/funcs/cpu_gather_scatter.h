@@ -0,0 +1,273 @@
+// Copyright (c) 2025 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+namespace phi {
+namespace funcs {
+
+// Row gather and scatter on CPU buffers shared by the gather, scatter and
+// index_select kernels. The source is viewed as [outer, rows, slice] and the
+// rows are selected along the middle dimension. The indices must have been
+// checked by the caller; negative indices count from the end.
+
+// Below this number of bytes moved the loops run on one thread.
+constexpr int64_t kGatherScatterMinParallelBytes = 1 << 16;
+// Rows copied by a parallel task of the gather.
+constexpr int64_t kGatherBlockRows = 64;
+// Distance in rows of the prefetch of the gathered rows.
+constexpr int64_t kGatherPrefetchRows = 8;
+
+inline void PrefetchRow(const void* ptr) {
+#if defined(__GNUC__) || defined(__clang__)
+  __builtin_prefetch(ptr);
+#endif
+}
+
+template <typename IndexT>
+inline int64_t NormalizeIndex(IndexT index, int64_t rows) {
+  return index < 0 ? static_cast<int64_t>(index) + rows
+                   : static_cast<int64_t>(index);
+}
+
+// out[i] = src[index[i]] for 4 or 8 bytes elements, with the vector gather
+// of AVX512F when the CPU has it. Returns false when it does not, and the
+// caller copies the elements one by one.
+bool GatherElements(const void* src,
+                    int element_bytes,
+                    int64_t rows,
+                    const int32_t* index,
+                    int64_t size,
+                    void* out);
+bool GatherElements(const void* src,
+                    int element_bytes,
+                    int64_t rows,
+                    const int64_t* index,
+                    int64_t size,
+                    void* out);
+
+namespace detail {
+
+bool GatherAVX512Compiled();
+
+void GatherElementsAVX512(const void* src,
+                          int element_bytes,
+                          int64_t rows,
+                          const int32_t* index,
+                          int64_t size,
+                          void* out);
+void GatherElementsAVX512(const void* src,
+                          int element_bytes,
+                          int64_t rows,
+                          const int64_t* index,
+                          int64_t size,
+                          void* out);
+
+}  // namespace detail
+
+// out[o, i, :] = src[o, index[i], :], with src [outer, rows, slice] and out
+// [outer, index_size, slice].
+template <typename T, typename IndexT>
+void GatherRows(const T* src,
+                int64_t outer,
+                int64_t rows,
+                const IndexT* index,
+                int64_t index_size,
+                int64_t slice,
+                T* out) {
+  if (slice == 1 && std::is_trivially_copyable<T>::value &&
+      (sizeof(T) == 4 || sizeof(T) == 8)) {
+    bool vectorized = true;
+    for (int64_t o = 0; o < outer && vectorized; ++o) {
+      vectorized = GatherElements(src + o * rows,
+                                  sizeof(T),
+                                  rows,
+                                  index,
+                                  index_size,
+                                  out + o * index_size);
+    }
+    if (vectorized) {
+      return;
+    }
+  }
+
+  const int64_t blocks_per_outer =
+      (index_size + kGatherBlockRows - 1) / kGatherBlockRows;
+#ifdef PADDLE_WITH_MKLML
+  const bool parallel =
+      outer * index_size * slice * static_cast<int64_t>(sizeof(T)) >=
+      kGatherScatterMinParallelBytes;
+#pragma omp parallel for if (parallel)
+#endif
+  for (int64_t block = 0; block < outer * blocks_per_outer; ++block) {
+    const int64_t o = block / blocks_per_outer;
+    const int64_t begin = block % blocks_per_outer * kGatherBlockRows;
+    const int64_t end = std::min(begin + kGatherBlockRows, index_size);
+    const T* src_outer = src + o * rows * slice;
+    T* out_outer = out + o * index_size * slice;
+    for (int64_t i = begin; i < end; ++i) {
+      // the indices are random for embeddings, start loading the rows
+      // needed a few iterations later
+      if (i + kGatherPrefetchRows < end) {
+        PrefetchRow(src_outer +
+                    NormalizeIndex(index[i + kGatherPrefetchRows], rows) *
+                        slice);
+      }
+      const T* row = src_outer + NormalizeIndex(index[i], rows) * slice;
+      if (slice == 1) {
+        out_outer[i] = *row;
+      } else {
+        std::memcpy(out_outer + i * slice, row, slice * sizeof(T));
+      }
+    }
+  }
+}
+
+// The positions of index grouped by destination row, each group in the
+// order of index and the groups by increasing row. Position
+// order[segments[s]] is the first one of segment s and the segments end at
+// order.size().
+//
+// The positions are sorted with a least significant digit first radix sort
+// of 8 bits per pass, as many passes as bytes in rows - 1. The passes are
+// stable, which keeps the order of index inside the groups.
+template <typename IndexT>
+void IndexSegments(const IndexT* index,
+                   int64_t index_size,
+                   int64_t rows,
+                   std::vector<int64_t>* order,
+                   std::vector<int64_t>* segments) {
+  std::vector<int64_t> keys(index_size), key_buffer(index_size);
+  std::vector<int64_t> position_buffer(index_size);
+  order->resize(index_size);
+  for (int64_t i = 0; i < index_size; ++i) {
+    keys[i] = NormalizeIndex(index[i], rows);
+    (*order)[i] = i;
+  }
+  for (int shift = 0; shift < 64 && ((rows - 1) >> shift) > 0; shift += 8) {
+    int64_t count[256] = {0};
+    for (int64_t i = 0; i < index_size; ++i) {
+      ++count[(keys[i] >> shift) & 0xff];
+    }
+    // all the rows share this digit
+    if (index_size == 0 || count[(keys[0] >> shift) & 0xff] == index_size) {
+      continue;
+    }
+    int64_t offset = 0;
+    for (int d = 0; d < 256; ++d) {
+      int64_t c = count[d];
+      count[d] = offset;
+      offset += c;
+    }
+    for (int64_t i = 0; i < index_size; ++i) {
+      int64_t dst = count[(keys[i] >> shift) & 0xff]++;
+      key_buffer[dst] = keys[i];
+      position_buffer[dst] = (*order)[i];
+    }
+    keys.swap(key_buffer);
+    order->swap(position_buffer);
+  }
+  segments->clear();
+  for (int64_t i = 0; i < index_size; ++i) {
+    if (i == 0 || keys[i] != keys[i - 1]) {
+      segments->push_back(i);
+    }
+  }
+}
+
+// dst[o, index[i], :] += src[o, i, :], with src [outer, index_size, slice]
+// and dst [outer, rows, slice]. With `overwrite` the destination rows take
+// the last source row scattered to them instead; with `reset` the scattered
+// destination rows are zeroed before the sum.
+//
+// Large scatters group the updates by destination row: each group is
+// reduced by one thread in the order of index, so the threads never write
+// the same row and the result is the one of the serial loop.
+template <typename T, typename IndexT>
+void ScatterRows(const T* src,
+                 int64_t outer,
+                 int64_t rows,
+                 const IndexT* index,
+                 int64_t index_size,
+                 int64_t slice,
+                 bool overwrite,
+                 bool reset,
+                 T* dst) {
+  const int64_t total = outer * index_size;
+  if (total * slice * static_cast<int64_t>(sizeof(T)) <
+      kGatherScatterMinParallelBytes) {
+    for (int64_t o = 0; o < outer; ++o) {
+      const T* src_outer = src + o * index_size * slice;
+      T* dst_outer = dst + o * rows * slice;
+      if (reset && !overwrite) {
+        for (int64_t i = 0; i < index_size; ++i) {
+          std::fill_n(dst_outer + NormalizeIndex(index[i], rows) * slice,
+                      slice,
+                      static_cast<T>(0));
+        }
+      }
+      for (int64_t i = 0; i < index_size; ++i) {
+        T* row = dst_outer + NormalizeIndex(index[i], rows) * slice;
+        const T* update = src_outer + i * slice;
+        if (overwrite) {
+          std::copy_n(update, slice, row);
+        } else {
+          for (int64_t j = 0; j < slice; ++j) {
+            row[j] += update[j];
+          }
+        }
+      }
+    }
+    return;
+  }
+
+  std::vector<int64_t> order, segments;
+  IndexSegments(index, index_size, rows, &order, &segments);
+  const int64_t num_segments = static_cast<int64_t>(segments.size());
+  // the rows of hot indices take longer, hence the dynamic schedule
+#ifdef PADDLE_WITH_MKLML
+#pragma omp parallel for schedule(dynamic, 16)
+#endif
+  for (int64_t task = 0; task < outer * num_segments; ++task) {
+    const int64_t o = task / num_segments;
+    const int64_t s = task % num_segments;
+    const int64_t begin = segments[s];
+    const int64_t end = s + 1 < num_segments ? segments[s + 1] : index_size;
+    const T* src_outer = src + o * index_size * slice;
+    T* row = dst + o * rows * slice +
+             NormalizeIndex(index[order[begin]], rows) * slice;
+    if (overwrite) {
+      std::copy_n(src_outer + order[end - 1] * slice, slice, row);
+      continue;
+    }
+    if (reset) {
+      std::fill_n(row, slice, static_cast<T>(0));
+    }
+    for (int64_t i = begin; i < end; ++i) {
+      const T* update = src_outer + order[i] * slice;
+      for (int64_t j = 0; j < slice; ++j) {
+        row[j] += update[j];
+      }
+    }
+  }
+}
+
+}  // namespace funcs
+}  // namespace phi
@@ -0,0 +1,416 @@
+// Copyright (c) 2025 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#ifdef PADDLE_WITH_MKLML
+#include <omp.h>
+#endif
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+namespace phi {
+namespace funcs {
+
+// Top-k and sort along the last dimension of a row-major [rows, width]
+// buffer, shared by the CPU topk and argsort kernels.
+//
+// The values are compared through unsigned rank keys: the order of the keys
+// is the order of the values, NaN ranks first when the largest values are
+// wanted and last otherwise, and equal keys are ordered by index, so the
+// results do not depend on the algorithm or the number of threads. The keys
+// are cheap to compute in blocks, which lets the selection skip whole blocks
+// that cannot enter the top k.
+
+inline uint32_t FloatOrder(float v) {
+  // -0.f and 0.f compare equal
+  v = v == 0.f ? 0.f : v;
+  uint32_t bits;
+  std::memcpy(&bits, &v, sizeof(bits));
+  uint32_t mask =
+      static_cast<uint32_t>(-static_cast<int32_t>(bits >> 31)) | 0x80000000u;
+  return bits ^ mask;
+}
+
+inline uint64_t DoubleOrder(double v) {
+  v = v == 0. ? 0. : v;
+  uint64_t bits;
+  std::memcpy(&bits, &v, sizeof(bits));
+  uint64_t mask = static_cast<uint64_t>(-static_cast<int64_t>(bits >> 63)) |
+                  0x8000000000000000ull;
+  return bits ^ mask;
+}
+
+// float16 and bfloat16 are ranked through float.
+template <typename T, typename Enable = void>
+struct RankKeyTraits {
+  using Type = uint32_t;
+  static Type Order(T v) { return FloatOrder(static_cast<float>(v)); }
+  static bool IsNan(T v) { return std::isnan(static_cast<float>(v)); }
+};
+
+template <>
+struct RankKeyTraits<double> {
+  using Type = uint64_t;
+  static Type Order(double v) { return DoubleOrder(v); }
+  static bool IsNan(double v) { return std::isnan(v); }
+};
+
+template <typename T>
+struct RankKeyTraits<T, std::enable_if_t<std::is_integral<T>::value>> {
+  static_assert(std::is_signed<T>::value,
+                "The rank keys of unsigned integers are not implemented.");
+  using Type = std::conditional_t<sizeof(T) <= 4, uint32_t, uint64_t>;
+  static Type Order(T v) {
+    using U = std::make_unsigned_t<T>;
+    return static_cast<Type>(static_cast<U>(v) ^
+                             (U(1) << (sizeof(T) * 8 - 1)));
+  }
+  static bool IsNan(T) { return false; }
+};
+
+template <typename T>
+using RankKey = typename RankKeyTraits<T>::Type;
+
+// The larger the key, the earlier the value is selected. `flip` is zero to
+// select the largest values and all ones to select the smallest.
+template <typename T>
+inline RankKey<T> MakeRankKey(T v, RankKey<T> flip) {
+  RankKey<T> key = RankKeyTraits<T>::IsNan(v)
+                       ? std::numeric_limits<RankKey<T>>::max()
+                       : RankKeyTraits<T>::Order(v);
+  return key ^ flip;
+}
+
+template <typename K>
+struct RankedIndex {
+  K key;
+  int64_t index;
+};
+
+template <typename K>
+inline bool RankedBefore(const RankedIndex<K>& l, const RankedIndex<K>& r) {
+  return l.key > r.key || (l.key == r.key && l.index < r.index);
+}
+
+// Number of keys computed at once when scanning for the top k.
+constexpr int64_t kTopKBlock = 64;
+// Below this ratio of width to k the top k is found with a heap, above it
+// with a radix select.
+constexpr int64_t kTopKHeapRatio = 16;
+// Minimum width of the chunks a row is split into when there are fewer rows
+// than threads.
+constexpr int64_t kTopKMinChunkWidth = 1 << 15;
+// From this width the rows are sorted with a radix sort.
+constexpr int64_t kRadixSortMinWidth = 1 << 10;
+
+// The top k of row[begin:end] with a heap of the k best elements seen so
+// far. The keys of a block are computed first and the block is skipped when
+// none of them beats the worst element of the heap: once the heap holds good
+// candidates most blocks are rejected by this vectorizable scan.
+template <typename T>
+void HeapTopK(const T* row,
+              int64_t begin,
+              int64_t end,
+              int64_t k,
+              RankKey<T> flip,
+              std::vector<RankedIndex<RankKey<T>>>* result) {
+  using K = RankKey<T>;
+  result->clear();
+  int64_t i = begin;
+  for (; i < begin + k; ++i) {
+    result->push_back({MakeRankKey(row[i], flip), i});
+  }
+  // the front of the heap is the worst element kept
+  std::make_heap(result->begin(), result->end(), RankedBefore<K>);
+  K threshold = result->front().key;
+  K keys[kTopKBlock];
+  for (; i < end; i += kTopKBlock) {
+    int64_t size = std::min(kTopKBlock, end - i);
+    K block_max = 0;
+    for (int64_t j = 0; j < size; ++j) {
+      keys[j] = MakeRankKey(row[i + j], flip);
+      block_max = std::max(block_max, keys[j]);
+    }
+    // elements with the same key as the threshold come later, so lose
+    if (block_max <= threshold) {
+      continue;
+    }
+    for (int64_t j = 0; j < size; ++j) {
+      if (keys[j] > threshold) {
+        std::pop_heap(result->begin(), result->end(), RankedBefore<K>);
+        result->back() = {keys[j], i + j};
+        std::push_heap(result->begin(), result->end(), RankedBefore<K>);
+        threshold = result->front().key;
+      }
+    }
+  }
+}
+
+// The top k of row[begin:end] with a most significant digit first radix
+// select: one histogram of 8 bits per pass finds the key of the k-th element,
+// then all the larger keys and the first copies of that key are taken.
+template <typename T>
+void RadixTopK(const T* row,
+               int64_t begin,
+               int64_t end,
+               int64_t k,
+               RankKey<T> flip,
+               std::vector<RankKey<T>>* keys,
+               std::vector<RankedIndex<RankKey<T>>>* result) {
+  using K = RankKey<T>;
+  const int64_t width = end - begin;
+  keys->resize(width);
+  K* key_data = keys->data();
+  for (int64_t j = 0; j < width; ++j) {
+    key_data[j] = MakeRankKey(row[begin + j], flip);
+  }
+
+  // the candidates sharing the digits chosen so far
+  std::vector<K> candidates;
+  const K* data = key_data;
+  int64_t size = width;
+  K kth = 0;
+  int64_t needed = k;
+  for (int shift = sizeof(K) * 8 - 8; shift >= 0; shift -= 8) {
+    int64_t histogram[256] = {0};
+    for (int64_t j = 0; j < size; ++j) {
+      ++histogram[(data[j] >> shift) & 0xff];
+    }
+    int digit = 255;
+    for (; digit > 0 && histogram[digit] < needed; --digit) {
+      needed -= histogram[digit];
+    }
+    kth |= static_cast<K>(digit) << shift;
+    if (shift > 0 && histogram[digit] < size) {
+      // later passes filter the candidates in place
+      if (data == key_data) {
+        candidates.resize(histogram[digit]);
+      }
+      K* filtered = candidates.data();
+      int64_t count = 0;
+      for (int64_t j = 0; j < size; ++j) {
+        if (static_cast<int>((data[j] >> shift) & 0xff) == digit) {
+          filtered[count++] = data[j];
+        }
+      }
+      data = filtered;
+      size = count;
+    }
+  }
+
+  // `needed` copies of the k-th key are selected
+  result->clear();
+  for (int64_t j = 0; j < width; ++j) {
+    if (key_data[j] > kth) {
+      result->push_back({key_data[j], begin + j});
+    } else if (key_data[j] == kth && needed > 0) {
+      result->push_back({key_data[j], begin + j});
+      --needed;
+    }
+  }
+}
+
+template <typename T>
+void RangeTopK(const T* row,
+               int64_t begin,
+               int64_t end,
+               int64_t k,
+               RankKey<T> flip,
+               std::vector<RankKey<T>>* keys,
+               std::vector<RankedIndex<RankKey<T>>>* result) {
+  if (k * kTopKHeapRatio < end - begin) {
+    HeapTopK(row, begin, end, k, flip, result);
+  } else {
+    RadixTopK(row, begin, end, k, flip, keys, result);
+  }
+}
+
+template <typename T>
+void WriteTopK(const T* row,
+               std::vector<RankedIndex<RankKey<T>>>* selected,
+               bool sorted,
+               T* out,
+               int64_t* indices) {
+  if (sorted) {
+    std::sort(selected->begin(), selected->end(), RankedBefore<RankKey<T>>);
+  }
+  for (size_t j = 0; j < selected->size(); ++j) {
+    out[j] = row[(*selected)[j].index];
+    indices[j] = (*selected)[j].index;
+  }
+}
+
+// out and indices are [rows, k].
+template <typename T>
+void TopKRows(const T* x,
+              int64_t rows,
+              int64_t width,
+              int64_t k,
+              bool largest,
+              bool sorted,
+              T* out,
+              int64_t* indices) {
+  using K = RankKey<T>;
+  if (k == 0) {
+    return;
+  }
+  const K flip = largest ? K(0) : ~K(0);
+  int num_threads = 1;
+#ifdef PADDLE_WITH_MKLML
+  num_threads = omp_get_max_threads();
+#endif
+  int64_t num_chunks = 1;
+  if (rows < num_threads) {
+    num_chunks = std::max<int64_t>(
+        1, std::min<int64_t>(num_threads, width / kTopKMinChunkWidth));
+  }
+
+  if (num_chunks == 1) {
+#ifdef PADDLE_WITH_MKLML
+#pragma omp parallel
+#endif
+    {
+      std::vector<K> keys;
+      std::vector<RankedIndex<K>> selected;
+#ifdef PADDLE_WITH_MKLML
+#pragma omp for
+#endif
+      for (int64_t i = 0; i < rows; ++i) {
+        const T* row = x + i * width;
+        RangeTopK(row, 0, width, k, flip, &keys, &selected);
+        WriteTopK(row, &selected, sorted, out + i * k, indices + i * k);
+      }
+    }
+    return;
+  }
+
+  // Few long rows: the top k of each chunk is selected in parallel, then the
+  // top k of the candidates.
+  const int64_t chunk_width = (width + num_chunks - 1) / num_chunks;
+  std::vector<std::vector<RankedIndex<K>>> chunk_selected(num_chunks);
+  std::vector<RankedIndex<K>> selected;
+  for (int64_t i = 0; i < rows; ++i) {
+    const T* row = x + i * width;
+#ifdef PADDLE_WITH_MKLML
+#pragma omp parallel for
+#endif
+    for (int64_t c = 0; c < num_chunks; ++c) {
+      int64_t begin = c * chunk_width;
+      int64_t end = std::min(begin + chunk_width, width);
+      std::vector<K> keys;
+      RangeTopK(row,
+                begin,
+                end,
+                std::min(k, end - begin),
+                flip,
+                &keys,
+                &chunk_selected[c]);
+    }
+    selected.clear();
+    for (auto& chunk : chunk_selected) {
+      selected.insert(selected.end(), chunk.begin(), chunk.end());
+    }
+    std::nth_element(selected.begin(),
+                     selected.begin() + (k - 1),
+                     selected.end(),
+                     RankedBefore<K>);
+    selected.resize(k);
+    WriteTopK(row, &selected, sorted, out + i * k, indices + i * k);
+  }
+}
+
+// Sorts a row by its rank keys with a least significant digit first radix
+// sort of 8 bits per pass. The passes are stable, so equal keys keep the
+// order of their indices.
+template <typename K>
+void RadixSortRanked(std::vector<RankedIndex<K>>* data,
+                     std::vector<RankedIndex<K>>* buffer) {
+  constexpr int kPasses = sizeof(K);
+  const int64_t size = static_cast<int64_t>(data->size());
+  std::vector<int64_t> histogram(kPasses * 256, 0);
+  // sorted by ascending ~key, which puts the largest keys first
+  for (auto& item : *data) {
+    item.key = ~item.key;
+    for (int p = 0; p < kPasses; ++p) {
+      ++histogram[p * 256 + ((item.key >> (p * 8)) & 0xff)];
+    }
+  }
+  buffer->resize(size);
+  for (int p = 0; p < kPasses; ++p) {
+    int64_t* count = histogram.data() + p * 256;
+    // all the keys share this digit
+    if (count[((*data)[0].key >> (p * 8)) & 0xff] == size) {
+      continue;
+    }
+    int64_t offset = 0;
+    for (int d = 0; d < 256; ++d) {
+      int64_t c = count[d];
+      count[d] = offset;
+      offset += c;
+    }
+    for (auto& item : *data) {
+      (*buffer)[count[(item.key >> (p * 8)) & 0xff]++] = item;
+    }
+    data->swap(*buffer);
+  }
+}
+
+// out and indices are [rows, width].
+template <typename T>
+void SortRows(const T* x,
+              int64_t rows,
+              int64_t width,
+              bool descending,
+              T* out,
+              int64_t* indices) {
+  using K = RankKey<T>;
+  if (width == 0) {
+    return;
+  }
+  const K flip = descending ? K(0) : ~K(0);
+#ifdef PADDLE_WITH_MKLML
+#pragma omp parallel
+#endif
+  {
+    std::vector<RankedIndex<K>> ranked, buffer;
+#ifdef PADDLE_WITH_MKLML
+#pragma omp for
+#endif
+    for (int64_t i = 0; i < rows; ++i) {
+      const T* row = x + i * width;
+      ranked.resize(width);
+      for (int64_t j = 0; j < width; ++j) {
+        ranked[j] = {MakeRankKey(row[j], flip), j};
+      }
+      if (width >= kRadixSortMinWidth) {
+        RadixSortRanked(&ranked, &buffer);
+      } else {
+        std::sort(ranked.begin(), ranked.end(), RankedBefore<K>);
+      }
+      for (int64_t j = 0; j < width; ++j) {
+        out[i * width + j] = row[ranked[j].index];
+        indices[i * width + j] = ranked[j].index;
+      }
+    }
+  }
+}
+
+}  // namespace funcs
+}  // namespace phi
@@ -17,10 +17,38 @@ limitations under the License. */
 #include "paddle/phi/backends/all_context.h"
 #include "paddle/phi/kernels/funcs/blas/blas.h"
 #include "paddle/phi/kernels/funcs/jit/kernels.h"
+#include "paddle/phi/kernels/funcs/packed_weight_cache.h"
 
 namespace phi {
 namespace funcs {
 
+namespace {
+
+// Y = relu(src + B) row by row, the rows of src are src_stride apart.
+template <typename T>
+void AddBias(const int M,
+             const int N,
+             const T* src,
+             const int src_stride,
+             const T* B,
+             bool relu,
+             T* Y) {
+  auto compute = relu ? phi::jit::KernelFuncs<phi::jit::VAddReluTuple<T>,
+                                              phi::CPUPlace>::Cache()
+                            .At(N)
+                      : phi::jit::KernelFuncs<phi::jit::VAddTuple<T>,
+                                              phi::CPUPlace>::Cache()
+                            .At(N);
+#ifdef PADDLE_WITH_MKLML
+#pragma omp parallel for
+#endif
+  for (int i = 0; i < M; i++) {
+    compute(B, src + i * src_stride, Y + i * N, N);
+  }
+}
+
+}  // namespace
+
 template <typename DeviceContext, typename T>
 void FCFunctor<DeviceContext, T>::operator()(const DeviceContext& context,
                                              const int M,
@@ -81,24 +109,116 @@ void FCFunctor<DeviceContext, T>::operator()(const DeviceContext& context,
         errors::PermissionDenied("When bias is NULL, relu can not be true."));
     return;
   }
-  auto compute = relu ? phi::jit::KernelFuncs<phi::jit::VAddReluTuple<T>,
-                                              phi::CPUPlace>::Cache()
-                            .At(N)
-                      : phi::jit::KernelFuncs<phi::jit::VAddTuple<T>,
-                                              phi::CPUPlace>::Cache()
-                            .At(N);
-#ifdef PADDLE_WITH_MKLML
-#pragma omp parallel for
-#endif
-  for (int i = 0; i < M; i++) {
-    T* dst = Y + i * N;
-    T* src = (padding_weights) ? Y1_data + i * (N + 4) : dst;
-    compute(B, src, dst, N);
+  if (padding_weights) {
+    AddBias(M, N, Y1_data, N + 4, B, relu, Y);
+  } else {
+    AddBias(M, N, Y, N, B, relu, Y);
   }
 }
 
 template class FCFunctor<CPUContext, float>;
 template class FCFunctor<CPUContext, double>;
 
+#ifdef PADDLE_WITH_MKLML
+template <typename T>
+FCPackedWeight<T>::FCPackedWeight(const CPUContext& context,
+                                  const T* W,
+                                  int N,
+                                  int K,
+                                  int ld)
+    : N_(N), K_(K) {
+  auto blas = GetBlas<CPUContext, T>(context);
+  data_ = blas.GEMM_ALLOC(CblasBMatrix, 1 /*height of C*/, N, K);
+  PADDLE_ENFORCE_NOT_NULL(
+      data_,
+      common::errors::Fatal("GEMM_ALLOC should not be null when using MKL."));
+  blas.GEMM_PACK(CblasBMatrix,
+                 CblasNoTrans,
+                 1 /*height of C*/,
+                 N,
+                 K,
+                 static_cast<T>(1.0),
+                 W,
+                 ld,
+                 data_);
+}
+
+template <typename T>
+FCPackedWeight<T>::~FCPackedWeight() {
+  CBlas<T>::GEMM_FREE(data_);
+}
+
+template <typename T>
+std::shared_ptr<const FCPackedWeight<T>> GetFCPackedWeight(
+    const CPUContext& context, const DenseTensor& w, bool padding_weights) {
+  PADDLE_ENFORCE_EQ(
+      w.dims().size(),
+      2,
+      common::errors::InvalidArgument(
+          "The weight of fc must be 2-D, but got %d-D.", w.dims().size()));
+  const int ld = static_cast<int>(w.dims()[1]);
+  const int K = static_cast<int>(w.dims()[0]) - (padding_weights ? 4 : 0);
+  const int N = ld - (padding_weights ? 4 : 0);
+  return PackedWeightCache::Instance().Get<FCPackedWeight<T>>(
+      w, padding_weights ? "mkl_padded" : "mkl", [&]() {
+        return std::make_unique<FCPackedWeight<T>>(
+            context, w.data<T>(), N, K, ld);
+      });
+}
+
+template <typename T>
+void FCPacked(const CPUContext& context,
+              const int M,
+              const T* X,
+              const FCPackedWeight<T>& W,
+              T* Y,
+              const T* B,
+              bool relu) {
+  auto blas = GetBlas<CPUContext, T>(context);
+  const int N = W.N(), K = W.K();
+  blas.GEMM_COMPUTE(CblasNoTrans,
+                    CblasPacked,
+                    M,
+                    N,
+                    K,
+                    X,
+                    K,
+                    W.data(),
+                    N,
+                    static_cast<T>(0.0),
+                    Y,
+                    N);
+  if (B == nullptr) {
+    PADDLE_ENFORCE_EQ(
+        relu,
+        false,
+        errors::PermissionDenied("When bias is NULL, relu can not be true."));
+    return;
+  }
+  AddBias(M, N, Y, N, B, relu, Y);
+}
+
+template class FCPackedWeight<float>;
+template class FCPackedWeight<double>;
+template std::shared_ptr<const FCPackedWeight<float>> GetFCPackedWeight(
+    const CPUContext& context, const DenseTensor& w, bool padding_weights);
+template std::shared_ptr<const FCPackedWeight<double>> GetFCPackedWeight(
+    const CPUContext& context, const DenseTensor& w, bool padding_weights);
+template void FCPacked(const CPUContext& context,
+                       const int M,
+                       const float* X,
+                       const FCPackedWeight<float>& W,
+                       float* Y,
+                       const float* B,
+                       bool relu);
+template void FCPacked(const CPUContext& context,
+                       const int M,
+                       const double* X,
+                       const FCPackedWeight<double>& W,
+                       double* Y,
+                       const double* B,
+                       bool relu);
+#endif
+
 }  // namespace funcs
 }  // namespace phi
@@ -14,6 +14,7 @@ limitations under the License. */
 
 #pragma once
 
+#include <memory>
 #include <string>
 
 #include "paddle/phi/backends/all_context.h"
@@ -57,5 +58,44 @@ class FCInt8Functor {
                   bool weight_pass = false);
 };
 
+#ifdef PADDLE_WITH_MKLML
+// The weight of fc packed once by MKL for the GEMMs of every batch: the
+// [K, N] block at the top left of a weight of ld columns.
+template <typename T>
+class FCPackedWeight {
+ public:
+  FCPackedWeight(const CPUContext& context, const T* W, int N, int K, int ld);
+  ~FCPackedWeight();
+
+  FCPackedWeight(const FCPackedWeight&) = delete;
+  FCPackedWeight& operator=(const FCPackedWeight&) = delete;
+
+  const T* data() const { return data_; }
+  int N() const { return N_; }
+  int K() const { return K_; }
+
+ private:
+  T* data_;
+  int N_;
+  int K_;
+};
+
+// The packed form of the weight w of fc, packed at the first call for its
+// allocation.
+template <typename T>
+std::shared_ptr<const FCPackedWeight<T>> GetFCPackedWeight(
+    const CPUContext& context, const DenseTensor& w, bool padding_weights);
+
+// fc of the rows of X and a packed weight, Y = relu(X * W + B).
+template <typename T>
+void FCPacked(const CPUContext& context,
+              const int M,
+              const T* X,
+              const FCPackedWeight<T>& W,
+              T* Y,
+              const T* B = nullptr,
+              bool relu = false);
+#endif
+
 }  // namespace funcs
 }  // namespace phi
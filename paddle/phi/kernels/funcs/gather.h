@@ -22,6 +22,7 @@ limitations under the License. */
 #include "paddle/common/macros.h"
 #include "paddle/phi/common/place.h"
 #include "paddle/phi/core/dense_tensor.h"
+#include "paddle/phi/kernels/funcs/cpu_gather_scatter.h"
 #include "paddle/phi/kernels/funcs/math_function.h"
 namespace phi {
 namespace funcs {
@@ -70,8 +71,6 @@ void CPUGather(const phi::CPUContext& ctx UNUSED,
   // int64_t input_size = src_dims[0] * slice_size;
   int64_t index_dim_size = src_dims[0];
 
-  const size_t slice_bytes = slice_size * sizeof(T);
-
   for (int64_t i = 0; i < index_size; ++i) {
     PADDLE_ENFORCE_LT(p_index[i],
                       index_dim_size,
@@ -92,9 +91,9 @@ void CPUGather(const phi::CPUContext& ctx UNUSED,
             -index_dim_size,
             p_index[i],
             i));
-    IndexT index_ = (p_index[i] < 0 ? p_index[i] + index_dim_size : p_index[i]);
-    memcpy(p_output + i * slice_size, p_src + index_ * slice_size, slice_bytes);
   }
+  GatherRows(
+      p_src, 1, index_dim_size, p_index, index_size, slice_size, p_output);
 }
 
 template <typename T, typename IndexT = int>
@@ -159,7 +158,6 @@ void GatherV2Function(const phi::CPUContext& ctx,
                       DenseTensor* out) {
   auto* index_data = index->data<U>();
   int64_t index_size = index->numel();
-  int64_t input_size = input->numel();
   auto input_dim = input->dims();
   auto* input_data = input->data<T>();
 
@@ -209,20 +207,13 @@ void GatherV2Function(const phi::CPUContext& ctx,
   out->Resize(out_dim);
   auto* out_data = ctx.Alloc<T>(out);
 
-  int out_index = 0;
-  for (int64_t i = 0; i < inner_dim_size; i++) {
-    for (int64_t j = 0; j < index_size; j++) {
-      const int64_t index_data_j =
-          (index_data[j] < 0 ? index_data[j] + input_index_dim_size
-                             : index_data[j]);
-      for (int64_t k = 0; k < outer_dim_size; k++) {
-        int64_t index = k + index_data_j * outer_dim_size +
-                        (i * input_size / inner_dim_size);
-        out_data[out_index] = input_data[index];
-        out_index++;
-      }
-    }
-  }
+  GatherRows(input_data,
+             inner_dim_size,
+             input_index_dim_size,
+             index_data,
+             index_size,
+             outer_dim_size,
+             out_data);
 }
 
 template <typename T, typename U>
@@ -262,18 +253,15 @@ void GatherV2GradFunction(const phi::CPUContext& ctx,
   // set_constant only supports input of type float value
   phi::funcs::set_constant(ctx, out, static_cast<float>(0.0));
 
-  for (int64_t i = 0; i < inner_dim_size; i++) {
-    for (int64_t j = 0; j < input_index_dim_size; j++) {
-      const int64_t index_data_j =
-          (index_data[j] < 0 ? index_data[j] + input_index_dim_size
-                             : index_data[j]);
-      for (int64_t k = 0; k < outer_dim_size; k++) {
-        int64_t index = k + index_data_j * outer_dim_size +
-                        i * outer_dim_size * out_index_dim_size;
-        out_data[index] += input_data[j * outer_dim_size + k];
-      }
-    }
-  }
+  ScatterRows(input_data,
+              inner_dim_size,
+              out_index_dim_size,
+              index_data,
+              input_index_dim_size,
+              outer_dim_size,
+              false,
+              false,
+              out_data);
 }
 
 }  // namespace funcs
@@ -269,6 +269,107 @@ void BenchKernelSeqPool() {
   }
 }
 
+template <typename KernelTuple, typename PlaceType>
+void BenchKernelSeqPoolCVM() {
+  using T = typename KernelTuple::data_type;
+  // CTR slots: show/click followed by the embedding, few ids per instance
+  for (int w : {11, 19, 35, 67}) {
+    for (bool use_cvm : {true, false}) {
+      jit::seq_pool_cvm_attr_t attr(w, jit::SeqPoolType::kSum, use_cvm);
+      for (int h : {1, 4, 16, 64}) {
+        attr.h = h;
+        phi::DenseTensor x, y;
+        x.Resize({h * w});
+        y.Resize({w});
+        RandomVec<T>(h * w, x.mutable_data<T>(PlaceType()), 0.f, 2.f);
+        const T* x_data = x.data<T>();
+        T* y_data = y.mutable_data<T>(PlaceType());
+        BenchAllImpls<KernelTuple, PlaceType>(attr, x_data, y_data, &attr);
+      }
+    }
+  }
+}
+
+// Average time of run in us, as BenchFunc.
+template <typename Callable>
+double BenchCallable(const Callable& run) {
+  for (int i = 0; i < FLAGS_burning; ++i) {
+    run();
+  }
+  double start = static_cast<double>(phi::PosixInNsec()) * 1e-3;
+  for (int i = 0; i < FLAGS_repeat; ++i) {
+    run();
+  }
+  double end = static_cast<double>(phi::PosixInNsec()) * 1e-3;
+  return static_cast<double>(end - start) / FLAGS_repeat;
+}
+
+template <typename KernelTuple, typename PlaceType>
+void BenchKernelFusedElementwise() {
+  using T = typename KernelTuple::data_type;
+  using XYZN = typename jit::VAddTuple<T>::func_type;
+  using XYN = typename jit::VExpTuple<T>::func_type;
+  // sigmoid((x0 + x1) * x2) and exp(x0 - x1) * x2 + x3, fused and as the
+  // chains of the jit kernels of each operation
+  jit::fused_elementwise_attr_t sigmoid_attr, exp_attr;
+  sigmoid_attr.Unary(
+      jit::kFuseSigmoid,
+      sigmoid_attr.Binary(
+          jit::kFuseMul,
+          sigmoid_attr.Binary(
+              jit::kFuseAdd, sigmoid_attr.Input(0), sigmoid_attr.Input(1)),
+          sigmoid_attr.Input(2)));
+  exp_attr.Binary(
+      jit::kFuseAdd,
+      exp_attr.Binary(
+          jit::kFuseMul,
+          exp_attr.Unary(
+              jit::kFuseExp,
+              exp_attr.Binary(
+                  jit::kFuseSub, exp_attr.Input(0), exp_attr.Input(1))),
+          exp_attr.Input(2)),
+      exp_attr.Input(3));
+  for (int d : {256, 4096, 65536, 1 << 20}) {
+    std::vector<phi::DenseTensor> x(4);
+    std::vector<const T*> inputs;
+    for (size_t i = 0; i < x.size(); ++i) {
+      x[i].Resize({d});
+      RandomVec<T>(d, x[i].mutable_data<T>(PlaceType()), -2.f, 2.f, i);
+      inputs.push_back(x[i].data<T>());
+    }
+    phi::DenseTensor y;
+    y.Resize({d});
+    T* y_data = y.mutable_data<T>(PlaceType());
+    const T* const* x_data = inputs.data();
+    const int64_t n = d;
+    BenchAllImpls<KernelTuple, PlaceType>(
+        sigmoid_attr, x_data, y_data, n, &sigmoid_attr);
+    BenchAllImpls<KernelTuple, PlaceType>(
+        exp_attr, x_data, y_data, n, &exp_attr);
+
+    XYZN vadd = jit::KernelFuncs<jit::VAddTuple<T>, PlaceType>::Cache().At(d);
+    XYZN vsub = jit::KernelFuncs<jit::VSubTuple<T>, PlaceType>::Cache().At(d);
+    XYZN vmul = jit::KernelFuncs<jit::VMulTuple<T>, PlaceType>::Cache().At(d);
+    XYN vexp = jit::KernelFuncs<jit::VExpTuple<T>, PlaceType>::Cache().At(d);
+    XYN vsigmoid =
+        jit::KernelFuncs<jit::VSigmoidTuple<T>, PlaceType>::Cache().At(d);
+    double sigmoid_chain = BenchCallable([&] {
+      vadd(inputs[0], inputs[1], y_data, d);
+      vmul(y_data, inputs[2], y_data, d);
+      vsigmoid(y_data, y_data, d);
+    });
+    double exp_chain = BenchCallable([&] {
+      vsub(inputs[0], inputs[1], y_data, d);
+      vexp(y_data, y_data, d);
+      vmul(y_data, inputs[2], y_data, d);
+      vadd(y_data, inputs[3], y_data, d);
+    });
+    LOG(INFO) << "Unfused chains of " << d << " elements: " << sigmoid_attr
+              << " takes " << sigmoid_chain << " us; " << exp_attr
+              << " takes " << exp_chain << " us";
+  }
+}
+
 template <typename KernelTuple, typename PlaceType>
 void BenchKernelEmbSeqPool() {
   using T = typename KernelTuple::data_type;
@@ -534,6 +635,8 @@ BENCH_FP32_CPU(LayerNorm);
 BENCH_FP32_CPU(CRFDecoding);
 
 BENCH_FP32_CPU(SeqPool);
+BENCH_FP32_CPU(SeqPoolCVM);
+BENCH_FP32_CPU(FusedElementwise);
 BENCH_FP32_CPU(EmbSeqPool);
 BENCH_FP32_CPU(MatMul);
 BENCH_FP32_CPU(Sgd);
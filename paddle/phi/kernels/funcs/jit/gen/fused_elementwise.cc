@@ -0,0 +1,251 @@
+/* Copyright (c) 2025 PaddlePaddle Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#include "paddle/phi/kernels/funcs/jit/gen/fused_elementwise.h"
+
+#include "paddle/phi/backends/cpu/cpu_info.h"
+#include "paddle/phi/kernels/funcs/jit/registry.h"
+
+namespace phi::jit::gen {
+
+// the mask of the first k lanes starts at fused_tail_mask[8 - k]
+const int ALIGN32_BEG fused_tail_mask[] ALIGN32_END = {  // NOLINT
+    REPEAT_8TIMES(-1),
+    REPEAT_8TIMES(0)};
+
+// offsets of the constants of gelu
+constexpr int kConstOne = 0;
+constexpr int kConstHalf = 1 * sizeof(float);
+constexpr int kConstGeluC1 = 2 * sizeof(float);
+constexpr int kConstGeluC0 = 3 * sizeof(float);
+
+std::vector<int> FusedElementwiseJitCode::AllocateRegisters(
+    const fused_elementwise_attr_t& attr) {
+  const auto& nodes = attr.nodes;
+  const int num_nodes = static_cast<int>(nodes.size());
+  std::vector<int> last_use(num_nodes, -1);
+  for (int i = 0; i < num_nodes; ++i) {
+    const auto& node = nodes[i];
+    if (node.op == kFuseInput) {
+      if (node.x < 0 || node.x >= attr.num_inputs) {
+        return {};
+      }
+    } else if (node.op != kFuseScalar) {
+      const bool binary = node.op <= kFuseMin;
+      if (node.op > kFuseGelu || node.x < 0 || node.x >= i ||
+          (binary && (node.y < 0 || node.y >= i))) {
+        return {};
+      }
+      last_use[node.x] = i;
+      if (binary) {
+        last_use[node.y] = i;
+      }
+    }
+  }
+  if (num_nodes == 0) {
+    return {};
+  }
+  last_use.back() = num_nodes;
+
+  // the register of a node is taken before the ones of its operands are
+  // given back, so that it never overwrites them
+  std::vector<int> free_regs;
+  for (int r = kNumRegs - 1; r >= 0; --r) {
+    free_regs.push_back(r);
+  }
+  std::vector<int> regs(num_nodes);
+  for (int i = 0; i < num_nodes; ++i) {
+    if (free_regs.empty()) {
+      return {};
+    }
+    regs[i] = free_regs.back();
+    free_regs.pop_back();
+    const auto& node = nodes[i];
+    if (node.op > kFuseScalar) {
+      if (last_use[node.x] == i) {
+        free_regs.push_back(regs[node.x]);
+      }
+      if (node.op <= kFuseMin && node.y != node.x && last_use[node.y] == i) {
+        free_regs.push_back(regs[node.y]);
+      }
+    }
+    if (last_use[i] < 0) {
+      // never used
+      free_regs.push_back(regs[i]);
+    }
+  }
+  return regs;
+}
+
+void FusedElementwiseJitCode::load(const ymm_t& dst,
+                                   const Xbyak::Address& src,
+                                   bool tail) {
+  if (tail) {
+    vmovups(ymm_mask, ptr[reg_mask]);
+    vmaskmovps(dst, ymm_mask, src);
+  } else {
+    vmovups(dst, src);
+  }
+}
+
+// 0.5 * x * (1 + tanh(sqrt(2 / pi) * x * (1 + 0.044715 * x^2)))
+void FusedElementwiseJitCode::gelu(const ymm_t& dst, const ymm_t& src) {
+  vmulps(dst, src, src);
+  vbroadcastss(ymm_tmp, ptr[reg_consts + kConstGeluC1]);
+  vmulps(dst, dst, ymm_tmp);
+  vbroadcastss(ymm_tmp, ptr[reg_consts + kConstOne]);
+  vaddps(dst, dst, ymm_tmp);
+  vmulps(dst, dst, src);
+  vbroadcastss(ymm_tmp, ptr[reg_consts + kConstGeluC0]);
+  vmulps(dst, dst, ymm_tmp);
+  tanh_jmm<ymm_t>(dst, dst, 11, 12, 13, 14, 15);
+  vbroadcastss(ymm_tmp, ptr[reg_consts + kConstOne]);
+  vaddps(dst, dst, ymm_tmp);
+  vmulps(dst, dst, src);
+  vbroadcastss(ymm_tmp, ptr[reg_consts + kConstHalf]);
+  vmulps(dst, dst, ymm_tmp);
+}
+
+void FusedElementwiseJitCode::genNodes(bool tail) {
+  for (size_t i = 0; i < nodes_.size(); ++i) {
+    const auto& node = nodes_[i];
+    ymm_t dst(regs_[i]);
+    if (node.op == kFuseInput) {
+      mov(reg_tmp, ptr[param_x + node.x * sizeof(void*)]);
+      load(dst, ptr[reg_tmp + reg_i * sizeof(float)], tail);
+      continue;
+    } else if (node.op == kFuseScalar) {
+      vbroadcastss(dst, ptr[reg_consts + scalar_offsets_[i]]);
+      continue;
+    }
+    ymm_t a(regs_[node.x]);
+    ymm_t b(node.op <= kFuseMin ? regs_[node.y] : regs_[node.x]);
+    switch (node.op) {
+      case kFuseAdd:
+        vaddps(dst, a, b);
+        break;
+      case kFuseSub:
+        vsubps(dst, a, b);
+        break;
+      case kFuseMul:
+        vmulps(dst, a, b);
+        break;
+      case kFuseDiv:
+        vdivps(dst, a, b);
+        break;
+      case kFuseMax:
+        vmaxps(dst, a, b);
+        break;
+      case kFuseMin:
+        vminps(dst, a, b);
+        break;
+      case kFuseRelu:
+        relu_jmm<ymm_t>(dst, a, 15);
+        break;
+      case kFuseSquare:
+        square_jmm<ymm_t>(dst, a);
+        break;
+      case kFuseExp:
+        exp_jmm<ymm_t>(dst, a, 11, 12, 13, 14, 15);
+        break;
+      case kFuseSigmoid:
+        sigmoid_jmm<ymm_t>(dst, a, 11, 12, 13, 14, 15);
+        break;
+      case kFuseTanh:
+        tanh_jmm<ymm_t>(dst, a, 11, 12, 13, 14, 15);
+        break;
+      case kFuseGelu:
+        gelu(dst, a);
+        break;
+      default:
+        PADDLE_THROW(common::errors::Unimplemented(
+            "Fused elementwise JIT kernel do not support operation: %d.",
+            node.op));
+    }
+  }
+  ymm_t out(regs_.back());
+  if (tail) {
+    vmovups(ymm_mask, ptr[reg_mask]);
+    vmaskmovps(ptr[param_y + reg_i * sizeof(float)], ymm_mask, out);
+  } else {
+    vmovups(ptr[param_y + reg_i * sizeof(float)], out);
+  }
+}
+
+void FusedElementwiseJitCode::genCode() {
+  Label l_main, l_tail, l_end;
+  mov(reg_consts, reinterpret_cast<size_t>(consts_.data()));
+  xor_(reg_i, reg_i);
+  mov(reg_end, param_n);
+  and_(reg_end, -YMM_FLOAT_BLOCK);
+  L(l_main);
+  cmp(reg_i, reg_end);
+  jge(l_tail, T_NEAR);
+  genNodes(false);
+  add(reg_i, YMM_FLOAT_BLOCK);
+  jmp(l_main, T_NEAR);
+
+  L(l_tail);
+  cmp(reg_i, param_n);
+  jge(l_end, T_NEAR);
+  mov(reg_tmp, param_n);
+  sub(reg_tmp, reg_i);
+  shl(reg_tmp, 2);
+  mov(reg_mask, reinterpret_cast<size_t>(fused_tail_mask + YMM_FLOAT_BLOCK));
+  sub(reg_mask, reg_tmp);
+  genNodes(true);
+
+  L(l_end);
+  vzeroupper();
+  ret();
+}
+
+class FusedElementwiseCreator
+    : public JitCodeCreator<fused_elementwise_attr_t> {
+ public:
+  // AVX2 as the exp of AVX goes through a global buffer, which the threads
+  // running fused kernels at the same time would share
+  bool CanBeUsed(const fused_elementwise_attr_t& attr) const override {
+    return phi::backends::cpu::MayIUse(phi::backends::cpu::avx2) &&
+           !FusedElementwiseJitCode::AllocateRegisters(attr).empty();
+  }
+  size_t CodeSize(const fused_elementwise_attr_t& attr) const override {
+    size_t size = 256;
+    for (const auto& node : attr.nodes) {
+      int instructions = 4;
+      if (node.op == kFuseExp) {
+        instructions = 70;
+      } else if (node.op == kFuseSigmoid) {
+        instructions = 82;
+      } else if (node.op == kFuseTanh) {
+        instructions = 84;
+      } else if (node.op == kFuseGelu) {
+        instructions = 96;
+      }
+      // the main loop and the tail, 8 bytes for each instruction
+      size += 2 * instructions * 8;
+    }
+    return size;
+  }
+  std::unique_ptr<GenBase> CreateJitCode(
+      const fused_elementwise_attr_t& attr) const override {
+    return make_unique<FusedElementwiseJitCode>(attr, CodeSize(attr));
+  }
+};
+
+}  // namespace phi::jit::gen
+
+namespace gen = phi::jit::gen;
+
+REGISTER_JITKERNEL_GEN(kFusedElementwise, gen::FusedElementwiseCreator);
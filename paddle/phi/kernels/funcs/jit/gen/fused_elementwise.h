@@ -0,0 +1,93 @@
+/* Copyright (c) 2025 PaddlePaddle Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "glog/logging.h"
+#include "paddle/phi/core/enforce.h"
+#include "paddle/phi/kernels/funcs/jit/gen/act.h"
+
+namespace phi {
+namespace jit {
+namespace gen {
+
+// One loop over the elements evaluating the whole expression in registers,
+// 8 elements at a time and the rest with masked loads and stores.
+class FusedElementwiseJitCode : public VActFunc {
+ public:
+  explicit FusedElementwiseJitCode(const fused_elementwise_attr_t& attr,
+                                   size_t code_size,
+                                   void* code_ptr = nullptr)
+      : VActFunc(code_size, code_ptr),
+        nodes_(attr.nodes),
+        regs_(AllocateRegisters(attr)) {
+    PADDLE_ENFORCE_EQ(regs_.empty(),
+                      false,
+                      common::errors::InvalidArgument(
+                          "The fused elementwise expression is invalid or "
+                          "needs more than %d registers.",
+                          kNumRegs));
+    // the constants of gelu, then the scalars of the expression
+    consts_ = {1.f, 0.5f, 0.044715f, 0.7978845608028654f};
+    scalar_offsets_.resize(nodes_.size(), 0);
+    for (size_t i = 0; i < nodes_.size(); ++i) {
+      if (nodes_[i].op == kFuseScalar) {
+        scalar_offsets_[i] = static_cast<int>(consts_.size() * sizeof(float));
+        consts_.push_back(nodes_[i].scalar);
+      }
+    }
+    this->genCode();
+  }
+
+  DECLARE_JIT_CODE(FusedElementwiseJitCode);
+  void genCode() override;
+
+  // The register of each node: the value of a node stays in its register
+  // until its last use, ymm11 to ymm15 are the temporaries of the
+  // activations. Empty if the expression is invalid or has more live values
+  // than registers.
+  static std::vector<int> AllocateRegisters(
+      const fused_elementwise_attr_t& attr);
+
+  static constexpr int kNumRegs = 11;
+
+ protected:
+  void genNodes(bool tail);
+  void load(const ymm_t& dst, const Xbyak::Address& src, bool tail);
+  void gelu(const ymm_t& dst, const ymm_t& src);
+
+  std::vector<fused_elementwise_node_t> nodes_;
+  std::vector<int> regs_;
+  std::vector<float> consts_;
+  std::vector<int> scalar_offsets_;
+
+  reg64_t param_x{abi_param1};
+  reg64_t param_y{abi_param2};
+  reg64_t param_n{abi_param3};
+  reg64_t reg_mask{abi_param4};
+  reg64_t reg_end{r8};
+  reg64_t reg_consts{r9};
+  reg64_t reg_i{r10};
+  reg64_t reg_tmp{r11};
+
+  ymm_t ymm_mask = ymm_t(15);
+  ymm_t ymm_tmp = ymm_t(15);
+};
+
+}  // namespace gen
+}  // namespace jit
+}  // namespace phi
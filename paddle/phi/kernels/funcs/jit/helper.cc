@@ -54,10 +54,12 @@ const char* to_string(KernelType kt) {
     ONE_CASE(kCRFDecoding);
     ONE_CASE(kLayerNorm);
     ONE_CASE(kSeqPool);
+    ONE_CASE(kSeqPoolCVM);
     ONE_CASE(kMatMul);
     ONE_CASE(kAdam);
     ONE_CASE(kAdamW);
     ONE_CASE(kEmbSeqPool);
+    ONE_CASE(kFusedElementwise);
     ONE_CASE(kSgd);
     default:
       PADDLE_THROW(common::errors::Unimplemented(
@@ -82,6 +84,77 @@ const char* to_string(SeqPoolType tp) {
 }
 #undef ONE_CASE
 
+namespace {
+
+const char* FusedOpName(FusedElementwiseOp op) {
+  switch (op) {
+    case kFuseAdd:
+      return "add";
+    case kFuseSub:
+      return "sub";
+    case kFuseMul:
+      return "mul";
+    case kFuseDiv:
+      return "div";
+    case kFuseMax:
+      return "max";
+    case kFuseMin:
+      return "min";
+    case kFuseRelu:
+      return "relu";
+    case kFuseSquare:
+      return "square";
+    case kFuseExp:
+      return "exp";
+    case kFuseSigmoid:
+      return "sigmoid";
+    case kFuseTanh:
+      return "tanh";
+    case kFuseGelu:
+      return "gelu";
+    default:
+      PADDLE_THROW(common::errors::Unimplemented(
+          "Fused elementwise JIT kernel do not support operation: %d.", op));
+  }
+  return nullptr;
+}
+
+void PrintFusedNode(std::ostream& os,
+                    const fused_elementwise_attr_t& attr,
+                    int i) {
+  PADDLE_ENFORCE_EQ(
+      i >= 0 && i < static_cast<int>(attr.nodes.size()),
+      true,
+      common::errors::InvalidArgument(
+          "The fused elementwise expression has no node %d.", i));
+  const auto& node = attr.nodes[i];
+  if (node.op == kFuseInput) {
+    os << "x" << node.x;
+  } else if (node.op == kFuseScalar) {
+    os << node.scalar;
+  } else {
+    os << FusedOpName(node.op) << "(";
+    PrintFusedNode(os, attr, node.x);
+    if (node.op < kFuseRelu) {
+      os << ",";
+      PrintFusedNode(os, attr, node.y);
+    }
+    os << ")";
+  }
+}
+
+}  // namespace
+
+std::ostream& operator<<(std::ostream& os,
+                         const fused_elementwise_attr_t& attr) {
+  os << "expression[";
+  if (!attr.nodes.empty()) {
+    PrintFusedNode(os, attr, static_cast<int>(attr.nodes.size()) - 1);
+  }
+  os << "]";
+  return os;
+}
+
 KernelType to_kerneltype(const std::string& act) {
   std::string lower = act;
   std::transform(lower.begin(), lower.end(), lower.begin(), ::tolower);
@@ -271,6 +271,14 @@ inline std::ostream& operator<<(std::ostream& os, const seq_pool_attr_t& attr) {
   return os;
 }
 
+inline std::ostream& operator<<(std::ostream& os,
+                                const seq_pool_cvm_attr_t& attr) {
+  os << "height_size[" << attr.h << "],width_size[" << attr.w << "],pool_type["
+     << to_string(attr.type) << "],use_cvm[" << attr.use_cvm
+     << "],cvm_offset[" << attr.cvm_offset << "]";
+  return os;
+}
+
 inline std::ostream& operator<<(std::ostream& os,
                                 const emb_seq_pool_attr_t& attr) {
   os << "table_height[" << attr.table_height << "],table_width["
@@ -298,6 +306,10 @@ inline std::ostream& operator<<(std::ostream& os, const matmul_attr_t& attr) {
   return os;
 }
 
+// Prints the expression as nested calls, as "expression[relu(add(x0,x1))]".
+std::ostream& operator<<(std::ostream& os,
+                         const fused_elementwise_attr_t& attr);
+
 // expose the method to pack matmul weight
 template <typename T>
 void pack_weights(const T* src, T* dst, int n, int k);
@@ -14,6 +14,7 @@
 
 #pragma once
 #include <cstdint>
+#include <vector>
 
 #include "paddle/common/macros.h"
 #include "paddle/phi/kernels/funcs/jit/macro.h"
@@ -28,6 +29,7 @@ typedef enum {
   kAdamW,
   kCRFDecoding,
   kEmbSeqPool,
+  kFusedElementwise,
   kGRUH1,
   kGRUHtPart1,
   kGRUHtPart2,
@@ -36,6 +38,7 @@ typedef enum {
   kLayerNorm,
   kMatMul,
   kSeqPool,
+  kSeqPoolCVM,
   kVAdd,
   kVAddBias,
   kVAddRelu,
@@ -207,6 +210,38 @@ struct SeqPoolTuple {
   typedef void (*func_type)(const T*, T*, const seq_pool_attr_t*);
 };
 
+// Sequence pooling followed by the CVM transform of CTR models: the first
+// cvm_offset columns are show/click counters that are log-transformed when
+// use_cvm is true and dropped otherwise, so y has width w or w - cvm_offset.
+typedef struct seq_pool_cvm_attr_s {
+  int h, w;  // h should always be the first one
+  SeqPoolType type;
+  bool use_cvm;
+  int cvm_offset;
+  float pad_value;
+  seq_pool_cvm_attr_s() = default;
+  explicit seq_pool_cvm_attr_s(int width,
+                               SeqPoolType pool_type,
+                               bool use_cvm = true,
+                               int cvm_offset = 2,
+                               float pad_value = 0.f,
+                               int height = 1)
+      : h(height),
+        w(width),
+        type(pool_type),
+        use_cvm(use_cvm),
+        cvm_offset(cvm_offset),
+        pad_value(pad_value) {}
+} seq_pool_cvm_attr_t;
+
+template <typename T>
+struct SeqPoolCVMTuple {
+  static constexpr KernelType kernel_type = kSeqPoolCVM;
+  typedef T data_type;
+  typedef seq_pool_cvm_attr_t attr_type;
+  typedef void (*func_type)(const T*, T*, const seq_pool_cvm_attr_t*);
+};
+
 typedef struct emb_seq_pool_attr_s {
   int64_t table_height, table_width;
   int64_t index_height, index_width;
@@ -343,6 +378,72 @@ struct MatMulTuple {
   typedef void (*func_type)(const T*, const T*, T*, const matmul_attr_t*);
 };
 
+// The operations of a fused elementwise expression: the leaves, the binary
+// operations from kFuseAdd to kFuseMin and the unary ones after them.
+typedef enum {
+  kFuseInput = 0,
+  kFuseScalar,
+  kFuseAdd,
+  kFuseSub,
+  kFuseMul,
+  kFuseDiv,
+  kFuseMax,
+  kFuseMin,
+  kFuseRelu,
+  kFuseSquare,
+  kFuseExp,
+  kFuseSigmoid,
+  kFuseTanh,
+  kFuseGelu,
+} FusedElementwiseOp;
+
+// A node of a fused elementwise expression: the input of index x, the scalar
+// constant, or the operation on the nodes x (and y for binary operations).
+typedef struct fused_elementwise_node_s {
+  FusedElementwiseOp op;
+  int x, y;
+  float scalar;
+} fused_elementwise_node_t;
+
+// The expression DAG of a chain of elementwise operations found by a fusion
+// pass, evaluated in one pass over the elements. The nodes only use the nodes
+// before them and the last node is the output. The kernels are cached by the
+// expression, whatever the number of elements.
+typedef struct fused_elementwise_attr_s {
+  int num_inputs{0};
+  std::vector<fused_elementwise_node_t> nodes;
+  fused_elementwise_attr_s() = default;
+
+  // Each method appends a node and returns its index.
+  int Input(int i) {
+    num_inputs = i + 1 > num_inputs ? i + 1 : num_inputs;
+    return Append({kFuseInput, i, -1, 0.f});
+  }
+  int Scalar(float value) { return Append({kFuseScalar, -1, -1, value}); }
+  int Unary(FusedElementwiseOp op, int x) { return Append({op, x, -1, 0.f}); }
+  int Binary(FusedElementwiseOp op, int x, int y) {
+    return Append({op, x, y, 0.f});
+  }
+
+ private:
+  int Append(const fused_elementwise_node_t& node) {
+    nodes.push_back(node);
+    return static_cast<int>(nodes.size()) - 1;
+  }
+} fused_elementwise_attr_t;
+
+// inputs, output, n
+template <typename T>
+struct FusedElementwiseTuple {
+  static constexpr KernelType kernel_type = kFusedElementwise;
+  typedef T data_type;
+  typedef fused_elementwise_attr_t attr_type;
+  typedef void (*func_type)(const T* const*,
+                            T*,
+                            int64_t,
+                            const fused_elementwise_attr_t*);
+};
+
 template <typename T>
 struct CRFDecodingTuple {
   static constexpr KernelType kernel_type = kCRFDecoding;
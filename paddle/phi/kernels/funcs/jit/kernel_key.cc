@@ -16,6 +16,8 @@
 
 #include <xxhash.h>  // XXH64: 13.8 GB/s
 #include <array>
+#include <cstring>
+#include <vector>
 
 namespace phi::jit {
 
@@ -50,6 +52,15 @@ int64_t JitCodeKey<seq_pool_attr_t>(const seq_pool_attr_t& attr) {
   return static_cast<int64_t>(XXH64(keys.data(), sizeof(int) * 2, 0));
 }
 
+template <>
+int64_t JitCodeKey<seq_pool_cvm_attr_t>(const seq_pool_cvm_attr_t& attr) {
+  std::array<int, 4> keys = {attr.w,
+                             static_cast<int>(attr.type),
+                             static_cast<int>(attr.use_cvm),
+                             attr.cvm_offset};
+  return static_cast<int64_t>(XXH64(keys.data(), sizeof(int) * 4, 0));
+}
+
 template <>
 int64_t JitCodeKey<matmul_attr_t>(const matmul_attr_t& attr) {
   return static_cast<int64_t>(XXH64(&attr, sizeof(int) * 3, 0));  // m, n, k
@@ -60,6 +71,23 @@ int64_t JitCodeKey<emb_seq_pool_attr_t>(const emb_seq_pool_attr_t& attr) {
   return attr.table_width;
 }
 
+template <>
+int64_t JitCodeKey<fused_elementwise_attr_t>(
+    const fused_elementwise_attr_t& attr) {
+  // the expression is the signature of the kernel, the scalars are part of it
+  std::vector<int> keys;
+  keys.reserve(attr.nodes.size() * 4 + 1);
+  keys.push_back(attr.num_inputs);
+  for (const auto& node : attr.nodes) {
+    int scalar;
+    std::memcpy(&scalar, &node.scalar, sizeof(int));
+    keys.insert(keys.end(),
+                {static_cast<int>(node.op), node.x, node.y, scalar});
+  }
+  return static_cast<int64_t>(
+      XXH64(keys.data(), sizeof(int) * keys.size(), 0));
+}
+
 template <>
 int64_t JitCodeKey<sgd_attr_t>(const sgd_attr_t& attr) {
   return attr.grad_width;
@@ -0,0 +1,98 @@
+/* Copyright (c) 2025 PaddlePaddle Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#include "paddle/phi/kernels/funcs/jit/more/intrinsic/seqpool_cvm.h"
+
+#include <immintrin.h>
+
+#include <cmath>
+
+#include "paddle/phi/backends/cpu/cpu_info.h"
+#include "paddle/phi/kernels/funcs/jit/registry.h"
+
+namespace phi::jit::more::intrinsic {
+
+namespace {
+
+bool UseAVX512() {
+  static const bool use_avx512 =
+      detail::SeqPoolCVMAVX512Compiled() &&
+      phi::backends::cpu::MayIUse(phi::backends::cpu::avx512f);
+  return use_avx512;
+}
+
+}  // namespace
+
+void SeqPoolCVM(const float* x, float* y, const seq_pool_cvm_attr_t* attr) {
+  const int h = attr->h;
+  const int w = attr->w;
+  const int start = attr->use_cvm ? 0 : attr->cvm_offset;
+  const int out_w = w - start;
+  float scalar = 1.f;
+  if (h > 0 && attr->type == SeqPoolType::kAvg) {
+    scalar = 1.f / static_cast<float>(h);
+  } else if (h > 0 && attr->type == SeqPoolType::kSqrt) {
+    scalar = 1.f / std::sqrt(static_cast<float>(h));
+  }
+  if (UseAVX512()) {
+    detail::SeqPoolCVMSumAVX512(x, y, attr, start, out_w, scalar);
+  } else {
+    int col = 0;
+    constexpr int block = YMM_FLOAT_BLOCK;
+    const __m256 pad = _mm256_set1_ps(attr->pad_value);
+    const __m256 scal = _mm256_set1_ps(scalar);
+    for (; col + 2 * block <= out_w; col += 2 * block) {
+      __m256 acc0 = pad, acc1 = pad;
+      const float* src = x + start + col;
+      for (int i = 0; i < h; ++i, src += w) {
+        acc0 = _mm256_add_ps(acc0, _mm256_loadu_ps(src));
+        acc1 = _mm256_add_ps(acc1, _mm256_loadu_ps(src + block));
+      }
+      _mm256_storeu_ps(y + col, _mm256_mul_ps(acc0, scal));
+      _mm256_storeu_ps(y + col + block, _mm256_mul_ps(acc1, scal));
+    }
+    for (; col + block <= out_w; col += block) {
+      __m256 acc = pad;
+      const float* src = x + start + col;
+      for (int i = 0; i < h; ++i, src += w) {
+        acc = _mm256_add_ps(acc, _mm256_loadu_ps(src));
+      }
+      _mm256_storeu_ps(y + col, _mm256_mul_ps(acc, scal));
+    }
+    for (; col < out_w; ++col) {
+      float acc = attr->pad_value;
+      const float* src = x + start + col;
+      for (int i = 0; i < h; ++i, src += w) {
+        acc += *src;
+      }
+      y[col] = acc * scalar;
+    }
+  }
+  if (attr->use_cvm) {
+    y[0] = std::log(y[0] + 1.f);
+    y[1] = std::log(y[1] + 1.f) - y[0];
+  }
+}
+
+bool SeqPoolCVMKernel::CanBeUsed(const seq_pool_cvm_attr_t& attr) const {
+  return UseAVX512() ||
+         (phi::backends::cpu::MayIUse(phi::backends::cpu::avx) &&
+          attr.w >= YMM_FLOAT_BLOCK);
+}
+
+}  // namespace phi::jit::more::intrinsic
+
+namespace intrinsic = phi::jit::more::intrinsic;
+
+REGISTER_JITKERNEL_MORE(kSeqPoolCVM, intrinsic, intrinsic::SeqPoolCVMKernel);
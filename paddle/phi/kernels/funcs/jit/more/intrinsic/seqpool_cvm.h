@@ -0,0 +1,51 @@
+/* Copyright (c) 2025 PaddlePaddle Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#pragma once
+
+#include <type_traits>
+
+#include "paddle/phi/kernels/funcs/jit/kernel_base.h"
+
+namespace phi {
+namespace jit {
+namespace more {
+namespace intrinsic {
+
+void SeqPoolCVM(const float* x, float* y, const seq_pool_cvm_attr_t* attr);
+
+namespace detail {
+// Sum pooling of seqpool_cvm_avx512.cc, built with AVX512F when it is found.
+// SeqPoolCVMSumAVX512 must only be called if SeqPoolCVMAVX512Compiled.
+bool SeqPoolCVMAVX512Compiled();
+void SeqPoolCVMSumAVX512(const float* x,
+                         float* y,
+                         const seq_pool_cvm_attr_t* attr,
+                         int start,
+                         int out_w,
+                         float scalar);
+}  // namespace detail
+
+class SeqPoolCVMKernel : public KernelMore<SeqPoolCVMTuple<float>> {
+ public:
+  SeqPoolCVMKernel() { this->func = SeqPoolCVM; }
+  bool CanBeUsed(
+      const typename SeqPoolCVMTuple<float>::attr_type&) const override;
+  const char* ImplType() const override { return "Intrinsic"; }
+};
+
+}  // namespace intrinsic
+}  // namespace more
+}  // namespace jit
+}  // namespace phi
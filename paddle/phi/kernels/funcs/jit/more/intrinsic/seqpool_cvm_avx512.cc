@@ -0,0 +1,85 @@
+/* Copyright (c) 2025 PaddlePaddle Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#include "paddle/phi/kernels/funcs/jit/more/intrinsic/seqpool_cvm.h"
+
+#ifdef __AVX512F__
+#include <immintrin.h>
+#endif
+
+#include "paddle/phi/core/enforce.h"
+
+namespace phi::jit::more::intrinsic::detail {
+
+#ifdef __AVX512F__
+
+bool SeqPoolCVMAVX512Compiled() { return true; }
+
+void SeqPoolCVMSumAVX512(const float* x,
+                         float* y,
+                         const seq_pool_cvm_attr_t* attr,
+                         int start,
+                         int out_w,
+                         float scalar) {
+  const int h = attr->h;
+  const int w = attr->w;
+  int col = 0;
+  constexpr int block = ZMM_FLOAT_BLOCK;
+  const __m512 pad = _mm512_set1_ps(attr->pad_value);
+  const __m512 scal = _mm512_set1_ps(scalar);
+  // 4 accumulators per pass so each row is read with full cache lines
+  for (; col + 4 * block <= out_w; col += 4 * block) {
+    __m512 acc0 = pad, acc1 = pad, acc2 = pad, acc3 = pad;
+    const float* src = x + start + col;
+    for (int i = 0; i < h; ++i, src += w) {
+      acc0 = _mm512_add_ps(acc0, _mm512_loadu_ps(src));
+      acc1 = _mm512_add_ps(acc1, _mm512_loadu_ps(src + block));
+      acc2 = _mm512_add_ps(acc2, _mm512_loadu_ps(src + 2 * block));
+      acc3 = _mm512_add_ps(acc3, _mm512_loadu_ps(src + 3 * block));
+    }
+    _mm512_storeu_ps(y + col, _mm512_mul_ps(acc0, scal));
+    _mm512_storeu_ps(y + col + block, _mm512_mul_ps(acc1, scal));
+    _mm512_storeu_ps(y + col + 2 * block, _mm512_mul_ps(acc2, scal));
+    _mm512_storeu_ps(y + col + 3 * block, _mm512_mul_ps(acc3, scal));
+  }
+  for (; col < out_w; col += block) {
+    const int rest = out_w - col;
+    const __mmask16 mask =
+        rest >= block ? 0xffff : static_cast<__mmask16>((1U << rest) - 1);
+    __m512 acc = pad;
+    const float* src = x + start + col;
+    for (int i = 0; i < h; ++i, src += w) {
+      acc = _mm512_add_ps(acc, _mm512_maskz_loadu_ps(mask, src));
+    }
+    _mm512_mask_storeu_ps(y + col, mask, _mm512_mul_ps(acc, scal));
+  }
+}
+
+#else
+
+bool SeqPoolCVMAVX512Compiled() { return false; }
+
+void SeqPoolCVMSumAVX512(const float* x,
+                         float* y,
+                         const seq_pool_cvm_attr_t* attr,
+                         int start,
+                         int out_w,
+                         float scalar) {
+  PADDLE_THROW(common::errors::Unavailable(
+      "The seqpool cvm jit kernel is not built with AVX512F."));
+}
+
+#endif
+
+}  // namespace phi::jit::more::intrinsic::detail
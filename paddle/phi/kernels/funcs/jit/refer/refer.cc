@@ -48,6 +48,8 @@ REGISTER_REFER_KERNEL(GRUHtPart2);
 REGISTER_REFER_KERNEL(CRFDecoding);
 REGISTER_REFER_KERNEL(LayerNorm);
 REGISTER_REFER_KERNEL(SeqPool);
+REGISTER_REFER_KERNEL(SeqPoolCVM);
+REGISTER_REFER_KERNEL(FusedElementwise);
 REGISTER_REFER_KERNEL(MatMul);
 REGISTER_REFER_KERNEL(EmbSeqPool);
 REGISTER_REFER_KERNEL(Adam);
@@ -17,6 +17,7 @@
 #include <cmath>
 #include <limits>
 #include <string>
+#include <vector>
 
 #include "paddle/phi/core/enforce.h"
 #include "paddle/phi/kernels/funcs/jit/helper.h"
@@ -375,6 +376,138 @@ void SeqPool(const T* x, T* y, const seq_pool_attr_t* attr) {
   }
 }
 
+template <typename T>
+void SeqPoolCVM(const T* x, T* y, const seq_pool_cvm_attr_t* attr) {
+  int start = attr->use_cvm ? 0 : attr->cvm_offset;
+  T scalar = static_cast<T>(1);
+  if (attr->type == SeqPoolType::kAvg) {
+    scalar = scalar / static_cast<T>(attr->h);
+  } else if (attr->type == SeqPoolType::kSqrt) {
+    scalar = scalar / std::sqrt(static_cast<T>(attr->h));
+  }
+  for (int w = start; w < attr->w; ++w) {
+    const T* src = x + w;
+    T sum = static_cast<T>(attr->pad_value);
+    for (int h = 0; h < attr->h; ++h) {
+      sum += *src;
+      src += attr->w;
+    }
+    y[w - start] = attr->h > 0 ? sum * scalar : sum;
+  }
+  if (attr->use_cvm) {
+    y[0] = std::log(y[0] + static_cast<T>(1));
+    y[1] = std::log(y[1] + static_cast<T>(1)) - y[0];
+  }
+}
+
+template <typename T>
+void FusedElementwise(const T* const* x,
+                      T* y,
+                      int64_t n,
+                      const fused_elementwise_attr_t* attr) {
+  const auto& nodes = attr->nodes;
+  PADDLE_ENFORCE_GT(nodes.size(),
+                    0UL,
+                    common::errors::InvalidArgument(
+                        "The fused elementwise expression is empty."));
+  for (size_t i = 0; i < nodes.size(); ++i) {
+    const auto& node = nodes[i];
+    const int num_nodes = static_cast<int>(i);
+    bool valid = true;
+    if (node.op == kFuseInput) {
+      valid = node.x >= 0 && node.x < attr->num_inputs;
+    } else if (node.op != kFuseScalar) {
+      valid = node.x >= 0 && node.x < num_nodes &&
+              (node.op > kFuseMin || (node.y >= 0 && node.y < num_nodes));
+    }
+    PADDLE_ENFORCE_EQ(
+        valid,
+        true,
+        common::errors::InvalidArgument(
+            "The node %d of the fused elementwise expression should use the "
+            "inputs or the nodes before it, but it uses %d and %d.",
+            i,
+            node.x,
+            node.y));
+  }
+  // y = 2 * sigmoid(2x) - 1 as VTanh
+  auto tanh = [](T v) {
+    const T min = SIGMOID_THRESHOLD_MIN;
+    const T max = SIGMOID_THRESHOLD_MAX;
+    v = static_cast<T>(2) * v;
+    v = (v < min) ? min : ((v > max) ? max : v);
+    return static_cast<T>(2) / (static_cast<T>(1) + std::exp(-v)) -
+           static_cast<T>(1);
+  };
+  std::vector<T> v(nodes.size());
+  for (int64_t i = 0; i < n; ++i) {
+    for (size_t j = 0; j < nodes.size(); ++j) {
+      const auto& node = nodes[j];
+      const T a = node.op > kFuseScalar ? v[node.x] : static_cast<T>(0);
+      const T b = node.op >= kFuseAdd && node.op <= kFuseMin
+                      ? v[node.y]
+                      : static_cast<T>(0);
+      switch (node.op) {
+        case kFuseInput:
+          v[j] = x[node.x][i];
+          break;
+        case kFuseScalar:
+          v[j] = static_cast<T>(node.scalar);
+          break;
+        case kFuseAdd:
+          v[j] = a + b;
+          break;
+        case kFuseSub:
+          v[j] = a - b;
+          break;
+        case kFuseMul:
+          v[j] = a * b;
+          break;
+        case kFuseDiv:
+          v[j] = a / b;
+          break;
+        case kFuseMax:
+          v[j] = a > b ? a : b;
+          break;
+        case kFuseMin:
+          v[j] = a < b ? a : b;
+          break;
+        case kFuseRelu:
+          v[j] = a > 0 ? a : 0;
+          break;
+        case kFuseSquare:
+          v[j] = a * a;
+          break;
+        case kFuseExp:
+          v[j] = std::exp(a);
+          break;
+        case kFuseSigmoid: {
+          const T min = SIGMOID_THRESHOLD_MIN;
+          const T max = SIGMOID_THRESHOLD_MAX;
+          T tmp = (a < min) ? min : ((a > max) ? max : a);
+          v[j] = static_cast<T>(1) / (static_cast<T>(1) + std::exp(-tmp));
+          break;
+        }
+        case kFuseTanh:
+          v[j] = tanh(a);
+          break;
+        case kFuseGelu: {
+          // the tanh approximation
+          const T c = static_cast<T>(0.7978845608028654);  // sqrt(2 / pi)
+          const T inner = c * a * (1 + static_cast<T>(0.044715) * a * a);
+          v[j] = static_cast<T>(0.5) * a * (1 + tanh(inner));
+          break;
+        }
+        default:
+          PADDLE_THROW(common::errors::Unimplemented(
+              "Fused elementwise JIT kernel do not support operation: %d.",
+              node.op));
+      }
+    }
+    y[i] = v.back();
+  }
+}
+
 // A(M,K) * B(K,N) = C(M,N)
 template <typename T>
 void MatMul(const T* A, const T* B, T* C, const matmul_attr_t* attr) {
@@ -627,6 +760,8 @@ DECLARE_REFER_KERNEL(GRUHtPart2);
 DECLARE_REFER_KERNEL(CRFDecoding);
 DECLARE_REFER_KERNEL(LayerNorm);
 DECLARE_REFER_KERNEL(SeqPool);
+DECLARE_REFER_KERNEL(SeqPoolCVM);
+DECLARE_REFER_KERNEL(FusedElementwise);
 DECLARE_REFER_KERNEL(MatMul);
 DECLARE_REFER_KERNEL(EmbSeqPool);
 DECLARE_REFER_KERNEL(Adam);
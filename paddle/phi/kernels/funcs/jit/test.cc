@@ -588,6 +588,129 @@ void TestKernelSeqPool() {
   }
 }
 
+template <typename KernelTuple, typename PlaceType>
+void TestKernelSeqPoolCVM() {
+  using T = typename KernelTuple::data_type;
+  VLOG(10) << "Test JITKernel: " << jit::to_string(KernelTuple::kernel_type);
+  std::vector<jit::SeqPoolType> pool_types = {
+      jit::SeqPoolType::kSum, jit::SeqPoolType::kAvg, jit::SeqPoolType::kSqrt};
+  auto test_sizes = TestSizes();
+  test_sizes.erase(std::remove_if(test_sizes.begin(),
+                                  test_sizes.end(),
+                                  [](int n) { return n >= 1000; }),
+                   test_sizes.end());
+  for (auto type : pool_types) {
+    for (bool use_cvm : {true, false}) {
+      for (int w : test_sizes) {
+        if (w < 3) continue;
+        jit::seq_pool_cvm_attr_t attr(w, type, use_cvm, 2, 0.5f);
+        int out_w = use_cvm ? w : w - attr.cvm_offset;
+        for (int h : test_sizes) {
+          attr.h = h;
+          auto ref = jit::GetReferFunc<KernelTuple>();
+          EXPECT_TRUE(ref != nullptr);
+          std::vector<T> x(h * w), yref(out_w);
+          // show/click are counters, keep them positive for the log
+          RandomVec<T>(h * w, x.data(), 0.f, 2.f);
+          ref(x.data(), yref.data(), &attr);
+          VLOG(10) << attr;
+          auto verifier = [](const typename KernelTuple::func_type tgt,
+                             const std::vector<T>& x,
+                             const std::vector<T>& yref,
+                             const typename KernelTuple::attr_type& attr) {
+            EXPECT_TRUE(tgt != nullptr);
+            std::vector<T> y(yref.size());
+            tgt(x.data(), y.data(), &attr);
+            ExpectEQ<T>(y.data(), yref.data(), yref.size());
+          };
+          TestAllImpls<KernelTuple, PlaceType>(attr, verifier, x, yref, attr);
+        }
+      }
+    }
+  }
+}
+
+std::vector<jit::fused_elementwise_attr_t> FusedElementwiseExpressions() {
+  std::vector<jit::fused_elementwise_attr_t> attrs(5);
+  // relu(x0 + x1)
+  auto* attr = &attrs[0];
+  attr->Unary(jit::kFuseRelu,
+              attr->Binary(jit::kFuseAdd, attr->Input(0), attr->Input(1)));
+  // gelu((x0 + x1) * x2)
+  attr = &attrs[1];
+  int sum = attr->Binary(jit::kFuseAdd, attr->Input(0), attr->Input(1));
+  attr->Unary(jit::kFuseGelu, attr->Binary(jit::kFuseMul, sum, attr->Input(2)));
+  // sigmoid(x0) * tanh(x1) - exp(min(x0, 1.5)) / max(x1 * x1, 0.5), the
+  // inputs are used twice
+  attr = &attrs[2];
+  int x0 = attr->Input(0), x1 = attr->Input(1);
+  int lhs = attr->Binary(jit::kFuseMul,
+                         attr->Unary(jit::kFuseSigmoid, x0),
+                         attr->Unary(jit::kFuseTanh, x1));
+  int num = attr->Unary(jit::kFuseExp,
+                        attr->Binary(jit::kFuseMin, x0, attr->Scalar(1.5f)));
+  int den = attr->Binary(jit::kFuseMax,
+                         attr->Binary(jit::kFuseMul, x1, x1),
+                         attr->Scalar(0.5f));
+  attr->Binary(jit::kFuseSub, lhs, attr->Binary(jit::kFuseDiv, num, den));
+  // square(x0 - 3), with a node that is never used
+  attr = &attrs[3];
+  x0 = attr->Input(0);
+  attr->Unary(jit::kFuseExp, x0);
+  attr->Unary(jit::kFuseSquare,
+              attr->Binary(jit::kFuseSub, x0, attr->Scalar(3.f)));
+  // x0 + x1 + ... + x11 with all the inputs loaded first, more live values
+  // than registers
+  attr = &attrs[4];
+  for (int i = 0; i < 12; ++i) {
+    attr->Input(i);
+  }
+  sum = 0;
+  for (int i = 1; i < 12; ++i) {
+    sum = attr->Binary(jit::kFuseAdd, sum, i);
+  }
+  return attrs;
+}
+
+template <typename KernelTuple, typename PlaceType>
+void TestKernelFusedElementwise() {
+  using T = typename KernelTuple::data_type;
+  VLOG(10) << "Test JITKernel: " << jit::to_string(KernelTuple::kernel_type);
+  for (const auto& attr : FusedElementwiseExpressions()) {
+    for (int n : TestSizes()) {
+      auto ref = jit::GetReferFunc<KernelTuple>();
+      EXPECT_TRUE(ref != nullptr);
+      std::vector<std::vector<T>> x(attr.num_inputs, std::vector<T>(n));
+      std::vector<const T*> inputs;
+      for (auto& xi : x) {
+        RandomVec<T>(n, xi.data());
+        inputs.push_back(xi.data());
+      }
+      std::vector<T> yref(n);
+      ref(inputs.data(), yref.data(), n, &attr);
+      VLOG(10) << attr;
+      auto verifier = [](const typename KernelTuple::func_type tgt,
+                         const std::vector<const T*>& inputs,
+                         const std::vector<T>& yref,
+                         const typename KernelTuple::attr_type& attr) {
+        EXPECT_TRUE(tgt != nullptr);
+        std::vector<T> y(yref.size());
+        tgt(inputs.data(), y.data(), static_cast<int64_t>(y.size()), &attr);
+        ExpectEQ<T>(y.data(), yref.data(), yref.size());
+      };
+      TestAllImpls<KernelTuple, PlaceType>(attr, verifier, inputs, yref, attr);
+    }
+  }
+  // the kernels are cached by the expression, scalars included
+  auto attrs = FusedElementwiseExpressions();
+  auto& cache = jit::KernelFuncs<KernelTuple, PlaceType>::Cache();
+  EXPECT_EQ(cache.At(attrs[2]), cache.At(FusedElementwiseExpressions()[2]));
+  EXPECT_NE(jit::JitCodeKey(attrs[2]), jit::JitCodeKey(attrs[3]));
+  auto other = attrs[3];
+  other.nodes[2].scalar = 2.f;
+  EXPECT_NE(jit::JitCodeKey(attrs[3]), jit::JitCodeKey(other));
+}
+
 template <typename KernelTuple, typename PlaceType>
 void TestKernelEmbSeqPool() {
   using T = typename KernelTuple::data_type;
@@ -1115,7 +1238,7 @@ TEST(JITKernel_pool, jitcreator) {
 #if defined(_WIN32) || defined(__APPLE__) || defined(__OSX__)
   EXPECT_EQ(jitcreators.size(), 0UL);
 #else
-  EXPECT_EQ(jitcreators.size(), 24UL);
+  EXPECT_EQ(jitcreators.size(), 25UL);
 #endif
 }
 
@@ -1137,7 +1260,7 @@ TEST(JITKernel_pool, more) {
   size_t target_num = 7;
 
 #ifdef __AVX__
-  target_num += 2;
+  target_num += 3;
 #endif
 
 #ifdef PADDLE_WITH_MKLML
@@ -1149,7 +1272,7 @@ TEST(JITKernel_pool, more) {
 
 TEST(JITKernel_pool, refer) {
   const auto& kers = jit::ReferKernelPool::Instance().AllKernels();
-  EXPECT_EQ(kers.size(), 27UL);
+  EXPECT_EQ(kers.size(), 29UL);
 }
 
 // test helper
@@ -1541,6 +1664,8 @@ TEST_CPU_KERNEL(LayerNorm);
 TEST_CPU_KERNEL(CRFDecoding);
 
 TEST_CPU_KERNEL(SeqPool);
+TEST_CPU_KERNEL(SeqPoolCVM);
+TEST_CPU_KERNEL(FusedElementwise);
 TEST_CPU_KERNEL(EmbSeqPool);
 TEST_CPU_KERNEL(MatMul);
 TEST_CPU_KERNEL(Adam);
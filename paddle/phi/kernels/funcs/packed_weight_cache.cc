@@ -0,0 +1,70 @@
+// Copyright (c) 2025 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/phi/kernels/funcs/packed_weight_cache.h"
+
+#include "glog/logging.h"
+
+namespace phi {
+namespace funcs {
+
+PackedWeightCache& PackedWeightCache::Instance() {
+  static PackedWeightCache cache;
+  return cache;
+}
+
+size_t PackedWeightCache::size() {
+  std::lock_guard<std::mutex> lock(mu_);
+  RemoveExpired();
+  return entries_.size();
+}
+
+void PackedWeightCache::RemoveExpired() {
+  for (auto it = entries_.begin(); it != entries_.end();) {
+    it = it->second.holder.expired() ? entries_.erase(it) : std::next(it);
+  }
+}
+
+std::shared_ptr<const void> PackedWeightCache::GetOrPack(
+    const DenseTensor& w,
+    const std::string& kind,
+    const std::function<std::shared_ptr<const void>()>& pack) {
+  const auto key = std::make_pair(w.data(), kind);
+  {
+    std::lock_guard<std::mutex> lock(mu_);
+    RemoveExpired();
+    auto it = entries_.find(key);
+    // the data pointer is only reused by the same weight if the allocation
+    // found is still the one of w
+    if (it != entries_.end() && it->second.holder.lock() == w.Holder() &&
+        it->second.dims == w.dims()) {
+      return it->second.packed;
+    }
+  }
+
+  // packed out of the lock, the threads running the first batch of
+  // different weights pack them in parallel
+  VLOG(3) << "Pack the " << kind << " form of a weight of shape " << w.dims();
+  std::shared_ptr<const void> packed = pack();
+  std::lock_guard<std::mutex> lock(mu_);
+  RemoveExpired();
+  auto& entry = entries_[key];
+  entry.holder = w.Holder();
+  entry.dims = w.dims();
+  entry.packed = packed;
+  return packed;
+}
+
+}  // namespace funcs
+}  // namespace phi
@@ -0,0 +1,73 @@
+// Copyright (c) 2025 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>  // NOLINT
+#include <string>
+#include <utility>
+
+#include "paddle/phi/core/dense_tensor.h"
+
+namespace phi {
+namespace funcs {
+
+// The packed forms of constant weights, such as the parameters of an
+// inference program, kept beside the allocation of each weight: a form is
+// packed at the first call for the allocation and dropped by the first call
+// of Get or size after the allocation is freed. The values of a weight must
+// not change after the first call.
+class PackedWeightCache {
+ public:
+  static PackedWeightCache& Instance();
+
+  // The form `kind` of w, made by pack if it is not cached.
+  template <typename T>
+  std::shared_ptr<const T> Get(
+      const DenseTensor& w,
+      const std::string& kind,
+      const std::function<std::unique_ptr<T>()>& pack) {
+    return std::static_pointer_cast<const T>(
+        GetOrPack(w, kind, [&pack]() -> std::shared_ptr<const void> {
+          return std::shared_ptr<const T>(pack());
+        }));
+  }
+
+  // The number of packed forms cached.
+  size_t size();
+
+ private:
+  struct Entry {
+    std::weak_ptr<phi::Allocation> holder;
+    DDim dims;
+    std::shared_ptr<const void> packed;
+  };
+
+  // Drops the forms of the freed allocations, requires mu_.
+  void RemoveExpired();
+
+  std::shared_ptr<const void> GetOrPack(
+      const DenseTensor& w,
+      const std::string& kind,
+      const std::function<std::shared_ptr<const void>()>& pack);
+
+  std::mutex mu_;
+  std::map<std::pair<const void*, std::string>, Entry> entries_;
+};
+
+}  // namespace funcs
+}  // namespace phi
@@ -0,0 +1,256 @@
+// Copyright (c) 2025 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#include "paddle/phi/common/data_type.h"
+#include "paddle/phi/core/allocator.h"
+#include "paddle/phi/core/dense_tensor.h"
+#include "paddle/phi/core/enforce.h"
+#include "paddle/phi/kernels/funcs/cpu_attention.h"
+
+namespace phi {
+namespace funcs {
+
+// Key and value cache of the generation on CPU, stored in blocks of
+// block_size tokens as the caches of block_multi_head_attention: two pools
+// of [num_blocks, kv_num_heads, block_size, head_size] and [..,
+// value_head_size] allocated once, and for each sequence the table of the
+// blocks holding its tokens in order.
+//
+// A decoding step appends the rows of the new token to the last block of
+// each sequence instead of concatenating the whole past of the sequence to
+// it. The sequences forked from a beam share the blocks of their common
+// prefix, counted by reference: a shared block is copied only when one of
+// them appends to it, and freed when the last of them is released.
+template <typename T>
+class PagedKVCache {
+ public:
+  PagedKVCache(Allocator* allocator,
+               int64_t num_blocks,
+               int64_t kv_num_heads,
+               int64_t block_size,
+               int64_t head_size,
+               int64_t value_head_size)
+      : kv_num_heads_(kv_num_heads),
+        block_size_(block_size),
+        head_size_(head_size),
+        value_head_size_(value_head_size),
+        key_cache_(allocator,
+                   DenseTensorMeta(CppTypeToDataType<T>::Type(),
+                                   common::make_ddim({num_blocks,
+                                                      kv_num_heads,
+                                                      block_size,
+                                                      head_size}))),
+        value_cache_(allocator,
+                     DenseTensorMeta(CppTypeToDataType<T>::Type(),
+                                     common::make_ddim({num_blocks,
+                                                        kv_num_heads,
+                                                        block_size,
+                                                        value_head_size}))),
+        block_refs_(num_blocks, 0) {
+    PADDLE_ENFORCE_GT(
+        num_blocks * block_size,
+        0,
+        common::errors::InvalidArgument(
+            "The number of blocks and the block size should be positive, but "
+            "received %d and %d.",
+            num_blocks,
+            block_size));
+    // the blocks of the smallest ids are taken first
+    free_blocks_.resize(num_blocks);
+    for (int64_t i = 0; i < num_blocks; ++i) {
+      free_blocks_[i] = static_cast<int>(num_blocks - 1 - i);
+    }
+  }
+
+  // A new empty sequence, returns its id.
+  int AddSequence() {
+    int seq;
+    if (free_sequences_.empty()) {
+      seq = static_cast<int>(sequences_.size());
+      sequences_.emplace_back();
+    } else {
+      seq = free_sequences_.back();
+      free_sequences_.pop_back();
+    }
+    sequences_[seq].alive = true;
+    return seq;
+  }
+
+  // A new sequence holding the tokens of `parent`, whose blocks it shares.
+  int ForkSequence(int parent) {
+    CheckSequence(parent);
+    int seq = AddSequence();
+    sequences_[seq].blocks = sequences_[parent].blocks;
+    sequences_[seq].length = sequences_[parent].length;
+    for (int block : sequences_[seq].blocks) {
+      ++block_refs_[block];
+    }
+    return seq;
+  }
+
+  // Releases the sequence and the blocks no other sequence shares.
+  void ReleaseSequence(int seq) {
+    CheckSequence(seq);
+    for (int block : sequences_[seq].blocks) {
+      if (--block_refs_[block] == 0) {
+        free_blocks_.push_back(block);
+      }
+    }
+    sequences_[seq] = Sequence();
+    free_sequences_.push_back(seq);
+  }
+
+  // Appends num_tokens tokens to the sequence. key and value are
+  // [kv_num_heads, token_stride, head_size] and [.., value_head_size], the
+  // layout of a sequence in a [batch, kv_num_heads, max_len, head_size]
+  // tensor; the first num_tokens tokens of each head are appended.
+  void Append(int seq,
+              const T* key,
+              const T* value,
+              int64_t num_tokens,
+              int64_t token_stride) {
+    CheckSequence(seq);
+    Sequence& s = sequences_[seq];
+    int64_t offset = s.length % block_size_;
+    if (offset != 0 && num_tokens > 0 && block_refs_[s.blocks.back()] > 1) {
+      // the partially filled block is shared, copy it before writing
+      int block = NewBlock();
+      CopyRows(s.blocks.back(), block, offset);
+      --block_refs_[s.blocks.back()];
+      s.blocks.back() = block;
+    }
+    for (int64_t t = 0; t < num_tokens;) {
+      offset = s.length % block_size_;
+      if (offset == 0) {
+        s.blocks.push_back(NewBlock());
+      }
+      const int64_t rows = std::min(block_size_ - offset, num_tokens - t);
+      const int64_t block = s.blocks.back();
+      for (int64_t h = 0; h < kv_num_heads_; ++h) {
+        const int64_t dst = (block * kv_num_heads_ + h) * block_size_ + offset;
+        const int64_t src = h * token_stride + t;
+        std::memcpy(key_cache_.data<T>() + dst * head_size_,
+                    key + src * head_size_,
+                    rows * head_size_ * sizeof(T));
+        std::memcpy(value_cache_.data<T>() + dst * value_head_size_,
+                    value + src * value_head_size_,
+                    rows * value_head_size_ * sizeof(T));
+      }
+      s.length += rows;
+      t += rows;
+    }
+  }
+
+  int64_t Length(int seq) const {
+    CheckSequence(seq);
+    return sequences_[seq].length;
+  }
+
+  int64_t NumFreeBlocks() const {
+    return static_cast<int64_t>(free_blocks_.size());
+  }
+
+  // The cache of the sequences `seqs`, in this order, for the attention
+  // kernels. The block tables are stored in `block_tables`, which must
+  // outlive the returned cache.
+  BlockKVCache<T> View(const std::vector<int>& seqs,
+                       std::vector<int>* block_tables) const {
+    int64_t max_blocks = 1;
+    for (int seq : seqs) {
+      CheckSequence(seq);
+      max_blocks = std::max<int64_t>(
+          max_blocks, static_cast<int64_t>(sequences_[seq].blocks.size()));
+    }
+    block_tables->assign(seqs.size() * max_blocks, -1);
+    for (size_t b = 0; b < seqs.size(); ++b) {
+      const auto& blocks = sequences_[seqs[b]].blocks;
+      std::copy(
+          blocks.begin(), blocks.end(), block_tables->begin() + b * max_blocks);
+    }
+    return BlockKVCache<T>{key_cache_.data<T>(),
+                           value_cache_.data<T>(),
+                           block_tables->data(),
+                           max_blocks,
+                           kv_num_heads_,
+                           block_size_,
+                           head_size_,
+                           value_head_size_};
+  }
+
+  const DenseTensor& key_cache() const { return key_cache_; }
+  const DenseTensor& value_cache() const { return value_cache_; }
+
+ private:
+  struct Sequence {
+    std::vector<int> blocks;
+    int64_t length = 0;
+    bool alive = false;
+  };
+
+  void CheckSequence(int seq) const {
+    PADDLE_ENFORCE_EQ(
+        seq >= 0 && seq < static_cast<int>(sequences_.size()) &&
+            sequences_[seq].alive,
+        true,
+        common::errors::InvalidArgument(
+            "The sequence %d is not in the paged KV cache.", seq));
+  }
+
+  int NewBlock() {
+    PADDLE_ENFORCE_EQ(
+        free_blocks_.empty(),
+        false,
+        common::errors::ResourceExhausted(
+            "All the %d blocks of the paged KV cache are in use.",
+            block_refs_.size()));
+    int block = free_blocks_.back();
+    free_blocks_.pop_back();
+    block_refs_[block] = 1;
+    return block;
+  }
+
+  // Copies the first `rows` tokens of block src to block dst.
+  void CopyRows(int64_t src, int64_t dst, int64_t rows) {
+    for (int64_t h = 0; h < kv_num_heads_; ++h) {
+      const int64_t from = (src * kv_num_heads_ + h) * block_size_;
+      const int64_t to = (dst * kv_num_heads_ + h) * block_size_;
+      std::memcpy(key_cache_.data<T>() + to * head_size_,
+                  key_cache_.data<T>() + from * head_size_,
+                  rows * head_size_ * sizeof(T));
+      std::memcpy(value_cache_.data<T>() + to * value_head_size_,
+                  value_cache_.data<T>() + from * value_head_size_,
+                  rows * value_head_size_ * sizeof(T));
+    }
+  }
+
+  int64_t kv_num_heads_;
+  int64_t block_size_;
+  int64_t head_size_;
+  int64_t value_head_size_;
+  DenseTensor key_cache_;
+  DenseTensor value_cache_;
+  std::vector<int> block_refs_;
+  std::vector<int> free_blocks_;
+  std::vector<Sequence> sequences_;
+  std::vector<int> free_sequences_;
+};
+
+}  // namespace funcs
+}  // namespace phi
@@ -21,6 +21,7 @@ limitations under the License. */
 #include "paddle/phi/common/place.h"
 #include "paddle/phi/core/dense_tensor.h"
 #include "paddle/phi/kernels/funcs/blas/blas.h"
+#include "paddle/phi/kernels/funcs/cpu_gather_scatter.h"
 #include "paddle/phi/kernels/funcs/eigen/common.h"
 
 namespace phi {
@@ -127,8 +128,6 @@ void ScatterAssign(const phi::CPUContext& ctx UNUSED,
     for (int i = 0; i < src_dims.size(); ++i) slice_size *= src_dims[i];
   }
 
-  const size_t slice_bytes = slice_size * sizeof(T);
-
   for (int64_t i = 0; i < index_size; ++i) {
     IndexT index_ = p_index[i];
     PADDLE_ENFORCE_GE(index_,
@@ -151,16 +150,21 @@ void ScatterAssign(const phi::CPUContext& ctx UNUSED,
             "be less than 1st-dim size (%d) of input, but received [%d]",
             dst_dims[0],
             index_));
-    if (index_ < 0) {
-      index_ += dst_dims[0];
-    }
-
-    memcpy(p_output + index_ * slice_size, p_src + i * slice_size, slice_bytes);
   }
+  // the last update of an index wins
+  ScatterRows(p_src,
+              1,
+              dst_dims[0],
+              p_index,
+              index_size,
+              static_cast<int64_t>(slice_size),
+              true,
+              false,
+              p_output);
 }
 
 template <typename T, typename IndexT = int>
-void ScatterAssignAdd(const phi::CPUContext& ctx,
+void ScatterAssignAdd(const phi::CPUContext& ctx UNUSED,
                       const DenseTensor& src,
                       const DenseTensor& index,
                       DenseTensor* output) {
@@ -207,9 +211,6 @@ void ScatterAssignAdd(const phi::CPUContext& ctx,
     for (int i = 0; i < src_dims.size(); ++i) slice_size *= src_dims[i];
   }
 
-  const size_t& slice_bytes = slice_size * sizeof(T);
-
-  // if not in overwrite mode, need to init output data
   auto max_index = dst_dims[0];
   for (int64_t i = 0; i < index_size; ++i) {
     PADDLE_ENFORCE_GE(p_index[i],
@@ -230,18 +231,19 @@ void ScatterAssignAdd(const phi::CPUContext& ctx,
                           "be less than [%d], but received [%d]",
                           max_index,
                           p_index[i]));
-    const IndexT& index_val =
-        (p_index[i] < 0 ? p_index[i] + max_index : p_index[i]);
-    memset(p_output + slice_size * index_val, 0, slice_bytes);
   }
 
-  // if not in overwrite mode, need to init output data
-  for (int64_t i = 0; i < index_size; ++i) {
-    const IndexT& index_val =
-        (p_index[i] < 0 ? p_index[i] + max_index : p_index[i]);
-    elementwise_inner_add<T, IndexT>(
-        ctx, p_src, p_output, i, index_val, slice_size);
-  }
+  // if not in overwrite mode, the scattered rows are the sums of their
+  // updates
+  ScatterRows(p_src,
+              1,
+              max_index,
+              p_index,
+              index_size,
+              static_cast<int64_t>(slice_size),
+              false,
+              true,
+              p_output);
 }
 
 // The function is only for scatter grad x,
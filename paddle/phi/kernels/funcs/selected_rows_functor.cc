@@ -15,6 +15,7 @@ limitations under the License. */
 #include "paddle/phi/kernels/funcs/selected_rows_functor.h"
 
 #include <algorithm>
+#include <functional>
 #include <map>
 #include <set>
 #include <vector>
@@ -540,6 +541,14 @@ struct MergeAddImpl {
     auto input_width = has_value_input->value().dims()[1];
     auto input_height = has_value_input->height();
     phi::SelectedRows& out = *output;
+    // a single input with strictly increasing rows, as the sparse gradient
+    // of embedding, is merged and sorted already
+    const bool merged =
+        inputs.size() == 1 &&
+        std::adjacent_find(has_value_input->rows().begin(),
+                           has_value_input->rows().end(),
+                           std::greater_equal<int64_t>()) ==
+            has_value_input->rows().end();
     std::set<int64_t> merged_row_set;
     size_t row_num = 0;
     for (auto* input : inputs) {
@@ -556,16 +565,19 @@ struct MergeAddImpl {
                         common::errors::InvalidArgument(
                             "All inputs should have same height."));
       row_num += input->rows().size();
-      merged_row_set.insert(input->rows().begin(), input->rows().end());
+      if (!merged) {
+        merged_row_set.insert(input->rows().begin(), input->rows().end());
+      }
     }
+    const size_t merged_row_num = merged ? row_num : merged_row_set.size();
 
     out.set_height(input_height);
     DenseTensor* out_tensor = out.mutable_value();
     out_tensor->Resize(common::make_ddim(
-        {static_cast<int64_t>(merged_row_set.size()), input_width}));
+        {static_cast<int64_t>(merged_row_num), input_width}));
     auto* out_data = context.template Alloc<T>(out_tensor);
 
-    if (merged_row_set.size() == row_num && !sorted_result) {
+    if (merged || (merged_row_set.size() == row_num && !sorted_result)) {
       // no duplicated ids, just concat the result together
       std::vector<int64_t> merge_rows;
       merge_rows.reserve(row_num);
@@ -0,0 +1,109 @@
+// Copyright (c) 2025 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/phi/kernels/funcs/weight_only_gemm.h"
+
+#include <algorithm>
+
+#include "glog/logging.h"
+#include "paddle/phi/backends/cpu/cpu_info.h"
+
+namespace phi {
+namespace funcs {
+
+namespace {
+
+inline float WeightAt(const WeightOnlyGemmParam& param,
+                      int64_t channel,
+                      int64_t idx) {
+  if (param.bits == 8) {
+    return param.weight[channel * param.k + idx];
+  }
+  int8_t packed = param.weight[channel / 2 * param.k + idx];
+  // arithmetic shifts sign extend the nibble
+  return channel % 2 == 0 ? static_cast<int8_t>(packed << 4) >> 4
+                          : packed >> 4;
+}
+
+void WeightOnlyGemmTileRef(const WeightOnlyGemmParam& param,
+                           int64_t m_begin,
+                           int64_t m_end,
+                           int64_t n_begin,
+                           int64_t n_end) {
+  const int64_t k = param.k;
+  const int64_t group_size = param.group_size;
+  for (int64_t n = n_begin; n < n_end; ++n) {
+    for (int64_t m = m_begin; m < m_end; ++m) {
+      const float* x = param.x + m * k;
+      float sum = 0.f;
+      for (int64_t group = 0; group * group_size < k; ++group) {
+        float partial = 0.f;
+        const int64_t end = std::min((group + 1) * group_size, k);
+        for (int64_t i = group * group_size; i < end; ++i) {
+          partial += x[i] * WeightAt(param, n, i);
+        }
+        sum += partial * param.scale[group * param.n + n];
+      }
+      param.out[m * param.n + n] =
+          param.bias != nullptr ? sum + param.bias[n] : sum;
+    }
+  }
+}
+
+using GemmTileFunc = void (*)(const WeightOnlyGemmParam&,
+                              int64_t,
+                              int64_t,
+                              int64_t,
+                              int64_t);
+
+GemmTileFunc SelectGemmTile() {
+  namespace cpu = phi::backends::cpu;
+  if (detail::WeightOnlyGemmAVX512Compiled() && cpu::MayIUse(cpu::avx512f)) {
+    VLOG(3) << "weight only gemm uses the avx512 microkernel";
+    return detail::WeightOnlyGemmTileAVX512;
+  }
+  if (detail::WeightOnlyGemmAVX2Compiled() && cpu::MayIUse(cpu::avx2)) {
+    VLOG(3) << "weight only gemm uses the avx2 microkernel";
+    return detail::WeightOnlyGemmTileAVX2;
+  }
+  return WeightOnlyGemmTileRef;
+}
+
+}  // namespace
+
+void WeightOnlyGemmTile(const WeightOnlyGemmParam& param,
+                        int64_t m_begin,
+                        int64_t m_end,
+                        int64_t n_begin,
+                        int64_t n_end) {
+  static const GemmTileFunc gemm_tile = SelectGemmTile();
+  gemm_tile(param, m_begin, m_end, n_begin, n_end);
+}
+
+void WeightOnlyDequantize(const WeightOnlyGemmParam& param,
+                          int64_t n_begin,
+                          int64_t n_end,
+                          float* out) {
+  const int64_t k = param.k;
+  for (int64_t n = n_begin; n < n_end; ++n) {
+    float* row = out + (n - n_begin) * k;
+    for (int64_t i = 0; i < k; ++i) {
+      row[i] = WeightAt(param, n, i) *
+               param.scale[i / param.group_size * param.n + n];
+    }
+  }
+}
+
+}  // namespace funcs
+}  // namespace phi
@@ -0,0 +1,86 @@
+// Copyright (c) 2025 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+
+namespace phi {
+namespace funcs {
+
+// The arch of weight_quantize and weight_only_linear selecting the CPU
+// layout of the quantized weight: for a [k, n] weight,
+//  - int8: [n, k], row j holds output channel j,
+//  - int4: [n / 2, k], the low and high nibbles of row j hold the signed
+//    values of output channels 2 * j and 2 * j + 1.
+// The scales are [n] per channel, or [ceil(k / group_size), n] group-wise,
+// the last group being short if k is not a multiple of group_size.
+constexpr int32_t kWeightOnlyCPUArch = 0;
+
+struct WeightOnlyGemmParam {
+  const float* x;       // [m, k]
+  const int8_t* weight;  // CPU layout, see kWeightOnlyCPUArch
+  const float* scale;   // [ceil(k / group_size), n]
+  const float* bias;    // [n] or nullptr
+  float* out;           // [m, n]
+  int64_t m;
+  int64_t n;
+  int64_t k;
+  int bits;
+  // k for per channel scales
+  int64_t group_size;
+};
+
+// Number of output channels computed together by the microkernels, a
+// multiple of the channels per int4 byte.
+constexpr int64_t kWeightOnlyChannelBlock = 4;
+
+// Computes out[m_begin:m_end, n_begin:n_end]. The int8 or int4 weights are
+// converted to float in registers inside the dot products and the scale of
+// each group is applied to its partial sums, so the weights are read from
+// memory once per row block in their quantized form. n_begin and n_end are
+// multiples of kWeightOnlyChannelBlock, k a multiple of 16.
+void WeightOnlyGemmTile(const WeightOnlyGemmParam& param,
+                        int64_t m_begin,
+                        int64_t m_end,
+                        int64_t n_begin,
+                        int64_t n_end);
+
+// Writes the float weights of channels [n_begin, n_end) to
+// out[n_end - n_begin, k], for callers running a float GEMM on many rows.
+void WeightOnlyDequantize(const WeightOnlyGemmParam& param,
+                          int64_t n_begin,
+                          int64_t n_end,
+                          float* out);
+
+namespace detail {
+// Microkernels of weight_only_gemm_avx2.cc and weight_only_gemm_avx512.cc.
+// The *Compiled functions tell whether the file was built with the
+// instruction set, the tiles must not be called otherwise.
+bool WeightOnlyGemmAVX2Compiled();
+void WeightOnlyGemmTileAVX2(const WeightOnlyGemmParam& param,
+                            int64_t m_begin,
+                            int64_t m_end,
+                            int64_t n_begin,
+                            int64_t n_end);
+bool WeightOnlyGemmAVX512Compiled();
+void WeightOnlyGemmTileAVX512(const WeightOnlyGemmParam& param,
+                              int64_t m_begin,
+                              int64_t m_end,
+                              int64_t n_begin,
+                              int64_t n_end);
+}  // namespace detail
+
+}  // namespace funcs
+}  // namespace phi
@@ -0,0 +1,159 @@
+// Copyright (c) 2025 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/phi/kernels/funcs/weight_only_gemm.h"
+
+#include <algorithm>
+
+#ifdef __AVX512F__
+#include <immintrin.h>
+#endif
+
+#include "paddle/phi/core/enforce.h"
+
+namespace phi {
+namespace funcs {
+namespace detail {
+
+#ifdef __AVX512F__
+
+namespace {
+
+constexpr int kBlock = 16;
+
+inline __m512 LoadInt8(const int8_t* ptr) {
+  __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr));
+  return _mm512_cvtepi32_ps(_mm512_cvtepi8_epi32(bytes));
+}
+
+// The channels of the low and the high nibbles of 16 packed int4 bytes.
+inline void LoadInt4(const int8_t* ptr, __m512* low, __m512* high) {
+  __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr));
+  __m512i v = _mm512_cvtepi8_epi32(bytes);
+  *low = _mm512_cvtepi32_ps(_mm512_srai_epi32(_mm512_slli_epi32(v, 28), 28));
+  *high = _mm512_cvtepi32_ps(_mm512_srai_epi32(_mm512_slli_epi32(v, 24), 28));
+}
+
+// out[m:m + kRows, n:n + 4]. The weights of a group are dequantized in
+// registers, once for all the rows.
+template <int kRows, int kBits>
+void GemmBlock(const WeightOnlyGemmParam& param, int64_t m, int64_t n) {
+  constexpr int kCols = kWeightOnlyChannelBlock;
+  const int64_t k = param.k;
+  const float* x[kRows];
+  for (int r = 0; r < kRows; ++r) {
+    x[r] = param.x + (m + r) * k;
+  }
+  const int8_t* w[kCols];
+  for (int c = 0; c < kCols; ++c) {
+    w[c] = kBits == 8 ? param.weight + (n + c) * k
+                      : param.weight + (n + c) / 2 * k;
+  }
+
+  __m512 acc[kRows][kCols];
+  for (int r = 0; r < kRows; ++r) {
+    for (int c = 0; c < kCols; ++c) {
+      acc[r][c] = _mm512_setzero_ps();
+    }
+  }
+  for (int64_t begin = 0; begin < k; begin += param.group_size) {
+    const float* scale = param.scale + begin / param.group_size * param.n + n;
+    __m512 s[kCols];
+    for (int c = 0; c < kCols; ++c) {
+      s[c] = _mm512_set1_ps(scale[c]);
+    }
+    // the last group is short if k is not a multiple of group_size
+    const int64_t end = std::min(begin + param.group_size, k);
+    for (int64_t i = begin; i < end; i += kBlock) {
+      __m512 wv[kCols];
+      if (kBits == 8) {
+        for (int c = 0; c < kCols; ++c) {
+          wv[c] = LoadInt8(w[c] + i);
+        }
+      } else {
+        for (int c = 0; c < kCols; c += 2) {
+          LoadInt4(w[c] + i, &wv[c], &wv[c + 1]);
+        }
+      }
+      for (int c = 0; c < kCols; ++c) {
+        wv[c] = _mm512_mul_ps(wv[c], s[c]);
+      }
+      for (int r = 0; r < kRows; ++r) {
+        __m512 xv = _mm512_loadu_ps(x[r] + i);
+        for (int c = 0; c < kCols; ++c) {
+          acc[r][c] = _mm512_fmadd_ps(xv, wv[c], acc[r][c]);
+        }
+      }
+    }
+  }
+  for (int r = 0; r < kRows; ++r) {
+    float* out = param.out + (m + r) * param.n + n;
+    for (int c = 0; c < kCols; ++c) {
+      out[c] = _mm512_reduce_add_ps(acc[r][c]) +
+               (param.bias != nullptr ? param.bias[n + c] : 0.f);
+    }
+  }
+}
+
+template <int kBits>
+void GemmTile(const WeightOnlyGemmParam& param,
+              int64_t m_begin,
+              int64_t m_end,
+              int64_t n_begin,
+              int64_t n_end) {
+  for (int64_t n = n_begin; n < n_end; n += kWeightOnlyChannelBlock) {
+    int64_t m = m_begin;
+    for (; m + 4 <= m_end; m += 4) {
+      GemmBlock<4, kBits>(param, m, n);
+    }
+    for (; m < m_end; ++m) {
+      GemmBlock<1, kBits>(param, m, n);
+    }
+  }
+}
+
+}  // namespace
+
+bool WeightOnlyGemmAVX512Compiled() { return true; }
+
+void WeightOnlyGemmTileAVX512(const WeightOnlyGemmParam& param,
+                              int64_t m_begin,
+                              int64_t m_end,
+                              int64_t n_begin,
+                              int64_t n_end) {
+  if (param.bits == 8) {
+    GemmTile<8>(param, m_begin, m_end, n_begin, n_end);
+  } else {
+    GemmTile<4>(param, m_begin, m_end, n_begin, n_end);
+  }
+}
+
+#else
+
+bool WeightOnlyGemmAVX512Compiled() { return false; }
+
+void WeightOnlyGemmTileAVX512(const WeightOnlyGemmParam& param,
+                              int64_t m_begin,
+                              int64_t m_end,
+                              int64_t n_begin,
+                              int64_t n_end) {
+  PADDLE_THROW(common::errors::Unavailable(
+      "The weight only gemm is not built with AVX512F."));
+}
+
+#endif
+
+}  // namespace detail
+}  // namespace funcs
+}  // namespace phi
@@ -12,8 +12,151 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "paddle/common/flags.h"
+#include "paddle/phi/backends/cpu/cpu_context.h"
 #include "paddle/phi/core/dense_tensor.h"
 #include "paddle/phi/core/kernel_registry.h"
+#include "paddle/phi/kernels/funcs/amx_gemm.h"
+#include "paddle/phi/kernels/funcs/fc_functor.h"
 #include "paddle/phi/kernels/impl/fc_kernel_impl.h"
 
-PD_REGISTER_KERNEL(fc, CPU, ALL_LAYOUT, phi::fusion::FCKernel, float, double) {}
+COMMON_DECLARE_string(fc_amx_gemm_type);
+COMMON_DECLARE_bool(fc_pack_weights);
+
+namespace phi {
+namespace fusion {
+
+namespace {
+
+// Runs the fc with the AMX GEMM of FLAGS_fc_amx_gemm_type on the weight
+// packed once, returns false if it is disabled or the CPU has no AMX.
+bool FCWithAmx(const CPUContext& dev_ctx,
+               const DenseTensor& input,
+               const DenseTensor& w,
+               const paddle::optional<DenseTensor>& bias,
+               const int in_num_col_dims,
+               const std::string& activation_type,
+               const bool padding_weights,
+               DenseTensor* out) {
+  const std::string& gemm_type = FLAGS_fc_amx_gemm_type;
+  if (gemm_type.empty() || padding_weights) {
+    return false;
+  }
+  PADDLE_ENFORCE_EQ(
+      gemm_type == "bf16" || gemm_type == "int8",
+      true,
+      common::errors::InvalidArgument(
+          "FLAGS_fc_amx_gemm_type must be empty, bf16 or int8, but got %s.",
+          gemm_type));
+  auto type = gemm_type == "bf16" ? funcs::AmxGemmType::kBF16
+                                  : funcs::AmxGemmType::kInt8;
+  if (!funcs::AmxGemmAvailable(type)) {
+    VLOG(3) << "The CPU has no AMX for " << gemm_type
+            << ", fc falls back to BLAS.";
+    return false;
+  }
+
+  std::vector<int64_t> output_dims;
+  funcs::FCOutputSize(
+      input.dims(), w.dims(), output_dims, in_num_col_dims, padding_weights);
+  out->Resize(common::make_ddim(output_dims));
+  out->set_lod(input.lod());
+  auto packed = funcs::GetAmxPackedWeight(w, type);
+
+  funcs::AmxGemmParam param;
+  param.x = input.data<float>();
+  param.weight = packed.get();
+  param.bias = bias ? bias->data<float>() : nullptr;
+  param.act = activation_type == "relu" ? funcs::AmxActivation::kRelu
+                                        : funcs::AmxActivation::kNone;
+  param.out = dev_ctx.template Alloc<float>(out);
+  param.m = out->numel() / packed->n;
+  funcs::AmxGemm(param);
+  return true;
+}
+
+// Runs the fc with the GEMM of MKL on the weight packed once, returns false
+// if FLAGS_fc_pack_weights is disabled or the build has no MKL.
+template <typename T>
+bool FCWithPackedWeight(const CPUContext& dev_ctx,
+                        const DenseTensor& input,
+                        const DenseTensor& w,
+                        const paddle::optional<DenseTensor>& bias,
+                        const int in_num_col_dims,
+                        const std::string& activation_type,
+                        const bool padding_weights,
+                        DenseTensor* out) {
+#ifdef PADDLE_WITH_MKLML
+  if (!FLAGS_fc_pack_weights) {
+    return false;
+  }
+  std::vector<int64_t> output_dims;
+  funcs::FCOutputSize(
+      input.dims(), w.dims(), output_dims, in_num_col_dims, padding_weights);
+  out->Resize(common::make_ddim(output_dims));
+  out->set_lod(input.lod());
+  auto packed = funcs::GetFCPackedWeight<T>(dev_ctx, w, padding_weights);
+  funcs::FCPacked<T>(dev_ctx,
+                     out->numel() / packed->N(),
+                     input.data<T>(),
+                     *packed,
+                     dev_ctx.template Alloc<T>(out),
+                     bias ? bias->data<T>() : nullptr,
+                     activation_type == "relu");
+  return true;
+#else
+  return false;
+#endif
+}
+
+}  // namespace
+
+template <typename T, typename Context>
+void FCCPUKernel(const Context& dev_ctx,
+                 const DenseTensor& input,
+                 const DenseTensor& w,
+                 const paddle::optional<DenseTensor>& bias,
+                 const int in_num_col_dims,
+                 const std::string& activation_type,
+                 const bool padding_weights,
+                 DenseTensor* out) {
+  if (std::is_same<T, float>::value &&
+      FCWithAmx(dev_ctx,
+                input,
+                w,
+                bias,
+                in_num_col_dims,
+                activation_type,
+                padding_weights,
+                out)) {
+    return;
+  }
+  if (FCWithPackedWeight<T>(dev_ctx,
+                            input,
+                            w,
+                            bias,
+                            in_num_col_dims,
+                            activation_type,
+                            padding_weights,
+                            out)) {
+    return;
+  }
+  FCKernel<T, Context>(dev_ctx,
+                       input,
+                       w,
+                       bias,
+                       in_num_col_dims,
+                       activation_type,
+                       padding_weights,
+                       out);
+}
+
+}  // namespace fusion
+}  // namespace phi
+
+PD_REGISTER_KERNEL(
+    fc, CPU, ALL_LAYOUT, phi::fusion::FCCPUKernel, float, double) {}
@@ -12,6 +12,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <cstring>
 #include <memory>
 #include <vector>
 
@@ -32,9 +33,62 @@ void FusedSeqpoolCVMGradOpCPUKernel(
     int cvm_offset,
     std::vector<DenseTensor *> x_grad,
     DenseTensor *cvm_grad) {
-  PADDLE_THROW(common::errors::Unimplemented(
-      "Unimplemented CPU kernel for FusedSeqpoolCVMGradOp, only support GPU "
-      "now."));
+  const size_t slot_size = x_grad.size();
+  int embedding_size = static_cast<int>(x[0]->numel() / x[0]->dims()[0]);
+  int out_width = use_cvm ? embedding_size : embedding_size - cvm_offset;
+  int batch_size = -1;
+  std::vector<const T *> out_grads_data(slot_size);
+  std::vector<T *> in_grads_data(slot_size);
+  std::vector<std::vector<size_t>> lods(slot_size);
+  for (size_t i = 0; i < slot_size; ++i) {
+    const auto *input = x[i];
+    if (!input->lod().empty()) {
+      lods[i] = input->lod()[0];
+    } else {
+      lods[i].resize(input->dims()[0] + 1);
+      for (size_t j = 0; j < lods[i].size(); ++j) {
+        lods[i][j] = j;
+      }
+    }
+    int cur_batch_size = static_cast<int>(lods[i].size() - 1);
+    if (batch_size == -1) {
+      batch_size = cur_batch_size;
+    } else {
+      PADDLE_ENFORCE_EQ(batch_size,
+                        cur_batch_size,
+                        common::errors::PreconditionNotMet(
+                            "The batch size of all input should be same, "
+                            "please check, last batch_size is %d, current "
+                            "batch_size is %d",
+                            batch_size,
+                            cur_batch_size));
+    }
+    out_grads_data[i] = out_grad[i]->data<T>();
+    x_grad[i]->Resize(input->dims());
+    in_grads_data[i] = dev_ctx.template Alloc<T>(x_grad[i]);
+  }
+  const T *cvm_data = cvm.data<T>();
+
+  // show/click columns take their gradient from cvm, the rest from out_grad;
+  // each (slot, instance) pair broadcasts one row over its sequence.
+  int64_t total = static_cast<int64_t>(slot_size) * batch_size;
+#ifdef PADDLE_WITH_MKLML
+#pragma omp parallel for
+#endif
+  for (int64_t k = 0; k < total; ++k) {
+    size_t i = k / batch_size;
+    size_t j = k % batch_size;
+    const T *cvm_row = cvm_data + j * cvm_offset;
+    const T *grad_row =
+        out_grads_data[i] + j * out_width + (use_cvm ? cvm_offset : 0);
+    for (size_t r = lods[i][j]; r < lods[i][j + 1]; ++r) {
+      T *dst = in_grads_data[i] + r * embedding_size;
+      std::memcpy(dst, cvm_row, sizeof(T) * cvm_offset);
+      std::memcpy(dst + cvm_offset,
+                  grad_row,
+                  sizeof(T) * (embedding_size - cvm_offset));
+    }
+  }
 }
 
 }  // namespace phi
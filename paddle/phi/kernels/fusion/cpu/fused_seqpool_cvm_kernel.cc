@@ -13,10 +13,12 @@
 // limitations under the License.
 
 #include <memory>
+#include <string>
 #include <vector>
 
 #include "paddle/phi/core/kernel_registry.h"
 #include "paddle/phi/core/tensor_utils.h"
+#include "paddle/phi/kernels/funcs/jit/kernels.h"
 
 namespace phi {
 
@@ -29,9 +31,68 @@ void FusedSeqpoolCVMOpCPUKernel(const Context &dev_ctx,
                                 bool use_cvm,
                                 int cvm_offset,
                                 std::vector<DenseTensor *> out) {
-  PADDLE_THROW(common::errors::Unimplemented(
-      "Unimplemented CPU kernel for FusedSeqpoolCVMOp, only support GPU "
-      "now."));
+  const size_t slot_size = x.size();
+  int embedding_size = static_cast<int>(x[0]->numel() / x[0]->dims()[0]);
+  int batch_size = -1;
+  std::vector<const T *> input_data(slot_size);
+  std::vector<T *> output_data(slot_size);
+  std::vector<std::vector<size_t>> lods(slot_size);
+  for (size_t i = 0; i < slot_size; ++i) {
+    const auto *input = x[i];
+    if (!input->lod().empty()) {
+      lods[i] = input->lod()[0];
+    } else {
+      lods[i].resize(input->dims()[0] + 1);
+      for (size_t j = 0; j < lods[i].size(); ++j) {
+        lods[i][j] = j;
+      }
+    }
+    int cur_batch_size = static_cast<int>(lods[i].size() - 1);
+    if (batch_size == -1) {
+      batch_size = cur_batch_size;
+    } else {
+      PADDLE_ENFORCE_EQ(batch_size,
+                        cur_batch_size,
+                        common::errors::PreconditionNotMet(
+                            "The batch size of all input should be same, "
+                            "please check, last batch_size is %d, current "
+                            "batch_size is %d",
+                            batch_size,
+                            cur_batch_size));
+    }
+    PADDLE_ENFORCE_EQ(static_cast<int>(input->numel() / input->dims()[0]),
+                      embedding_size,
+                      common::errors::InvalidArgument(
+                          "Width of all inputs should be equal."));
+    input_data[i] = input->data<T>();
+    out[i]->Resize({batch_size,
+                    use_cvm ? embedding_size : embedding_size - cvm_offset});
+    output_data[i] = dev_ctx.template Alloc<T>(out[i]);
+  }
+
+  // like the GPU kernel, only sum pooling is supported
+  phi::jit::seq_pool_cvm_attr_t attr(embedding_size,
+                                     phi::jit::SeqPoolType::kSum,
+                                     use_cvm,
+                                     cvm_offset,
+                                     pad_value);
+  auto seqpool_cvm =
+      phi::jit::KernelFuncs<phi::jit::SeqPoolCVMTuple<T>,
+                            phi::CPUPlace>::Cache()
+          .At(attr);
+  int out_width = use_cvm ? embedding_size : embedding_size - cvm_offset;
+  int64_t total = static_cast<int64_t>(slot_size) * batch_size;
+#ifdef PADDLE_WITH_MKLML
+#pragma omp parallel for firstprivate(attr)
+#endif
+  for (int64_t k = 0; k < total; ++k) {
+    size_t i = k / batch_size;
+    size_t j = k % batch_size;
+    attr.h = static_cast<int>(lods[i][j + 1] - lods[i][j]);
+    seqpool_cvm(input_data[i] + lods[i][j] * embedding_size,
+                output_data[i] + j * out_width,
+                &attr);
+  }
 }
 
 }  // namespace phi
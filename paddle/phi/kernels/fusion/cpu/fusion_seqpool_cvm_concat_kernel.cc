@@ -49,41 +49,49 @@ void FusionSeqPoolCVMConcatKernel(const Context& dev_ctx,
                     0,
                     common::errors::InvalidArgument(
                         "The output of dims[1] should be dividable of w"));
-  phi::jit::seq_pool_attr_t attr(w, phi::jit::SeqPoolType::kSum);
+  phi::jit::SeqPoolType type = phi::jit::SeqPoolType::kSum;
   if (pooltype == "AVERAGE") {
-    attr.type = phi::jit::SeqPoolType::kAvg;
+    type = phi::jit::SeqPoolType::kAvg;
   } else if (pooltype == "SQRT") {
-    attr.type = phi::jit::SeqPoolType::kSqrt;
+    type = phi::jit::SeqPoolType::kSqrt;
   }
-  auto seqpool =
-      phi::jit::KernelFuncs<phi::jit::SeqPoolTuple<T>, phi::CPUPlace>::Cache()
+  // Currently only use_cvm is true.
+  phi::jit::seq_pool_cvm_attr_t attr(w, type, true);
+  auto seqpool_cvm =
+      phi::jit::KernelFuncs<phi::jit::SeqPoolCVMTuple<T>,
+                            phi::CPUPlace>::Cache()
           .At(attr);
   size_t n = ins.size();
   size_t dst_step_size = n * w;
+  std::vector<const T*> srcs(n);
+  std::vector<const size_t*> lods(n);
   for (size_t i = 0; i < n; ++i) {
     const auto& x_dims = ins[i]->dims();
-    auto x_lod = ins[i]->lod()[0];
-    const T* src = ins[i]->data<T>();
-    T* dst = y_data + i * w;
     PADDLE_ENFORCE_EQ(static_cast<int>(ins[i]->numel() / x_dims[0]),
                       w,
                       common::errors::InvalidArgument(
                           "Width of all inputs should be equal."));
-    PADDLE_ENFORCE_EQ(x_lod.size(),
+    PADDLE_ENFORCE_EQ(ins[i]->lod()[0].size(),
                       bs + 1,
                       common::errors::InvalidArgument(
                           "Batchsize of all inputs should be equal."));
-    for (size_t j = 0; j < bs; ++j) {
-      attr.h = static_cast<int>(x_lod[j + 1] - x_lod[j]);
-      seqpool(src, dst, &attr);
-
-      // Currently only use_cvm is true.
-      dst[0] = log(dst[0] + 1);
-      dst[1] = log(dst[1] + 1) - dst[0];
-
-      dst += dst_step_size;
-      src += attr.h * attr.w;
-    }
+    srcs[i] = ins[i]->template data<T>();
+    lods[i] = ins[i]->lod()[0].data();
+  }
+  // Every (instance, slot) pair pools, transforms and writes its own w
+  // columns of the concatenated output in one pass, so the pairs are
+  // partitioned across threads without any synchronization.
+  int64_t total = static_cast<int64_t>(bs * n);
+#ifdef PADDLE_WITH_MKLML
+#pragma omp parallel for firstprivate(attr)
+#endif
+  for (int64_t k = 0; k < total; ++k) {
+    size_t j = k / n;
+    size_t i = k % n;
+    attr.h = static_cast<int>(lods[i][j + 1] - lods[i][j]);
+    seqpool_cvm(srcs[i] + lods[i][j] * w,
+                y_data + j * dst_step_size + i * w,
+                &attr);
   }
 }
 }  // namespace fusion
@@ -0,0 +1,126 @@
+// Copyright (c) 2025 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+
+#include "paddle/phi/backends/cpu/cpu_context.h"
+#include "paddle/phi/core/kernel_registry.h"
+#include "paddle/phi/kernels/funcs/cpu_attention.h"
+
+namespace phi {
+namespace fusion {
+
+template <typename T, typename Context>
+void MultiHeadAttentionVariableForwardKernel(
+    const Context& ctx,
+    const DenseTensor& query,
+    const DenseTensor& key,
+    const DenseTensor& value,
+    const DenseTensor& seq_lens,
+    const DenseTensor& kv_seq_lens,
+    const paddle::optional<DenseTensor>& mask,
+    const float scale,
+    const bool causal,
+    const int pre_cache_length,
+    DenseTensor* output) {
+  // [B, N, S, H]
+  funcs::AttentionParams params;
+  params.batch_size = query.dims()[0];
+  params.num_heads = query.dims()[1];
+  params.kv_num_heads = key.dims()[1];
+  params.max_query_len = query.dims()[2];
+  params.head_size = query.dims()[3];
+  params.value_head_size = value.dims()[3];
+  params.seq_lens = seq_lens.data<int>();
+  params.kv_seq_lens = kv_seq_lens.data<int>();
+  params.pre_cache_length = pre_cache_length;
+  params.scale = scale;
+  params.causal = causal;
+  const int64_t max_kv_len = key.dims()[2];
+
+  PADDLE_ENFORCE_EQ(
+      seq_lens.numel() == params.batch_size &&
+          kv_seq_lens.numel() == params.batch_size,
+      true,
+      common::errors::InvalidArgument(
+          "The seq_lens and kv_seq_lens should have batch size %d elements, "
+          "but received %d and %d.",
+          params.batch_size,
+          seq_lens.numel(),
+          kv_seq_lens.numel()));
+  int64_t max_seq_len = 0;
+  int64_t max_kv_seq_len = 0;
+  for (int64_t b = 0; b < params.batch_size; ++b) {
+    const int q_len = params.seq_lens[b];
+    const int kv_len = params.kv_seq_lens[b] + pre_cache_length;
+    PADDLE_ENFORCE_EQ(
+        q_len >= 0 && q_len <= params.max_query_len && kv_len >= 0 &&
+            kv_len <= max_kv_len,
+        true,
+        common::errors::InvalidArgument(
+            "The lengths of sequence %d should be in [0, %d] for the queries "
+            "and in [0, %d] for the keys including the pre cache, but "
+            "received %d and %d.",
+            b,
+            params.max_query_len,
+            max_kv_len,
+            q_len,
+            kv_len));
+    if (q_len > 0) {
+      max_seq_len = std::max<int64_t>(max_seq_len, q_len);
+      max_kv_seq_len = std::max<int64_t>(max_kv_seq_len, kv_len);
+    }
+  }
+
+  const T* mask_data = nullptr;
+  if (mask) {
+    // [B, 1 or N, S, D]
+    const auto& mask_dims = mask->dims();
+    PADDLE_ENFORCE_EQ(
+        mask_dims.size() == 4 && mask_dims[0] == params.batch_size &&
+            (mask_dims[1] == 1 || mask_dims[1] == params.num_heads) &&
+            mask_dims[2] >= max_seq_len && mask_dims[3] >= max_kv_seq_len,
+        true,
+        common::errors::InvalidArgument(
+            "The mask should be [batch size, 1 or num heads, query length, "
+            "key length] and cover the sequences, but received [%s].",
+            mask_dims));
+    params.mask_num_heads = mask_dims[1];
+    params.mask_rows = mask_dims[2];
+    params.mask_cols = mask_dims[3];
+    mask_data = mask->data<T>();
+  }
+
+  funcs::DenseKVCache<T> cache{key.data<T>(),
+                               value.data<T>(),
+                               params.kv_num_heads,
+                               max_kv_len,
+                               params.head_size,
+                               params.value_head_size};
+  funcs::VarlenAttention(
+      params, query.data<T>(), cache, mask_data, ctx.template Alloc<T>(output));
+}
+
+}  // namespace fusion
+}  // namespace phi
+
+PD_REGISTER_KERNEL(variable_length_memory_efficient_attention,
+                   CPU,
+                   ALL_LAYOUT,
+                   phi::fusion::MultiHeadAttentionVariableForwardKernel,
+                   float,
+                   phi::dtype::float16,
+                   phi::dtype::bfloat16) {
+  kernel->InputAt(3).SetDataType(phi::DataType::INT32);
+}
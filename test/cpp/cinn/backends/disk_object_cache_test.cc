@@ -0,0 +1,99 @@
+// Copyright (c) 2025 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include "paddle/cinn/backends/llvm/disk_object_cache.h"
+
+namespace cinn {
+namespace backends {
+
+namespace {
+
+// A cache directory of this process, removed at the end of the test.
+struct TempDir {
+  explicit TempDir(const std::string& suffix)
+      : path("/tmp/cinn_object_cache_test." + std::to_string(getpid()) +
+             suffix) {}
+  ~TempDir() { std::filesystem::remove_all(path); }
+
+  std::string path;
+};
+
+// Sets the last use of the object of `key` to `seconds`.
+void SetMtime(const std::string& dir, const std::string& key, int seconds) {
+  struct timeval times[2] = {{seconds, 0}, {seconds, 0}};
+  utimes((dir + "/" + key + ".o").c_str(), times);
+}
+
+}  // namespace
+
+TEST(DiskObjectCache, StoreAndLoad) {
+  TempDir temp_dir(".load");
+  const std::string& dir = temp_dir.path;
+  DiskObjectCache cache(dir, 1 << 20);
+  std::string object;
+  EXPECT_FALSE(cache.Load("a", &object));
+
+  cache.Store("a", "object of a", 5);
+  ASSERT_TRUE(cache.Load("a", &object));
+  EXPECT_EQ(object, "object of a");
+
+  // another process sees the object stored by this one
+  DiskObjectCache other(dir, 1 << 20);
+  ASSERT_TRUE(other.Load("a", &object));
+  EXPECT_EQ(object, "object of a");
+
+  // a truncated object is a miss
+  std::ofstream(dir + "/b.o") << "CINN";
+  EXPECT_FALSE(cache.Load("b", &object));
+
+  auto stats = cache.stats();
+  EXPECT_EQ(stats.hits, 1);
+  EXPECT_EQ(stats.misses, 2);
+  EXPECT_DOUBLE_EQ(stats.compile_ms, 5);
+  EXPECT_DOUBLE_EQ(stats.saved_ms, 5);
+  EXPECT_DOUBLE_EQ(other.stats().saved_ms, 5);
+}
+
+TEST(DiskObjectCache, EvictLeastRecentlyUsed) {
+  TempDir temp_dir(".evict");
+  const std::string& dir = temp_dir.path;
+  const std::string payload(1000, 'x');
+  // room for two objects and their headers, not three
+  DiskObjectCache cache(dir, 3000);
+  std::string object;
+  cache.Store("a", payload, 1);
+  cache.Store("b", payload, 1);
+  SetMtime(dir, "a", 100);
+  SetMtime(dir, "b", 200);
+  // loading a makes b the least recently used
+  ASSERT_TRUE(cache.Load("a", &object));
+
+  cache.Store("c", payload, 1);
+  EXPECT_EQ(cache.stats().evictions, 1);
+  EXPECT_TRUE(cache.Load("a", &object));
+  EXPECT_FALSE(cache.Load("b", &object));
+  EXPECT_TRUE(cache.Load("c", &object));
+}
+
+}  // namespace backends
+}  // namespace cinn
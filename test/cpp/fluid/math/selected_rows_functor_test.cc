@@ -431,6 +431,41 @@ TEST(selected_rows_functor, cpu_merge_add_multi_noduplicated) {
   }
 }
 
+TEST(selected_rows_functor, cpu_merge_add_sorted_unique) {
+  phi::CPUPlace cpu_place;
+  phi::CPUContext ctx(cpu_place);
+  ctx.SetAllocator(paddle::memory::allocation::AllocatorFacade::Instance()
+                       .GetAllocator(cpu_place)
+                       .get());
+  int64_t height = 10;
+  int64_t row_numel = 4;
+
+  // the rows of the deduplicated sparse gradient of embedding
+  std::vector<int64_t> rows{1, 3, 8};
+  std::unique_ptr<phi::SelectedRows> selected_rows{
+      new phi::SelectedRows(rows, height)};
+  auto* in_value = selected_rows->mutable_value();
+  auto* in_data = in_value->mutable_data<float>(
+      common::make_ddim({static_cast<int64_t>(rows.size()), row_numel}),
+      cpu_place);
+  for (int64_t i = 0; i < in_value->numel(); ++i) {
+    in_data[i] = static_cast<float>(i);
+  }
+
+  phi::funcs::scatter::MergeAdd<phi::CPUContext, float> merge_add_functor;
+  for (bool sorted_result : {false, true}) {
+    std::unique_ptr<phi::SelectedRows> output{new phi::SelectedRows()};
+    merge_add_functor(ctx, *selected_rows, output.get(), sorted_result);
+
+    EXPECT_EQ(output->height(), height);
+    EXPECT_EQ(output->rows(), rows);
+    auto* out_data = output->value().data<float>();
+    for (int64_t i = 0; i < in_value->numel(); ++i) {
+      EXPECT_EQ(out_data[i], static_cast<float>(i));
+    }
+  }
+}
+
 TEST(selected_rows_functor, cpu_sum_to) {
   phi::CPUPlace cpu_place;
   phi::CPUContext ctx(cpu_place);
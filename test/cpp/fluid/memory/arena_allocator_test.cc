@@ -0,0 +1,134 @@
+// Copyright (c) 2025 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "paddle/phi/core/memory/allocation/arena_allocator.h"
+
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "paddle/phi/core/memory/allocation/cpu_allocator.h"
+
+namespace paddle {
+namespace memory {
+namespace allocation {
+
+namespace {
+
+// Allocates like the intermediates of a request: a chain of tensors, each
+// freed once the next one is computed, plus an output kept to the end.
+void RunRequest(ArenaAllocator* arena, std::vector<void*>* addresses) {
+  auto output = arena->Allocate(100);
+  AllocationPtr prev;
+  for (size_t size : {1000, 3000, 2000, 500}) {
+    auto cur = arena->Allocate(size);
+    addresses->push_back(cur->ptr());
+    prev = std::move(cur);
+  }
+  prev.reset();
+  output.reset();
+  arena->EndRequest();
+}
+
+}  // namespace
+
+TEST(ArenaAllocator, SizedAfterWarmup) {
+  auto arena =
+      std::make_shared<ArenaAllocator>(std::make_shared<CPUAllocator>(), 64);
+
+  std::vector<void*> warmup, settle;
+  RunRequest(arena.get(), &warmup);
+  auto stat = arena->GetStat();
+  EXPECT_EQ(stat.capacity, 0UL);
+  EXPECT_EQ(stat.arena_allocs, 0UL);
+  EXPECT_EQ(stat.fallback_allocs, 5UL);
+  // the block holds the peak, 100 + 3000 + 2000 bytes aligned, but the
+  // 2000 bytes do not fit in the hole left by the 1000 ones and fall back,
+  // which grows the block once
+  RunRequest(arena.get(), &settle);
+  EXPECT_EQ(arena->GetStat().fallback_allocs, 6UL);
+
+  std::vector<void*> first, second;
+  RunRequest(arena.get(), &first);
+  RunRequest(arena.get(), &second);
+  stat = arena->GetStat();
+  EXPECT_EQ(stat.capacity, 128UL + 1024UL + 3008UL + 2048UL);
+  EXPECT_EQ(stat.fallback_allocs, 6UL);
+  EXPECT_EQ(stat.arena_allocs, 14UL);
+  EXPECT_EQ(stat.resets, 3UL);
+  EXPECT_EQ(stat.request_bytes, 0UL);
+  // the arena is reset between requests, so they reuse the same addresses
+  EXPECT_EQ(first, second);
+  for (auto* ptr : first) {
+    EXPECT_TRUE(arena->Contains(ptr));
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(ptr) % 64, 0UL);
+  }
+
+  EXPECT_EQ(arena->Release(phi::CPUPlace()), stat.capacity);
+  EXPECT_EQ(arena->GetStat().capacity, 0UL);
+}
+
+TEST(ArenaAllocator, SizedFromPeak) {
+  auto arena =
+      std::make_shared<ArenaAllocator>(std::make_shared<CPUAllocator>(), 64);
+  // a chain of 20 tensors of 1000 bytes, each freed once the next one is
+  // computed: 20000 bytes allocated, at most two of them alive
+  auto run = [&arena]() {
+    AllocationPtr prev;
+    for (int i = 0; i < 20; ++i) {
+      auto cur = arena->Allocate(1000);
+      prev = std::move(cur);
+    }
+    prev.reset();
+    arena->EndRequest();
+  };
+  for (int i = 0; i < 3; ++i) {
+    run();
+  }
+  auto stat = arena->GetStat();
+  EXPECT_EQ(stat.capacity, 2 * 1024UL);
+  // only the first request falls back, the freed space is reused
+  EXPECT_EQ(stat.fallback_allocs, 20UL);
+  EXPECT_EQ(stat.arena_allocs, 40UL);
+}
+
+TEST(ArenaAllocator, GrowsAndKeepsLiveAllocations) {
+  auto arena =
+      std::make_shared<ArenaAllocator>(std::make_shared<CPUAllocator>(), 64);
+  arena->Allocate(256).reset();
+  arena->EndRequest();
+
+  auto a = arena->Allocate(256);
+  EXPECT_TRUE(arena->Contains(a->ptr()));
+  // does not fit, served by the underlying allocator
+  auto b = arena->Allocate(1024);
+  EXPECT_FALSE(arena->Contains(b->ptr()));
+  arena->EndRequest();
+  // a is alive, so the arena can be neither regrown nor released
+  auto c = arena->Allocate(1024);
+  EXPECT_FALSE(arena->Contains(c->ptr()));
+  EXPECT_EQ(arena->Release(phi::CPUPlace()), 0UL);
+  EXPECT_EQ(arena->GetStat().capacity, 256UL);
+  a.reset();
+  b.reset();
+  c.reset();
+  arena->EndRequest();
+
+  auto d = arena->Allocate(1024);
+  EXPECT_TRUE(arena->Contains(d->ptr()));
+  EXPECT_GE(arena->GetStat().capacity, 256UL + 1024UL);
+}
+
+}  // namespace allocation
+}  // namespace memory
+}  // namespace paddle
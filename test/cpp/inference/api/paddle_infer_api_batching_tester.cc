@@ -0,0 +1,110 @@
+/* Copyright (c) 2025 PaddlePaddle Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License. */
+
+#include <glog/logging.h>
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <future>
+#include <numeric>
+#include <vector>
+
+#include "paddle/common/flags.h"
+#include "paddle/fluid/inference/api/paddle_batching_predictor.h"
+#include "test/cpp/inference/api/tester_helper.h"
+
+namespace paddle_infer {
+
+namespace {
+
+Config MakeConfig() {
+  std::string model_dir = FLAGS_infer_model + "/model";
+  Config config;
+  config.EnableNewIR(false);
+  config.SetModel(model_dir + "/model", model_dir + "/params");
+  config.DisableGpu();
+  config.SetCpuMathLibraryNumThreads(1);
+  return config;
+}
+
+services::BatchingTensor MakeInput(int batch, int seed) {
+  services::BatchingTensor x;
+  x.shape = {batch, 3, 224, 224};
+  std::vector<float> data(batch * 3 * 224 * 224);
+  for (size_t i = 0; i < data.size(); i++) {
+    data[i] = static_cast<float>((i * 7 + seed) % 255) / 255.f;
+  }
+  x.data.resize(data.size() * sizeof(float));
+  std::memcpy(x.data.data(), data.data(), x.data.size());
+  return x;
+}
+
+std::vector<float> RunDirect(Predictor* predictor,
+                             const services::BatchingTensor& x) {
+  auto input = predictor->GetInputHandle(predictor->GetInputNames()[0]);
+  input->Reshape(x.shape);
+  input->CopyFromCpu(reinterpret_cast<const float*>(x.data.data()));
+  predictor->Run();
+  auto output = predictor->GetOutputHandle(predictor->GetOutputNames()[0]);
+  auto shape = output->shape();
+  std::vector<float> res(
+      std::accumulate(shape.begin(), shape.end(), 1, std::multiplies<int>()));
+  output->CopyToCpu(res.data());
+  return res;
+}
+
+}  // namespace
+
+TEST(BatchingPredictor, cpu) {
+  Config config = MakeConfig();
+  auto predictor = CreatePredictor(config);
+  std::string input_name = predictor->GetInputNames()[0];
+  std::string output_name = predictor->GetOutputNames()[0];
+
+  services::BatchingConfig batching;
+  batching.max_batch_size = 8;
+  batching.max_delay_us = 20000;
+  batching.num_workers = 2;
+  services::BatchingPredictor batching_predictor(config, batching);
+
+  const int request_num = 12;
+  std::vector<services::BatchingTensor> inputs;
+  std::vector<std::future<services::BatchingTensorMap>> results;
+  for (int i = 0; i < request_num; i++) {
+    inputs.push_back(MakeInput(1 + i % 3, i));
+    results.push_back(batching_predictor.Submit({{input_name, inputs[i]}}));
+  }
+  for (int i = 0; i < request_num; i++) {
+    auto outputs = results[i].get();
+    auto& out = outputs.at(output_name);
+    ASSERT_EQ(out.shape[0], inputs[i].shape[0]);
+    auto expect = RunDirect(predictor.get(), inputs[i]);
+    ASSERT_EQ(out.data.size(), expect.size() * sizeof(float));
+    const float* data = reinterpret_cast<const float*>(out.data.data());
+    for (size_t j = 0; j < expect.size(); j++) {
+      EXPECT_NEAR(data[j], expect[j], 1e-4);
+    }
+  }
+
+  auto stats = batching_predictor.GetStats();
+  LOG(INFO) << "batches: " << stats.num_batches
+            << ", avg batch size: " << stats.avg_batch_size
+            << ", avg queue latency: " << stats.avg_queue_latency_us
+            << "us, avg run latency: " << stats.avg_run_latency_us
+            << "us, qps: " << stats.requests_per_second;
+  EXPECT_EQ(stats.num_requests, static_cast<uint64_t>(request_num));
+  EXPECT_LT(stats.num_batches, static_cast<uint64_t>(request_num));
+}
+
+}  // namespace paddle_infer
@@ -0,0 +1,138 @@
+/* Copyright (c) 2025 PaddlePaddle Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License. */
+
+#include <glog/logging.h>
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+#include <filesystem>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "paddle/fluid/inference/api/paddle_inference_api.h"
+#include "paddle/fluid/pir/dialect/operator/ir/op_dialect.h"
+#include "paddle/fluid/pir/dialect/operator/ir/op_type.h"
+#include "paddle/fluid/pir/dialect/operator/ir/pd_op.h"
+#include "paddle/fluid/pir/serialize_deserialize/include/interface.h"
+#include "paddle/phi/backends/context_pool.h"
+#include "paddle/pir/include/core/builtin_attribute.h"
+#include "paddle/pir/include/core/builtin_dialect.h"
+#include "paddle/pir/include/core/builtin_op.h"
+#include "paddle/pir/include/core/builtin_type.h"
+#include "paddle/pir/include/core/program.h"
+
+namespace paddle_infer {
+
+namespace {
+
+// Writes a PIR model in dir with the outputs relu(x * w) and 2 * x * w, x of
+// shape [-1, 4] and w of shape [4, 3].
+void WriteModel(const std::string& dir) {
+  pir::IrContext* ctx = pir::IrContext::Instance();
+  ctx->GetOrRegisterDialect<paddle::dialect::OperatorDialect>();
+  ctx->GetOrRegisterDialect<pir::BuiltinDialect>();
+  pir::Program program(ctx);
+  pir::Builder builder(ctx, program.block());
+
+  auto x = builder
+               .Build<paddle::dialect::DataOp>("x",
+                                               std::vector<int64_t>{-1, 4},
+                                               phi::DataType::FLOAT32,
+                                               phi::CPUPlace())
+               .result(0);
+  pir::Type w_type =
+      paddle::dialect::DenseTensorType::get(ctx,
+                                            pir::Float32Type::get(ctx),
+                                            common::make_ddim({4, 3}),
+                                            phi::DataLayout::NCHW,
+                                            phi::LegacyLoD(),
+                                            0);
+  auto w = builder.Build<pir::ParameterOp>("w", w_type).result(0);
+  w.set_attribute("persistable", pir::BoolAttribute::get(ctx, true));
+  auto h = builder.Build<paddle::dialect::MatmulOp>(x, w).result(0);
+  auto out0 = builder.Build<paddle::dialect::ReluOp>(h).result(0);
+  auto out1 =
+      builder.Build<paddle::dialect::ScaleOp>(h, 2.0, 0.0, true).result(0);
+  builder.Build<paddle::dialect::FetchOp>(out0, "out0", 0);
+  builder.Build<paddle::dialect::FetchOp>(out1, "out1", 1);
+  pir::WriteModule(program, dir + "/model.json", 1, true);
+
+  phi::DenseTensor w_tensor;
+  w_tensor.Resize(common::make_ddim({4, 3}));
+  auto* dev_ctx = phi::DeviceContextPool::Instance().Get(phi::CPUPlace());
+  float* w_data = dev_ctx->Alloc<float>(&w_tensor);
+  for (int i = 0; i < 12; i++) {
+    w_data[i] = static_cast<float>(i % 5) - 2.f;
+  }
+  pir::SaveCombineFunction(
+      {&w_tensor}, {"w"}, dir + "/model.pdiparams", true, false, false);
+}
+
+void CheckFetchCallback(const std::string& dir, bool streaming) {
+  Config config;
+  config.SetModel(dir + "/model.json", dir + "/model.pdiparams");
+  config.EnableNewIR(true);
+  config.EnableNewExecutor(true);
+  config.DisableGpu();
+  config.EnableStreamingFetch(streaming);
+  auto predictor = CreatePredictor(config);
+
+  std::map<std::string, std::vector<std::vector<float>>> fetched;
+  predictor->RegisterFetchCallback(
+      [&fetched](const std::string& name, const paddle::Tensor& tensor) {
+        const float* data = tensor.data<float>();
+        fetched[name].emplace_back(data, data + tensor.numel());
+      });
+
+  std::vector<float> x(2 * 4);
+  for (size_t i = 0; i < x.size(); i++) {
+    x[i] = static_cast<float>(i) / 4.f - 1.f;
+  }
+  for (int run = 1; run <= 2; run++) {
+    auto input = predictor->GetInputHandle("x");
+    input->Reshape({2, 4});
+    input->CopyFromCpu(x.data());
+    ASSERT_TRUE(predictor->Run());
+
+    // Every output is passed to the callback once per run, with the value
+    // of the output handle.
+    auto names = predictor->GetOutputNames();
+    ASSERT_EQ(fetched.size(), names.size());
+    for (auto& name : names) {
+      ASSERT_EQ(fetched[name].size(), static_cast<size_t>(run)) << name;
+      auto output = predictor->GetOutputHandle(name);
+      std::vector<float> res(2 * 3);
+      output->CopyToCpu(res.data());
+      EXPECT_EQ(fetched[name].back(), res) << name;
+    }
+  }
+}
+
+}  // namespace
+
+TEST(Predictor, fetch_callback) {
+  std::string dir = (std::filesystem::temp_directory_path() /
+                     ("fetch_callback_test." + std::to_string(getpid())))
+                        .string();
+  std::filesystem::create_directories(dir);
+  WriteModel(dir);
+
+  CheckFetchCallback(dir, false);
+  CheckFetchCallback(dir, true);
+
+  std::filesystem::remove_all(dir);
+}
+
+}  // namespace paddle_infer
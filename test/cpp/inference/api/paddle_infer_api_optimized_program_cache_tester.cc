@@ -0,0 +1,138 @@
+/* Copyright (c) 2025 PaddlePaddle Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License. */
+
+#include <glog/logging.h>
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "paddle/fluid/inference/api/paddle_inference_api.h"
+#include "paddle/fluid/pir/dialect/operator/ir/op_dialect.h"
+#include "paddle/fluid/pir/dialect/operator/ir/op_type.h"
+#include "paddle/fluid/pir/dialect/operator/ir/pd_op.h"
+#include "paddle/fluid/pir/serialize_deserialize/include/interface.h"
+#include "paddle/phi/backends/context_pool.h"
+#include "paddle/phi/core/platform/monitor.h"
+#include "paddle/pir/include/core/builtin_attribute.h"
+#include "paddle/pir/include/core/builtin_dialect.h"
+#include "paddle/pir/include/core/builtin_op.h"
+#include "paddle/pir/include/core/builtin_type.h"
+#include "paddle/pir/include/core/program.h"
+
+namespace paddle_infer {
+
+namespace {
+
+// Writes relu(x * w) with x of shape [-1, 4] and w of shape [4, 3] as a PIR
+// model in dir.
+void WriteModel(const std::string& dir) {
+  pir::IrContext* ctx = pir::IrContext::Instance();
+  ctx->GetOrRegisterDialect<paddle::dialect::OperatorDialect>();
+  ctx->GetOrRegisterDialect<pir::BuiltinDialect>();
+  pir::Program program(ctx);
+  pir::Builder builder(ctx, program.block());
+
+  auto x = builder
+               .Build<paddle::dialect::DataOp>("x",
+                                               std::vector<int64_t>{-1, 4},
+                                               phi::DataType::FLOAT32,
+                                               phi::CPUPlace())
+               .result(0);
+  pir::Type w_type =
+      paddle::dialect::DenseTensorType::get(ctx,
+                                            pir::Float32Type::get(ctx),
+                                            common::make_ddim({4, 3}),
+                                            phi::DataLayout::NCHW,
+                                            phi::LegacyLoD(),
+                                            0);
+  auto w = builder.Build<pir::ParameterOp>("w", w_type).result(0);
+  w.set_attribute("persistable", pir::BoolAttribute::get(ctx, true));
+  auto out = builder.Build<paddle::dialect::MatmulOp>(x, w).result(0);
+  out = builder.Build<paddle::dialect::ReluOp>(out).result(0);
+  builder.Build<paddle::dialect::FetchOp>(out, "out", 0);
+  pir::WriteModule(program, dir + "/model.json", 1, true);
+
+  phi::DenseTensor w_tensor;
+  w_tensor.Resize(common::make_ddim({4, 3}));
+  auto* dev_ctx = phi::DeviceContextPool::Instance().Get(phi::CPUPlace());
+  float* w_data = dev_ctx->Alloc<float>(&w_tensor);
+  for (int i = 0; i < 12; i++) {
+    w_data[i] = static_cast<float>(i % 5) - 2.f;
+  }
+  pir::SaveCombineFunction(
+      {&w_tensor}, {"w"}, dir + "/model.pdiparams", true, false, false);
+}
+
+Config MakeConfig(const std::string& dir) {
+  Config config;
+  config.SetModel(dir + "/model.json", dir + "/model.pdiparams");
+  config.EnableNewIR(true);
+  config.EnableNewExecutor(true);
+  config.DisableGpu();
+  config.SwitchIrOptim(true);
+  config.SetOptimCacheDir(dir + "/cache");
+  config.EnableOptimizedProgramCache();
+  return config;
+}
+
+std::vector<float> RunOnce(Predictor* predictor) {
+  auto input = predictor->GetInputHandle("x");
+  std::vector<float> data(2 * 4);
+  for (size_t i = 0; i < data.size(); i++) {
+    data[i] = static_cast<float>(i) / 4.f - 1.f;
+  }
+  input->Reshape({2, 4});
+  input->CopyFromCpu(data.data());
+  predictor->Run();
+  auto output = predictor->GetOutputHandle(predictor->GetOutputNames()[0]);
+  std::vector<float> res(2 * 3);
+  output->CopyToCpu(res.data());
+  return res;
+}
+
+int64_t CacheHits() {
+  auto* stat = paddle::platform::StatRegistry<int64_t>::Instance().get(
+      "STAT_optimized_program_cache_hit");
+  return stat == nullptr ? 0 : stat->get();
+}
+
+}  // namespace
+
+TEST(Predictor, optimized_program_cache) {
+  std::string dir = (std::filesystem::temp_directory_path() /
+                     ("optimized_program_cache_test." +
+                      std::to_string(getpid())))
+                        .string();
+  std::filesystem::create_directories(dir);
+  WriteModel(dir);
+
+  // The first predictor runs the passes and fills the cache, the second one
+  // with the same config loads the optimized program.
+  int64_t hits = CacheHits();
+  auto first = CreatePredictor(MakeConfig(dir));
+  EXPECT_EQ(CacheHits(), hits);
+  auto expected = RunOnce(first.get());
+  auto second = CreatePredictor(MakeConfig(dir));
+  EXPECT_EQ(CacheHits(), hits + 1);
+  EXPECT_EQ(RunOnce(second.get()), expected);
+
+  first.reset();
+  second.reset();
+  std::filesystem::remove_all(dir);
+}
+
+}  // namespace paddle_infer
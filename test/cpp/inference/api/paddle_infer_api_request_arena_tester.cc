@@ -0,0 +1,151 @@
+/* Copyright (c) 2025 PaddlePaddle Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License. */
+
+#include <glog/logging.h>
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "paddle/fluid/inference/api/paddle_inference_api.h"
+#include "paddle/fluid/pir/dialect/operator/ir/op_dialect.h"
+#include "paddle/fluid/pir/dialect/operator/ir/op_type.h"
+#include "paddle/fluid/pir/dialect/operator/ir/pd_op.h"
+#include "paddle/fluid/pir/serialize_deserialize/include/interface.h"
+#include "paddle/phi/backends/context_pool.h"
+#include "paddle/pir/include/core/builtin_attribute.h"
+#include "paddle/pir/include/core/builtin_dialect.h"
+#include "paddle/pir/include/core/builtin_op.h"
+#include "paddle/pir/include/core/builtin_type.h"
+#include "paddle/pir/include/core/program.h"
+
+namespace paddle_infer {
+
+namespace {
+
+// Writes relu(x * w) with x of shape [-1, 4] and w of shape [4, 3] as a PIR
+// model in dir, and returns w.
+std::vector<float> WriteModel(const std::string& dir) {
+  pir::IrContext* ctx = pir::IrContext::Instance();
+  ctx->GetOrRegisterDialect<paddle::dialect::OperatorDialect>();
+  ctx->GetOrRegisterDialect<pir::BuiltinDialect>();
+  pir::Program program(ctx);
+  pir::Builder builder(ctx, program.block());
+
+  auto x = builder
+               .Build<paddle::dialect::DataOp>("x",
+                                               std::vector<int64_t>{-1, 4},
+                                               phi::DataType::FLOAT32,
+                                               phi::CPUPlace())
+               .result(0);
+  pir::Type w_type =
+      paddle::dialect::DenseTensorType::get(ctx,
+                                            pir::Float32Type::get(ctx),
+                                            common::make_ddim({4, 3}),
+                                            phi::DataLayout::NCHW,
+                                            phi::LegacyLoD(),
+                                            0);
+  auto w = builder.Build<pir::ParameterOp>("w", w_type).result(0);
+  w.set_attribute("persistable", pir::BoolAttribute::get(ctx, true));
+  auto out = builder.Build<paddle::dialect::MatmulOp>(x, w).result(0);
+  out = builder.Build<paddle::dialect::ReluOp>(out).result(0);
+  builder.Build<paddle::dialect::FetchOp>(out, "out", 0);
+  pir::WriteModule(program, dir + "/model.json", 1, true);
+
+  phi::DenseTensor w_tensor;
+  w_tensor.Resize(common::make_ddim({4, 3}));
+  auto* dev_ctx = phi::DeviceContextPool::Instance().Get(phi::CPUPlace());
+  float* w_data = dev_ctx->Alloc<float>(&w_tensor);
+  for (int i = 0; i < 12; i++) {
+    w_data[i] = static_cast<float>(i % 5) - 2.f;
+  }
+  pir::SaveCombineFunction(
+      {&w_tensor}, {"w"}, dir + "/model.pdiparams", true, false, false);
+  return std::vector<float>(w_data, w_data + 12);
+}
+
+std::vector<float> Input(int batch, float shift) {
+  std::vector<float> data(batch * 4);
+  for (size_t i = 0; i < data.size(); i++) {
+    data[i] = static_cast<float>(i) / 4.f - shift;
+  }
+  return data;
+}
+
+std::vector<float> Reference(const std::vector<float>& x,
+                             const std::vector<float>& w) {
+  std::vector<float> out(x.size() / 4 * 3, 0.f);
+  for (size_t i = 0; i < x.size() / 4; i++) {
+    for (size_t j = 0; j < 3; j++) {
+      for (size_t k = 0; k < 4; k++) {
+        out[i * 3 + j] += x[i * 4 + k] * w[k * 3 + j];
+      }
+      out[i * 3 + j] = std::max(out[i * 3 + j], 0.f);
+    }
+  }
+  return out;
+}
+
+std::vector<float> Run(Predictor* predictor, const std::vector<float>& x) {
+  auto input = predictor->GetInputHandle("x");
+  input->Reshape({static_cast<int>(x.size() / 4), 4});
+  input->CopyFromCpu(x.data());
+  EXPECT_TRUE(predictor->Run());
+  auto output = predictor->GetOutputHandle(predictor->GetOutputNames()[0]);
+  std::vector<float> res(x.size() / 4 * 3);
+  output->CopyToCpu(res.data());
+  return res;
+}
+
+}  // namespace
+
+TEST(Predictor, request_arena) {
+  std::string dir = (std::filesystem::temp_directory_path() /
+                     ("request_arena_test." + std::to_string(getpid())))
+                        .string();
+  std::filesystem::create_directories(dir);
+  auto w = WriteModel(dir);
+
+  Config config;
+  config.SetModel(dir + "/model.json", dir + "/model.pdiparams");
+  config.EnableNewIR(true);
+  config.EnableNewExecutor(true);
+  config.DisableGpu();
+  config.EnableRequestArena();
+  auto predictor = CreatePredictor(config);
+
+  // The first run sizes the arena, the second one allocates from it and
+  // resets it at the end, the outputs must survive both.
+  auto x1 = Input(2, 1.f);
+  auto x2 = Input(3, 2.f);
+  EXPECT_EQ(Run(predictor.get(), x1), Reference(x1, w));
+  EXPECT_EQ(Run(predictor.get(), x2), Reference(x2, w));
+  EXPECT_EQ(Run(predictor.get(), x1), Reference(x1, w));
+
+  // Releasing the block of the arena leaves the output of the last run
+  // intact.
+  predictor->TryShrinkMemory();
+  auto output = predictor->GetOutputHandle(predictor->GetOutputNames()[0]);
+  std::vector<float> res(x1.size() / 4 * 3);
+  output->CopyToCpu(res.data());
+  EXPECT_EQ(res, Reference(x1, w));
+
+  predictor.reset();
+  std::filesystem::remove_all(dir);
+}
+
+}  // namespace paddle_infer
@@ -0,0 +1,112 @@
+/* Copyright (c) 2025 PaddlePaddle Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License. */
+
+#include <glog/logging.h>
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <future>
+#include <vector>
+
+#include "paddle/common/flags.h"
+#include "paddle/phi/api/include/tensor_utils.h"
+#include "test/cpp/inference/api/tester_helper.h"
+
+namespace paddle_infer {
+
+namespace {
+
+Config MakeConfig() {
+  std::string model_dir = FLAGS_infer_model + "/model";
+  Config config;
+  config.EnableNewIR(false);
+  config.SetModel(model_dir + "/model", model_dir + "/params");
+  config.DisableGpu();
+  config.SetCpuMathLibraryNumThreads(1);
+  config.SetAsyncRunNumThreads(2);
+  return config;
+}
+
+std::vector<float> MakeData(int seed) {
+  std::vector<float> data(3 * 224 * 224);
+  for (size_t i = 0; i < data.size(); i++) {
+    data[i] = static_cast<float>((i * 7 + seed) % 255) / 255.f;
+  }
+  return data;
+}
+
+std::vector<float> ToVector(const paddle::Tensor& tensor) {
+  const float* data = tensor.data<float>();
+  return std::vector<float>(data, data + tensor.numel());
+}
+
+}  // namespace
+
+TEST(Predictor, RunAsync) {
+  Config config = MakeConfig();
+  auto predictor = CreatePredictor(config);
+  std::string input_name = predictor->GetInputNames()[0];
+
+  const int num = 8;
+  std::vector<std::vector<float>> data;
+  std::vector<std::vector<float>> expected;
+  for (int i = 0; i < num; i++) {
+    data.push_back(MakeData(i));
+    auto x = paddle::from_blob(
+        data[i].data(), {1, 3, 224, 224}, phi::DataType::FLOAT32);
+    x.set_name(input_name);
+    std::vector<paddle::Tensor> outputs;
+    ASSERT_TRUE(predictor->Run({x}, &outputs));
+    expected.push_back(ToVector(outputs[0]));
+  }
+
+  // Keep every request in flight at once, the outputs must not be
+  // overwritten by the runs that follow them.
+  std::vector<std::future<std::vector<paddle::Tensor>>> futures;
+  std::atomic<int> num_callbacks{0};
+  for (int i = 0; i < num; i++) {
+    auto x = paddle::from_blob(
+        data[i].data(), {1, 3, 224, 224}, phi::DataType::FLOAT32);
+    x.set_name(input_name);
+    futures.push_back(predictor->RunAsync({x}));
+    predictor->RunAsync(
+        {x}, [&](bool success, std::vector<paddle::Tensor>* outputs) {
+          EXPECT_TRUE(success);
+          EXPECT_EQ(outputs->size(), 1UL);
+          num_callbacks++;
+        });
+  }
+  for (int i = 0; i < num; i++) {
+    auto outputs = futures[i].get();
+    ASSERT_EQ(outputs.size(), 1UL);
+    auto res = ToVector(outputs[0]);
+    ASSERT_EQ(res.size(), expected[i].size());
+    for (size_t j = 0; j < res.size(); j++) {
+      EXPECT_NEAR(res[j], expected[i][j], 1e-5);
+    }
+  }
+  // The predictor finishes the pending calls before it is destroyed.
+  predictor.reset();
+  EXPECT_EQ(num_callbacks.load(), num);
+}
+
+TEST(Predictor, RunAsyncError) {
+  Config config = MakeConfig();
+  auto predictor = CreatePredictor(config);
+  // No input is fed.
+  auto result = predictor->RunAsync(std::vector<paddle::Tensor>());
+  EXPECT_THROW(result.get(), std::runtime_error);
+}
+
+}  // namespace paddle_infer
@@ -0,0 +1,240 @@
+/* Copyright (c) 2025 PaddlePaddle Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License. */
+
+#include <glog/logging.h>
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include "paddle/common/flags.h"
+#include "paddle/fluid/inference/api/weight_registry.h"
+#include "paddle/fluid/pir/dialect/operator/ir/op_dialect.h"
+#include "paddle/fluid/pir/dialect/operator/ir/op_type.h"
+#include "paddle/fluid/pir/dialect/operator/ir/pd_op.h"
+#include "paddle/fluid/pir/serialize_deserialize/include/interface.h"
+#include "paddle/phi/backends/context_pool.h"
+#include "paddle/pir/include/core/builtin_attribute.h"
+#include "paddle/pir/include/core/builtin_dialect.h"
+#include "paddle/pir/include/core/builtin_op.h"
+#include "paddle/pir/include/core/builtin_type.h"
+#include "paddle/pir/include/core/program.h"
+#include "test/cpp/inference/api/tester_helper.h"
+
+namespace paddle_infer {
+
+namespace {
+
+Config MakeConfig(bool ir_optim) {
+  std::string model_dir = FLAGS_infer_model + "/model";
+  Config config;
+  config.EnableNewIR(false);
+  config.SetModel(model_dir + "/model", model_dir + "/params");
+  config.DisableGpu();
+  config.SwitchIrOptim(ir_optim);
+  config.EnableSharedWeights();
+  return config;
+}
+
+std::vector<float> RunOnce(Predictor* predictor) {
+  auto input = predictor->GetInputHandle(predictor->GetInputNames()[0]);
+  std::vector<float> data(2 * 3 * 224 * 224);
+  for (size_t i = 0; i < data.size(); i++) {
+    data[i] = static_cast<float>(i % 255) / 255.f;
+  }
+  input->Reshape({2, 3, 224, 224});
+  input->CopyFromCpu(data.data());
+  predictor->Run();
+  auto output = predictor->GetOutputHandle(predictor->GetOutputNames()[0]);
+  auto shape = output->shape();
+  std::vector<float> res(
+      std::accumulate(shape.begin(), shape.end(), 1, std::multiplies<int>()));
+  output->CopyToCpu(res.data());
+  return res;
+}
+
+// Writes a PIR model computing relu(x * w) and cache += y, with x of shape
+// [-1, 4], and w, y and cache of shape [4, 3], in dir. w and cache are
+// persistables with equal data, returns it.
+std::vector<float> WriteModelWithCache(const std::string& dir) {
+  pir::IrContext* ctx = pir::IrContext::Instance();
+  ctx->GetOrRegisterDialect<paddle::dialect::OperatorDialect>();
+  ctx->GetOrRegisterDialect<pir::BuiltinDialect>();
+  pir::Program program(ctx);
+  pir::Builder builder(ctx, program.block());
+
+  auto x = builder
+               .Build<paddle::dialect::DataOp>("x",
+                                               std::vector<int64_t>{-1, 4},
+                                               phi::DataType::FLOAT32,
+                                               phi::CPUPlace())
+               .result(0);
+  auto y = builder
+               .Build<paddle::dialect::DataOp>("y",
+                                               std::vector<int64_t>{4, 3},
+                                               phi::DataType::FLOAT32,
+                                               phi::CPUPlace())
+               .result(0);
+  pir::Type type =
+      paddle::dialect::DenseTensorType::get(ctx,
+                                            pir::Float32Type::get(ctx),
+                                            common::make_ddim({4, 3}),
+                                            phi::DataLayout::NCHW,
+                                            phi::LegacyLoD(),
+                                            0);
+  auto w = builder.Build<pir::ParameterOp>("w", type).result(0);
+  w.set_attribute("persistable", pir::BoolAttribute::get(ctx, true));
+  auto cache = builder.Build<pir::ParameterOp>("cache", type).result(0);
+  cache.set_attribute("persistable", pir::BoolAttribute::get(ctx, true));
+  auto out = builder.Build<paddle::dialect::MatmulOp>(x, w).result(0);
+  out = builder.Build<paddle::dialect::ReluOp>(out).result(0);
+  builder.Build<paddle::dialect::FetchOp>(out, "out", 0);
+  auto updated = builder.Build<paddle::dialect::Add_Op>(cache, y).result(0);
+  builder.Build<paddle::dialect::FetchOp>(updated, "cache_out", 1);
+  pir::WriteModule(program, dir + "/model.json", 1, true);
+
+  phi::DenseTensor w_tensor, cache_tensor;
+  w_tensor.Resize(common::make_ddim({4, 3}));
+  cache_tensor.Resize(common::make_ddim({4, 3}));
+  auto* dev_ctx = phi::DeviceContextPool::Instance().Get(phi::CPUPlace());
+  float* w_data = dev_ctx->Alloc<float>(&w_tensor);
+  float* cache_data = dev_ctx->Alloc<float>(&cache_tensor);
+  for (int i = 0; i < 12; i++) {
+    w_data[i] = static_cast<float>(i % 5) - 2.f;
+    cache_data[i] = w_data[i];
+  }
+  pir::SaveCombineFunction({&w_tensor, &cache_tensor},
+                           {"w", "cache"},
+                           dir + "/model.pdiparams",
+                           true,
+                           false,
+                           false);
+  return std::vector<float>(w_data, w_data + 12);
+}
+
+// Runs the model of WriteModelWithCache with y filled with ones, and checks
+// out and the cache of the run-th run.
+void RunWithCache(Predictor* predictor, const std::vector<float>& w, int run) {
+  std::vector<float> x(8), y(12, 1.f);
+  for (size_t i = 0; i < x.size(); i++) {
+    x[i] = static_cast<float>(i) / 4.f - 1.f;
+  }
+  auto x_input = predictor->GetInputHandle("x");
+  x_input->Reshape({2, 4});
+  x_input->CopyFromCpu(x.data());
+  auto y_input = predictor->GetInputHandle("y");
+  y_input->Reshape({4, 3});
+  y_input->CopyFromCpu(y.data());
+  ASSERT_TRUE(predictor->Run());
+
+  auto output_names = predictor->GetOutputNames();
+  ASSERT_EQ(output_names.size(), 2UL);
+  std::vector<float> out(6), cache(12);
+  predictor->GetOutputHandle(output_names[0])->CopyToCpu(out.data());
+  predictor->GetOutputHandle(output_names[1])->CopyToCpu(cache.data());
+  for (size_t i = 0; i < 2; i++) {
+    for (size_t j = 0; j < 3; j++) {
+      float expected = 0.f;
+      for (size_t k = 0; k < 4; k++) {
+        expected += x[i * 4 + k] * w[k * 3 + j];
+      }
+      EXPECT_FLOAT_EQ(out[i * 3 + j], std::max(expected, 0.f));
+    }
+  }
+  for (size_t i = 0; i < cache.size(); i++) {
+    EXPECT_FLOAT_EQ(cache[i], w[i] + static_cast<float>(run));
+  }
+}
+
+}  // namespace
+
+TEST(Predictor, shared_weights_skip_written) {
+  std::string dir = (std::filesystem::temp_directory_path() /
+                     ("shared_weights_test." + std::to_string(getpid())))
+                        .string();
+  std::filesystem::create_directories(dir);
+  auto w = WriteModelWithCache(dir);
+
+  Config config;
+  config.SetModel(dir + "/model.json", dir + "/model.pdiparams");
+  config.EnableNewIR(true);
+  config.EnableNewExecutor(true);
+  config.DisableGpu();
+  config.EnableSharedWeights();
+  auto first = CreatePredictor(config);
+  auto second = CreatePredictor(config);
+
+  // w is shared across the predictors, the cache the program writes is
+  // neither shared with w nor with the cache of the other predictor.
+  auto first_data = experimental::InternalUtils::GetParameterData(first.get());
+  auto second_data =
+      experimental::InternalUtils::GetParameterData(second.get());
+  ASSERT_TRUE(first_data.count("w") && first_data.count("cache"));
+  ASSERT_TRUE(second_data.count("w") && second_data.count("cache"));
+  EXPECT_EQ(first_data["w"], second_data["w"]);
+  EXPECT_NE(first_data["cache"], first_data["w"]);
+  EXPECT_NE(second_data["cache"], second_data["w"]);
+  EXPECT_NE(first_data["cache"], second_data["cache"]);
+
+  RunWithCache(first.get(), w, 1);
+  RunWithCache(first.get(), w, 2);
+  RunWithCache(second.get(), w, 1);
+
+  first.reset();
+  second.reset();
+  std::filesystem::remove_all(dir);
+}
+
+TEST(Predictor, shared_weights) {
+  auto expected = RunOnce(CreatePredictor(MakeConfig(true)).get());
+
+  // Predictors created independently with other configs share what their
+  // optimized programs have in common, and keep working when the one that
+  // registered the weights first is gone.
+  auto first = CreatePredictor(MakeConfig(true));
+  auto second = CreatePredictor(MakeConfig(true));
+  auto stat = paddle::SharedWeightRegistry::Instance().GetStat();
+  EXPECT_GT(stat.num_weights, 0UL);
+  EXPECT_GT(stat.saved_bytes, 0UL);
+  auto first_data = experimental::InternalUtils::GetParameterData(first.get());
+  auto second_data =
+      experimental::InternalUtils::GetParameterData(second.get());
+  // the parameters of the optimized program point to one copy, the scope
+  // may also hold parameters the passes dropped from the program
+  size_t shared = 0;
+  for (auto& item : second_data) {
+    auto it = first_data.find(item.first);
+    shared += it != first_data.end() && it->second == item.second;
+  }
+  EXPECT_GT(shared, 0UL);
+  auto third = CreatePredictor(MakeConfig(false));
+  auto third_expected = RunOnce(third.get());
+  first.reset();
+  auto res = RunOnce(second.get());
+  ASSERT_EQ(res.size(), expected.size());
+  for (size_t i = 0; i < res.size(); i++) {
+    EXPECT_NEAR(res[i], expected[i], 1e-5);
+  }
+  second.reset();
+  auto third_res = RunOnce(third.get());
+  for (size_t i = 0; i < third_res.size(); i++) {
+    EXPECT_NEAR(third_res[i], third_expected[i], 1e-5);
+  }
+}
+
+}  // namespace paddle_infer
@@ -16,9 +16,12 @@
 
 #include <gtest/gtest.h>
 
+#include <array>
 #include <chrono>
+#include <cmath>
 #include <iostream>
 #include <string>
+#include <vector>
 
 #include "paddle/phi/core/kernel_registry.h"
 
@@ -34,6 +37,7 @@
 #include "paddle/fluid/pir/dialect/operator/ir/op_type.h"
 
 #include "paddle/common/macros.h"
+#include "paddle/phi/core/platform/monitor.h"
 #include "paddle/pir/include/dialect/control_flow/ir/cf_dialect.h"
 #include "paddle/pir/include/dialect/control_flow/ir/cf_op.h"
 
@@ -46,6 +50,10 @@ PD_DECLARE_KERNEL(add, CPU, ALL_LAYOUT);
 PD_DECLARE_KERNEL(sqrt, CPU, ALL_LAYOUT);
 PD_DECLARE_KERNEL(less_than, CPU, ALL_LAYOUT);
 
+USE_INT_STAT(STAT_shape_plan_cache_hit);
+USE_INT_STAT(STAT_shape_plan_cache_miss);
+USE_INT_STAT(STAT_shape_plan_presized_outputs);
+
 bool simple_cmp(float a, float b) { return std::abs((a - b) / a) < 1e-5; }
 
 namespace paddle {
@@ -385,5 +393,94 @@ TEST(StandaloneExecutor, while_op) {
   EXPECT_EQ(res0, true);
 }
 
+TEST(StandaloneExecutor, shape_plan_cache) {
+  pir::IrContext* ctx = pir::IrContext::Instance();
+  pir::Program program(ctx);
+  ctx->GetOrRegisterDialect<paddle::dialect::OperatorDialect>();
+  pir::Builder builder = pir::Builder(ctx, program.block());
+
+  auto x = builder
+               .Build<paddle::dialect::DataOp>("x",
+                                               std::vector<int64_t>{-1, 4},
+                                               phi::DataType::FLOAT32,
+                                               phi::CPUPlace())
+               .result(0);
+  auto sqrt_out = builder.Build<paddle::dialect::SqrtOp>(x).result(0);
+  auto add_out = builder.Build<paddle::dialect::AddOp>(sqrt_out, x).result(0);
+  std::string out_name = "add_out";
+  builder.Build<pir::ShadowOutputOp>(add_out, out_name);
+
+  auto kernel_program = paddle::dialect::PdOpLowerToKernelPass(&program);
+
+  auto place = phi::CPUPlace();
+  Scope scope;
+  auto* x_tensor = scope.Var("x")->GetMutable<phi::DenseTensor>();
+
+  interpreter::ExecutionConfig execution_config;
+  execution_config.create_local_scope = false;
+  execution_config.used_for_inference = true;
+  execution_config.shape_plan_cache_capacity = 2;
+  execution_config.skip_gc_vars = {"x", out_name};
+  InterpreterCore test_core(
+      place, {}, kernel_program->block(), &scope, execution_config);
+
+  int64_t hit = STAT_GET(STAT_shape_plan_cache_hit);
+  int64_t miss = STAT_GET(STAT_shape_plan_cache_miss);
+  int64_t presized = STAT_GET(STAT_shape_plan_presized_outputs);
+  // the plan of 3 rows is evicted by the one of 4 rows, the last runs reuse
+  // the memory of the plan of 4 rows
+  for (int64_t rows : {2, 3, 2, 4, 3, 4, 4, 4}) {
+    x_tensor->Resize({rows, 4});
+    float* x_data = x_tensor->mutable_data<float>(place);
+    for (int64_t i = 0; i < rows * 4; ++i) {
+      x_data[i] = static_cast<float>(i + rows);
+    }
+    test_core.Run({});
+
+    auto& out = scope.FindVar(out_name)->Get<phi::DenseTensor>();
+    ASSERT_EQ(out.dims(), common::make_ddim({rows, 4}));
+    for (int64_t i = 0; i < rows * 4; ++i) {
+      float v = static_cast<float>(i + rows);
+      EXPECT_TRUE(simple_cmp(out.data<float>()[i], std::sqrt(v) + v));
+    }
+  }
+  EXPECT_EQ(STAT_GET(STAT_shape_plan_cache_hit) - hit, 4);
+  EXPECT_EQ(STAT_GET(STAT_shape_plan_cache_miss) - miss, 4);
+  // sqrt_out is the only output not leaving the run
+  EXPECT_EQ(STAT_GET(STAT_shape_plan_presized_outputs) - presized, 4);
+}
+
+TEST(StandaloneExecutor, shape_plan_layout_buffers) {
+  // (begin, end, size) in run order
+  std::vector<std::array<size_t, 3>> lifetimes = {
+      {0, 2, 100}, {1, 3, 64}, {3, 4, 128}, {4, 5, 32}};
+  std::vector<interpreter::ShapePlanBuffer> buffers(lifetimes.size());
+  for (size_t i = 0; i < lifetimes.size(); ++i) {
+    buffers[i].begin = lifetimes[i][0];
+    buffers[i].end = lifetimes[i][1];
+    buffers[i].size = lifetimes[i][2];
+  }
+  size_t memory_size = interpreter::ShapePlanCache::LayoutBuffers(&buffers);
+
+  // buffer 0 is padded to 128 bytes, buffer 2 takes its place once it is
+  // released, buffer 3 the place of buffer 1
+  EXPECT_EQ(buffers[0].offset, 0UL);
+  EXPECT_EQ(buffers[0].size, 128UL);
+  EXPECT_EQ(buffers[1].offset, 128UL);
+  EXPECT_EQ(buffers[2].offset, 0UL);
+  EXPECT_EQ(buffers[2].overlaps, std::vector<size_t>({0}));
+  EXPECT_EQ(buffers[3].offset, 128UL);
+  EXPECT_EQ(buffers[3].overlaps, std::vector<size_t>({1}));
+  EXPECT_EQ(memory_size, 192UL);
+  for (size_t i = 0; i < buffers.size(); ++i) {
+    for (size_t j = i + 1; j < buffers.size(); ++j) {
+      bool alive = buffers[i].end >= buffers[j].begin;
+      bool share = buffers[i].offset < buffers[j].offset + buffers[j].size &&
+                   buffers[j].offset < buffers[i].offset + buffers[i].size;
+      EXPECT_FALSE(alive && share);
+    }
+  }
+}
+
 }  // namespace framework
 }  // namespace paddle
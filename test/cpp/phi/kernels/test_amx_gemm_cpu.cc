@@ -0,0 +1,164 @@
+// Copyright (c) 2025 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "glog/logging.h"
+#include "paddle/phi/backends/context_pool.h"
+#include "paddle/phi/backends/cpu/cpu_context.h"
+#include "paddle/phi/core/dense_tensor.h"
+#include "paddle/phi/kernels/funcs/amx_gemm.h"
+
+namespace phi {
+namespace tests {
+
+namespace {
+
+using funcs::AmxActivation;
+using funcs::AmxGemmType;
+
+std::vector<float> RandomData(int64_t size, std::mt19937* gen) {
+  std::uniform_real_distribution<float> dist(-1.f, 1.f);
+  std::vector<float> data(size);
+  for (auto& v : data) {
+    v = dist(*gen);
+  }
+  return data;
+}
+
+// The values the GEMM multiplies: rounded to bf16, or quantized to int8
+// with the scale of the values of each of the `count` vectors of `size`
+// values `stride` apart.
+std::vector<float> Emulate(const std::vector<float>& data,
+                           AmxGemmType type,
+                           int64_t count,
+                           int64_t size,
+                           int64_t stride,
+                           int64_t step) {
+  std::vector<float> emulated(data.size());
+  for (int64_t v = 0; v < count; ++v) {
+    float max_abs = 0.f;
+    for (int64_t i = 0; i < size; ++i) {
+      max_abs = std::max(max_abs, std::abs(data[v * step + i * stride]));
+    }
+    const float scale = max_abs / 127.f;
+    const float inv_scale = max_abs > 0.f ? 1.f / scale : 0.f;
+    for (int64_t i = 0; i < size; ++i) {
+      const int64_t idx = v * step + i * stride;
+      if (type == AmxGemmType::kBF16) {
+        emulated[idx] = static_cast<float>(phi::dtype::bfloat16(data[idx]));
+      } else {
+        emulated[idx] = std::nearbyint(data[idx] * inv_scale) * scale;
+      }
+    }
+  }
+  return emulated;
+}
+
+void CheckAmxGemm(AmxGemmType type,
+                  AmxActivation act,
+                  int64_t m,
+                  int64_t k,
+                  int64_t n) {
+  std::mt19937 gen(m * 10000 + k * 100 + n);
+  auto x = RandomData(m * k, &gen);
+  auto w = RandomData(k * n, &gen);
+  auto bias = RandomData(n, &gen);
+  auto packed = funcs::AmxPackWeight(w.data(), k, n, type);
+  std::vector<float> out(m * n);
+  funcs::AmxGemmParam param{
+      x.data(), packed.get(), bias.data(), act, out.data(), m};
+  funcs::AmxGemm(param);
+
+  // rows of x, columns of w
+  auto x_emulated = Emulate(x, type, m, k, 1, k);
+  auto w_emulated = Emulate(w, type, n, k, n, 1);
+  for (int64_t i = 0; i < m; ++i) {
+    for (int64_t j = 0; j < n; ++j) {
+      double expected = bias[j], exact = bias[j];
+      for (int64_t l = 0; l < k; ++l) {
+        expected += x_emulated[i * k + l] * w_emulated[l * n + j];
+        exact += x[i * k + l] * w[l * n + j];
+      }
+      if (act == AmxActivation::kRelu) {
+        expected = std::max(expected, 0.);
+        exact = std::max(exact, 0.);
+      } else if (act == AmxActivation::kGelu) {
+        expected = 0.5 * expected * (1. + std::erf(expected / std::sqrt(2.)));
+        exact = 0.5 * exact * (1. + std::erf(exact / std::sqrt(2.)));
+      }
+      ASSERT_NEAR(out[i * n + j], expected, 1e-3)
+          << "m " << m << " k " << k << " n " << n << " at " << i << ", "
+          << j;
+      ASSERT_NEAR(out[i * n + j], exact, 0.1);
+    }
+  }
+}
+
+}  // namespace
+
+TEST(AmxGemmCPU, BF16) {
+  LOG(INFO) << "AMX bf16 available: "
+            << funcs::AmxGemmAvailable(AmxGemmType::kBF16);
+  // shapes padded in every dimension, and the blocks of 2x2 tiles
+  for (int64_t m : {1, 17, 40}) {
+    for (int64_t k : {7, 96}) {
+      for (int64_t n : {5, 48, 80}) {
+        CheckAmxGemm(AmxGemmType::kBF16, AmxActivation::kNone, m, k, n);
+      }
+    }
+  }
+  CheckAmxGemm(AmxGemmType::kBF16, AmxActivation::kRelu, 33, 64, 40);
+  CheckAmxGemm(AmxGemmType::kBF16, AmxActivation::kGelu, 33, 64, 40);
+}
+
+TEST(AmxGemmCPU, Int8) {
+  LOG(INFO) << "AMX int8 available: "
+            << funcs::AmxGemmAvailable(AmxGemmType::kInt8);
+  for (int64_t m : {1, 17, 40}) {
+    for (int64_t k : {7, 130}) {
+      for (int64_t n : {5, 48, 80}) {
+        CheckAmxGemm(AmxGemmType::kInt8, AmxActivation::kNone, m, k, n);
+      }
+    }
+  }
+  CheckAmxGemm(AmxGemmType::kInt8, AmxActivation::kRelu, 33, 64, 40);
+}
+
+TEST(AmxGemmCPU, PackedWeightCache) {
+  auto* dev_ctx = static_cast<phi::CPUContext*>(
+      phi::DeviceContextPool::Instance().Get(phi::CPUPlace()));
+  phi::DenseTensor w;
+  w.Resize({64, 32});
+  std::fill_n(dev_ctx->template Alloc<float>(&w), w.numel(), 1.f);
+  auto packed = funcs::GetAmxPackedWeight(w, AmxGemmType::kBF16);
+  EXPECT_EQ(funcs::GetAmxPackedWeight(w, AmxGemmType::kBF16), packed);
+  EXPECT_NE(funcs::GetAmxPackedWeight(w, AmxGemmType::kInt8), nullptr);
+
+  // another allocation is packed again
+  phi::DenseTensor other;
+  other.Resize({64, 32});
+  std::fill_n(dev_ctx->template Alloc<float>(&other), other.numel(), 2.f);
+  auto other_packed = funcs::GetAmxPackedWeight(other, AmxGemmType::kBF16);
+  EXPECT_NE(other_packed, packed);
+  EXPECT_EQ(static_cast<float>(other_packed->bf16[0]), 2.f);
+}
+
+}  // namespace tests
+}  // namespace phi
@@ -0,0 +1,199 @@
+// Copyright (c) 2025 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "paddle/phi/kernels/funcs/cpu_attention.h"
+
+namespace phi {
+namespace tests {
+
+namespace {
+
+std::vector<float> RandomData(int64_t size, int seed) {
+  std::mt19937 gen(seed);
+  std::uniform_real_distribution<float> dist(-1.f, 1.f);
+  std::vector<float> data(size);
+  for (auto& v : data) {
+    v = dist(gen);
+  }
+  return data;
+}
+
+// Softmax of the scores of each query over all of its keys at once. The
+// causal mask is the one of the CUTLASS kernel of
+// variable_length_memory_efficient_attention, which masks out the key
+// columns after the query row, both counted from the start of the sequence.
+std::vector<float> ReferenceAttention(const funcs::AttentionParams& p,
+                                      const std::vector<float>& query,
+                                      const std::vector<float>& key,
+                                      const std::vector<float>& value,
+                                      const float* mask,
+                                      int64_t max_kv_len) {
+  const int64_t D = p.head_size;
+  const int64_t Dv = p.value_head_size;
+  std::vector<float> out(
+      p.batch_size * p.num_heads * p.max_query_len * Dv, 0.f);
+  for (int64_t b = 0; b < p.batch_size; ++b) {
+    const int64_t q_len = p.seq_lens[b];
+    const int64_t kv_len = p.kv_seq_lens[b] + p.pre_cache_length;
+    for (int64_t h = 0; h < p.num_heads; ++h) {
+      const int64_t kv_h = h / (p.num_heads / p.kv_num_heads);
+      for (int64_t i = 0; i < q_len; ++i) {
+        const float* q = &query[((b * p.num_heads + h) * p.max_query_len + i) *
+                                D];
+        std::vector<double> s(kv_len, -INFINITY);
+        double max = -INFINITY;
+        for (int64_t j = 0; j < kv_len; ++j) {
+          if (p.causal && j > i) {
+            continue;
+          }
+          const float* k = &key[((b * p.kv_num_heads + kv_h) * max_kv_len + j) *
+                                D];
+          double dot = 0;
+          for (int64_t d = 0; d < D; ++d) {
+            dot += q[d] * k[d];
+          }
+          s[j] = dot * p.scale;
+          if (mask != nullptr) {
+            int64_t mh = p.mask_num_heads == 1 ? 0 : h;
+            s[j] += mask[((b * p.mask_num_heads + mh) * p.mask_rows + i) *
+                             p.mask_cols +
+                         j];
+          }
+          max = std::max(max, s[j]);
+        }
+        if (max == -INFINITY) {
+          continue;
+        }
+        double sum = 0;
+        for (int64_t j = 0; j < kv_len; ++j) {
+          s[j] = std::exp(s[j] - max);
+          sum += s[j];
+        }
+        float* o = &out[((b * p.num_heads + h) * p.max_query_len + i) * Dv];
+        for (int64_t j = 0; j < kv_len; ++j) {
+          const float* v =
+              &value[((b * p.kv_num_heads + kv_h) * max_kv_len + j) * Dv];
+          for (int64_t d = 0; d < Dv; ++d) {
+            o[d] += s[j] / sum * v[d];
+          }
+        }
+      }
+    }
+  }
+  return out;
+}
+
+void CheckAttention(const std::vector<int>& seq_lens,
+                    const std::vector<int>& kv_seq_lens,
+                    int pre_cache_length,
+                    int64_t num_heads,
+                    int64_t kv_num_heads,
+                    bool causal,
+                    bool with_mask) {
+  funcs::AttentionParams p;
+  p.batch_size = static_cast<int64_t>(seq_lens.size());
+  p.num_heads = num_heads;
+  p.kv_num_heads = kv_num_heads;
+  p.max_query_len = *std::max_element(seq_lens.begin(), seq_lens.end()) + 3;
+  p.head_size = 40;
+  p.value_head_size = 24;
+  p.seq_lens = seq_lens.data();
+  p.kv_seq_lens = kv_seq_lens.data();
+  p.pre_cache_length = pre_cache_length;
+  p.scale = 1.f / std::sqrt(40.f);
+  p.causal = causal;
+  const int64_t max_kv_len =
+      *std::max_element(kv_seq_lens.begin(), kv_seq_lens.end()) +
+      pre_cache_length + 5;
+
+  auto query =
+      RandomData(p.batch_size * num_heads * p.max_query_len * p.head_size, 1);
+  auto key =
+      RandomData(p.batch_size * kv_num_heads * max_kv_len * p.head_size, 2);
+  auto value = RandomData(
+      p.batch_size * kv_num_heads * max_kv_len * p.value_head_size, 3);
+  std::vector<float> mask;
+  if (with_mask) {
+    p.mask_num_heads = num_heads;
+    p.mask_rows = p.max_query_len;
+    p.mask_cols = max_kv_len;
+    mask = RandomData(p.batch_size * num_heads * p.mask_rows * p.mask_cols, 4);
+    // a masked key in each row
+    for (size_t i = 0; i < mask.size(); i += 7) {
+      mask[i] = -std::numeric_limits<float>::infinity();
+    }
+  }
+  const float* mask_data = with_mask ? mask.data() : nullptr;
+
+  std::vector<float> out(p.batch_size * num_heads * p.max_query_len *
+                             p.value_head_size,
+                         std::nanf(""));
+  funcs::DenseKVCache<float> cache{key.data(),
+                                   value.data(),
+                                   kv_num_heads,
+                                   max_kv_len,
+                                   p.head_size,
+                                   p.value_head_size};
+  funcs::VarlenAttention(p, query.data(), cache, mask_data, out.data());
+  auto expected =
+      ReferenceAttention(p, query, key, value, mask_data, max_kv_len);
+  for (size_t i = 0; i < out.size(); ++i) {
+    ASSERT_NEAR(out[i], expected[i], 1e-5)
+        << "at " << i << " causal " << causal << " mask " << with_mask
+        << " pre cache " << pre_cache_length;
+  }
+}
+
+}  // namespace
+
+TEST(CPUAttention, VariableLength) {
+  // sequences shorter and longer than a block, and an empty one
+  std::vector<int> seq_lens = {1, 37, 0, 130, 64};
+  for (bool causal : {false, true}) {
+    for (bool with_mask : {false, true}) {
+      CheckAttention(seq_lens, seq_lens, 0, 4, 4, causal, with_mask);
+      CheckAttention(seq_lens, seq_lens, 0, 6, 2, causal, with_mask);
+    }
+  }
+}
+
+TEST(CPUAttention, PreCache) {
+  // prefill after a cached prefix, and decoding of one token per sequence
+  std::vector<int> seq_lens = {20, 75, 3};
+  std::vector<int> decode_lens = {1, 1, 1};
+  for (bool causal : {false, true}) {
+    CheckAttention(seq_lens, seq_lens, 50, 4, 2, causal, false);
+    CheckAttention(decode_lens, decode_lens, 300, 4, 1, causal, true);
+  }
+}
+
+TEST(CPUAttention, CausalAlignment) {
+  // query i sees the keys up to i, also when the keys of a sequence are
+  // fewer or more than its queries
+  std::vector<int> seq_lens = {40, 3, 100};
+  std::vector<int> kv_seq_lens = {10, 70, 100};
+  CheckAttention(seq_lens, kv_seq_lens, 0, 4, 2, true, false);
+  CheckAttention(seq_lens, kv_seq_lens, 16, 4, 2, true, true);
+}
+
+}  // namespace tests
+}  // namespace phi
@@ -0,0 +1,127 @@
+// Copyright (c) 2025 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "paddle/phi/backends/context_pool.h"
+#include "paddle/phi/backends/cpu/cpu_context.h"
+#include "paddle/phi/core/dense_tensor.h"
+#include "paddle/phi/kernels/funcs/fc_functor.h"
+#include "paddle/phi/kernels/funcs/packed_weight_cache.h"
+
+namespace phi {
+namespace tests {
+
+namespace {
+
+struct Packed {
+  float first;
+};
+
+}  // namespace
+
+TEST(PackedWeightCache, PackOncePerAllocation) {
+  auto* dev_ctx = static_cast<phi::CPUContext*>(
+      phi::DeviceContextPool::Instance().Get(phi::CPUPlace()));
+  auto& cache = funcs::PackedWeightCache::Instance();
+  int packs = 0;
+  auto pack = [&packs](const DenseTensor& w) {
+    return [&packs, &w]() {
+      ++packs;
+      return std::make_unique<Packed>(Packed{w.data<float>()[0]});
+    };
+  };
+
+  auto w = std::make_unique<DenseTensor>();
+  w->Resize({4, 8});
+  std::fill_n(dev_ctx->template Alloc<float>(w.get()), w->numel(), 1.f);
+  auto packed = cache.Get<Packed>(*w, "test", pack(*w));
+  EXPECT_EQ(cache.Get<Packed>(*w, "test", pack(*w)), packed);
+  EXPECT_EQ(packs, 1);
+  // another form of the same weight
+  EXPECT_NE(cache.Get<Packed>(*w, "other", pack(*w)), packed);
+  EXPECT_EQ(packs, 2);
+
+  // a copy shares the allocation
+  DenseTensor copy(*w);
+  EXPECT_EQ(cache.Get<Packed>(copy, "test", pack(copy)), packed);
+  EXPECT_EQ(packs, 2);
+
+  // another allocation is packed again, and the two forms of a freed one
+  // are dropped without packing anything else
+  DenseTensor other;
+  other.Resize({4, 8});
+  std::fill_n(dev_ctx->template Alloc<float>(&other), other.numel(), 2.f);
+  EXPECT_EQ(cache.Get<Packed>(other, "test", pack(other))->first, 2.f);
+  EXPECT_EQ(packs, 3);
+  const size_t size = cache.size();
+  w.reset();
+  copy = DenseTensor();
+  EXPECT_EQ(cache.size(), size - 2);
+  EXPECT_EQ(packs, 3);
+  // the packed form stays valid for the callers holding it
+  EXPECT_EQ(packed->first, 1.f);
+}
+
+#ifdef PADDLE_WITH_MKLML
+TEST(FCPackedWeight, SameAsFC) {
+  auto* dev_ctx = static_cast<phi::CPUContext*>(
+      phi::DeviceContextPool::Instance().Get(phi::CPUPlace()));
+  std::mt19937 gen(0);
+  std::uniform_real_distribution<float> dist(-1.f, 1.f);
+  for (bool padding_weights : {false, true}) {
+    const int M = 37, K = 65, N = 129;
+    const int pad = padding_weights ? 4 : 0;
+    DenseTensor w;
+    w.Resize({K + pad, N + pad});
+    float* w_data = dev_ctx->template Alloc<float>(&w);
+    std::generate_n(w_data, w.numel(), [&]() { return dist(gen); });
+    std::vector<float> x(M * K), bias(N);
+    std::generate(x.begin(), x.end(), [&]() { return dist(gen); });
+    std::generate(bias.begin(), bias.end(), [&]() { return dist(gen); });
+
+    for (bool relu : {false, true}) {
+      std::vector<float> expected(M * N), out(M * N);
+      funcs::FCFunctor<phi::CPUContext, float> fc;
+      fc(*dev_ctx,
+         M,
+         N,
+         K,
+         x.data(),
+         w_data,
+         expected.data(),
+         bias.data(),
+         relu,
+         padding_weights);
+      auto packed =
+          funcs::GetFCPackedWeight<float>(*dev_ctx, w, padding_weights);
+      EXPECT_EQ(funcs::GetFCPackedWeight<float>(*dev_ctx, w, padding_weights),
+                packed);
+      funcs::FCPacked<float>(
+          *dev_ctx, M, x.data(), *packed, out.data(), bias.data(), relu);
+      for (int i = 0; i < M * N; ++i) {
+        ASSERT_NEAR(out[i], expected[i], 1e-4) << "at " << i;
+      }
+    }
+  }
+}
+#endif
+
+}  // namespace tests
+}  // namespace phi
@@ -0,0 +1,167 @@
+// Copyright (c) 2025 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <vector>
+
+#include "paddle/phi/kernels/funcs/cpu_gather_scatter.h"
+
+namespace phi {
+namespace tests {
+
+namespace {
+
+// Indices in [-rows, rows), with duplicates.
+template <typename IndexT>
+std::vector<IndexT> RandomIndex(int64_t size, int64_t rows, int seed) {
+  std::mt19937 gen(seed);
+  std::uniform_int_distribution<int64_t> dist(-rows, rows - 1);
+  std::vector<IndexT> index(size);
+  for (auto& i : index) {
+    i = static_cast<IndexT>(dist(gen));
+  }
+  return index;
+}
+
+template <typename T>
+std::vector<T> RandomData(int64_t size, int seed) {
+  std::mt19937 gen(seed);
+  std::uniform_int_distribution<int> dist(-100, 100);
+  std::vector<T> data(size);
+  for (auto& v : data) {
+    v = static_cast<T>(dist(gen));
+  }
+  return data;
+}
+
+template <typename T, typename IndexT>
+void CheckGather(int64_t outer, int64_t rows, int64_t size, int64_t slice) {
+  auto src = RandomData<T>(outer * rows * slice, 1);
+  auto index = RandomIndex<IndexT>(size, rows, 2);
+  std::vector<T> out(outer * size * slice);
+  funcs::GatherRows(
+      src.data(), outer, rows, index.data(), size, slice, out.data());
+  for (int64_t o = 0; o < outer; ++o) {
+    for (int64_t i = 0; i < size; ++i) {
+      int64_t row = index[i] < 0 ? index[i] + rows : index[i];
+      for (int64_t j = 0; j < slice; ++j) {
+        ASSERT_EQ(out[(o * size + i) * slice + j],
+                  src[(o * rows + row) * slice + j])
+            << "outer " << outer << " size " << size << " slice " << slice;
+      }
+    }
+  }
+}
+
+template <typename T, typename IndexT>
+void CheckScatter(int64_t outer,
+                  int64_t rows,
+                  int64_t size,
+                  int64_t slice,
+                  bool overwrite,
+                  bool reset) {
+  auto src = RandomData<T>(outer * size * slice, 3);
+  auto index = RandomIndex<IndexT>(size, rows, 4);
+  auto dst = RandomData<T>(outer * rows * slice, 5);
+  auto expected = dst;
+  // the serial loop
+  for (int64_t o = 0; o < outer; ++o) {
+    if (reset && !overwrite) {
+      for (int64_t i = 0; i < size; ++i) {
+        int64_t row = index[i] < 0 ? index[i] + rows : index[i];
+        std::fill_n(&expected[(o * rows + row) * slice], slice, T(0));
+      }
+    }
+    for (int64_t i = 0; i < size; ++i) {
+      int64_t row = index[i] < 0 ? index[i] + rows : index[i];
+      for (int64_t j = 0; j < slice; ++j) {
+        T& value = expected[(o * rows + row) * slice + j];
+        T update = src[(o * size + i) * slice + j];
+        value = overwrite ? update : value + update;
+      }
+    }
+  }
+  funcs::ScatterRows(src.data(),
+                     outer,
+                     rows,
+                     index.data(),
+                     size,
+                     slice,
+                     overwrite,
+                     reset,
+                     dst.data());
+  EXPECT_EQ(dst, expected) << "outer " << outer << " size " << size
+                           << " slice " << slice;
+}
+
+}  // namespace
+
+TEST(GatherScatterCPU, Gather) {
+  // slice 1 takes the vector gather of the elements when available
+  for (int64_t slice : {1, 3, 64}) {
+    CheckGather<float, int32_t>(1, 100, 1000, slice);
+    CheckGather<float, int64_t>(3, 100, 1000, slice);
+    CheckGather<double, int32_t>(2, 50, 777, slice);
+    CheckGather<double, int64_t>(1, 50, 20000, slice);
+    CheckGather<uint8_t, int64_t>(2, 50, 500, slice);
+  }
+}
+
+TEST(GatherScatterCPU, Scatter) {
+  // small scatters run the serial loop, large ones reduce segments
+  for (int64_t size : {10, 5000}) {
+    for (bool overwrite : {true, false}) {
+      for (bool reset : {true, false}) {
+        CheckScatter<float, int32_t>(1, 300, size, 16, overwrite, reset);
+        CheckScatter<double, int64_t>(2, 300, size, 8, overwrite, reset);
+        CheckScatter<int64_t, int64_t>(3, 40, size, 1, overwrite, reset);
+      }
+    }
+  }
+}
+
+TEST(GatherScatterCPU, IndexSegments) {
+  const int64_t rows = 100000;
+  auto index = RandomIndex<int64_t>(20000, 300, 8);
+  for (auto& i : index) {
+    // spread the rows over three bytes
+    i = i * 331 % rows;
+  }
+  std::vector<int64_t> order, segments;
+  funcs::IndexSegments(index.data(),
+                       static_cast<int64_t>(index.size()),
+                       rows,
+                       &order,
+                       &segments);
+  ASSERT_EQ(order.size(), index.size());
+  auto row_of = [&](int64_t i) {
+    return index[order[i]] < 0 ? index[order[i]] + rows : index[order[i]];
+  };
+  for (size_t s = 0; s < segments.size(); ++s) {
+    int64_t end = s + 1 < segments.size() ? segments[s + 1] : order.size();
+    if (s > 0) {
+      EXPECT_LT(row_of(segments[s - 1]), row_of(segments[s]));
+    }
+    for (int64_t i = segments[s] + 1; i < end; ++i) {
+      // same row, positions in the order of index
+      EXPECT_EQ(row_of(i), row_of(segments[s]));
+      EXPECT_LT(order[i - 1], order[i]);
+    }
+  }
+}
+
+}  // namespace tests
+}  // namespace phi
@@ -0,0 +1,84 @@
+// Copyright (c) 2025 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "glog/logging.h"
+#include "paddle/phi/kernels/funcs/cpu_gather_scatter.h"
+#include "test/cpp/phi/core/timer.h"
+
+namespace phi {
+namespace tests {
+
+namespace {
+
+// Indices in [-rows, rows), with duplicates.
+std::vector<int64_t> RandomIndex(int64_t size, int64_t rows, int seed) {
+  std::mt19937 gen(seed);
+  std::uniform_int_distribution<int64_t> dist(-rows, rows - 1);
+  std::vector<int64_t> index(size);
+  for (auto& i : index) {
+    i = dist(gen);
+  }
+  return index;
+}
+
+std::vector<float> RandomData(int64_t size, int seed) {
+  std::mt19937 gen(seed);
+  std::uniform_real_distribution<float> dist(-1.f, 1.f);
+  std::vector<float> data(size);
+  for (auto& v : data) {
+    v = dist(gen);
+  }
+  return data;
+}
+
+}  // namespace
+
+// Compares GatherRows with the memcpy loop of the former kernel, built by
+// test_gather_scatter_cpu_benchmark and not run by ctest.
+TEST(GatherScatterCPU, Benchmark) {
+  Timer timer;
+  const int64_t rows = 1 << 20;
+  const int64_t size = 1 << 16;
+  auto index = RandomIndex(size, rows, 6);
+  for (int64_t slice : {1, 16, 128}) {
+    auto src = RandomData(rows * slice, 7);
+    std::vector<float> out(size * slice);
+    timer.tic();
+    funcs::GatherRows(
+        src.data(), 1, rows, index.data(), size, slice, out.data());
+    double t_gather = timer.toc();
+
+    // the former kernel: a memcpy per row on one thread
+    timer.tic();
+    for (int64_t i = 0; i < size; ++i) {
+      int64_t row = index[i] < 0 ? index[i] + rows : index[i];
+      std::memcpy(out.data() + i * slice,
+                  src.data() + row * slice,
+                  slice * sizeof(float));
+    }
+    double t_memcpy = timer.toc();
+    LOG(INFO) << "gather of " << size << " rows of " << slice
+              << " floats: " << t_gather << "ms, memcpy loop: " << t_memcpy
+              << "ms.";
+  }
+}
+
+}  // namespace tests
+}  // namespace phi
@@ -0,0 +1,171 @@
+// Copyright (c) 2025 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "paddle/phi/kernels/funcs/paged_kv_cache.h"
+#include "test/cpp/phi/core/allocator.h"
+
+namespace phi {
+namespace tests {
+
+namespace {
+
+std::vector<float> RandomData(int64_t size, int seed) {
+  std::mt19937 gen(seed);
+  std::uniform_real_distribution<float> dist(-1.f, 1.f);
+  std::vector<float> data(size);
+  for (auto& v : data) {
+    v = dist(gen);
+  }
+  return data;
+}
+
+// Checks the keys of sequence b of `cache` against the tokens of `expected`,
+// [kv_num_heads, length, head_size].
+void CheckKeys(const funcs::BlockKVCache<float>& cache,
+               int64_t b,
+               const std::vector<float>& expected,
+               int64_t length) {
+  for (int64_t h = 0; h < cache.kv_num_heads; ++h) {
+    for (int64_t t = 0; t < length; ++t) {
+      const float* key = cache.Key(b, h, t);
+      for (int64_t d = 0; d < cache.head_size; ++d) {
+        ASSERT_EQ(key[d], expected[(h * length + t) * cache.head_size + d])
+            << "sequence " << b << " head " << h << " token " << t;
+      }
+    }
+  }
+}
+
+// Token t of the [heads, tokens, head_size] data, as [heads, head_size].
+std::vector<float> Token(const std::vector<float>& data,
+                         int64_t heads,
+                         int64_t tokens,
+                         int64_t head_size,
+                         int64_t t) {
+  std::vector<float> token(heads * head_size);
+  for (int64_t h = 0; h < heads; ++h) {
+    std::copy_n(&data[(h * tokens + t) * head_size],
+                head_size,
+                &token[h * head_size]);
+  }
+  return token;
+}
+
+}  // namespace
+
+TEST(PagedKVCache, AppendAndFork) {
+  FancyAllocator allocator;
+  const int64_t heads = 2, block_size = 4, head_size = 3, tokens = 12;
+  funcs::PagedKVCache<float> cache(
+      &allocator, 8, heads, block_size, head_size, head_size);
+  auto data = RandomData(heads * tokens * head_size, 1);
+
+  // 6 tokens of the prompt in one append, strided as in a [heads, tokens,
+  // head_size] tensor
+  int a = cache.AddSequence();
+  cache.Append(a, data.data(), data.data(), 6, tokens);
+  EXPECT_EQ(cache.Length(a), 6);
+  EXPECT_EQ(cache.NumFreeBlocks(), 6);
+
+  // the beams share the two blocks of the prompt
+  int b = cache.ForkSequence(a);
+  EXPECT_EQ(cache.NumFreeBlocks(), 6);
+  auto other = RandomData(heads * tokens * head_size, 2);
+  for (int64_t t = 6; t < tokens; ++t) {
+    auto token_a = Token(data, heads, tokens, head_size, t);
+    auto token_b = Token(other, heads, tokens, head_size, t);
+    cache.Append(a, token_a.data(), token_a.data(), 1, 1);
+    cache.Append(b, token_b.data(), token_b.data(), 1, 1);
+  }
+  // the full block of the prompt stays shared, the first beam has copied the
+  // half filled one and each beam has filled a block of its own
+  EXPECT_EQ(cache.NumFreeBlocks(), 8 - 1 - 2 * 2);
+
+  std::vector<float> expected_b = data;
+  for (int64_t h = 0; h < heads; ++h) {
+    for (int64_t t = 6; t < tokens; ++t) {
+      std::copy_n(&other[(h * tokens + t) * head_size],
+                  head_size,
+                  &expected_b[(h * tokens + t) * head_size]);
+    }
+  }
+  std::vector<int> block_tables;
+  auto view = cache.View({a, b}, &block_tables);
+  CheckKeys(view, 0, data, tokens);
+  CheckKeys(view, 1, expected_b, tokens);
+
+  cache.ReleaseSequence(a);
+  EXPECT_EQ(cache.NumFreeBlocks(), 8 - 3);
+  view = cache.View({b}, &block_tables);
+  CheckKeys(view, 0, expected_b, tokens);
+  cache.ReleaseSequence(b);
+  EXPECT_EQ(cache.NumFreeBlocks(), 8);
+  ASSERT_ANY_THROW(cache.Length(b));
+}
+
+TEST(PagedKVCache, Attention) {
+  FancyAllocator allocator;
+  const int64_t batch = 3, heads = 4, kv_heads = 2, head_size = 32;
+  const int64_t max_len = 70;
+  std::vector<int> lens = {70, 1, 33};
+  funcs::PagedKVCache<float> cache(
+      &allocator, 64, kv_heads, 16, head_size, head_size);
+  auto key = RandomData(batch * kv_heads * max_len * head_size, 3);
+  auto value = RandomData(batch * kv_heads * max_len * head_size, 4);
+  std::vector<int> seqs;
+  for (int64_t b = 0; b < batch; ++b) {
+    seqs.push_back(cache.AddSequence());
+    const int64_t offset = b * kv_heads * max_len * head_size;
+    cache.Append(seqs[b], &key[offset], &value[offset], lens[b], max_len);
+  }
+
+  // the last token of each sequence attends to the whole cache
+  funcs::AttentionParams p;
+  p.batch_size = batch;
+  p.num_heads = heads;
+  p.kv_num_heads = kv_heads;
+  p.max_query_len = 1;
+  p.head_size = head_size;
+  p.value_head_size = head_size;
+  std::vector<int> query_lens(batch, 1);
+  p.seq_lens = query_lens.data();
+  p.kv_seq_lens = lens.data();
+  p.scale = 0.2f;
+  auto query = RandomData(batch * heads * head_size, 5);
+  const float* no_mask = nullptr;
+
+  std::vector<int> block_tables;
+  std::vector<float> paged(batch * heads * head_size);
+  funcs::VarlenAttention(p,
+                         query.data(),
+                         cache.View(seqs, &block_tables),
+                         no_mask,
+                         paged.data());
+  std::vector<float> dense(batch * heads * head_size);
+  funcs::DenseKVCache<float> dense_cache{
+      key.data(), value.data(), kv_heads, max_len, head_size, head_size};
+  funcs::VarlenAttention(p, query.data(), dense_cache, no_mask, dense.data());
+  for (size_t i = 0; i < dense.size(); ++i) {
+    ASSERT_FLOAT_EQ(paged[i], dense[i]);
+  }
+}
+
+}  // namespace tests
+}  // namespace phi
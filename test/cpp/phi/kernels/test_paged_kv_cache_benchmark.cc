@@ -0,0 +1,125 @@
+// Copyright (c) 2025 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "glog/logging.h"
+#include "paddle/phi/kernels/funcs/paged_kv_cache.h"
+#include "test/cpp/phi/core/allocator.h"
+#include "test/cpp/phi/core/timer.h"
+
+namespace phi {
+namespace tests {
+
+namespace {
+
+std::vector<float> RandomData(int64_t size, int seed) {
+  std::mt19937 gen(seed);
+  std::uniform_real_distribution<float> dist(-1.f, 1.f);
+  std::vector<float> data(size);
+  for (auto& v : data) {
+    v = dist(gen);
+  }
+  return data;
+}
+
+}  // namespace
+
+// Compares decoding with the paged cache and with the past concatenated at
+// each step, built by test_paged_kv_cache_benchmark and not run by ctest.
+TEST(PagedKVCache, DecodeBenchmark) {
+  FancyAllocator allocator;
+  const int64_t batch = 8, heads = 8, head_size = 64;
+  const int64_t prompt = 128, steps = 256;
+  const int64_t row = heads * head_size;
+  funcs::AttentionParams p;
+  p.batch_size = batch;
+  p.num_heads = heads;
+  p.kv_num_heads = heads;
+  p.max_query_len = 1;
+  p.head_size = head_size;
+  p.value_head_size = head_size;
+  p.scale = 0.125f;
+  std::vector<int> query_lens(batch, 1);
+  std::vector<int> lens(batch, prompt);
+  p.seq_lens = query_lens.data();
+  p.kv_seq_lens = lens.data();
+  auto query = RandomData(batch * row, 6);
+  auto token = RandomData(batch * row, 7);
+  auto prefix = RandomData(batch * heads * prompt * head_size, 8);
+  std::vector<float> out(batch * row);
+  const float* no_mask = nullptr;
+  Timer timer;
+
+  timer.tic();
+  const int64_t num_blocks = batch * (prompt + steps) / 16 + batch;
+  funcs::PagedKVCache<float> cache(
+      &allocator, num_blocks, heads, 16, head_size, head_size);
+  std::vector<int> seqs;
+  for (int64_t b = 0; b < batch; ++b) {
+    seqs.push_back(cache.AddSequence());
+    const float* k = &prefix[b * heads * prompt * head_size];
+    cache.Append(seqs[b], k, k, prompt, prompt);
+  }
+  std::vector<int> block_tables;
+  for (int64_t step = 0; step < steps; ++step) {
+    for (int64_t b = 0; b < batch; ++b) {
+      cache.Append(seqs[b], &token[b * row], &token[b * row], 1, 1);
+      lens[b] = cache.Length(seqs[b]);
+    }
+    funcs::VarlenAttention(p,
+                           query.data(),
+                           cache.View(seqs, &block_tables),
+                           no_mask,
+                           out.data());
+  }
+  double t_paged = timer.toc();
+
+  // the past of every sequence is concatenated with the new token at each
+  // step, into [batch, heads, len, head_size] tensors
+  timer.tic();
+  std::vector<float> keys = prefix, values = prefix;
+  for (int64_t step = 0; step < steps; ++step) {
+    const int64_t len = prompt + step;
+    auto concat = [&](std::vector<float>* past) {
+      std::vector<float> next(batch * heads * (len + 1) * head_size);
+      for (int64_t bh = 0; bh < batch * heads; ++bh) {
+        std::copy_n(&(*past)[bh * len * head_size],
+                    len * head_size,
+                    &next[bh * (len + 1) * head_size]);
+        std::copy_n(&token[bh * head_size],
+                    head_size,
+                    &next[(bh * (len + 1) + len) * head_size]);
+      }
+      past->swap(next);
+    };
+    concat(&keys);
+    concat(&values);
+    std::fill(lens.begin(), lens.end(), len + 1);
+    funcs::DenseKVCache<float> dense{
+        keys.data(), values.data(), heads, len + 1, head_size, head_size};
+    funcs::VarlenAttention(p, query.data(), dense, no_mask, out.data());
+  }
+  double t_concat = timer.toc();
+  LOG(INFO) << "decoding " << steps << " tokens of " << batch
+            << " sequences, paged cache: " << t_paged
+            << "ms, concatenated cache: " << t_concat << "ms.";
+}
+
+}  // namespace tests
+}  // namespace phi
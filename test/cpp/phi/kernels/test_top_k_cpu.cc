@@ -0,0 +1,159 @@
+// Copyright (c) 2025 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include "paddle/phi/kernels/funcs/cpu_top_k.h"
+
+namespace phi {
+namespace tests {
+
+namespace {
+
+// The order of the former kernels: NaN is the largest value and equal values
+// keep the order of their indices.
+template <typename T>
+std::vector<int64_t> ReferenceOrder(const T* row,
+                                    int64_t width,
+                                    bool largest) {
+  std::vector<int64_t> order(width);
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(), [&](int64_t l, int64_t r) {
+    bool l_nan = std::isnan(static_cast<double>(row[l]));
+    bool r_nan = std::isnan(static_cast<double>(row[r]));
+    if (largest) {
+      return (l_nan && !r_nan) || row[l] > row[r];
+    }
+    return (!l_nan && r_nan) || row[l] < row[r];
+  });
+  return order;
+}
+
+// Few distinct values, so that most of the keys have duplicates.
+template <typename T>
+std::vector<T> RandomRows(int64_t numel, int distinct, bool with_nan) {
+  std::mt19937 gen(numel + distinct);
+  std::uniform_int_distribution<int> dist(-distinct / 2, distinct / 2);
+  std::vector<T> data(numel);
+  for (auto& v : data) {
+    v = static_cast<T>(dist(gen));
+  }
+  if (with_nan && std::numeric_limits<T>::has_quiet_NaN) {
+    for (int64_t i = 0; i < numel; i += 37) {
+      data[i] = std::numeric_limits<T>::quiet_NaN();
+    }
+  }
+  return data;
+}
+
+template <typename T>
+void CheckTopK(int64_t rows, int64_t width, int64_t k, bool with_nan) {
+  auto data = RandomRows<T>(rows * width, 1000, with_nan);
+  for (bool largest : {true, false}) {
+    std::vector<T> out(rows * k);
+    std::vector<int64_t> indices(rows * k);
+    funcs::TopKRows(
+        data.data(), rows, width, k, largest, true, out.data(), indices.data());
+    for (int64_t i = 0; i < rows; ++i) {
+      const T* row = data.data() + i * width;
+      auto order = ReferenceOrder(row, width, largest);
+      for (int64_t j = 0; j < k; ++j) {
+        ASSERT_EQ(indices[i * k + j], order[j])
+            << "width " << width << " k " << k << " largest " << largest;
+      }
+    }
+  }
+}
+
+template <typename T>
+void CheckSort(int64_t rows, int64_t width, bool with_nan) {
+  auto data = RandomRows<T>(rows * width, 100, with_nan);
+  for (bool descending : {true, false}) {
+    std::vector<T> out(rows * width);
+    std::vector<int64_t> indices(rows * width);
+    funcs::SortRows(
+        data.data(), rows, width, descending, out.data(), indices.data());
+    for (int64_t i = 0; i < rows; ++i) {
+      const T* row = data.data() + i * width;
+      auto order = ReferenceOrder(row, width, descending);
+      for (int64_t j = 0; j < width; ++j) {
+        ASSERT_EQ(indices[i * width + j], order[j])
+            << "width " << width << " descending " << descending;
+      }
+    }
+  }
+}
+
+}  // namespace
+
+TEST(TopKCPU, HeapAndRadixSelect) {
+  // small k selects with the heap, large k with the radix select
+  for (int64_t k : {1, 5, 100, 2000, 4096}) {
+    CheckTopK<float>(3, 4096, k, true);
+    CheckTopK<double>(2, 4096, k, true);
+    CheckTopK<int32_t>(2, 4096, k, false);
+    CheckTopK<int64_t>(2, 4096, k, false);
+  }
+}
+
+TEST(TopKCPU, LongRow) {
+  // a row wider than a chunk is split when there are several threads
+  CheckTopK<float>(1, 1 << 17, 10, true);
+  CheckTopK<float>(1, 1 << 17, 5000, true);
+}
+
+TEST(TopKCPU, SpecialValues) {
+  std::vector<float> row = {0.f,
+                            -0.f,
+                            std::numeric_limits<float>::infinity(),
+                            -std::numeric_limits<float>::infinity(),
+                            std::nanf(""),
+                            1.f,
+                            -1.f};
+  std::vector<float> out(row.size());
+  std::vector<int64_t> indices(row.size());
+  funcs::SortRows(row.data(),
+                  1,
+                  static_cast<int64_t>(row.size()),
+                  true,
+                  out.data(),
+                  indices.data());
+  EXPECT_EQ(indices, std::vector<int64_t>({4, 2, 5, 0, 1, 6, 3}));
+  funcs::SortRows(row.data(),
+                  1,
+                  static_cast<int64_t>(row.size()),
+                  false,
+                  out.data(),
+                  indices.data());
+  EXPECT_EQ(indices, std::vector<int64_t>({3, 6, 0, 1, 5, 2, 4}));
+}
+
+TEST(ArgsortCPU, ComparisonAndRadixSort) {
+  for (int64_t width : {1, 7, 1000, 1 << 12}) {
+    CheckSort<float>(3, width, true);
+    CheckSort<double>(2, width, true);
+    CheckSort<int32_t>(2, width, false);
+    CheckSort<int64_t>(2, width, false);
+  }
+}
+
+}  // namespace tests
+}  // namespace phi
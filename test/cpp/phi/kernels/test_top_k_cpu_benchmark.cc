@@ -0,0 +1,68 @@
+// Copyright (c) 2025 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <functional>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "glog/logging.h"
+#include "paddle/phi/kernels/funcs/cpu_top_k.h"
+#include "test/cpp/phi/core/timer.h"
+
+namespace phi {
+namespace tests {
+
+// Compares TopKRows with the partial sort of the former kernel, built by
+// test_top_k_cpu_benchmark and not run by ctest.
+TEST(TopKCPU, Benchmark) {
+  Timer timer;
+  for (int64_t width : {1 << 10, 1 << 14, 1 << 18}) {
+    const int64_t rows = (1 << 20) / width;
+    std::mt19937 gen(width);
+    std::uniform_real_distribution<float> dist(-1.f, 1.f);
+    std::vector<float> data(rows * width);
+    for (auto& v : data) {
+      v = dist(gen);
+    }
+    for (int64_t k : std::vector<int64_t>{1, 16, 256, width / 4}) {
+      std::vector<float> out(rows * k);
+      std::vector<int64_t> indices(rows * k);
+      timer.tic();
+      funcs::TopKRows(
+          data.data(), rows, width, k, true, true, out.data(), indices.data());
+      double t_topk = timer.toc();
+
+      // the former kernel: a partial sort of (value, index) pairs
+      timer.tic();
+      std::vector<std::pair<float, int64_t>> pairs(width);
+      for (int64_t i = 0; i < rows; ++i) {
+        for (int64_t j = 0; j < width; ++j) {
+          pairs[j] = {data[i * width + j], j};
+        }
+        std::partial_sort(
+            pairs.begin(), pairs.begin() + k, pairs.end(), std::greater<>());
+      }
+      double t_partial_sort = timer.toc();
+      LOG(INFO) << "topk of " << rows << " x " << width << " k " << k << ": "
+                << t_topk << "ms, partial sort: " << t_partial_sort << "ms.";
+    }
+  }
+}
+
+}  // namespace tests
+}  // namespace phi
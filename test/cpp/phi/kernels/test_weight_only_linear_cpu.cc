@@ -0,0 +1,151 @@
+// Copyright (c) 2025 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <random>
+#include <string>
+
+#include "paddle/phi/backends/context_pool.h"
+#include "paddle/phi/backends/cpu/cpu_context.h"
+#include "paddle/phi/core/dense_tensor.h"
+#include "paddle/phi/kernels/funcs/weight_only_gemm.h"
+#include "paddle/phi/kernels/weight_only_linear_kernel.h"
+#include "paddle/phi/kernels/weight_quantize_kernel.h"
+
+namespace phi {
+namespace tests {
+
+namespace {
+
+void FillRandom(const phi::CPUContext& dev_ctx,
+                phi::DenseTensor* t,
+                std::mt19937* gen) {
+  std::uniform_real_distribution<float> dist(-1.f, 1.f);
+  float* data = dev_ctx.template Alloc<float>(t);
+  for (int64_t i = 0; i < t->numel(); ++i) {
+    data[i] = dist(*gen);
+  }
+}
+
+// Reads the weight of channel n at row i back from the CPU layout.
+int QuantizedAt(const phi::DenseTensor& weight,
+                int bits,
+                int64_t n,
+                int64_t i) {
+  const int8_t* data = weight.data<int8_t>();
+  int64_t k = weight.dims()[1];
+  if (bits == 8) {
+    return data[n * k + i];
+  }
+  int8_t packed = data[n / 2 * k + i];
+  return n % 2 == 0 ? static_cast<int8_t>(packed << 4) >> 4 : packed >> 4;
+}
+
+void CheckWeightOnlyLinear(int bits,
+                           int group_size,
+                           int64_t m,
+                           int64_t k = 128) {
+  const int64_t n = 64;
+  auto* dev_ctx = static_cast<phi::CPUContext*>(
+      phi::DeviceContextPool::Instance().Get(phi::CPUPlace()));
+  std::mt19937 gen(bits * 1000 + group_size + m + k);
+
+  phi::DenseTensor x, w, bias;
+  x.Resize({m, k});
+  w.Resize({k, n});
+  bias.Resize({n});
+  FillRandom(*dev_ctx, &x, &gen);
+  FillRandom(*dev_ctx, &w, &gen);
+  FillRandom(*dev_ctx, &bias, &gen);
+
+  phi::DenseTensor quanted, scale;
+  quanted.Resize({bits == 8 ? n : n / 2, k});
+  if (group_size == -1) {
+    scale.Resize({n});
+  } else {
+    scale.Resize({(k + group_size - 1) / group_size, n});
+  }
+  phi::WeightQuantizeKernel<float, phi::CPUContext>(
+      *dev_ctx,
+      w,
+      bits == 8 ? "weight_only_int8" : "weight_only_int4",
+      funcs::kWeightOnlyCPUArch,
+      group_size,
+      &quanted,
+      &scale);
+
+  phi::DenseTensor out;
+  out.Resize({m, n});
+  phi::WeightOnlyLinearKernel<float, phi::CPUContext>(
+      *dev_ctx,
+      x,
+      quanted,
+      paddle::optional<phi::DenseTensor>(bias),
+      scale,
+      bits == 8 ? "int8" : "int4",
+      funcs::kWeightOnlyCPUArch,
+      group_size,
+      &out);
+
+  const float* x_data = x.data<float>();
+  const float* w_data = w.data<float>();
+  const float* scale_data = scale.data<float>();
+  const float* bias_data = bias.data<float>();
+  const float* out_data = out.data<float>();
+  int64_t group = group_size == -1 ? k : group_size;
+  for (int64_t i = 0; i < m; ++i) {
+    for (int64_t j = 0; j < n; ++j) {
+      float dequantized = bias_data[j], exact = bias_data[j];
+      for (int64_t l = 0; l < k; ++l) {
+        dequantized += x_data[i * k + l] * QuantizedAt(quanted, bits, j, l) *
+                       scale_data[l / group * n + j];
+        exact += x_data[i * k + l] * w_data[l * n + j];
+      }
+      // the kernel computes the product with the dequantized weight, which
+      // is close to the float one
+      EXPECT_NEAR(out_data[i * n + j], dequantized, 1e-3f);
+      EXPECT_NEAR(out_data[i * n + j], exact, bits == 8 ? 0.1f : 1.f);
+    }
+  }
+}
+
+}  // namespace
+
+TEST(WeightOnlyLinearCPU, Int8) {
+  // a few rows run the microkernels, many rows the BLAS path
+  for (int64_t m : {1, 3, 40}) {
+    CheckWeightOnlyLinear(8, -1, m);
+    CheckWeightOnlyLinear(8, 64, m);
+  }
+}
+
+TEST(WeightOnlyLinearCPU, Int4) {
+  for (int64_t m : {1, 3, 40}) {
+    CheckWeightOnlyLinear(4, -1, m);
+    CheckWeightOnlyLinear(4, 128, m);
+  }
+}
+
+TEST(WeightOnlyLinearCPU, ShortLastGroup) {
+  // k = 80 splits into groups of 64 and 16 rows
+  for (int64_t m : {1, 3, 40}) {
+    CheckWeightOnlyLinear(8, 64, m, 80);
+    CheckWeightOnlyLinear(4, 64, m, 80);
+  }
+}
+
+}  // namespace tests
+}  // namespace phi
@@ -0,0 +1,103 @@
+// Copyright (c) 2025 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <glog/logging.h>
+#include <gtest/gtest.h>
+#include <chrono>
+#include <filesystem>
+#include <sstream>
+#include <string>
+
+#include "paddle/fluid/pir/dialect/operator/ir/control_flow_op.h"
+#include "paddle/fluid/pir/dialect/operator/ir/op_dialect.h"
+#include "paddle/fluid/pir/dialect/operator/ir/pd_op.h"
+#include "paddle/fluid/pir/serialize_deserialize/include/binary_module.h"
+#include "paddle/fluid/pir/serialize_deserialize/include/interface.h"
+#include "paddle/pir/include/core/builtin_dialect.h"
+#include "paddle/pir/include/core/program.h"
+#include "paddle/pir/include/dialect/control_flow/ir/cf_dialect.h"
+#include "paddle/pir/include/dialect/control_flow/ir/cf_op.h"
+
+namespace {
+
+std::string ToString(const pir::Program& program) {
+  std::ostringstream os;
+  program.Print(os);
+  return os.str();
+}
+
+double ReadMs(const std::string& path, pir::Program* program) {
+  auto start = std::chrono::steady_clock::now();
+  pir::ReadModule(path, program, /*pir_version*/ 1);
+  return std::chrono::duration<double, std::milli>(
+             std::chrono::steady_clock::now() - start)
+      .count();
+}
+
+}  // namespace
+
+TEST(BinaryModule, SameProgramAsJson) {
+  pir::IrContext* ctx = pir::IrContext::Instance();
+  ctx->GetOrRegisterDialect<paddle::dialect::OperatorDialect>();
+  ctx->GetOrRegisterDialect<pir::BuiltinDialect>();
+  ctx->GetOrRegisterDialect<pir::ControlFlowDialect>();
+
+  pir::Program program(ctx);
+  pir::Builder builder(ctx, program.block());
+  // a long chain of ops sharing a few types and attributes
+  pir::Value x =
+      builder.Build<paddle::dialect::FullOp>(std::vector<int64_t>{8, 8}, 1.0)
+          .out();
+  for (int i = 0; i < 1000; i++) {
+    auto y = builder
+                 .Build<paddle::dialect::FullOp>(std::vector<int64_t>{8, 8},
+                                                 static_cast<float>(i % 7))
+                 .out();
+    x = builder.Build<paddle::dialect::AddOp>(x, y).out();
+  }
+  // nested regions are stored as separate chunks
+  auto cond = builder
+                  .Build<paddle::dialect::FullOp>(
+                      std::vector<int64_t>{1}, true, phi::DataType::BOOL)
+                  .out();
+  auto if_op = builder.Build<paddle::dialect::IfOp>(
+      cond, std::vector<pir::Type>{x.type()});
+  builder.SetInsertionPointToStart(&if_op.true_block());
+  auto one =
+      builder.Build<paddle::dialect::FullOp>(std::vector<int64_t>{8, 8}, 1.0);
+  auto sum = builder.Build<paddle::dialect::AddOp>(x, one.out());
+  builder.Build<pir::YieldOp>(std::vector<pir::Value>{sum.out()});
+  builder.SetInsertionPointToStart(&if_op.false_block());
+  builder.Build<pir::YieldOp>(std::vector<pir::Value>{x});
+
+  const std::string json_path = "./binary_module_test.json";
+  const std::string binary_path = "./binary_module_test.pirb";
+  pir::WriteModule(program, json_path, 1, true, false, true);
+  pir::WriteModule(program, binary_path, 1, true, false, true, true);
+  EXPECT_FALSE(pir::BinaryModule::IsBinary(json_path));
+  EXPECT_TRUE(pir::BinaryModule::IsBinary(binary_path));
+
+  pir::Program json_program(ctx), binary_program(ctx);
+  double json_ms = ReadMs(json_path, &json_program);
+  double binary_ms = ReadMs(binary_path, &binary_program);
+  auto json_size = std::filesystem::file_size(json_path);
+  auto binary_size = std::filesystem::file_size(binary_path);
+  LOG(INFO) << "json: " << json_size << " bytes, read in " << json_ms
+            << " ms; binary: " << binary_size << " bytes, read in "
+            << binary_ms << " ms";
+
+  EXPECT_LT(binary_size, json_size);
+  EXPECT_EQ(json_program.block()->size(), program.block()->size());
+  EXPECT_EQ(ToString(binary_program), ToString(json_program));
+}
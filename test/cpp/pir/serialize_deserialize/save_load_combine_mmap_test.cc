@@ -0,0 +1,78 @@
+// Copyright (c) 2025 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "paddle/common/flags.h"
+#include "paddle/fluid/pir/serialize_deserialize/include/interface.h"
+#include "paddle/phi/backends/context_pool.h"
+#include "paddle/phi/core/dense_tensor.h"
+
+COMMON_DECLARE_bool(load_combine_params_by_mmap);
+
+namespace {
+
+phi::DenseTensor MakeTensor(const std::vector<int64_t>& dims, float start) {
+  phi::DenseTensor x;
+  x.Resize(common::make_ddim(dims));
+  auto* dev_ctx = phi::DeviceContextPool::Instance().Get(phi::CPUPlace());
+  float* data = dev_ctx->Alloc<float>(&x);
+  for (int64_t i = 0; i < x.numel(); i++) {
+    data[i] = start + static_cast<float>(i);
+  }
+  return x;
+}
+
+void LoadAndCheck(const std::string& path,
+                  const std::vector<std::string>& names,
+                  const std::vector<phi::DenseTensor>& expect) {
+  std::vector<phi::DenseTensor> tensors(names.size());
+  std::vector<phi::DenseTensor*> out;
+  for (auto& t : tensors) out.push_back(&t);
+  pir::LoadCombineFunction(path, names, &out, false, phi::CPUPlace());
+  for (size_t i = 0; i < names.size(); i++) {
+    ASSERT_EQ(tensors[i].dims(), expect[i].dims());
+    ASSERT_EQ(tensors[i].dtype(), phi::DataType::FLOAT32);
+    const float* data = tensors[i].data<float>();
+    if (FLAGS_load_combine_params_by_mmap) {
+      EXPECT_EQ(reinterpret_cast<uintptr_t>(data) % 64, 0UL);
+    }
+    for (int64_t j = 0; j < expect[i].numel(); j++) {
+      ASSERT_EQ(data[j], expect[i].data<float>()[j]);
+    }
+  }
+}
+
+}  // namespace
+
+TEST(SaveLoadCombine, LoadByMmap) {
+  std::vector<phi::DenseTensor> tensors = {MakeTensor({3}, 0.f),
+                                           MakeTensor({17, 5}, 100.f),
+                                           MakeTensor({1}, -1.f),
+                                           MakeTensor({64, 33}, 7.f)};
+  std::vector<std::string> names = {"a", "b", "c", "d"};
+  std::vector<const phi::DenseTensor*> x;
+  for (auto& t : tensors) x.push_back(&t);
+  const std::string path = "./save_load_combine_mmap_test.pdiparams";
+  pir::SaveCombineFunction(x, names, path, true, false, false);
+
+  FLAGS_load_combine_params_by_mmap = false;
+  LoadAndCheck(path, names, tensors);
+  FLAGS_load_combine_params_by_mmap = true;
+  LoadAndCheck(path, names, tensors);
+  FLAGS_load_combine_params_by_mmap = false;
+}
@@ -0,0 +1,131 @@
+// Copyright (c) 2025 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "glog/logging.h"
+#include "paddle/common/flags.h"
+#include "paddle/fluid/pir/serialize_deserialize/include/interface.h"
+#include "paddle/phi/backends/context_pool.h"
+#include "paddle/phi/common/float16.h"
+#include "paddle/phi/core/dense_tensor.h"
+
+COMMON_DECLARE_int32(load_params_thread_num);
+
+namespace {
+
+// Many small parameters, as in models saved with one file per parameter.
+constexpr int kParamNum = 512;
+
+phi::DenseTensor MakeTensor(int64_t numel, float start) {
+  phi::DenseTensor x;
+  x.Resize(common::make_ddim({numel}));
+  auto* dev_ctx = phi::DeviceContextPool::Instance().Get(phi::CPUPlace());
+  float* data = dev_ctx->Alloc<float>(&x);
+  for (int64_t i = 0; i < numel; i++) {
+    data[i] = start + static_cast<float>(i % 100);
+  }
+  return x;
+}
+
+double TimeMs(const std::function<void()>& fn) {
+  auto start = std::chrono::steady_clock::now();
+  fn();
+  return std::chrono::duration<double, std::milli>(
+             std::chrono::steady_clock::now() - start)
+      .count();
+}
+
+class SaveLoadParallel : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    thread_num_ = FLAGS_load_params_thread_num;
+    for (int i = 0; i < kParamNum; i++) {
+      names_.push_back("param_" + std::to_string(i));
+      // mix sizes so that a static split would be unbalanced
+      tensors_.push_back(MakeTensor(i % 16 == 0 ? 65536 : 256, i));
+    }
+  }
+
+  void TearDown() override { FLAGS_load_params_thread_num = thread_num_; }
+
+  void Check(const std::vector<phi::DenseTensor>& loaded, bool as_fp16) {
+    ASSERT_EQ(loaded.size(), tensors_.size());
+    for (size_t i = 0; i < loaded.size(); i++) {
+      ASSERT_EQ(loaded[i].dims(), tensors_[i].dims());
+      const float* expect = tensors_[i].data<float>();
+      for (int64_t j = 0; j < loaded[i].numel(); j++) {
+        if (as_fp16) {
+          ASSERT_EQ(loaded[i].dtype(), phi::DataType::FLOAT16);
+          ASSERT_EQ(static_cast<float>(loaded[i].data<phi::float16>()[j]),
+                    static_cast<float>(static_cast<phi::float16>(expect[j])));
+        } else {
+          ASSERT_EQ(loaded[i].data<float>()[j], expect[j]);
+        }
+      }
+    }
+  }
+
+  std::vector<std::string> names_;
+  std::vector<phi::DenseTensor> tensors_;
+  int thread_num_;
+};
+
+}  // namespace
+
+TEST_F(SaveLoadParallel, SeparateFiles) {
+  std::vector<std::string> files;
+  for (int i = 0; i < kParamNum; i++) {
+    files.push_back("./save_load_parallel_test/" + names_[i]);
+    pir::SaveFunction(tensors_[i], names_[i], files.back(), true, false);
+  }
+  for (int threads : {1, 8}) {
+    FLAGS_load_params_thread_num = threads;
+    std::vector<phi::DenseTensor> loaded(kParamNum);
+    std::vector<phi::DenseTensor*> out;
+    for (auto& t : loaded) out.push_back(&t);
+    double ms = TimeMs(
+        [&] { pir::LoadFunctions(files, out, false, phi::CPUPlace()); });
+    LOG(INFO) << "Load " << kParamNum << " separate params with " << threads
+              << " threads: " << ms << " ms";
+    Check(loaded, false);
+  }
+}
+
+TEST_F(SaveLoadParallel, CombinedFile) {
+  std::vector<const phi::DenseTensor*> x;
+  for (auto& t : tensors_) x.push_back(&t);
+  const std::string path = "./save_load_parallel_test.pdiparams";
+  pir::SaveCombineFunction(x, names_, path, true, false, false);
+  // Loading as fp16 needs a cast per tensor, which is what the pipeline
+  // overlaps with reading the file.
+  for (bool as_fp16 : {false, true}) {
+    for (int threads : {1, 8}) {
+      FLAGS_load_params_thread_num = threads;
+      std::vector<phi::DenseTensor> loaded(kParamNum);
+      std::vector<phi::DenseTensor*> out;
+      for (auto& t : loaded) out.push_back(&t);
+      double ms = TimeMs([&] {
+        pir::LoadCombineFunction(path, names_, &out, as_fp16, phi::CPUPlace());
+      });
+      LOG(INFO) << "Load combined params (fp16: " << as_fp16 << ") with "
+                << threads << " threads: " << ms << " ms";
+      Check(loaded, as_fp16);
+    }
+  }
+}
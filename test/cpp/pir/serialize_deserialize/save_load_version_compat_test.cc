@@ -17,6 +17,7 @@
 #include <filesystem>
 #include <iostream>
 #include <map>
+#include <memory>
 #include <sstream>
 #include <string>
 #include <vector>
@@ -25,6 +26,7 @@
 #include "paddle/fluid/pir/dialect/operator/ir/op_dialect.h"
 #include "paddle/fluid/pir/dialect/operator/ir/op_type.h"
 #include "paddle/fluid/pir/dialect/operator/utils/utils.h"
+#include "paddle/fluid/pir/serialize_deserialize/include/binary_module.h"
 #include "paddle/fluid/pir/serialize_deserialize/include/interface.h"
 #include "paddle/fluid/pir/serialize_deserialize/include/ir_deserialize.h"
 #include "paddle/fluid/pir/serialize_deserialize/include/version_compat.h"
@@ -75,8 +77,17 @@ TEST(save_load_version_compat, op_patch_test) {
 bool ReadModuleForTest(const std::string &file_path,
                        pir::Program *program,
                        uint64_t pir_version) {
-  std::ifstream f(file_path);
-  Json data = Json::parse(f);
+  // a binary module is read through the same json of base code and program
+  std::unique_ptr<pir::BinaryModule> binary_module;
+  Json data;
+  if (pir::BinaryModule::IsBinary(file_path)) {
+    binary_module = std::make_unique<pir::BinaryModule>(file_path);
+    data[BASE_CODE] = *binary_module->base_code();
+    data[PROGRAM] = *binary_module->program();
+  } else {
+    std::ifstream f(file_path);
+    data = Json::parse(f);
+  }
   pir::PatchBuilder builder(pir_version);
 
   if (data.contains(BASE_CODE) && data[BASE_CODE].contains(MAGIC) &&
@@ -95,6 +106,9 @@ bool ReadModuleForTest(const std::string &file_path,
   }
 
   pir::ProgramReader reader(pir_version);
+  if (binary_module) {
+    reader.SetBinaryModule(binary_module.get());
+  }
   reader.RecoverProgram(&(data[PROGRAM]), program, &builder);
 
   if (data[BASE_CODE].contains(TRAINABLE)) {
@@ -104,8 +118,9 @@ bool ReadModuleForTest(const std::string &file_path,
   }
 }
 
-// Test for attribute patch and op attribute modification.
-TEST(save_load_version_compat, attribute_patch_test1) {
+// Saves a program in version 1, in json or in the binary format, and checks
+// the attribute patches applied when it is read as version 2.
+void CheckAttributePatch(bool binary) {
   pir::IrContext *ctx = pir::IrContext::Instance();
   ctx->GetOrRegisterDialect<test::TestDialect>();
   ctx->GetOrRegisterDialect<paddle::dialect::OperatorDialect>();
@@ -137,8 +152,14 @@ TEST(save_load_version_compat, attribute_patch_test1) {
   program.block()->push_back(op2);
 
   // Save the program into file
-  pir::WriteModule(
-      program, "./test_save_load", /*pir_version*/ 1, true, false, true);
+  pir::WriteModule(program,
+                   "./test_save_load",
+                   /*pir_version*/ 1,
+                   true,
+                   false,
+                   true,
+                   binary);
+  EXPECT_EQ(pir::BinaryModule::IsBinary("./test_save_load"), binary);
   // Load the program from file
   pir::Program new_program(ctx);
   ReadModuleForTest("./test_save_load", &new_program, 2);
@@ -179,6 +200,16 @@ TEST(save_load_version_compat, attribute_patch_test1) {
             pir::Float64Type::get(ctx));
 }
 
+// Test for attribute patch and op attribute modification.
+TEST(save_load_version_compat, attribute_patch_test1) {
+  CheckAttributePatch(false);
+}
+
+// The patches apply to the type and attribute tables of a binary module.
+TEST(save_load_version_compat, attribute_patch_binary_test) {
+  CheckAttributePatch(true);
+}
+
 // Test for op I/O and op attribute modification.
 TEST(save_load_version_compat, op_patch_test1) {
   pir::IrContext *ctx = pir::IrContext::Instance();